@@ -0,0 +1,242 @@
+#include "TestUtilities.h"
+
+#include "Core/BoundingObjects/AABBTree.h"
+
+#include <random>
+#include <algorithm>
+
+using namespace MxEngine;
+
+namespace
+{
+    // leaves of tested tree together with their exact boxes. User data of each leaf is its index in this list
+    struct TreeLeaves
+    {
+        MxVector<AABBTree::ProxyId> Proxies;
+        MxVector<AABB> Boxes;
+        MxVector<size_t> Alive;
+    };
+
+    AABB MakeRandomBox(std::mt19937& random, float worldSize)
+    {
+        std::uniform_real_distribution<float> coordinate(-worldSize, worldSize);
+        std::uniform_real_distribution<float> size(0.1f, 5.0f);
+        auto center = MakeVector3(coordinate(random), coordinate(random), coordinate(random));
+        auto extent = MakeVector3(size(random), size(random), size(random));
+        return AABB{ center - extent, center + extent };
+    }
+
+    AABB OffsetBox(const AABB& box, const Vector3& offset)
+    {
+        return AABB{ box.Min + offset, box.Max + offset };
+    }
+
+    // performs random insertions, moves and removals, checking tree structure every few operations
+    size_t ApplyRandomOperations(AABBTree& tree, TreeLeaves& leaves, std::mt19937& random, size_t operationCount)
+    {
+        std::uniform_int_distribution<int> operation(0, 9);
+        std::uniform_real_distribution<float> offset(-3.0f, 3.0f);
+        size_t invalidChecks = 0;
+        for (size_t i = 0; i < operationCount; i++)
+        {
+            int type = operation(random);
+            if (type < 4 || leaves.Alive.empty())
+            {
+                auto box = MakeRandomBox(random, 100.0f);
+                size_t index = leaves.Boxes.size();
+                leaves.Boxes.push_back(box);
+                leaves.Proxies.push_back(tree.Insert(box, index));
+                leaves.Alive.push_back(index);
+            }
+            else if (type < 8)
+            {
+                size_t index = leaves.Alive[random() % leaves.Alive.size()];
+                // small moves usually stay inside fat box, large ones always reinsert leaf
+                auto moved = type == 7 ? MakeRandomBox(random, 100.0f) : OffsetBox(leaves.Boxes[index], MakeVector3(offset(random), offset(random), offset(random)) * 0.1f);
+                leaves.Boxes[index] = moved;
+                tree.Move(leaves.Proxies[index], moved);
+            }
+            else
+            {
+                size_t aliveIndex = random() % leaves.Alive.size();
+                size_t index = leaves.Alive[aliveIndex];
+                tree.Remove(leaves.Proxies[index]);
+                leaves.Proxies[index] = AABBTree::InvalidProxy;
+                leaves.Alive[aliveIndex] = leaves.Alive.back();
+                leaves.Alive.pop_back();
+            }
+
+            if (i % 64 == 0 && !tree.Validate()) invalidChecks++;
+        }
+        if (!tree.Validate()) invalidChecks++;
+        return invalidChecks;
+    }
+
+    bool Contains(const AABB& outer, const AABB& inner)
+    {
+        return outer.Min.x <= inner.Min.x && outer.Min.y <= inner.Min.y && outer.Min.z <= inner.Min.z &&
+               outer.Max.x >= inner.Max.x && outer.Max.y >= inner.Max.y && outer.Max.z >= inner.Max.z;
+    }
+
+    template<typename Predicate>
+    MxVector<size_t> BruteForce(const AABBTree& tree, const TreeLeaves& leaves, Predicate&& predicate)
+    {
+        MxVector<size_t> result;
+        for (size_t index : leaves.Alive)
+        {
+            if (predicate(tree.GetFatBox(leaves.Proxies[index]))) result.push_back(index);
+        }
+        std::sort(result.begin(), result.end());
+        return result;
+    }
+
+    MxVector<size_t> Sorted(MxVector<size_t> values)
+    {
+        std::sort(values.begin(), values.end());
+        return values;
+    }
+}
+
+MX_TEST(AABBTreeInvariants)
+{
+    std::mt19937 random(7);
+    AABBTree tree;
+    TreeLeaves leaves;
+    MX_CHECK(tree.Validate());
+
+    size_t invalidChecks = ApplyRandomOperations(tree, leaves, random, 20000);
+    MX_CHECK(invalidChecks == 0);
+    MX_CHECK(tree.GetLeafCount() == leaves.Alive.size());
+
+    // fat box of each leaf must contain exact box of its object
+    size_t uncoveredLeaves = 0;
+    for (size_t index : leaves.Alive)
+    {
+        if (!Contains(tree.GetFatBox(leaves.Proxies[index]), leaves.Boxes[index])) uncoveredLeaves++;
+        if (tree.GetUserData(leaves.Proxies[index]) != index) uncoveredLeaves++;
+    }
+    MX_CHECK(uncoveredLeaves == 0);
+
+    // balancing keeps height logarithmic even for random insertion order
+    size_t log2Count = 0;
+    while (((size_t)1 << log2Count) < tree.GetLeafCount()) log2Count++;
+    MX_CHECK((size_t)tree.GetHeight() <= 3 * log2Count);
+
+    // removing all leaves must leave tree empty and consistent
+    for (size_t index : leaves.Alive)
+        tree.Remove(leaves.Proxies[index]);
+    MX_CHECK(tree.GetLeafCount() == 0 && tree.GetHeight() == 0);
+    MX_CHECK(tree.Validate());
+}
+
+MX_TEST(AABBTreeQueriesMatchBruteForce)
+{
+    std::mt19937 random(99);
+    AABBTree tree;
+    TreeLeaves leaves;
+    MX_CHECK(ApplyRandomOperations(tree, leaves, random, 5000) == 0);
+
+    size_t mismatches = 0;
+    for (size_t query = 0; query < 50; query++)
+    {
+        auto box = MakeRandomBox(random, 100.0f);
+        box.Max += MakeVector3(10.0f);
+        MxVector<size_t> found;
+        tree.QueryAABB(box, [&found](AABBTree::UserData index) { found.push_back(index); return true; });
+        if (Sorted(found) != BruteForce(tree, leaves, [&box](const AABB& fatBox) { return AABBTree::Overlaps(fatBox, box); })) mismatches++;
+
+        BoundingSphere sphere(box.GetCenter(), 15.0f);
+        found.clear();
+        tree.QuerySphere(sphere, [&found](AABBTree::UserData index) { found.push_back(index); return true; });
+        if (Sorted(found) != BruteForce(tree, leaves, [&sphere](const AABB& fatBox) { return AABBTree::DistanceSquared(fatBox, sphere.Center) <= sphere.Radius * sphere.Radius; })) mismatches++;
+
+        auto from = MakeRandomBox(random, 100.0f).GetCenter();
+        auto to = MakeRandomBox(random, 100.0f).GetCenter();
+        found.clear();
+        // returning full fraction keeps collecting hits behind closer ones
+        tree.RayCast(from, to, [&found](AABBTree::UserData index, float) { found.push_back(index); return 1.0f; });
+        if (Sorted(found) != BruteForce(tree, leaves, [&](const AABB& fatBox) { return AABBTree::IntersectRay(fatBox, from, to - from, 1.0f) >= 0.0f; })) mismatches++;
+
+        // nearest leaves may tie in distance, so distances are compared instead of leaf ids
+        constexpr size_t nearestCount = 10;
+        MxVector<AABBTree::UserData> nearest;
+        tree.QueryNearest(from, nearestCount, nearest);
+        MxVector<float> distances;
+        for (size_t index : leaves.Alive)
+            distances.push_back(AABBTree::DistanceSquared(tree.GetFatBox(leaves.Proxies[index]), from));
+        std::sort(distances.begin(), distances.end());
+        if (nearest.size() != Min(nearestCount, distances.size())) mismatches++;
+        for (size_t i = 0; i < nearest.size(); i++)
+        {
+            if (AABBTree::DistanceSquared(tree.GetFatBox(leaves.Proxies[nearest[i]]), from) != distances[i]) mismatches++;
+        }
+    }
+
+    auto projection = MakePerspectiveMatrix(Radians(65.0f), 1.5f, 0.1f, 150.0f);
+    auto view = MakeViewMatrix(MakeVector3(0.0f), MakeVector3(1.0f, 0.2f, 0.5f), MakeVector3(0.0f, 1.0f, 0.0f));
+    FrustrumCuller culler(projection * view);
+    MxVector<size_t> found;
+    size_t insideLeaves = 0;
+    tree.QueryFrustrum(culler, [&](AABBTree::UserData index, bool isInside)
+    {
+        found.push_back(index);
+        const auto& fatBox = tree.GetFatBox(leaves.Proxies[index]);
+        uint8_t planeMask = FrustrumCuller::AllPlanesMask;
+        // leaves reported as fully inside must not intersect any plane
+        if (isInside && (!culler.IsAABBVisible(fatBox.Min, fatBox.Max, planeMask) || planeMask != 0)) insideLeaves++;
+        return true;
+    });
+    auto expected = BruteForce(tree, leaves, [&culler](const AABB& fatBox)
+    {
+        uint8_t planeMask = FrustrumCuller::AllPlanesMask;
+        return culler.IsAABBVisible(fatBox.Min, fatBox.Max, planeMask);
+    });
+    MX_CHECK(Sorted(found) == expected);
+    MX_CHECK(!expected.empty());
+    MX_CHECK(insideLeaves == 0);
+    MX_CHECK(mismatches == 0);
+}
+
+MX_TEST(AABBTreeStaticSceneBenchmark)
+{
+    // 100k objects, of which 1% move each frame. Most moves are small and stay inside fat boxes
+    constexpr size_t objectCount = 100000;
+    constexpr size_t frameCount = 60;
+    std::mt19937 random(2024);
+    std::uniform_real_distribution<float> offset(-0.05f, 0.05f);
+
+    AABBTree tree;
+    TreeLeaves leaves;
+    {
+        EngineTests::ScopedBenchmark benchmark("AABBTree::Insert", objectCount);
+        for (size_t i = 0; i < objectCount; i++)
+        {
+            auto box = MakeRandomBox(random, 1000.0f);
+            leaves.Boxes.push_back(box);
+            leaves.Proxies.push_back(tree.Insert(box, i));
+        }
+    }
+
+    auto projection = MakePerspectiveMatrix(Radians(65.0f), 16.0f / 9.0f, 0.1f, 500.0f);
+    auto view = MakeViewMatrix(MakeVector3(0.0f), MakeVector3(1.0f, 0.0f, 0.3f), MakeVector3(0.0f, 1.0f, 0.0f));
+    FrustrumCuller culler(projection * view);
+
+    size_t reinserted = 0;
+    size_t visible = 0;
+    {
+        EngineTests::ScopedBenchmark benchmark("AABBTree frame (1% moved + frustrum query)", frameCount);
+        for (size_t frame = 0; frame < frameCount; frame++)
+        {
+            for (size_t i = 0; i < objectCount / 100; i++)
+            {
+                size_t index = random() % objectCount;
+                leaves.Boxes[index] = OffsetBox(leaves.Boxes[index], MakeVector3(offset(random), offset(random), offset(random)));
+                reinserted += tree.Move(leaves.Proxies[index], leaves.Boxes[index]);
+            }
+            tree.QueryFrustrum(culler, [&visible](AABBTree::UserData, bool) { visible++; return true; });
+        }
+    }
+    std::cout << "    " << reinserted << " of " << frameCount * objectCount / 100 << " moves reinserted leaves, tree height " << tree.GetHeight() << std::endl;
+    MX_CHECK(visible > 0);
+    MX_CHECK(tree.Validate());
+}
@@ -0,0 +1,172 @@
+#include "TestUtilities.h"
+
+#include "Utilities/ECS/Component.h"
+
+#include <utility>
+
+using namespace MxEngine;
+
+namespace
+{
+    #define MX_TEST_COMPONENT(name) \
+        struct name \
+        { \
+            MAKE_COMPONENT(name); \
+        public: \
+            size_t Value = 0; \
+            name() = default; \
+            name(size_t value) : Value(value) { } \
+        }
+
+    MX_TEST_COMPONENT(LookupComponent0);
+    MX_TEST_COMPONENT(LookupComponent1);
+    MX_TEST_COMPONENT(LookupComponent2);
+    MX_TEST_COMPONENT(LookupComponent3);
+    MX_TEST_COMPONENT(LookupComponent4);
+    MX_TEST_COMPONENT(LookupComponent5);
+    MX_TEST_COMPONENT(LookupComponent6);
+    MX_TEST_COMPONENT(LookupComponent7);
+    MX_TEST_COMPONENT(LookupComponent8);
+    MX_TEST_COMPONENT(LookupComponent9);
+
+    #undef MX_TEST_COMPONENT
+
+    // removes another component of its owner when destroyed
+    struct CascadeComponent
+    {
+        MAKE_COMPONENT(CascadeComponent);
+    public:
+        ComponentManager* Owner = nullptr;
+
+        CascadeComponent(ComponentManager* owner) : Owner(owner) { }
+        CascadeComponent(CascadeComponent&& other) noexcept : Owner(std::exchange(other.Owner, nullptr)) { }
+
+        ~CascadeComponent()
+        {
+            if (this->Owner != nullptr) this->Owner->RemoveComponent<LookupComponent1>();
+        }
+    };
+
+    void AddLookupComponents(ComponentManager& manager, size_t value)
+    {
+        manager.AddComponent<LookupComponent0>(value + 0);
+        manager.AddComponent<LookupComponent1>(value + 1);
+        manager.AddComponent<LookupComponent2>(value + 2);
+        manager.AddComponent<LookupComponent3>(value + 3);
+        manager.AddComponent<LookupComponent4>(value + 4);
+        manager.AddComponent<LookupComponent5>(value + 5);
+        manager.AddComponent<LookupComponent6>(value + 6);
+        manager.AddComponent<LookupComponent7>(value + 7);
+        manager.AddComponent<LookupComponent8>(value + 8);
+        manager.AddComponent<LookupComponent9>(value + 9);
+    }
+}
+
+MX_TEST(ComponentManagerAddRemove)
+{
+    ComponentManager manager;
+    AddLookupComponents(manager, 100);
+    MX_CHECK(manager.HasComponent<LookupComponent0>() && manager.HasComponent<LookupComponent9>());
+    MX_CHECK(manager.BorrowComponent<LookupComponent4>()->Value == 104);
+
+    // removed component is replaced by the last one, which must still be found through slot table
+    manager.RemoveComponent<LookupComponent2>();
+    MX_CHECK(!manager.HasComponent<LookupComponent2>());
+    MX_CHECK(manager.GetComponent<LookupComponent9>()->Value == 109);
+    MX_CHECK(manager.BorrowComponent<LookupComponent2>() == nullptr);
+
+    // adding component of existing type replaces it
+    manager.AddComponent<LookupComponent9>(7);
+    MX_CHECK(manager.BorrowComponent<LookupComponent9>()->Value == 7);
+
+    bool isFound = true;
+    isFound &= manager.BorrowComponent<LookupComponent0>()->Value == 100;
+    isFound &= manager.BorrowComponent<LookupComponent1>()->Value == 101;
+    isFound &= manager.BorrowComponent<LookupComponent3>()->Value == 103;
+    isFound &= manager.BorrowComponent<LookupComponent8>()->Value == 108;
+    MX_CHECK(isFound);
+
+    manager.RemoveAllComponents();
+    MX_CHECK(!manager.HasComponent<LookupComponent0>() && !manager.HasComponent<LookupComponent9>());
+}
+
+MX_TEST(ComponentManagerRemoveFromDestructor)
+{
+    ComponentManager manager;
+    manager.AddComponent<CascadeComponent>(&manager);
+    manager.AddComponent<LookupComponent1>(1);
+    manager.AddComponent<LookupComponent2>(2);
+
+    // list changes while first component is destroyed, so removal must locate it again
+    manager.RemoveComponent<CascadeComponent>();
+    MX_CHECK(!manager.HasComponent<CascadeComponent>());
+    MX_CHECK(!manager.HasComponent<LookupComponent1>());
+    MX_CHECK(manager.HasComponent<LookupComponent2>() && manager.BorrowComponent<LookupComponent2>()->Value == 2);
+}
+
+MX_TEST(ComponentManagerMoveAssign)
+{
+    ComponentManager first, second;
+    first.AddComponent<LookupComponent0>(1);
+    auto previous = first.GetComponent<LookupComponent0>();
+    second.AddComponent<LookupComponent1>(2);
+
+    first = std::move(second);
+    MX_CHECK(!first.HasComponent<LookupComponent0>() && first.BorrowComponent<LookupComponent1>()->Value == 2);
+    // previous components are kept by moved-from manager until it is destroyed
+    MX_CHECK(second.HasComponent<LookupComponent0>() && previous.IsValid());
+    second.RemoveAllComponents();
+    MX_CHECK(!previous.IsValid());
+}
+
+MX_TEST(ComponentManagerLookupBenchmark)
+{
+    constexpr size_t objectCount = 10000;
+    constexpr size_t lookupRounds = 10;
+    MxVector<ComponentManager> managers(objectCount);
+    for (size_t i = 0; i < objectCount; i++)
+        AddLookupComponents(managers[i], i);
+
+    size_t checksum = 0;
+    {
+        EngineTests::ScopedBenchmark benchmark("borrow lookup of 10 components per object", objectCount * lookupRounds * 10);
+        for (size_t round = 0; round < lookupRounds; round++)
+        {
+            for (const auto& manager : managers)
+            {
+                checksum += manager.BorrowComponent<LookupComponent0>()->Value;
+                checksum += manager.BorrowComponent<LookupComponent1>()->Value;
+                checksum += manager.BorrowComponent<LookupComponent2>()->Value;
+                checksum += manager.BorrowComponent<LookupComponent3>()->Value;
+                checksum += manager.BorrowComponent<LookupComponent4>()->Value;
+                checksum += manager.BorrowComponent<LookupComponent5>()->Value;
+                checksum += manager.BorrowComponent<LookupComponent6>()->Value;
+                checksum += manager.BorrowComponent<LookupComponent7>()->Value;
+                checksum += manager.BorrowComponent<LookupComponent8>()->Value;
+                checksum += manager.BorrowComponent<LookupComponent9>()->Value;
+            }
+        }
+    }
+    // sum of i + k over all objects and component indices
+    size_t expected = lookupRounds * (10 * objectCount * (objectCount - 1) / 2 + objectCount * 45);
+    MX_CHECK(checksum == expected);
+
+    size_t validHandles = 0;
+    {
+        EngineTests::ScopedBenchmark benchmark("handle lookup of 10 components per object", objectCount * 10);
+        for (const auto& manager : managers)
+        {
+            validHandles += manager.GetComponent<LookupComponent0>().IsValid();
+            validHandles += manager.GetComponent<LookupComponent1>().IsValid();
+            validHandles += manager.GetComponent<LookupComponent2>().IsValid();
+            validHandles += manager.GetComponent<LookupComponent3>().IsValid();
+            validHandles += manager.GetComponent<LookupComponent4>().IsValid();
+            validHandles += manager.GetComponent<LookupComponent5>().IsValid();
+            validHandles += manager.GetComponent<LookupComponent6>().IsValid();
+            validHandles += manager.GetComponent<LookupComponent7>().IsValid();
+            validHandles += manager.GetComponent<LookupComponent8>().IsValid();
+            validHandles += manager.GetComponent<LookupComponent9>().IsValid();
+        }
+    }
+    MX_CHECK(validHandles == objectCount * 10);
+}
@@ -0,0 +1,109 @@
+#include "TestUtilities.h"
+
+#include "Core/MxObject/MxObject.h"
+
+using namespace MxEngine;
+
+namespace
+{
+    #define MX_TEST_COMPONENT(name) \
+        struct name \
+        { \
+            MAKE_COMPONENT(name); \
+        public: \
+            size_t Value = 0; \
+            name() = default; \
+            name(size_t value) : Value(value) { } \
+        }
+
+    MX_TEST_COMPONENT(QueryComponentA);
+    MX_TEST_COMPONENT(QueryComponentB);
+    MX_TEST_COMPONENT(QueryBenchmarkComponentA);
+    MX_TEST_COMPONENT(QueryBenchmarkComponentB);
+
+    #undef MX_TEST_COMPONENT
+
+    template<typename... Ts>
+    bool IsQueryMatched(const MxObject& object)
+    {
+        for (auto entry : ComponentFactory::Query<Ts...>())
+        {
+            if (entry.GetObjectHandle() == object.GetNativeHandle()) return true;
+        }
+        return false;
+    }
+}
+
+MX_TEST(ComponentQueryMatchList)
+{
+    // objects created before first query call are collected when query is registered
+    auto existing = MxObject::Create();
+    existing->AddComponent<QueryComponentA>(1);
+    existing->AddComponent<QueryComponentB>(2);
+    auto partial = MxObject::Create();
+    partial->AddComponent<QueryComponentA>(3);
+
+    MX_CHECK(ComponentFactory::Query<QueryComponentA, QueryComponentB>().size() == 1);
+    MX_CHECK(IsQueryMatched<QueryComponentA, QueryComponentB>(*existing));
+    MX_CHECK(!IsQueryMatched<QueryComponentA, QueryComponentB>(*partial));
+
+    // later changes are applied incrementally
+    partial->AddComponent<QueryComponentB>(4);
+    MX_CHECK(IsQueryMatched<QueryComponentA, QueryComponentB>(*partial));
+    auto entry = ComponentFactory::Query<QueryComponentA, QueryComponentB>()[1];
+    MX_CHECK(entry.Get<QueryComponentA>().Value == 3 && entry.Get<QueryComponentB>().Value == 4);
+
+    existing->RemoveComponent<QueryComponentB>();
+    MX_CHECK(!IsQueryMatched<QueryComponentA, QueryComponentB>(*existing));
+    MX_CHECK(ComponentFactory::Query<QueryComponentA, QueryComponentB>().size() == 1);
+
+    MxObject::Destroy(partial);
+    MX_CHECK(ComponentFactory::Query<QueryComponentA, QueryComponentB>().size() == 0);
+    MxObject::Destroy(existing);
+}
+
+MX_TEST(ComponentQueryBenchmark)
+{
+    // every fourth object has both components, as most objects in a scene do not match a particular query
+    constexpr size_t objectCount = 100000;
+    constexpr size_t iterationCount = 10;
+    MxVector<MxObject::Handle> objects;
+    objects.reserve(objectCount);
+    for (size_t i = 0; i < objectCount; i++)
+    {
+        auto& object = objects.emplace_back(MxObject::Create());
+        object->AddComponent<QueryBenchmarkComponentA>(i);
+        if (i % 4 == 0) object->AddComponent<QueryBenchmarkComponentB>(i);
+    }
+    auto query = ComponentFactory::Query<QueryBenchmarkComponentA, QueryBenchmarkComponentB>();
+
+    size_t viewSum = 0;
+    {
+        EngineTests::ScopedBenchmark benchmark("GetView + HasComponent iteration", objectCount * iterationCount);
+        for (size_t iteration = 0; iteration < iterationCount; iteration++)
+        {
+            for (auto& componentA : ComponentFactory::GetView<QueryBenchmarkComponentA>())
+            {
+                auto& object = MxObject::GetByComponent(componentA);
+                if (!object.HasComponent<QueryBenchmarkComponentB>()) continue;
+                viewSum += componentA.Value + object.BorrowComponent<QueryBenchmarkComponentB>()->Value;
+            }
+        }
+    }
+
+    size_t querySum = 0;
+    {
+        EngineTests::ScopedBenchmark benchmark("Query iteration", objectCount * iterationCount);
+        for (size_t iteration = 0; iteration < iterationCount; iteration++)
+        {
+            for (auto entry : query)
+                querySum += entry.Get<QueryBenchmarkComponentA>().Value + entry.Get<QueryBenchmarkComponentB>().Value;
+        }
+    }
+    MX_CHECK(query.size() == objectCount / 4);
+    MX_CHECK(viewSum == querySum);
+
+    for (auto& object : objects)
+        MxObject::Destroy(object);
+    MX_CHECK(query.size() == 0);
+}
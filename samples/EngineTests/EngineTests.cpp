@@ -0,0 +1,47 @@
+#include "TestUtilities.h"
+#include "Utilities/Logging/Logger.h"
+#include "Utilities/UUID/UUID.h"
+#include "Utilities/JobSystem/JobSystem.h"
+#include "Utilities/ECS/ComponentFactory.h"
+#include "Core/MxObject/MxObject.h"
+#include "Core/Components/TransformHierarchy.h"
+
+#include <cstring>
+
+/*
+engine tests do not create application or graphic context, so only modules which are independent of them are covered.
+Only services which are shared by such modules (logger, uuid generator, job system, component storage and object storage) are initialized.
+Pass test name as first argument to run only one test
+*/
+int main(int argc, char** argv)
+{
+    using namespace EngineTests;
+
+    MxEngine::Logger::Init();
+    MxEngine::UUIDGenerator::Init();
+    MxEngine::JobSystem::Init();
+    MxEngine::ComponentFactory::Init();
+    MxEngine::MxObject::Factory::Init();
+    MxEngine::TransformHierarchy::Init();
+
+    size_t executedTests = 0;
+    size_t failedTests = 0;
+    for (const auto& test : GetTests())
+    {
+        if (argc > 1 && std::strcmp(argv[1], test.Name) != 0) continue;
+
+        std::cout << "[ run  ] " << test.Name << std::endl;
+        size_t failedChecks = GetFailedChecks();
+        test.Function();
+        bool passed = GetFailedChecks() == failedChecks;
+        std::cout << (passed ? "[  ok  ] " : "[ fail ] ") << test.Name << std::endl;
+
+        executedTests++;
+        if (!passed) failedTests++;
+    }
+
+    MxEngine::JobSystem::Destroy();
+
+    std::cout << executedTests - failedTests << " of " << executedTests << " tests passed" << std::endl;
+    return failedTests == 0 ? 0 : 1;
+}
@@ -0,0 +1,228 @@
+#include "TestUtilities.h"
+
+#include "Core/BoundingObjects/FrustrumCuller.h"
+#include "Core/BoundingObjects/AABB.h"
+#include "Core/Components/Instancing/InstanceFactory.h"
+
+#include <random>
+
+using namespace MxEngine;
+
+namespace
+{
+    // box count is not multiple of four, so both SSE and scalar tail paths are executed
+    constexpr size_t CullingVolumeCount = 100003;
+
+    FrustrumCuller MakeTestCuller()
+    {
+        auto projection = MakePerspectiveMatrix(Radians(65.0f), 16.0f / 9.0f, 0.1f, 500.0f);
+        auto view = MakeViewMatrix(MakeVector3(0.0f, 5.0f, 0.0f), MakeVector3(50.0f, 0.0f, 30.0f), MakeVector3(0.0f, 1.0f, 0.0f));
+        return FrustrumCuller(projection * view);
+    }
+
+    void FillRandomBoxes(AABBArray& boxes, size_t count)
+    {
+        std::mt19937 random(1234);
+        std::uniform_real_distribution<float> coordinate(-600.0f, 600.0f);
+        std::uniform_real_distribution<float> size(0.1f, 20.0f);
+        for (size_t i = 0; i < count; i++)
+        {
+            auto center = MakeVector3(coordinate(random), coordinate(random) * 0.1f, coordinate(random));
+            auto extent = MakeVector3(size(random), size(random), size(random));
+            boxes.Add(center - extent, center + extent);
+        }
+    }
+
+    Vector3 GetCenter(const AABBArray& boxes, size_t i)
+    {
+        return MakeVector3(boxes.CenterX[i], boxes.CenterY[i], boxes.CenterZ[i]);
+    }
+
+    Vector3 GetExtent(const AABBArray& boxes, size_t i)
+    {
+        return MakeVector3(boxes.ExtentX[i], boxes.ExtentY[i], boxes.ExtentZ[i]);
+    }
+
+    // batch path sums plane distance in different order than scalar one, so boxes touching a plane may be classified differently
+    bool IsOnPlaneBorder(const FrustrumCuller& culler, const Vector3& center, const Vector3& extent, uint8_t planeMask)
+    {
+        uint8_t grownMask = planeMask, shrunkMask = planeMask;
+        auto grownExtent = extent * 1.001f + MakeVector3(0.001f);
+        auto shrunkExtent = extent * 0.999f;
+        bool grown = culler.IsAABBVisible(center - grownExtent, center + grownExtent, grownMask);
+        bool shrunk = culler.IsAABBVisible(center - shrunkExtent, center + shrunkExtent, shrunkMask);
+        return grown != shrunk || grownMask != shrunkMask;
+    }
+}
+
+MX_TEST(FrustrumCullerBatchMatchesScalar)
+{
+    auto culler = MakeTestCuller();
+    AABBArray boxes;
+    FillRandomBoxes(boxes, CullingVolumeCount);
+
+    // near and far planes are skipped in second pass, as hierarchies do for nodes fully inside of them
+    uint8_t testedMasks[] = { FrustrumCuller::AllPlanesMask, 0x0F };
+    for (uint8_t planeMask : testedMasks)
+    {
+        MxVector<uint8_t> visibility(boxes.Size());
+        MxVector<uint8_t> planeMasks(boxes.Size());
+        size_t visibleCount = culler.CullAABBs(boxes, visibility.data(), planeMask, planeMasks.data());
+
+        size_t mismatches = 0;
+        size_t countedVisible = 0;
+        for (size_t i = 0; i < boxes.Size(); i++)
+        {
+            auto center = GetCenter(boxes, i);
+            auto extent = GetExtent(boxes, i);
+            uint8_t scalarMask = planeMask;
+            bool isVisible = culler.IsAABBVisible(center - extent, center + extent, scalarMask);
+            countedVisible += visibility[i];
+
+            // plane masks are defined only for visible boxes, as culled ones may stop testing planes at any point
+            bool isMatched = isVisible == (bool)visibility[i] && (!isVisible || scalarMask == planeMasks[i]);
+            if (!isMatched && !IsOnPlaneBorder(culler, center, extent, planeMask)) mismatches++;
+        }
+        MX_CHECK(mismatches == 0);
+        MX_CHECK(countedVisible == visibleCount);
+        MX_CHECK(visibleCount > 0 && visibleCount < boxes.Size());
+    }
+}
+
+MX_TEST(FrustrumCullerBatchIsConservative)
+{
+    // exact test additionally rejects boxes near frustrum corners, so it never keeps box which plane test culls
+    auto culler = MakeTestCuller();
+    AABBArray boxes;
+    FillRandomBoxes(boxes, CullingVolumeCount);
+    MxVector<uint8_t> visibility(boxes.Size());
+    culler.CullAABBs(boxes, visibility.data());
+
+    size_t violations = 0;
+    for (size_t i = 0; i < boxes.Size(); i++)
+    {
+        auto center = GetCenter(boxes, i);
+        auto extent = GetExtent(boxes, i);
+        if (culler.IsAABBVisible(center - extent, center + extent) && !visibility[i] &&
+            !IsOnPlaneBorder(culler, center, extent, FrustrumCuller::AllPlanesMask)) violations++;
+    }
+    MX_CHECK(violations == 0);
+}
+
+MX_TEST(FrustrumCullerSpheresMatchScalar)
+{
+    auto culler = MakeTestCuller();
+    AABBArray boxes;
+    FillRandomBoxes(boxes, CullingVolumeCount);
+    SphereArray spheres;
+    for (size_t i = 0; i < boxes.Size(); i++)
+        spheres.Add(GetCenter(boxes, i), Length(GetExtent(boxes, i)));
+
+    MxVector<uint8_t> visibility(spheres.Size());
+    size_t visibleCount = culler.CullSpheres(spheres, visibility.data());
+
+    // arrays of single sphere are processed only by scalar path
+    SphereArray single;
+    single.Resize(1);
+    uint8_t singleVisibility = 0;
+    size_t mismatches = 0;
+    size_t countedVisible = 0;
+    for (size_t i = 0; i < spheres.Size(); i++)
+    {
+        countedVisible += visibility[i];
+        single.CenterX[0] = spheres.CenterX[i]; single.CenterY[0] = spheres.CenterY[i]; single.CenterZ[0] = spheres.CenterZ[i];
+        float radius = spheres.Radius[i];
+
+        single.Radius[0] = radius;
+        culler.CullSpheres(single, &singleVisibility);
+        if (singleVisibility == visibility[i]) continue;
+
+        // spheres touching a plane may be classified differently because of summation order
+        uint8_t grown = 0, shrunk = 0;
+        single.Radius[0] = radius * 1.001f + 0.001f;
+        culler.CullSpheres(single, &grown);
+        single.Radius[0] = radius * 0.999f;
+        culler.CullSpheres(single, &shrunk);
+        if (grown == shrunk) mismatches++;
+    }
+    MX_CHECK(mismatches == 0);
+    MX_CHECK(countedVisible == visibleCount);
+}
+
+MX_TEST(FrustrumCullerBenchmark)
+{
+    constexpr size_t iterationCount = 20;
+    auto culler = MakeTestCuller();
+    AABBArray boxes;
+    FillRandomBoxes(boxes, CullingVolumeCount);
+    SphereArray spheres;
+    for (size_t i = 0; i < boxes.Size(); i++)
+        spheres.Add(GetCenter(boxes, i), Length(GetExtent(boxes, i)));
+    MxVector<uint8_t> visibility(boxes.Size());
+
+    size_t scalarVisible = 0;
+    {
+        EngineTests::ScopedBenchmark benchmark("scalar IsAABBVisible boxes", boxes.Size() * iterationCount);
+        for (size_t iteration = 0; iteration < iterationCount; iteration++)
+        {
+            for (size_t i = 0; i < boxes.Size(); i++)
+            {
+                auto center = GetCenter(boxes, i);
+                auto extent = GetExtent(boxes, i);
+                uint8_t planeMask = FrustrumCuller::AllPlanesMask;
+                scalarVisible += culler.IsAABBVisible(center - extent, center + extent, planeMask);
+            }
+        }
+    }
+
+    size_t batchVisible = 0;
+    {
+        EngineTests::ScopedBenchmark benchmark("FrustrumCuller::CullAABBs boxes", boxes.Size() * iterationCount);
+        for (size_t iteration = 0; iteration < iterationCount; iteration++)
+            batchVisible += culler.CullAABBs(boxes, visibility.data());
+    }
+
+    size_t sphereVisible = 0;
+    {
+        EngineTests::ScopedBenchmark benchmark("FrustrumCuller::CullSpheres spheres", spheres.Size() * iterationCount);
+        for (size_t iteration = 0; iteration < iterationCount; iteration++)
+            sphereVisible += culler.CullSpheres(spheres, visibility.data());
+    }
+    MX_CHECK(batchVisible > 0 && scalarVisible > 0 && sphereVisible >= batchVisible);
+}
+
+MX_TEST(InstanceCullingBenchmark)
+{
+    // object has no mesh source, so instances are culled on CPU without any GPU upload
+    constexpr size_t iterationCount = 10;
+    auto culler = MakeTestCuller();
+    AABBArray boxes;
+    FillRandomBoxes(boxes, CullingVolumeCount);
+
+    auto object = MxObject::Create();
+    auto instances = object->AddComponent<InstanceFactory>();
+    auto& storage = instances->GetInstanceStorage();
+    for (size_t i = 0; i < boxes.Size(); i++)
+        storage.Add(GetCenter(boxes, i));
+    AABB unitBox{ MakeVector3(-0.5f), MakeVector3(0.5f) };
+
+    size_t minExpected = 0, maxExpected = 0;
+    for (size_t i = 0; i < boxes.Size(); i++)
+    {
+        auto center = GetCenter(boxes, i);
+        uint8_t shrunkMask = FrustrumCuller::AllPlanesMask, grownMask = FrustrumCuller::AllPlanesMask;
+        minExpected += culler.IsAABBVisible(center + unitBox.Min * 0.999f, center + unitBox.Max * 0.999f, shrunkMask);
+        maxExpected += culler.IsAABBVisible(center + unitBox.Min * 1.001f, center + unitBox.Max * 1.001f, grownMask);
+    }
+
+    size_t visibleCount = 0;
+    {
+        EngineTests::ScopedBenchmark benchmark("InstanceFactory::CullInstances instances", boxes.Size() * iterationCount);
+        for (size_t iteration = 0; iteration < iterationCount; iteration++)
+            visibleCount = instances->CullInstances(culler, unitBox);
+    }
+    MX_CHECK(visibleCount >= minExpected && visibleCount <= maxExpected);
+    MX_CHECK(visibleCount > 0 && visibleCount < boxes.Size());
+
+    MxObject::Destroy(object);
+}
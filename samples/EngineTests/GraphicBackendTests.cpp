@@ -0,0 +1,66 @@
+#include "TestUtilities.h"
+
+#include "Platform/GraphicAPI.h"
+
+#if defined(MXENGINE_USE_NULLGRAPHICS)
+#include "Platform/Null/GraphicRecorder.h"
+#endif
+
+using namespace MxEngine;
+
+// backend is selected by MXENGINE_BUILD_HEADLESS option, exactly one of them must be compiled in
+#if defined(MXENGINE_USE_OPENGL) == defined(MXENGINE_USE_NULLGRAPHICS)
+    #error "exactly one graphic backend must be selected"
+#endif
+
+MX_TEST(GraphicBackendSelection)
+{
+    #if defined(MXENGINE_HEADLESS)
+    constexpr bool isHeadless = true;
+    #else
+    constexpr bool isHeadless = false;
+    #endif
+
+    #if defined(MXENGINE_USE_NULLGRAPHICS)
+    constexpr bool isNullBackend = true;
+    #else
+    constexpr bool isNullBackend = false;
+    #endif
+
+    MX_CHECK(isHeadless == isNullBackend);
+}
+
+#if defined(MXENGINE_USE_NULLGRAPHICS)
+MX_TEST(GraphicBackendNullRecordsCommands)
+{
+    GraphicRecorder::Reset();
+
+    // null backend does not need graphic context, so buffers can be created directly
+    MxVector<float> vertecies(3 * 256, 1.0f);
+    MxVector<uint32_t> indicies(3 * 64, 0);
+    {
+        VertexBuffer vertexBuffer;
+        IndexBuffer indexBuffer;
+        MX_CHECK(vertexBuffer.GetNativeHandle() != 0 && indexBuffer.GetNativeHandle() != 0);
+        MX_CHECK(vertexBuffer.GetNativeHandle() != indexBuffer.GetNativeHandle());
+
+        vertexBuffer.Load(vertecies.data(), vertecies.size(), UsageType::STATIC_DRAW);
+        indexBuffer.Load(indicies.data(), indicies.size());
+        MX_CHECK(vertexBuffer.GetSize() == vertecies.size());
+    }
+
+    const auto& frame = GraphicRecorder::GetFrameStatistics();
+    MX_CHECK(frame.CreatedObjects == 2 && frame.DestroyedObjects == 2);
+    MX_CHECK(frame.BufferUploads == 2);
+    MX_CHECK(frame.BufferUploadBytes == vertecies.size() * sizeof(float) + indicies.size() * sizeof(uint32_t));
+
+    // finished frames are accumulated into total statistics and current frame starts from zero
+    GraphicRecorder::EndFrame();
+    MX_CHECK(GraphicRecorder::GetFrameCount() == 1);
+    MX_CHECK(GraphicRecorder::GetFrameStatistics().BufferUploads == 0);
+    MX_CHECK(GraphicRecorder::GetTotalStatistics().BufferUploads == 2);
+
+    GraphicRecorder::Reset();
+    MX_CHECK(GraphicRecorder::GetFrameCount() == 0 && GraphicRecorder::GetTotalStatistics().BufferUploads == 0);
+}
+#endif
@@ -0,0 +1,115 @@
+#include "TestUtilities.h"
+
+#include "Core/Rendering/RenderUtilities/InstanceBatcher.h"
+
+#include <random>
+
+using namespace MxEngine;
+
+static bool HasSameState(const RenderCommand& c1, const RenderCommand& c2)
+{
+    return c1.ShaderId == c2.ShaderId && c1.MaterialId == c2.MaterialId && c1.GeometryId == c2.GeometryId;
+}
+
+MX_TEST(InstanceBatcherShortRuns)
+{
+    MxVector<RenderCommand> commands;
+    // run of 3 equal commands, run of 2 equal commands, then 4 equal commands where second unit cannot be instanced
+    uint32_t geometries[] = { 1, 1, 1, 2, 2, 3, 3, 3, 3 };
+    for (uint32_t i = 0; i < 9; i++)
+        commands.push_back(RenderCommand{ 0, i, 0, 0, geometries[i] });
+    MxVector<uint8_t> batchableUnits(9, 1);
+    batchableUnits[6] = 0;
+
+    InstanceBatcher batcher;
+    batcher.SetMinBatchSize(3);
+    auto statistics = batcher.Build(commands, batchableUnits);
+
+    const auto& batches = batcher.GetBatches();
+    // [0-2] instanced, [3], [4], [5], [6], [7-8] split as shorter than minimal size
+    MX_CHECK(batches.size() == 7);
+    MX_CHECK(batches[0].IsInstanced() && batches[0].CommandCount == 3 && batches[0].FirstInstance == 0);
+    MX_CHECK(!batches[1].IsInstanced() && batches[1].FirstCommand == 3);
+    MX_CHECK(!batches[4].IsInstanced() && batches[4].FirstCommand == 6);
+    MX_CHECK(!batches[6].IsInstanced() && batches[6].FirstCommand == 8);
+    MX_CHECK(batcher.GetInstanceCount() == 3);
+    MX_CHECK(statistics.SubmittedCommands == 9 && statistics.InstancedCommands == 3 && statistics.InstancedBatches == 1);
+    MX_CHECK(statistics.GetDrawCalls() == 7);
+
+    batcher.SetMinBatchSize(2);
+    statistics = batcher.Build(commands, batchableUnits);
+    MX_CHECK(batcher.GetBatches().size() == 5);
+    MX_CHECK(batcher.GetInstanceCount() == 7);
+    MX_CHECK(statistics.GetDrawCalls() == 5);
+
+    batcher.Clear();
+    MX_CHECK(batcher.GetBatches().empty() && batcher.GetCommands().empty() && batcher.GetInstanceCount() == 0);
+}
+
+MX_TEST(InstanceBatcherGrouping)
+{
+    constexpr size_t unitCount = 50000;
+    std::mt19937 random(7);
+    std::uniform_int_distribution<uint32_t> shaders(0, 3), materials(0, 15), geometries(0, 63), chance(0, 9);
+
+    RenderCommandQueue queue;
+    MxVector<uint8_t> batchableUnits(unitCount);
+    queue.Reserve(unitCount);
+    for (uint32_t i = 0; i < unitCount; i++)
+    {
+        uint32_t shader = shaders(random), material = materials(random), geometry = geometries(random);
+        queue.Push(RenderCommandQueue::MakeKey(RenderSortOrder::FRONT_TO_BACK, 0, shader, material, geometry, float(chance(random))), i, shader, material, geometry);
+        // some units have own instances or no vertex buffer, and must be drawn separately
+        batchableUnits[i] = chance(random) != 0;
+    }
+    queue.Sort();
+    const auto& commands = queue.GetCommands();
+
+    InstanceBatcher batcher;
+    InstanceBatchStatistics statistics;
+    {
+        EngineTests::ScopedBenchmark benchmark("instance batching of 50k units", unitCount);
+        statistics = batcher.Build(commands, batchableUnits);
+    }
+    const auto& batches = batcher.GetBatches();
+    const auto& batchCommands = batcher.GetCommands();
+
+    MX_CHECK(batchCommands.size() == batches.size());
+    MX_CHECK(statistics.SubmittedCommands == unitCount);
+    MX_CHECK(statistics.GetDrawCalls() == batches.size());
+    // 4 * 16 * 64 state combinations for 50k units, so draws are merged even though every tenth unit breaks its run
+    MX_CHECK(batches.size() < unitCount / 2);
+
+    size_t nextCommand = 0, nextInstance = 0, instancedCommands = 0, instancedBatches = 0;
+    bool isCovered = true, isGrouped = true, isMaximal = true;
+    for (size_t i = 0; i < batches.size(); i++)
+    {
+        const auto& batch = batches[i];
+        // batches cover sorted commands in order, without gaps
+        isCovered &= batch.FirstCommand == nextCommand && batch.CommandCount > 0;
+        isCovered &= batchCommands[i].UnitIndex == i && HasSameState(batchCommands[i], commands[batch.FirstCommand]);
+        nextCommand += batch.CommandCount;
+
+        if (batch.IsInstanced())
+        {
+            isGrouped &= batch.FirstInstance == nextInstance;
+            for (size_t j = batch.FirstCommand; j < batch.FirstCommand + batch.CommandCount; j++)
+                isGrouped &= batchableUnits[commands[j].UnitIndex] && HasSameState(commands[j], commands[batch.FirstCommand]);
+            nextInstance += batch.CommandCount;
+            instancedCommands += batch.CommandCount;
+            instancedBatches++;
+        }
+
+        // batch must not end while next command could still be drawn as its instance
+        size_t last = batch.FirstCommand + batch.CommandCount - 1;
+        if (batch.IsInstanced() && last + 1 < commands.size())
+        {
+            isMaximal &= !(batchableUnits[commands[last + 1].UnitIndex] && HasSameState(commands[last], commands[last + 1]));
+        }
+    }
+    MX_CHECK(isCovered && nextCommand == unitCount);
+    MX_CHECK(isGrouped);
+    MX_CHECK(isMaximal);
+    MX_CHECK(nextInstance == batcher.GetInstanceCount());
+    MX_CHECK(instancedCommands == statistics.InstancedCommands && instancedBatches == statistics.InstancedBatches);
+}
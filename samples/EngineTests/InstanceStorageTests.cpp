@@ -0,0 +1,65 @@
+#include "TestUtilities.h"
+
+#include "Core/Components/Instancing/InstanceStorage.h"
+#include "Core/Components/Transform.h"
+
+#include <random>
+#include <cmath>
+
+using namespace MxEngine;
+
+static bool IsNear(const Vector3& v1, const Vector3& v2, float epsilon)
+{
+    return std::abs(v1.x - v2.x) < epsilon && std::abs(v1.y - v2.y) < epsilon && std::abs(v1.z - v2.z) < epsilon;
+}
+
+MX_TEST(InstanceStorageComputeMatrices)
+{
+    // more instances than one ParallelFor chunk, so matrices are computed by several jobs
+    constexpr size_t instanceCount = 10000;
+    std::mt19937 random(42);
+    std::uniform_real_distribution<float> coordinate(-100.0f, 100.0f);
+    std::uniform_real_distribution<float> angle(0.0f, 360.0f);
+    std::uniform_real_distribution<float> scale(0.1f, 5.0f);
+
+    InstanceStorage storage;
+    MxVector<TransformComponent> transforms(instanceCount);
+    for (size_t i = 0; i < instanceCount; i++)
+    {
+        auto position = MakeVector3(coordinate(random), coordinate(random), coordinate(random));
+        auto axis = Normalize(MakeVector3(coordinate(random), coordinate(random), coordinate(random)) + MakeVector3(0.001f));
+        auto rotation = MakeQuaternion(Radians(angle(random)), axis);
+        // half of instances have uniform scale, as transform component builds normal matrix differently for them
+        auto instanceScale = i % 2 == 0 ? MakeVector3(scale(random)) : MakeVector3(scale(random), scale(random), scale(random));
+
+        storage.Add(position, rotation, instanceScale);
+        transforms[i].SetPosition(position).SetRotation(rotation).SetScale(instanceScale);
+    }
+
+    MxVector<Matrix4x4> models(instanceCount);
+    MxVector<Matrix3x3> normals(instanceCount);
+    storage.ComputeMatrices(models.data(), normals.data());
+
+    size_t mismatchedModels = 0;
+    size_t mismatchedNormals = 0;
+    Vector3 directions[] = { MakeVector3(1.0f, 0.0f, 0.0f), MakeVector3(0.0f, 1.0f, 0.0f), MakeVector3(0.0f, 0.0f, 1.0f), Normalize(MakeVector3(1.0f, -2.0f, 3.0f)) };
+    for (size_t i = 0; i < instanceCount; i++)
+    {
+        const auto& expectedModel = transforms[i].GetMatrix();
+        for (int column = 0; column < 4; column++)
+        {
+            float epsilon = 0.0005f * Max(1.0f, Length(Vector3(expectedModel[column])));
+            if (!IsNear(Vector3(models[i][column]), Vector3(expectedModel[column]), epsilon) ||
+                std::abs(models[i][column].w - expectedModel[column].w) > epsilon) mismatchedModels++;
+        }
+
+        // uniformly scaled transforms keep scale in normal matrix, so only directions of transformed normals are compared
+        const auto& expectedNormal = transforms[i].GetNormalMatrix();
+        for (const auto& direction : directions)
+        {
+            if (!IsNear(Normalize(normals[i] * direction), Normalize(expectedNormal * direction), 0.001f)) mismatchedNormals++;
+        }
+    }
+    MX_CHECK(mismatchedModels == 0);
+    MX_CHECK(mismatchedNormals == 0);
+}
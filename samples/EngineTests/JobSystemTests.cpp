@@ -0,0 +1,138 @@
+#include "TestUtilities.h"
+
+#include "Utilities/JobSystem/JobSystem.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+using namespace MxEngine;
+
+MX_TEST(JobSystemCounter)
+{
+    constexpr size_t jobCount = 1000;
+    std::atomic<size_t> executedJobs{ 0 };
+    JobCounter counter;
+    for (size_t i = 0; i < jobCount; i++)
+        JobSystem::Schedule([&executedJobs]() { executedJobs.fetch_add(1); }, &counter);
+    JobSystem::Wait(counter);
+
+    MX_CHECK(counter.IsDone() && counter.Get() == 0);
+    MX_CHECK(executedJobs.load() == jobCount);
+}
+
+MX_TEST(JobSystemStealing)
+{
+    // jobs are pushed into deque of main thread, so other workers can get them only by stealing
+    constexpr size_t jobCount = 64;
+    MxVector<size_t> threadIndices(jobCount, JobSystem::GetThreadCount());
+    JobCounter counter;
+    for (size_t i = 0; i < jobCount; i++)
+    {
+        JobSystem::Schedule([&threadIndices, i]()
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            threadIndices[i] = JobSystem::GetThreadIndex();
+        }, &counter);
+    }
+    JobSystem::Wait(counter);
+
+    size_t stolenJobs = 0;
+    bool isIndexValid = true;
+    for (size_t index : threadIndices)
+    {
+        isIndexValid &= index < JobSystem::GetThreadCount();
+        stolenJobs += index != 0;
+    }
+    MX_CHECK(isIndexValid);
+    if (JobSystem::GetThreadCount() > 1) MX_CHECK(stolenJobs > 0);
+}
+
+MX_TEST(JobSystemDependency)
+{
+    std::atomic<size_t> finishedProducers{ 0 };
+    std::atomic<size_t> observedProducers{ 0 };
+    JobCounter consumerCounter;
+    {
+        auto producers = MakeRef<JobCounter>();
+        for (size_t i = 0; i < 16; i++)
+        {
+            JobSystem::Schedule([&finishedProducers]()
+            {
+                std::this_thread::sleep_for(std::chrono::microseconds(200));
+                finishedProducers.fetch_add(1);
+            }, producers.get());
+        }
+        // consumer keeps its own handle, so producer counter outlives this scope
+        JobSystem::Schedule([&finishedProducers, &observedProducers]() { observedProducers = finishedProducers.load(); }, producers, &consumerCounter);
+    }
+    JobSystem::Wait(consumerCounter);
+    MX_CHECK(observedProducers.load() == 16);
+}
+
+MX_TEST(JobSystemParallelForCoverage)
+{
+    constexpr size_t count = 100003;
+    size_t batchSizes[] = { 0, 1, 7, 1024, count, 2 * count };
+    for (size_t batchSize : batchSizes)
+    {
+        MxVector<std::atomic<uint8_t>> visits(count);
+        for (auto& visit : visits) visit = 0;
+
+        JobSystem::ParallelFor(count, batchSize, [&visits](size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; i++)
+                visits[i].fetch_add(1);
+        });
+
+        bool isCovered = true;
+        for (const auto& visit : visits)
+            isCovered &= visit.load() == 1;
+        MX_CHECK(isCovered);
+    }
+
+    size_t calls = 0;
+    JobSystem::ParallelFor(0, 16, [&calls](size_t, size_t) { calls++; });
+    MX_CHECK(calls == 0);
+}
+
+MX_TEST(JobSystemInlineFallback)
+{
+    // temporary detach job system, as if JobSystem::Init() was never called
+    auto* impl = JobSystem::GetImpl();
+    JobSystem::Clone(nullptr);
+
+    MX_CHECK(JobSystem::GetThreadCount() == 1);
+    auto caller = std::this_thread::get_id();
+    bool isInline = true;
+    size_t processed = 0;
+    JobSystem::ParallelFor(1000, 10, [&](size_t begin, size_t end)
+    {
+        isInline &= std::this_thread::get_id() == caller;
+        processed += end - begin;
+    });
+    MX_CHECK(isInline && processed == 1000);
+
+    JobCounter counter;
+    size_t executedJobs = 0;
+    JobSystem::Schedule([&executedJobs]() { executedJobs++; }, &counter);
+    JobSystem::Schedule([&executedJobs]() { executedJobs++; }, MakeRef<JobCounter>(), &counter);
+    JobSystem::Wait(counter);
+    MX_CHECK(executedJobs == 2 && counter.IsDone());
+
+    JobSystem::Clone(impl);
+}
+
+MX_TEST(JobSystemBenchmark)
+{
+    constexpr size_t jobCount = 100000;
+    std::atomic<size_t> executedJobs{ 0 };
+    JobCounter counter;
+    {
+        EngineTests::ScopedBenchmark benchmark("schedule and execute 100k jobs", jobCount);
+        for (size_t i = 0; i < jobCount; i++)
+            JobSystem::Schedule([&executedJobs]() { executedJobs.fetch_add(1, std::memory_order_relaxed); }, &counter);
+        JobSystem::Wait(counter);
+    }
+    MX_CHECK(executedJobs.load() == jobCount);
+}
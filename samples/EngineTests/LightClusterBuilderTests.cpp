@@ -0,0 +1,117 @@
+#include "TestUtilities.h"
+
+#include "Core/Rendering/RenderUtilities/LightClusterBuilder.h"
+
+#include <cmath>
+#include <random>
+
+using namespace MxEngine;
+
+namespace EngineTests
+{
+    struct ClusterTestCamera
+    {
+        float Near = 0.1f;
+        float Far = 500.0f;
+        Matrix4x4 View = MakeViewMatrix(MakeVector3(0.0f), MakeVector3(0.0f, 0.0f, -1.0f), MakeVector3(0.0f, 1.0f, 0.0f));
+        Matrix4x4 Projection = MakePerspectiveMatrix(Radians(65.0f), 16.0f / 9.0f, 0.1f, 500.0f);
+
+        // cluster which contains point, or cluster count if point is outside of camera frustrum
+        size_t GetClusterOfPoint(const LightClusterGrid& grid, const Vector3& point) const
+        {
+            Vector4 clip = this->Projection * this->View * Vector4(point, 1.0f);
+            float depth = -Vector3(this->View * Vector4(point, 1.0f)).z;
+            if (depth < this->Near || depth > this->Far || clip.w <= 0.0f) return grid.GetClusterCount();
+
+            float ndcX = clip.x / clip.w, ndcY = clip.y / clip.w;
+            if (ndcX < -1.0f || ndcX >= 1.0f || ndcY < -1.0f || ndcY >= 1.0f) return grid.GetClusterCount();
+
+            auto x = (uint32_t)std::floor((ndcX * 0.5f + 0.5f) * grid.TilesX);
+            auto y = (uint32_t)std::floor((ndcY * 0.5f + 0.5f) * grid.TilesY);
+            auto z = (uint32_t)std::floor(std::log(depth / this->Near) / std::log(this->Far / this->Near) * grid.SlicesZ);
+            return grid.GetClusterIndex(Min(x, grid.TilesX - 1), Min(y, grid.TilesY - 1), Min(z, grid.SlicesZ - 1));
+        }
+    };
+
+    static SphereArray MakeRandomLights(size_t count, unsigned seed)
+    {
+        std::mt19937 random(seed);
+        std::uniform_real_distribution<float> lateral(-150.0f, 150.0f);
+        std::uniform_real_distribution<float> depth(-450.0f, 20.0f); // some lights are behind camera
+        std::uniform_real_distribution<float> radius(0.5f, 8.0f);
+
+        SphereArray lights;
+        for (size_t i = 0; i < count; i++)
+            lights.Add(MakeVector3(lateral(random), lateral(random) * 0.5f, depth(random)), radius(random));
+        return lights;
+    }
+}
+
+using namespace EngineTests;
+
+MX_TEST(LightClusterBuilderBinning)
+{
+    ClusterTestCamera camera;
+    auto lights = MakeRandomLights(1003, 7); // odd count also covers scalar tail after vectorized groups
+
+    LightClusterBuilder builder;
+    builder.Build(lights, camera.View, camera.Projection, camera.Near, camera.Far);
+    const auto& grid = builder.GetGrid();
+
+    const auto& offsets = builder.GetOffsets();
+    MX_CHECK(offsets.size() == grid.GetClusterCount() + 1);
+    MX_CHECK(offsets.back() == builder.GetLightIndices().size());
+
+    // light lists are sorted by light index and contain each light at most once
+    bool isSorted = true;
+    for (size_t cluster = 0; cluster < grid.GetClusterCount(); cluster++)
+    {
+        const uint32_t* clusterLights = builder.GetLights(cluster);
+        for (size_t i = 1; i < builder.GetLightCount(cluster); i++)
+            isSorted &= clusterLights[i - 1] < clusterLights[i];
+    }
+    MX_CHECK(isSorted);
+
+    // binning is conservative: cluster which contains light center must reference the light
+    size_t missedLights = 0;
+    size_t checkedLights = 0;
+    for (size_t light = 0; light < lights.Size(); light++)
+    {
+        auto center = MakeVector3(lights.CenterX[light], lights.CenterY[light], lights.CenterZ[light]);
+        size_t cluster = camera.GetClusterOfPoint(grid, center);
+        if (cluster == grid.GetClusterCount()) continue;
+
+        checkedLights++;
+        const uint32_t* clusterLights = builder.GetLights(cluster);
+        bool isFound = false;
+        for (size_t i = 0; i < builder.GetLightCount(cluster); i++)
+            isFound |= clusterLights[i] == light;
+        missedLights += !isFound;
+    }
+    MX_CHECK(checkedLights > 0);
+    MX_CHECK(missedLights == 0);
+
+    // light which is fully behind camera is not binned
+    SphereArray hiddenLight;
+    hiddenLight.Add(MakeVector3(0.0f, 0.0f, 10.0f), 1.0f);
+    builder.Build(hiddenLight, camera.View, camera.Projection, camera.Near, camera.Far);
+    MX_CHECK(builder.GetLightIndices().empty());
+}
+
+MX_TEST(LightClusterBuilderBenchmark)
+{
+    constexpr size_t lightCount = 10000;
+    constexpr size_t buildCount = 20;
+    ClusterTestCamera camera;
+    auto lights = MakeRandomLights(lightCount, 42);
+
+    LightClusterBuilder builder;
+    builder.Build(lights, camera.View, camera.Projection, camera.Near, camera.Far); // warm up allocations
+    {
+        ScopedBenchmark benchmark("binning of 10k lights into 16x9x24 clusters", buildCount);
+        for (size_t i = 0; i < buildCount; i++)
+            builder.Build(lights, camera.View, camera.Projection, camera.Near, camera.Far);
+    }
+    std::cout << "    " << builder.GetLightIndices().size() << " light references in " << builder.GetGrid().GetClusterCount() << " clusters" << std::endl;
+    MX_CHECK(!builder.GetLightIndices().empty());
+}
@@ -0,0 +1,50 @@
+#include "TestUtilities.h"
+
+#include "Core/MxObject/MxObject.h"
+
+using namespace MxEngine;
+
+MX_TEST(MxObjectGetByName)
+{
+    auto named = MxObject::Create();
+    named->Name = "Named Object";
+    auto unnamed = MxObject::Create();
+
+    MX_CHECK(unnamed->Name.empty());
+    MX_CHECK(MxObject::GetByName("Named Object") == named);
+    MX_CHECK(MxObject::GetByName(unnamed->GetDisplayName()) == unnamed);
+    MX_CHECK(named->GetDisplayName() == "Named Object");
+    // unnamed object must not match empty string or malformed uuids
+    MX_CHECK(!MxObject::GetByName("").IsValid());
+    MX_CHECK(!MxObject::GetByName(unnamed->GetDisplayName() + "0").IsValid());
+    MX_CHECK(!MxObject::GetByName("not an uuid").IsValid());
+
+    MxObject::Destroy(named);
+    MxObject::Destroy(unnamed);
+}
+
+MX_TEST(MxObjectCreateBenchmark)
+{
+    constexpr size_t objectCount = 100000;
+    MxVector<MxObject::Handle> objects;
+    objects.reserve(objectCount);
+
+    {
+        EngineTests::ScopedBenchmark benchmark("MxObject::Create", objectCount);
+        for (size_t i = 0; i < objectCount; i++)
+            objects.push_back(MxObject::Create());
+    }
+    MX_CHECK(objects.back().IsValid());
+
+    {
+        EngineTests::ScopedBenchmark benchmark("MxObject::GetByName (unnamed, last object)", 1);
+        MX_CHECK(MxObject::GetByName(objects.back()->GetDisplayName()) == objects.back());
+    }
+
+    {
+        EngineTests::ScopedBenchmark benchmark("MxObject::Destroy", objectCount);
+        for (auto& object : objects)
+            MxObject::Destroy(object);
+    }
+    MX_CHECK(!objects.front().IsValid());
+}
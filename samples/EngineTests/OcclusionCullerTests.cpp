@@ -0,0 +1,251 @@
+#include "TestUtilities.h"
+
+#include "Core/BoundingObjects/OcclusionCuller.h"
+
+#include <random>
+#include <limits>
+#include <cmath>
+
+using namespace MxEngine;
+
+constexpr size_t BufferWidth = 256;
+constexpr size_t BufferHeight = 128;
+constexpr float ZNear = 0.1f;
+
+static Matrix4x4 MakeTestViewProjection()
+{
+    // camera in origin looking along -Z, so view depth of point is equal to its -z
+    auto projection = MakePerspectiveMatrix(Radians(60.0f), float(BufferWidth) / float(BufferHeight), ZNear, 1000.0f);
+    auto view = MakeViewMatrix(MakeVector3(0.0f), MakeVector3(0.0f, 0.0f, -1.0f), MakeVector3(0.0f, 1.0f, 0.0f));
+    return projection * view;
+}
+
+struct QuadOccluder
+{
+    // screen is covered by one quad at depth 10. Its diagonal goes far to the left of screen, so each pixel
+    // is covered completely by one of its triangles, as conservative rasterization ignores partially covered pixels
+    MxVector<Vector3> Positions = {
+        MakeVector3(-100.0f,  -10.0f, -10.0f),
+        MakeVector3( 100.0f,  -10.0f, -10.0f),
+        MakeVector3( 100.0f, 1000.0f, -10.0f),
+        MakeVector3(-100.0f, 1000.0f, -10.0f),
+    };
+    MxVector<uint32_t> Indices = { 0, 1, 2, 0, 2, 3 };
+
+    OccluderMesh GetMesh() const
+    {
+        OccluderMesh mesh;
+        mesh.Positions = &this->Positions.front().x;
+        mesh.PositionStride = sizeof(Vector3);
+        mesh.Indices = this->Indices.data();
+        mesh.IndexCount = this->Indices.size();
+        return mesh;
+    }
+};
+
+static void RasterizeQuad(OcclusionCuller& culler, const QuadOccluder& quad)
+{
+    culler.Clear(MakeTestViewProjection(), ZNear);
+    MxVector<OccluderMesh> occluders = { quad.GetMesh() };
+    culler.RasterizeOccluders(occluders);
+}
+
+MX_TEST(OcclusionCullerFullScreenQuad)
+{
+    OcclusionCuller culler(BufferWidth, BufferHeight);
+    QuadOccluder quad;
+    RasterizeQuad(culler, quad);
+
+    bool isCovered = true;
+    for (float depth : culler.GetDepthBuffer())
+        isCovered &= std::abs(depth - 10.0f) < 0.001f;
+    MX_CHECK(isCovered);
+    MX_CHECK(culler.GetStatistics().RasterizedTriangles == 2);
+
+    // box behind quad is hidden, box in front of it is not
+    MX_CHECK(!culler.IsAABBVisible(MakeVector3(-1.0f, -1.0f, -21.0f), MakeVector3(1.0f, 1.0f, -19.0f)));
+    MX_CHECK(culler.IsAABBVisible(MakeVector3(-1.0f, -1.0f, -6.0f), MakeVector3(1.0f, 1.0f, -4.0f)));
+    // box which intersects quad has its nearest point in front of it, so it is kept too
+    MX_CHECK(culler.IsAABBVisible(MakeVector3(-1.0f, -1.0f, -12.0f), MakeVector3(1.0f, 1.0f, -8.0f)));
+}
+
+MX_TEST(OcclusionCullerNearPlane)
+{
+    OcclusionCuller culler(BufferWidth, BufferHeight);
+    QuadOccluder quad;
+    RasterizeQuad(culler, quad);
+
+    // boxes crossing near plane can cover whole screen, so they are never culled even if most of their volume is occluded
+    MX_CHECK(culler.IsAABBVisible(MakeVector3(-1.0f, -1.0f, -50.0f), MakeVector3(1.0f, 1.0f, 1.0f)));
+    MX_CHECK(culler.IsAABBVisible(MakeVector3(-1.0f, -1.0f, -50.0f), MakeVector3(1.0f, 1.0f, -0.5f * ZNear)));
+    // box behind camera is handled by frustrum culling, occlusion culler keeps it
+    MX_CHECK(culler.IsAABBVisible(MakeVector3(-1.0f, -1.0f, 5.0f), MakeVector3(1.0f, 1.0f, 6.0f)));
+
+    // occluder triangles crossing near plane are dropped, so nothing is occluded by them
+    QuadOccluder crossingQuad;
+    crossingQuad.Positions[2].z = 1.0f;
+    crossingQuad.Positions[3].z = 1.0f;
+    RasterizeQuad(culler, crossingQuad);
+    bool isEmpty = true;
+    for (float depth : culler.GetDepthBuffer())
+        isEmpty &= depth == std::numeric_limits<float>::max();
+    MX_CHECK(isEmpty);
+    MX_CHECK(culler.IsAABBVisible(MakeVector3(-1.0f, -1.0f, -21.0f), MakeVector3(1.0f, 1.0f, -19.0f)));
+}
+
+MX_TEST(OcclusionCullerStatistics)
+{
+    OcclusionCuller culler(BufferWidth, BufferHeight);
+    QuadOccluder quad;
+    RasterizeQuad(culler, quad);
+
+    AABBArray boxes;
+    boxes.Add(MakeVector3(-1.0f, -1.0f, -21.0f), MakeVector3(1.0f, 1.0f, -19.0f)); // occluded
+    boxes.Add(MakeVector3( 2.0f,  1.0f, -31.0f), MakeVector3(4.0f, 2.0f, -29.0f)); // occluded
+    boxes.Add(MakeVector3(-6.0f, -2.0f, -41.0f), MakeVector3(-4.0f, 0.0f, -39.0f)); // occluded
+    boxes.Add(MakeVector3(-1.0f, -1.0f, -6.0f), MakeVector3(1.0f, 1.0f, -4.0f)); // in front of quad
+    boxes.Add(MakeVector3(-1.0f, -1.0f, -60.0f), MakeVector3(1.0f, 1.0f, -50.0f)); // occluded, but already culled by frustrum
+    MxVector<uint8_t> visibility = { 1, 1, 1, 1, 0 };
+
+    size_t occluded = culler.CullAABBs(boxes, visibility.data());
+    MX_CHECK(occluded == 3);
+    MX_CHECK((visibility == MxVector<uint8_t>{ 0, 0, 0, 1, 0 }));
+
+    // only boxes which were visible before test are counted
+    const auto& statistics = culler.GetStatistics();
+    MX_CHECK(statistics.TestedBoxes == 4 && statistics.OccludedBoxes == 3);
+    MX_CHECK(std::abs(statistics.GetOccludedPercentage() - 75.0f) < 0.001f);
+
+    // statistics are accumulated between calls until next Clear()
+    MxVector<uint8_t> secondVisibility = { 1, 0, 0, 1, 0 };
+    culler.CullAABBs(boxes, secondVisibility.data());
+    MX_CHECK(culler.GetStatistics().TestedBoxes == 6 && culler.GetStatistics().OccludedBoxes == 4);
+    MX_CHECK(std::abs(culler.GetStatistics().GetOccludedPercentage() - 400.0f / 6.0f) < 0.001f);
+
+    culler.ResetStatistics();
+    MX_CHECK(culler.GetStatistics().GetOccludedPercentage() == 0.0f);
+}
+
+MX_TEST(OcclusionCullerRandomTriangles)
+{
+    // depth buffer built from triangles binned by bands is compared with per-pixel test of all triangles. Pixel corners are tested
+    // with small margin in both directions, as pixels lying exactly on triangle edge can be rounded either way
+    constexpr size_t triangleCount = 300;
+    std::mt19937 random(42);
+    std::uniform_real_distribution<float> x(-30.0f, 30.0f), y(-15.0f, 15.0f), z(-50.0f, -2.0f);
+
+    MxVector<Vector3> positions;
+    MxVector<uint32_t> indices;
+    for (size_t i = 0; i < 3 * triangleCount; i++)
+    {
+        positions.push_back(MakeVector3(x(random), y(random), z(random)));
+        indices.push_back((uint32_t)i);
+    }
+
+    OccluderMesh mesh;
+    mesh.Positions = &positions.front().x;
+    mesh.PositionStride = sizeof(Vector3);
+    mesh.Indices = indices.data();
+    mesh.IndexCount = indices.size();
+    MxVector<OccluderMesh> occluders = { mesh };
+
+    auto viewProjection = MakeTestViewProjection();
+    OcclusionCuller culler(BufferWidth, BufferHeight);
+    culler.Clear(viewProjection, ZNear);
+    culler.RasterizeOccluders(occluders);
+
+    struct Triangle { Vector2 V[3]; float Depth; };
+    MxVector<Triangle> triangles;
+    Vector2 screenSize{ (float)BufferWidth, (float)BufferHeight };
+    for (size_t t = 0; t < triangleCount; t++)
+    {
+        Triangle triangle{ };
+        for (size_t v = 0; v < 3; v++)
+        {
+            auto clip = viewProjection * Vector4(positions[3 * t + v], 1.0f);
+            triangle.V[v] = (Vector2(clip.x, clip.y) / clip.w * 0.5f + 0.5f) * screenSize;
+            triangle.Depth = Max(triangle.Depth, clip.w);
+        }
+        float area = (triangle.V[1].x - triangle.V[0].x) * (triangle.V[2].y - triangle.V[0].y) - (triangle.V[1].y - triangle.V[0].y) * (triangle.V[2].x - triangle.V[0].x);
+        if (area < 0.0f) std::swap(triangle.V[1], triangle.V[2]);
+        if (area != 0.0f) triangles.push_back(triangle);
+    }
+
+    auto coversPixel = [](const Triangle& triangle, float px, float py, float margin)
+    {
+        for (size_t k = 0; k < 3; k++)
+        {
+            const auto& a = triangle.V[k];
+            const auto& b = triangle.V[(k + 1) % 3];
+            Vector2 d = b - a;
+            float epsilon = margin * (std::abs(d.x) + std::abs(d.y));
+            for (size_t corner = 0; corner < 4; corner++)
+            {
+                float cx = px + float(corner & 1), cy = py + float(corner >> 1);
+                if (d.x * (cy - a.y) - d.y * (cx - a.x) < epsilon) return false;
+            }
+        }
+        return true;
+    };
+
+    size_t wrongPixels = 0, coveredPixels = 0;
+    const auto& depthBuffer = culler.GetDepthBuffer();
+    for (size_t py = 0; py < BufferHeight; py++)
+    {
+        for (size_t px = 0; px < BufferWidth; px++)
+        {
+            float strictDepth = std::numeric_limits<float>::max();
+            float looseDepth = std::numeric_limits<float>::max();
+            for (const auto& triangle : triangles)
+            {
+                if (coversPixel(triangle, (float)px, (float)py, 0.01f)) strictDepth = Min(strictDepth, triangle.Depth);
+                if (coversPixel(triangle, (float)px, (float)py, -0.01f)) looseDepth = Min(looseDepth, triangle.Depth);
+            }
+
+            float depth = depthBuffer[py * BufferWidth + px];
+            wrongPixels += depth < looseDepth || depth > strictDepth;
+            coveredPixels += depth != std::numeric_limits<float>::max();
+        }
+    }
+    MX_CHECK(wrongPixels == 0);
+    MX_CHECK(coveredPixels > BufferWidth * BufferHeight / 4);
+}
+
+MX_TEST(OcclusionCullerBenchmark)
+{
+    // many small triangles spread over screen, as in scenes with lots of detailed occluders
+    constexpr size_t triangleCount = 100000;
+    constexpr size_t frameCount = 20;
+    std::mt19937 random(7);
+    std::uniform_real_distribution<float> x(-30.0f, 30.0f), y(-15.0f, 15.0f), z(-50.0f, -5.0f), offset(-1.0f, 1.0f);
+
+    MxVector<Vector3> positions;
+    MxVector<uint32_t> indices;
+    for (size_t i = 0; i < triangleCount; i++)
+    {
+        auto center = MakeVector3(x(random), y(random), z(random));
+        for (size_t v = 0; v < 3; v++)
+        {
+            indices.push_back((uint32_t)positions.size());
+            positions.push_back(center + MakeVector3(offset(random), offset(random), offset(random)));
+        }
+    }
+
+    OccluderMesh mesh;
+    mesh.Positions = &positions.front().x;
+    mesh.PositionStride = sizeof(Vector3);
+    mesh.Indices = indices.data();
+    mesh.IndexCount = indices.size();
+    MxVector<OccluderMesh> occluders = { mesh };
+
+    OcclusionCuller culler(BufferWidth, BufferHeight);
+    {
+        EngineTests::ScopedBenchmark benchmark("OcclusionCuller::RasterizeOccluders", frameCount);
+        for (size_t i = 0; i < frameCount; i++)
+        {
+            culler.Clear(MakeTestViewProjection(), ZNear);
+            culler.RasterizeOccluders(occluders);
+        }
+    }
+    MX_CHECK(culler.GetStatistics().RasterizedTriangles == triangleCount);
+}
@@ -0,0 +1,32 @@
+#include "TestUtilities.h"
+
+#include "Utilities/VectorPool/PagedVectorPool.h"
+
+using namespace MxEngine;
+
+MX_TEST(PagedVectorPoolIndexOf)
+{
+    constexpr size_t objectCount = 100000;
+    PagedVectorPool<size_t> pool;
+    MxVector<size_t> indices;
+    for (size_t i = 0; i < objectCount; i++)
+        indices.push_back(pool.Allocate(i));
+
+    size_t mismatches = 0;
+    {
+        EngineTests::ScopedBenchmark benchmark("paged pool index lookup", objectCount);
+        for (size_t index : indices)
+            mismatches += pool.IndexOf(pool[index]) != index;
+    }
+    MX_CHECK(mismatches == 0);
+
+    // freed slots are reused, lookup must still point to the same slot
+    for (size_t i = 0; i < objectCount; i += 3)
+        pool.Deallocate(indices[i]);
+    for (size_t i = 0; i < objectCount / 3; i++)
+    {
+        size_t index = pool.Allocate(i);
+        mismatches += pool.IndexOf(pool[index]) != index || pool[index] != i;
+    }
+    MX_CHECK(mismatches == 0);
+}
@@ -0,0 +1,205 @@
+#include "TestUtilities.h"
+
+#include "Utilities/Memory/RangeAllocator.h"
+
+#include <random>
+
+using namespace MxEngine;
+
+static bool IsConsistent(const RangeAllocator& allocator)
+{
+    // allocations and free ranges must tile whole capacity without overlaps, and free ranges must never be adjacent
+    const auto& allocations = allocator.GetAllocations();
+    const auto& freeRanges = allocator.GetFreeRanges();
+    size_t i = 0, j = 0, cursor = 0, usedSize = 0;
+    bool previousIsFree = false;
+    while (i < allocations.size() || j < freeRanges.size())
+    {
+        bool takeFree = i == allocations.size() || (j < freeRanges.size() && freeRanges[j].Offset < allocations[i].Offset);
+        const auto& range = takeFree ? freeRanges[j++] : allocations[i++];
+        if (range.Offset != cursor || range.Size == 0) return false;
+        if (takeFree && previousIsFree) return false;
+        if (!takeFree) usedSize += range.Size;
+        previousIsFree = takeFree;
+        cursor += range.Size;
+    }
+    return cursor == allocator.GetCapacity() && usedSize == allocator.GetUsedSize();
+}
+
+MX_TEST(RangeAllocatorMerging)
+{
+    RangeAllocator allocator(100);
+    size_t a = allocator.Allocate(10);
+    size_t b = allocator.Allocate(20);
+    size_t c = allocator.Allocate(30);
+    MX_CHECK(a == 0 && b == 10 && c == 30);
+    MX_CHECK(allocator.GetUsedSize() == 60 && allocator.GetFreeSize() == 40);
+
+    // freed range between allocations stays separate from free tail
+    allocator.Free(b);
+    MX_CHECK(allocator.GetFreeRanges().size() == 2);
+    // freeing neighbour merges it with previous range
+    allocator.Free(a);
+    MX_CHECK(allocator.GetFreeRanges().size() == 2);
+    MX_CHECK(allocator.GetFreeRanges()[0].Offset == 0 && allocator.GetFreeRanges()[0].Size == 30);
+    // last allocation joins both free ranges into one
+    allocator.Free(c);
+    MX_CHECK(allocator.GetFreeRanges().size() == 1);
+    MX_CHECK(allocator.GetFreeRanges()[0].Offset == 0 && allocator.GetFreeRanges()[0].Size == 100);
+    MX_CHECK(allocator.GetUsedSize() == 0);
+
+    // growing storage merges new space with free tail
+    a = allocator.Allocate(100);
+    allocator.Grow(150);
+    MX_CHECK(allocator.Allocate(50) == 100);
+    MX_CHECK(allocator.Allocate(1) == RangeAllocator::InvalidOffset);
+    allocator.Free(a);
+    allocator.Grow(200);
+    MX_CHECK(allocator.GetFreeRanges().size() == 2 && allocator.GetFreeRanges()[1].Offset == 150);
+    MX_CHECK(IsConsistent(allocator));
+}
+
+MX_TEST(RangeAllocatorBestFit)
+{
+    RangeAllocator allocator(100);
+    size_t ranges[6];
+    for (size_t i = 0; i < 6; i++)
+        ranges[i] = allocator.Allocate(10);
+    // leaves hole of 10 elements at offset 10 and free tail at offset 30, which is extended by Grow()
+    allocator.Free(ranges[1]);
+    allocator.Free(ranges[3]);
+    allocator.Free(ranges[4]);
+    allocator.Free(ranges[5]);
+    allocator.Grow(130);
+    MX_CHECK(allocator.GetFreeRanges().size() == 2);
+    // exact fit is preferred over larger free ranges
+    MX_CHECK(allocator.Allocate(10) == 10);
+    MX_CHECK(allocator.Allocate(25) == 30);
+
+    // smallest fitting range is used, even if larger one is located before it
+    RangeAllocator holes(100);
+    size_t first = holes.Allocate(20);
+    size_t separator1 = holes.Allocate(1);
+    size_t second = holes.Allocate(8);
+    size_t separator2 = holes.Allocate(1);
+    holes.Free(first);
+    holes.Free(second);
+    MX_CHECK(separator1 == 20 && separator2 == 29);
+    MX_CHECK(holes.Allocate(8) == 21);
+    MX_CHECK(holes.Allocate(15) == 0);
+    // remainder of split range stays free
+    MX_CHECK(holes.Allocate(5) == 15);
+    MX_CHECK(holes.Allocate(71) == RangeAllocator::InvalidOffset);
+    MX_CHECK(holes.Allocate(70) == 30);
+    MX_CHECK(holes.GetFreeSize() == 0 && holes.GetFreeRanges().empty());
+    MX_CHECK(IsConsistent(holes));
+}
+
+MX_TEST(RangeAllocatorDefragment)
+{
+    // storage mirrors what GeometryArena does with its buffers: each element holds id of allocation owning it
+    constexpr size_t capacity = 64;
+    RangeAllocator allocator(capacity);
+    MxVector<size_t> storage(capacity, 0);
+    MxVector<size_t> offsets;
+    for (size_t id = 1; id <= 8; id++)
+    {
+        size_t offset = allocator.Allocate(id);
+        offsets.push_back(offset);
+        for (size_t i = offset; i < offset + id; i++)
+            storage[i] = id;
+    }
+    for (size_t id = 1; id <= 8; id += 2)
+        allocator.Free(offsets[id - 1]);
+    MX_CHECK(allocator.GetFragmentation() > 0.0f);
+
+    MxVector<RangeAllocator::Relocation> relocations;
+    allocator.Defragment(relocations);
+    MX_CHECK(relocations.size() == 4);
+    for (const auto& relocation : relocations)
+    {
+        MX_CHECK(relocation.To < relocation.From);
+        // moves are applied in order provided, copying forward is safe as destination precedes source
+        for (size_t i = 0; i < relocation.Size; i++)
+            storage[relocation.To + i] = storage[relocation.From + i];
+    }
+
+    const auto& allocations = allocator.GetAllocations();
+    MX_CHECK(allocations.size() == 4);
+    size_t cursor = 0;
+    bool isCompacted = true;
+    for (size_t k = 0; k < allocations.size(); k++)
+    {
+        // allocation order is preserved, so k-th remaining allocation holds id 2 * (k + 1)
+        size_t id = 2 * (k + 1);
+        isCompacted &= allocations[k].Offset == cursor && allocations[k].Size == id;
+        for (size_t i = 0; i < allocations[k].Size; i++)
+            isCompacted &= storage[allocations[k].Offset + i] == id;
+        cursor += allocations[k].Size;
+    }
+    MX_CHECK(isCompacted);
+    MX_CHECK(allocator.GetFreeRanges().size() == 1 && allocator.GetFreeRanges()[0].Offset == cursor);
+    MX_CHECK(allocator.GetFragmentation() == 0.0f);
+
+    // compacted storage produces no moves
+    allocator.Defragment(relocations);
+    MX_CHECK(relocations.empty());
+    MX_CHECK(IsConsistent(allocator));
+}
+
+MX_TEST(RangeAllocatorFragmentation)
+{
+    RangeAllocator allocator(100);
+    MX_CHECK(allocator.GetFragmentation() == 0.0f);
+    size_t whole = allocator.Allocate(100);
+    // full storage has no free space to fragment
+    MX_CHECK(allocator.GetFragmentation() == 0.0f && allocator.GetLargestFreeRange() == 0);
+    allocator.Free(whole);
+
+    size_t offsets[10];
+    for (size_t i = 0; i < 10; i++)
+        offsets[i] = allocator.Allocate(10);
+    for (size_t i = 0; i < 10; i += 2)
+        allocator.Free(offsets[i]);
+    // 50 free elements split into 5 ranges of 10
+    MX_CHECK(allocator.GetLargestFreeRange() == 10);
+    MX_CHECK(allocator.GetFragmentation() > 0.79f && allocator.GetFragmentation() < 0.81f);
+    MX_CHECK(allocator.Allocate(20) == RangeAllocator::InvalidOffset);
+
+    allocator.Free(offsets[1]);
+    MX_CHECK(allocator.GetLargestFreeRange() == 30);
+    MX_CHECK(allocator.GetFragmentation() > 0.49f && allocator.GetFragmentation() < 0.51f);
+}
+
+MX_TEST(RangeAllocatorThroughput)
+{
+    constexpr size_t operationCount = 100000;
+    constexpr size_t liveAllocations = 1000;
+    std::mt19937 random(11);
+    std::uniform_int_distribution<size_t> sizes(1, 256), slots(0, liveAllocations - 1);
+
+    RangeAllocator allocator(liveAllocations * 512);
+    MxVector<size_t> offsets(liveAllocations, RangeAllocator::InvalidOffset);
+    size_t failedAllocations = 0;
+    {
+        EngineTests::ScopedBenchmark benchmark("range allocator allocate/free", operationCount);
+        for (size_t i = 0; i < operationCount; i++)
+        {
+            // random slot is freed and reallocated with new size, as meshes are replaced in arena
+            auto& offset = offsets[slots(random)];
+            if (offset != RangeAllocator::InvalidOffset) allocator.Free(offset);
+            offset = allocator.Allocate(sizes(random));
+            failedAllocations += offset == RangeAllocator::InvalidOffset;
+        }
+    }
+    MX_CHECK(failedAllocations == 0);
+    MX_CHECK(IsConsistent(allocator));
+
+    MxVector<RangeAllocator::Relocation> relocations;
+    {
+        EngineTests::ScopedBenchmark benchmark("range allocator defragmentation", 1);
+        allocator.Defragment(relocations);
+    }
+    MX_CHECK(allocator.GetFragmentation() == 0.0f);
+    MX_CHECK(IsConsistent(allocator));
+}
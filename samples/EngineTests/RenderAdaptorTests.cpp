@@ -0,0 +1,43 @@
+#include "TestUtilities.h"
+
+#include "Core/Rendering/RenderAdaptor.h"
+
+using namespace MxEngine;
+
+static MxVector<size_t> GatherMerged(size_t itemCount, size_t workerCount, MxVector<MxVector<size_t>>& slices)
+{
+    // items produce different number of results (including none), as objects do for their submeshes
+    RenderAdaptor::GatherSlices(itemCount, workerCount, slices, [](size_t item, MxVector<size_t>& results)
+    {
+        for (size_t i = 0; i < item % 4; i++)
+            results.push_back(item * 4 + i);
+    });
+
+    MxVector<size_t> merged;
+    for (const auto& slice : slices)
+        merged.insert(merged.end(), slice.begin(), slice.end());
+    return merged;
+}
+
+MX_TEST(RenderAdaptorGatherSlicesOrder)
+{
+    MxVector<MxVector<size_t>> slices;
+    for (size_t itemCount : { (size_t)0, (size_t)1, (size_t)3, (size_t)1000, (size_t)100003 })
+    {
+        auto reference = GatherMerged(itemCount, 1, slices);
+        MX_CHECK(slices.size() == 1);
+
+        size_t expectedCount = 0;
+        for (size_t item = 0; item < itemCount; item++)
+            expectedCount += item % 4;
+        MX_CHECK(reference.size() == expectedCount);
+
+        // slices are reused between frames, so gather with more workers after fewer ones and vice versa
+        for (size_t workerCount : { (size_t)2, (size_t)3, JobSystem::GetThreadCount(), (size_t)64, (size_t)1 })
+        {
+            auto merged = GatherMerged(itemCount, workerCount, slices);
+            MX_CHECK(slices.size() == Max(Min(workerCount, itemCount), (size_t)1));
+            MX_CHECK(merged == reference);
+        }
+    }
+}
@@ -0,0 +1,111 @@
+#include "TestUtilities.h"
+
+#include "Core/Rendering/RenderUtilities/RenderCommandQueue.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+using namespace MxEngine;
+
+MX_TEST(RenderCommandQueueQuantizeDepth)
+{
+    MX_CHECK(RenderCommandQueue::QuantizeDepth(-1.0f, 16) == 0);
+    MX_CHECK(RenderCommandQueue::QuantizeDepth(0.0f, 16) == 0);
+    MX_CHECK(RenderCommandQueue::QuantizeDepth(std::nanf(""), 16) == 0);
+
+    uint32_t previous = 0;
+    bool isMonotonic = true;
+    for (float depth = 0.001f; depth < 100000.0f; depth *= 1.5f)
+    {
+        uint32_t quantized = RenderCommandQueue::QuantizeDepth(depth, 16);
+        isMonotonic &= quantized >= previous && quantized < (1u << 16);
+        previous = quantized;
+    }
+    MX_CHECK(isMonotonic);
+}
+
+MX_TEST(RenderCommandQueueKeyOrder)
+{
+    constexpr auto frontToBack = RenderSortOrder::FRONT_TO_BACK;
+    constexpr auto backToFront = RenderSortOrder::BACK_TO_FRONT;
+
+    // pass is the most significant field for both layouts
+    MX_CHECK(RenderCommandQueue::MakeKey(frontToBack, 0, 4095, 65535, 65535, 1000.0f) < RenderCommandQueue::MakeKey(frontToBack, 1, 0, 0, 0, 0.0f));
+    MX_CHECK(RenderCommandQueue::MakeKey(backToFront, 0, 4095, 4095, 4095, 0.0f) < RenderCommandQueue::MakeKey(backToFront, 1, 0, 0, 0, 1000.0f));
+
+    // opaque draws are grouped by shader, then by material, then by geometry, and sorted front to back inside group
+    MX_CHECK(RenderCommandQueue::MakeKey(frontToBack, 0, 1, 9, 9, 1000.0f) < RenderCommandQueue::MakeKey(frontToBack, 0, 2, 0, 0, 0.0f));
+    MX_CHECK(RenderCommandQueue::MakeKey(frontToBack, 0, 1, 1, 9, 1000.0f) < RenderCommandQueue::MakeKey(frontToBack, 0, 1, 2, 0, 0.0f));
+    MX_CHECK(RenderCommandQueue::MakeKey(frontToBack, 0, 1, 1, 1, 1000.0f) < RenderCommandQueue::MakeKey(frontToBack, 0, 1, 1, 2, 0.0f));
+    MX_CHECK(RenderCommandQueue::MakeKey(frontToBack, 0, 1, 1, 1, 1.0f) < RenderCommandQueue::MakeKey(frontToBack, 0, 1, 1, 1, 2.0f));
+
+    // transparent draws are sorted back to front regardless of state
+    MX_CHECK(RenderCommandQueue::MakeKey(backToFront, 0, 9, 9, 9, 2.0f) < RenderCommandQueue::MakeKey(backToFront, 0, 1, 1, 1, 1.0f));
+    MX_CHECK(RenderCommandQueue::MakeKey(backToFront, 0, 1, 1, 1, 1.0f) < RenderCommandQueue::MakeKey(backToFront, 0, 2, 1, 1, 1.0f));
+
+    // ids are truncated to field size, so they never overflow into more significant fields
+    MX_CHECK(RenderCommandQueue::MakeKey(frontToBack, 0, 0, 0, 0x10000, 0.0f) == RenderCommandQueue::MakeKey(frontToBack, 0, 0, 0, 0, 0.0f));
+    MX_CHECK(RenderCommandQueue::MakeKey(frontToBack, 0x10, 0, 0, 0, 0.0f) == RenderCommandQueue::MakeKey(frontToBack, 0, 0, 0, 0, 0.0f));
+}
+
+MX_TEST(RenderCommandQueueRadixSort)
+{
+    constexpr size_t commandCount = 100000;
+    std::mt19937 random(42);
+    std::uniform_int_distribution<uint32_t> ids(0, 63);
+    std::uniform_real_distribution<float> depths(0.0f, 500.0f);
+
+    RenderCommandQueue queue;
+    queue.Reserve(commandCount);
+    for (size_t i = 0; i < commandCount; i++)
+    {
+        uint32_t shader = ids(random) % 8, material = ids(random), geometry = ids(random);
+        auto order = i % 4 == 0 ? RenderSortOrder::BACK_TO_FRONT : RenderSortOrder::FRONT_TO_BACK;
+        uint8_t pass = i % 4 == 0 ? 1 : 0;
+        queue.Push(RenderCommandQueue::MakeKey(order, pass, shader, material, geometry, depths(random)), (uint32_t)i, shader, material, geometry);
+    }
+
+    auto expected = queue.GetCommands();
+    std::stable_sort(expected.begin(), expected.end(), [](const RenderCommand& c1, const RenderCommand& c2) { return c1.Key < c2.Key; });
+    {
+        EngineTests::ScopedBenchmark benchmark("radix sort of 100k commands", commandCount);
+        queue.Sort();
+    }
+
+    // radix sort is stable, so commands with equal keys keep submission order
+    bool isEqual = true;
+    for (size_t i = 0; i < commandCount; i++)
+        isEqual &= queue.GetCommands()[i].Key == expected[i].Key && queue.GetCommands()[i].UnitIndex == expected[i].UnitIndex;
+    MX_CHECK(isEqual);
+}
+
+MX_TEST(RenderCommandQueueReplay)
+{
+    struct RecordingVisitor
+    {
+        size_t ShaderBinds = 0, MaterialBinds = 0, GeometryBinds = 0, Draws = 0;
+
+        void BindShader(const RenderCommand&) { this->ShaderBinds++; }
+        void BindMaterial(const RenderCommand&) { this->MaterialBinds++; }
+        void BindGeometry(const RenderCommand&) { this->GeometryBinds++; }
+        void Draw(const RenderCommand&) { this->Draws++; }
+    };
+
+    RenderCommandQueue queue;
+    // two shaders, each with two materials, all sharing one geometry, pushed in interleaved order
+    for (uint32_t i = 0; i < 16; i++)
+    {
+        uint32_t shader = i % 2, material = (i / 2) % 2, geometry = 7;
+        queue.Push(RenderCommandQueue::MakeKey(RenderSortOrder::FRONT_TO_BACK, 0, shader, material, geometry, float(i)), i, shader, material, geometry);
+    }
+    queue.Sort();
+
+    RecordingVisitor visitor;
+    auto statistics = queue.Replay(visitor);
+    MX_CHECK(visitor.Draws == 16 && statistics.DrawCalls == 16);
+    MX_CHECK(visitor.ShaderBinds == 2 && statistics.ShaderBinds == 2);
+    MX_CHECK(visitor.MaterialBinds == 4 && statistics.MaterialBinds == 4);
+    MX_CHECK(visitor.GeometryBinds == 1 && statistics.GeometryBinds == 1);
+    MX_CHECK(statistics.ElidedShaderBinds == 14 && statistics.ElidedMaterialBinds == 12 && statistics.ElidedGeometryBinds == 15);
+}
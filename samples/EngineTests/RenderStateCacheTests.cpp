@@ -0,0 +1,211 @@
+#include "TestUtilities.h"
+
+#include "Platform/RenderStateCache.h"
+#include "Utilities/STL/MxVector.h"
+
+using namespace MxEngine;
+
+namespace
+{
+    enum class StateCall
+    {
+        USE_PROGRAM,
+        BIND_VERTEX_ARRAY,
+        ACTIVE_TEXTURE,
+        BIND_TEXTURE,
+        ENABLE,
+        DEPTH_MASK,
+        BLEND_FUNCTION,
+    };
+
+    struct RecordedCall
+    {
+        StateCall Call;
+        unsigned int Value;
+    };
+
+    constexpr unsigned int Texture2D = 1;
+    constexpr unsigned int TextureCubeMap = 2;
+
+    // mimics graphic backend: asks cache before each state change and records calls which would reach graphic API
+    struct RecordingBackend
+    {
+        MxVector<RecordedCall> Calls;
+
+        void UseProgram(unsigned int id)
+        {
+            if (RenderStateCache::UseProgram(id)) Calls.push_back({ StateCall::USE_PROGRAM, id });
+        }
+
+        void BindVertexArray(unsigned int id)
+        {
+            if (RenderStateCache::BindVertexArray(id)) Calls.push_back({ StateCall::BIND_VERTEX_ARRAY, id });
+        }
+
+        void BindTexture(unsigned int unit, unsigned int target, unsigned int id)
+        {
+            if (RenderStateCache::ActiveTexture(unit)) Calls.push_back({ StateCall::ACTIVE_TEXTURE, unit });
+            if (RenderStateCache::BindTexture(unit, target, id)) Calls.push_back({ StateCall::BIND_TEXTURE, id });
+        }
+
+        void Enable(RenderCapability capability, bool value)
+        {
+            if (RenderStateCache::Enable(capability, value)) Calls.push_back({ StateCall::ENABLE, (unsigned int)value });
+        }
+
+        void DepthMask(bool value)
+        {
+            if (RenderStateCache::DepthMask(value)) Calls.push_back({ StateCall::DEPTH_MASK, (unsigned int)value });
+        }
+
+        void BlendFunction(unsigned int source, unsigned int destination)
+        {
+            if (RenderStateCache::BlendFunction(source, destination)) Calls.push_back({ StateCall::BLEND_FUNCTION, source });
+        }
+
+        size_t Count(StateCall call) const
+        {
+            size_t result = 0;
+            for (const auto& recorded : Calls)
+                result += recorded.Call == call;
+            return result;
+        }
+    };
+
+    void ResetCache()
+    {
+        RenderStateCache::Invalidate();
+        RenderStateCache::ResetStatistics();
+    }
+}
+
+MX_TEST(RenderStateCacheSkipsRedundantCalls)
+{
+    ResetCache();
+    RecordingBackend backend;
+
+    backend.UseProgram(3);
+    backend.UseProgram(3);
+    backend.BindVertexArray(5);
+    backend.BindVertexArray(5);
+    backend.BindVertexArray(6);
+    backend.DepthMask(true);
+    backend.DepthMask(true);
+    backend.DepthMask(false);
+    backend.Enable(RenderCapability::BLEND, true);
+    backend.Enable(RenderCapability::DEPTH_TEST, true);
+    backend.Enable(RenderCapability::BLEND, true);
+
+    MX_CHECK(backend.Count(StateCall::USE_PROGRAM) == 1);
+    MX_CHECK(backend.Count(StateCall::BIND_VERTEX_ARRAY) == 2);
+    MX_CHECK(backend.Count(StateCall::DEPTH_MASK) == 2);
+    // capabilities are tracked separately
+    MX_CHECK(backend.Count(StateCall::ENABLE) == 2);
+
+    const auto& statistics = RenderStateCache::GetFrameStatistics();
+    MX_CHECK(statistics.IssuedCalls == 7);
+    MX_CHECK(statistics.SkippedCalls == 4);
+}
+
+MX_TEST(RenderStateCacheBlendFunction)
+{
+    ResetCache();
+    RecordingBackend backend;
+
+    backend.BlendFunction(1, 2);
+    backend.BlendFunction(1, 2);
+    // call sets both factors, so change of any of them must be issued
+    backend.BlendFunction(1, 3);
+    backend.BlendFunction(4, 3);
+    MX_CHECK(backend.Count(StateCall::BLEND_FUNCTION) == 3);
+}
+
+MX_TEST(RenderStateCacheTextureUnits)
+{
+    ResetCache();
+    RecordingBackend backend;
+
+    backend.BindTexture(0, Texture2D, 10);
+    backend.BindTexture(0, Texture2D, 10);
+    // same unit keeps separate binding for each target
+    backend.BindTexture(0, TextureCubeMap, 10);
+    backend.BindTexture(0, Texture2D, 10);
+    backend.BindTexture(1, Texture2D, 10);
+    backend.BindTexture(0, Texture2D, 11);
+
+    MX_CHECK(backend.Count(StateCall::BIND_TEXTURE) == 4);
+    MX_CHECK(backend.Count(StateCall::ACTIVE_TEXTURE) == 3);
+    MX_CHECK(RenderStateCache::GetActiveTexture() == 0);
+
+    // deleted texture id may be reused by graphic API, so its next binding must be issued
+    backend.Calls.clear();
+    RenderStateCache::ForgetTexture(11);
+    backend.BindTexture(0, Texture2D, 11);
+    backend.BindTexture(1, Texture2D, 10);
+    MX_CHECK(backend.Count(StateCall::BIND_TEXTURE) == 1);
+}
+
+MX_TEST(RenderStateCacheForgetAndInvalidate)
+{
+    ResetCache();
+    RecordingBackend backend;
+
+    backend.UseProgram(3);
+    backend.BindVertexArray(5);
+    RenderStateCache::ForgetProgram(4);
+    RenderStateCache::ForgetVertexArray(5);
+    backend.UseProgram(3);
+    backend.BindVertexArray(5);
+    MX_CHECK(backend.Count(StateCall::USE_PROGRAM) == 1);
+    MX_CHECK(backend.Count(StateCall::BIND_VERTEX_ARRAY) == 2);
+
+    // state changed bypassing cache, everything must be issued again
+    backend.Calls.clear();
+    RenderStateCache::Invalidate();
+    backend.UseProgram(3);
+    backend.BindVertexArray(5);
+    backend.DepthMask(true);
+    backend.BindTexture(0, Texture2D, 10);
+    MX_CHECK(backend.Calls.size() == 5);
+}
+
+MX_TEST(RenderStateCacheFrameStatistics)
+{
+    ResetCache();
+    RecordingBackend backend;
+
+    constexpr size_t drawCount = 10000;
+    constexpr unsigned int programCount = 4;
+    constexpr unsigned int meshCount = 16;
+
+    // draws sorted by program and mesh, as render command queue submits them
+    for (size_t frame = 0; frame < 2; frame++)
+    {
+        backend.Calls.clear();
+        for (size_t i = 0; i < drawCount; i++)
+        {
+            unsigned int program = 1 + (unsigned int)(i * programCount / drawCount);
+            unsigned int mesh = 1 + (unsigned int)(i * meshCount / drawCount);
+            backend.UseProgram(program);
+            backend.BindVertexArray(mesh);
+            backend.BindTexture(0, Texture2D, 100 + mesh);
+            backend.DepthMask(true);
+            backend.Enable(RenderCapability::DEPTH_TEST, true);
+        }
+        RenderStateCache::EndFrame();
+    }
+
+    const auto& lastFrame = RenderStateCache::GetLastFrameStatistics();
+    // cache persists between frames, so only changes of program, mesh and texture are issued
+    MX_CHECK(backend.Count(StateCall::USE_PROGRAM) == programCount);
+    MX_CHECK(backend.Count(StateCall::BIND_VERTEX_ARRAY) == meshCount);
+    MX_CHECK(backend.Count(StateCall::BIND_TEXTURE) == meshCount);
+    MX_CHECK(backend.Count(StateCall::DEPTH_MASK) == 0);
+    MX_CHECK(lastFrame.IssuedCalls == backend.Calls.size());
+    MX_CHECK(lastFrame.IssuedCalls + lastFrame.SkippedCalls == drawCount * 6);
+    MX_CHECK(lastFrame.GetSkippedPercentage() > 99.0f);
+
+    const auto& total = RenderStateCache::GetTotalStatistics();
+    MX_CHECK(total.IssuedCalls + total.SkippedCalls == 2 * drawCount * 6);
+    MX_CHECK(RenderStateCache::GetFrameStatistics().IssuedCalls == 0);
+}
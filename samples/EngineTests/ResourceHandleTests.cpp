@@ -0,0 +1,146 @@
+#include "TestUtilities.h"
+
+#include "Utilities/AbstractFactory/AbstractFactory.h"
+
+namespace EngineTests
+{
+    using namespace MxEngine;
+
+    struct HandleTestObject
+    {
+        int Value = 0;
+
+        HandleTestObject(int value) : Value(value) { }
+    };
+
+    using HandleTestFactory = AbstractFactoryImpl<HandleTestObject>;
+    using HandleTestResource = Resource<HandleTestObject, HandleTestFactory>;
+
+    // records UUID of its own handle when destroyed, as components do to unsubscribe their event listeners
+    struct UUIDObserverObject
+    {
+        inline static const void* Self = nullptr;
+        inline static UUID Observed;
+
+        ~UUIDObserverObject();
+    };
+
+    using UUIDObserverFactory = AbstractFactoryImpl<UUIDObserverObject>;
+    using UUIDObserverHandle = BorrowedResource<UUIDObserverObject, UUIDObserverFactory>;
+
+    UUIDObserverObject::~UUIDObserverObject()
+    {
+        if (Self != nullptr) Observed = static_cast<const UUIDObserverHandle*>(Self)->GetUUID();
+    }
+
+    static void InitHandleTestFactory()
+    {
+        // uuid generator is initialized once by test runner
+        HandleTestFactory::Init();
+    }
+}
+
+using namespace EngineTests;
+
+MX_TEST(ResourceHandleLayout)
+{
+    #if !defined(MXENGINE_DEBUG)
+    MX_CHECK(sizeof(HandleTestResource) == 8);
+    #endif
+    MX_CHECK(sizeof(BorrowedResource<HandleTestObject, HandleTestFactory>) == 8);
+}
+
+MX_TEST(ResourceHandleGeneration)
+{
+    InitHandleTestFactory();
+
+    auto resource = HandleTestFactory::Create<HandleTestObject>(42);
+    auto uuid = resource.GetUUID();
+    auto borrowed = resource.Borrow();
+    MX_CHECK(resource.IsValid() && borrowed.IsValid());
+    MX_CHECK(uuid != UUIDGenerator::GetNull());
+    MX_CHECK(borrowed->Value == 42);
+    MX_CHECK(borrowed.Lock() == resource);
+
+    size_t handle = resource.GetHandle();
+    resource = HandleTestResource{ };
+    MX_CHECK(!borrowed.IsValid());
+    MX_CHECK(borrowed.GetUUID() == UUIDGenerator::GetNull());
+    MX_CHECK(!HandleTestResource(uuid, handle).IsValid());
+
+    // new object reuses the freed block, but old handles must not see it
+    auto reused = HandleTestFactory::Create<HandleTestObject>(7);
+    MX_CHECK(reused.GetHandle() == handle);
+    MX_CHECK(!borrowed.IsValid());
+    MX_CHECK(reused.GetUUID() != uuid);
+    MX_CHECK(!HandleTestResource(uuid, handle).IsValid());
+}
+
+MX_TEST(ResourceHandleUUIDInDestructor)
+{
+    UUIDObserverFactory::Init();
+
+    auto resource = UUIDObserverFactory::Create<UUIDObserverObject>();
+    auto uuid = resource.GetUUID();
+    auto borrowed = resource.Borrow();
+    UUIDObserverObject::Self = &borrowed;
+    UUIDObserverObject::Observed = UUIDGenerator::GetNull();
+
+    // block generation changes only after destructor is finished, so object still can get its UUID
+    resource = Resource<UUIDObserverObject, UUIDObserverFactory>{ };
+    UUIDObserverObject::Self = nullptr;
+    MX_CHECK(UUIDObserverObject::Observed == uuid);
+    MX_CHECK(borrowed.GetUUID() == UUIDGenerator::GetNull());
+}
+
+MX_TEST(ResourceHandleBenchmark)
+{
+    InitHandleTestFactory();
+
+    constexpr size_t objectCount = 100000;
+    constexpr size_t passCount = 20;
+    MxVector<HandleTestResource> resources;
+    resources.reserve(objectCount);
+    for (size_t i = 0; i < objectCount; i++)
+        resources.push_back(HandleTestFactory::Create<HandleTestObject>((int)i));
+
+    int64_t expected = int64_t(objectCount) * int64_t(objectCount - 1) / 2 * int64_t(passCount);
+    {
+        ScopedBenchmark benchmark("owning handle copy and access", objectCount * passCount);
+        int64_t sum = 0;
+        for (size_t pass = 0; pass < passCount; pass++)
+        {
+            for (const auto& resource : resources)
+            {
+                auto copy = resource;
+                if (copy.IsValid()) sum += copy->Value;
+            }
+        }
+        MX_CHECK(sum == expected);
+    }
+
+    MxVector<BorrowedResource<HandleTestObject, HandleTestFactory>> borrowed;
+    borrowed.reserve(objectCount);
+    for (const auto& resource : resources)
+        borrowed.push_back(resource.Borrow());
+    {
+        ScopedBenchmark benchmark("borrowed handle copy and access", objectCount * passCount);
+        int64_t sum = 0;
+        for (size_t pass = 0; pass < passCount; pass++)
+        {
+            for (const auto& resource : borrowed)
+            {
+                auto copy = resource;
+                if (copy.IsValid()) sum += copy->Value;
+            }
+        }
+        MX_CHECK(sum == expected);
+    }
+    {
+        ScopedBenchmark benchmark("uuid lookup", objectCount);
+        size_t validCount = 0;
+        for (const auto& resource : resources)
+            validCount += resource.GetUUID() != UUIDGenerator::GetNull();
+        MX_CHECK(validCount == objectCount);
+    }
+}
@@ -0,0 +1,209 @@
+#include "TestUtilities.h"
+
+#include "Core/Rendering/RenderUtilities/StaticBatchBuilder.h"
+
+#include <random>
+#include <algorithm>
+#include <cmath>
+
+using namespace MxEngine;
+
+static bool IsNear(const Vector3& v1, const Vector3& v2, float epsilon)
+{
+    return std::abs(v1.x - v2.x) < epsilon && std::abs(v1.y - v2.y) < epsilon && std::abs(v1.z - v2.z) < epsilon;
+}
+
+static void MakeBoxData(MeshData& data)
+{
+    // 8 corners of unit box with 12 triangles. Normals point away from center, so their transformation can be checked too
+    auto& vertecies = data.GetVertecies();
+    for (size_t i = 0; i < 8; i++)
+    {
+        auto& vertex = vertecies.emplace_back();
+        vertex.Position = MakeVector3(i & 1 ? 0.5f : -0.5f, i & 2 ? 0.5f : -0.5f, i & 4 ? 0.5f : -0.5f);
+        vertex.TexCoord = Vector2((float)(i & 1), (float)((i >> 1) & 1));
+        vertex.Normal = Normalize(vertex.Position);
+        vertex.Tangent = MakeVector3(1.0f, 0.0f, 0.0f);
+        vertex.Bitangent = MakeVector3(0.0f, 1.0f, 0.0f);
+    }
+
+    data.GetIndicies() = {
+        0, 2, 1, 1, 2, 3, 4, 5, 6, 5, 7, 6,
+        0, 1, 4, 1, 5, 4, 2, 6, 3, 3, 6, 7,
+        0, 4, 2, 2, 4, 6, 1, 3, 5, 3, 7, 5,
+    };
+    data.UpdateBoundingGeometry();
+}
+
+static VectorInt3 GetCell(const Vector3& position, float cellSize)
+{
+    auto cell = position / cellSize;
+    return VectorInt3((int)std::floor(cell.x), (int)std::floor(cell.y), (int)std::floor(cell.z));
+}
+
+MX_TEST(StaticBatchBuilderBuild)
+{
+    constexpr size_t sourceCount = 1000;
+    constexpr size_t groupCount = 3;
+    std::mt19937 random(42);
+    std::uniform_real_distribution<float> coordinate(-200.0f, 200.0f);
+    std::uniform_real_distribution<float> angle(0.0f, 360.0f);
+
+    MeshData box;
+    MakeBoxData(box);
+
+    StaticBatchBuilder builder;
+    MxVector<StaticBatchSource> sources;
+    for (size_t i = 0; i < sourceCount; i++)
+    {
+        auto axis = Normalize(MakeVector3(coordinate(random), coordinate(random), coordinate(random)) + MakeVector3(0.001f));
+        auto model = Translate(Matrix4x4(1.0f), MakeVector3(coordinate(random), coordinate(random), coordinate(random)));
+        model = model * ToMatrix(MakeQuaternion(Radians(angle(random)), axis));
+        auto normal = Matrix3x3(model);
+
+        MX_CHECK(builder.AddSource(box, model, normal, i % groupCount));
+        sources.push_back(StaticBatchSource{ &box, model, normal, i % groupCount });
+    }
+    MX_CHECK(builder.GetSourceCount() == sourceCount);
+
+    builder.Build();
+    const auto& batches = builder.GetBatches();
+    const auto& statistics = builder.GetStatistics();
+    MX_CHECK(statistics.MergedSources == sourceCount && statistics.Batches == batches.size());
+    MX_CHECK(statistics.Vertecies == sourceCount * box.GetVertecies().size());
+    MX_CHECK(statistics.Indicies == sourceCount * box.GetIndicies().size());
+
+    // each source must appear exactly once in batch of its group and cell, with vertecies transformed into world space
+    MxVector<size_t> sourcesPerBatch(batches.size(), 0);
+    MxVector<bool> isBatchKeyUnique(batches.size(), true);
+    for (size_t i = 0; i < batches.size(); i++)
+    {
+        for (size_t j = 0; j < i; j++)
+            isBatchKeyUnique[i] = isBatchKeyUnique[i] && !(batches[j].GroupId == batches[i].GroupId && batches[j].Cell == batches[i].Cell);
+    }
+    MX_CHECK(std::find(isBatchKeyUnique.begin(), isBatchKeyUnique.end(), false) == isBatchKeyUnique.end());
+
+    bool isSourceFound = true;
+    bool isGeometryValid = true;
+    for (const auto& source : sources)
+    {
+        auto center = Vector3(source.ModelMatrix[3]);
+        auto cell = GetCell((box.GetBoundingBox() * source.ModelMatrix).GetCenter(), builder.GetCellSize());
+        auto batch = std::find_if(batches.begin(), batches.end(), [&](const auto& b) { return b.GroupId == source.GroupId && b.Cell == cell; });
+        if (batch == batches.end()) { isSourceFound = false; continue; }
+        sourcesPerBatch[batch - batches.begin()]++;
+
+        // box vertecies are 0.87 units away from its center, so first vertex of source is searched by position of its first corner
+        auto firstCorner = Vector3(source.ModelMatrix * Vector4(box.GetVertecies()[0].Position, 1.0f));
+        size_t firstVertex = batch->Vertecies.size();
+        for (size_t v = 0; v < batch->Vertecies.size(); v += box.GetVertecies().size())
+        {
+            if (IsNear(batch->Vertecies[v].Position, firstCorner, 0.001f)) firstVertex = v;
+        }
+        if (firstVertex == batch->Vertecies.size()) { isSourceFound = false; continue; }
+
+        for (size_t v = 0; v < box.GetVertecies().size(); v++)
+        {
+            const auto& input = box.GetVertecies()[v];
+            const auto& output = batch->Vertecies[firstVertex + v];
+            isGeometryValid &= IsNear(output.Position, Vector3(source.ModelMatrix * Vector4(input.Position, 1.0f)), 0.001f);
+            isGeometryValid &= IsNear(output.Normal, source.NormalMatrix * input.Normal, 0.001f);
+            isGeometryValid &= output.TexCoord == input.TexCoord;
+            isGeometryValid &= Length(output.Position - center) < 1.0f;
+        }
+    }
+    MX_CHECK(isSourceFound);
+    MX_CHECK(isGeometryValid);
+
+    size_t totalSources = 0;
+    bool isBatchSizeValid = true;
+    for (size_t i = 0; i < batches.size(); i++)
+    {
+        totalSources += sourcesPerBatch[i];
+        isBatchSizeValid &= batches[i].Vertecies.size() == sourcesPerBatch[i] * box.GetVertecies().size();
+        isBatchSizeValid &= batches[i].Indicies.size() == sourcesPerBatch[i] * box.GetIndicies().size();
+    }
+    MX_CHECK(totalSources == sourceCount);
+    MX_CHECK(isBatchSizeValid);
+
+    // indicies of each source are offset by its first vertex, so every triangle stays inside of one source range
+    bool areIndiciesValid = true;
+    for (const auto& batch : batches)
+    {
+        size_t boxVertecies = box.GetVertecies().size();
+        for (size_t i = 0; i < batch.Indicies.size(); i += 3)
+        {
+            size_t sourceIndex = batch.Indicies[i] / boxVertecies;
+            for (size_t k = 0; k < 3; k++)
+            {
+                areIndiciesValid &= batch.Indicies[i + k] < batch.Vertecies.size();
+                areIndiciesValid &= batch.Indicies[i + k] / boxVertecies == sourceIndex;
+                areIndiciesValid &= batch.Indicies[i + k] % boxVertecies == box.GetIndicies()[i % box.GetIndicies().size() + k];
+            }
+        }
+    }
+    MX_CHECK(areIndiciesValid);
+
+    // sources are merged by several jobs, but each writes into its own range, so rebuild gives exactly the same batches
+    auto previousBatches = batches;
+    builder.Build();
+    bool isRebuildEqual = previousBatches.size() == batches.size();
+    for (size_t i = 0; i < batches.size() && isRebuildEqual; i++)
+    {
+        isRebuildEqual &= previousBatches[i].GroupId == batches[i].GroupId && previousBatches[i].Cell == batches[i].Cell;
+        isRebuildEqual &= previousBatches[i].Indicies == batches[i].Indicies;
+        for (size_t v = 0; v < batches[i].Vertecies.size() && isRebuildEqual; v++)
+            isRebuildEqual &= batches[i].Vertecies[v].Position == previousBatches[i].Vertecies[v].Position;
+    }
+    MX_CHECK(isRebuildEqual);
+    MX_CHECK(builder.GetStatistics().Rebuilds == 2);
+
+    builder.Clear();
+    MX_CHECK(builder.GetSourceCount() == 0 && builder.GetBatches().empty());
+}
+
+MX_TEST(StaticBatchBuilderSkipsMeshWithoutCopy)
+{
+    MeshData box;
+    MakeBoxData(box);
+    MeshData freedBox;
+    MakeBoxData(freedBox);
+    freedBox.FreeMeshDataCopy();
+
+    StaticBatchBuilder builder;
+    MX_CHECK(builder.AddSource(box, Matrix4x4(1.0f), Matrix3x3(1.0f), 0));
+    MX_CHECK(!builder.AddSource(freedBox, Matrix4x4(1.0f), Matrix3x3(1.0f), 0));
+    MX_CHECK(builder.GetSourceCount() == 1);
+
+    builder.Build();
+    MX_CHECK(builder.GetBatches().size() == 1);
+    MX_CHECK(builder.GetBatches().front().Vertecies.size() == box.GetVertecies().size());
+}
+
+MX_TEST(StaticBatchBuilderBenchmark)
+{
+    // large static scene: many small meshes of several materials spread over wide area
+    constexpr size_t sourceCount = 50000;
+    constexpr size_t groupCount = 16;
+    constexpr size_t buildCount = 10;
+    std::mt19937 random(7);
+    std::uniform_real_distribution<float> coordinate(-1000.0f, 1000.0f);
+
+    MeshData box;
+    MakeBoxData(box);
+
+    StaticBatchBuilder builder;
+    for (size_t i = 0; i < sourceCount; i++)
+    {
+        auto model = Translate(Matrix4x4(1.0f), MakeVector3(coordinate(random), coordinate(random), coordinate(random)));
+        builder.AddSource(box, model, Matrix3x3(1.0f), i % groupCount);
+    }
+
+    {
+        EngineTests::ScopedBenchmark benchmark("StaticBatchBuilder::Build", buildCount);
+        for (size_t i = 0; i < buildCount; i++)
+            builder.Build();
+    }
+    MX_CHECK(builder.GetStatistics().Vertecies == sourceCount * box.GetVertecies().size());
+    std::cout << "    " << sourceCount << " sources merged into " << builder.GetStatistics().Batches << " batches" << std::endl;
+}
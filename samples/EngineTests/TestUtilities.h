@@ -0,0 +1,83 @@
+#pragma once
+
+#include <chrono>
+#include <iostream>
+
+#include "Utilities/STL/MxVector.h"
+
+namespace EngineTests
+{
+    /*
+    minimal test registry used by engine tests. Each test is a free function registered by MX_TEST macro,
+    failed checks are reported to std::cout and counted, so test executable can return non-zero code to ctest
+    */
+    using TestFunction = void(*)();
+
+    struct TestEntry
+    {
+        const char* Name;
+        TestFunction Function;
+    };
+
+    inline MxEngine::MxVector<TestEntry>& GetTests()
+    {
+        static MxEngine::MxVector<TestEntry> tests;
+        return tests;
+    }
+
+    inline size_t& GetFailedChecks()
+    {
+        static size_t failedChecks = 0;
+        return failedChecks;
+    }
+
+    struct TestRegistration
+    {
+        TestRegistration(const char* name, TestFunction function)
+        {
+            GetTests().push_back(TestEntry{ name, function });
+        }
+    };
+
+    /*
+    measures time of scope execution and prints it with time per iteration
+    */
+    class ScopedBenchmark
+    {
+        using Clock = std::chrono::high_resolution_clock;
+
+        const char* name;
+        size_t iterations;
+        Clock::time_point start;
+    public:
+        ScopedBenchmark(const char* name, size_t iterations)
+            : name(name), iterations(iterations), start(Clock::now())
+        {
+
+        }
+
+        ~ScopedBenchmark()
+        {
+            auto elapsed = std::chrono::duration<double, std::milli>(Clock::now() - this->start).count();
+            std::cout << "    [benchmark] " << this->name << ": " << elapsed << " ms";
+            if (this->iterations > 0)
+                std::cout << " (" << elapsed * 1000000.0 / double(this->iterations) << " ns per iteration, "
+                          << double(this->iterations) * 1000.0 / elapsed << " iterations per second)";
+            std::cout << std::endl;
+        }
+    };
+}
+
+#define MX_TEST(name) \
+    static void name(); \
+    static EngineTests::TestRegistration name##Registration(#name, name); \
+    static void name()
+
+#define MX_CHECK(condition) \
+    do { \
+        if (!(condition)) \
+        { \
+            EngineTests::GetFailedChecks()++; \
+            std::cout << "    check failed: " #condition " (" << __FILE__ << ":" << __LINE__ << ")" << std::endl; \
+        } \
+    } while(false)
@@ -0,0 +1,131 @@
+#include "TestUtilities.h"
+
+#include "Core/MxObject/MxObject.h"
+#include "Core/Components/TransformHierarchy.h"
+
+#include <cmath>
+
+using namespace MxEngine;
+
+namespace
+{
+    bool IsNear(const Matrix4x4& a, const Matrix4x4& b)
+    {
+        for (int column = 0; column < 4; column++)
+        {
+            for (int row = 0; row < 4; row++)
+            {
+                if (std::abs(a[column][row] - b[column][row]) > 0.0001f) return false;
+            }
+        }
+        return true;
+    }
+}
+
+MX_TEST(TransformHierarchyWorldMatrix)
+{
+    auto root = MxObject::Create();
+    auto child = MxObject::Create();
+    auto grandChild = MxObject::Create();
+    auto single = MxObject::Create();
+
+    root->Transform.SetPosition(MakeVector3(1.0f, 2.0f, 3.0f)).RotateY(90.0f).SetScale(2.0f);
+    child->Transform.SetPosition(MakeVector3(0.0f, 0.0f, 5.0f)).RotateX(45.0f);
+    grandChild->Transform.SetPosition(MakeVector3(1.0f, 0.0f, 0.0f));
+    single->Transform.SetPosition(MakeVector3(7.0f, 0.0f, 0.0f));
+
+    child->SetParent(root);
+    grandChild->SetParent(child);
+    // relation which would create a cycle is rejected
+    MX_CHECK(!TransformHierarchy::SetParent(root->GetNativeHandle(), grandChild->GetNativeHandle()));
+    TransformHierarchy::Update();
+
+    MX_CHECK(TransformHierarchy::GetNodeCount() == 3);
+    MX_CHECK(IsNear(root->GetWorldMatrix(), root->Transform.GetMatrix()));
+    MX_CHECK(IsNear(child->GetWorldMatrix(), root->Transform.GetMatrix() * child->Transform.GetMatrix()));
+    auto expected = root->Transform.GetMatrix() * child->Transform.GetMatrix() * grandChild->Transform.GetMatrix();
+    MX_CHECK(IsNear(grandChild->GetWorldMatrix(), expected));
+    // objects outside of hierarchy use their local transform
+    MX_CHECK(&single->GetWorldMatrix() == &single->Transform.GetMatrix());
+
+    // world transform decomposes world matrix, so it can be passed to systems which work with position, rotation and scale
+    auto worldTransform = grandChild->GetWorldTransform();
+    MX_CHECK(IsNear(worldTransform.GetMatrix(), expected));
+    MX_CHECK(Length(grandChild->GetWorldPosition() - Vector3(expected[3])) < 0.0001f);
+
+    // only changed subtree is recomputed
+    TransformHierarchy::Update();
+    MX_CHECK(TransformHierarchy::GetUpdatedNodeCount() == 0);
+    child->Transform.TranslateX(1.0f);
+    TransformHierarchy::Update();
+    MX_CHECK(TransformHierarchy::GetUpdatedNodeCount() == 2);
+    MX_CHECK(IsNear(grandChild->GetWorldMatrix(), root->Transform.GetMatrix() * child->Transform.GetMatrix() * grandChild->Transform.GetMatrix()));
+
+    // destroyed parent detaches its children, which become roots with world matrix equal to local one
+    MxObject::Destroy(child);
+    TransformHierarchy::Update();
+    MX_CHECK(!grandChild->GetParent().IsValid());
+    MX_CHECK(TransformHierarchy::GetNodeCount() == 0);
+    MX_CHECK(IsNear(grandChild->GetWorldMatrix(), grandChild->Transform.GetMatrix()));
+
+    MxObject::Destroy(root);
+    MxObject::Destroy(grandChild);
+    MxObject::Destroy(single);
+}
+
+MX_TEST(TransformHierarchyReusedHandle)
+{
+    auto parent = MxObject::Create();
+    auto child = MxObject::Create();
+    parent->Transform.SetPosition(MakeVector3(10.0f, 0.0f, 0.0f));
+    child->SetParent(parent);
+    TransformHierarchy::Update();
+
+    // new object can take handle of destroyed one before next update, and must not see its cached world matrix
+    auto childHandle = child->GetNativeHandle();
+    MxObject::Destroy(child);
+    MxVector<MxObject::Handle> created;
+    while (created.size() < 1024 && (created.empty() || created.back()->GetNativeHandle() != childHandle))
+        created.push_back(MxObject::Create());
+
+    auto& reused = created.back();
+    MX_CHECK(reused->GetNativeHandle() == childHandle);
+    MX_CHECK(IsNear(reused->GetWorldMatrix(), reused->Transform.GetMatrix()));
+    MX_CHECK(!reused->GetParent().IsValid());
+
+    for (auto& object : created)
+        MxObject::Destroy(object);
+    MxObject::Destroy(parent);
+    TransformHierarchy::Update();
+}
+
+MX_TEST(TransformHierarchyLookupBenchmark)
+{
+    // half of objects are children of first one, so both hierarchy and non-hierarchy lookups are measured
+    constexpr size_t objectCount = 100000;
+    MxVector<MxObject::Handle> objects;
+    objects.reserve(objectCount);
+    for (size_t i = 0; i < objectCount; i++)
+    {
+        auto& object = objects.emplace_back(MxObject::Create());
+        object->Transform.SetPosition(MakeVector3(float(i), 0.0f, 0.0f));
+        if (i > 0 && i % 2 == 0) object->SetParent(objects.front());
+    }
+    {
+        EngineTests::ScopedBenchmark benchmark("TransformHierarchy::Update (rebuild)", objectCount / 2);
+        TransformHierarchy::Update();
+    }
+
+    float checksum = 0.0f;
+    {
+        EngineTests::ScopedBenchmark benchmark("MxObject::GetWorldMatrix", objectCount);
+        for (const auto& object : objects)
+            checksum += object->GetWorldMatrix()[3][0];
+    }
+    MX_CHECK(checksum > 0.0f);
+
+    for (auto& object : objects)
+        MxObject::Destroy(object);
+    TransformHierarchy::Update();
+    MX_CHECK(TransformHierarchy::GetNodeCount() == 0);
+}
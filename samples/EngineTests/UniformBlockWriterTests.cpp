@@ -0,0 +1,99 @@
+#include "TestUtilities.h"
+
+#include "Core/Rendering/RenderUtilities/UniformBlockWriter.h"
+
+#include <cstring>
+
+using namespace MxEngine;
+
+static float ReadFloat(const UniformBlockWriter& writer, size_t offset)
+{
+    float value = 0.0f;
+    std::memcpy(&value, writer.GetData() + offset, sizeof(value));
+    return value;
+}
+
+MX_TEST(UniformBlockWriterAlignOffset)
+{
+    MX_CHECK(UniformBlockWriter::AlignOffset(0, 16) == 0);
+    MX_CHECK(UniformBlockWriter::AlignOffset(1, 16) == 16);
+    MX_CHECK(UniformBlockWriter::AlignOffset(16, 16) == 16);
+    MX_CHECK(UniformBlockWriter::AlignOffset(17, 8) == 24);
+    MX_CHECK(UniformBlockWriter::AlignOffset(6, 4) == 8);
+}
+
+MX_TEST(UniformBlockWriterScalarsAndVectors)
+{
+    UniformBlockWriter writer;
+    MX_CHECK(writer.Write(1.0f) == 0);
+    MX_CHECK(writer.Write(2) == 4);
+    // vec2 is aligned by 8 bytes
+    MX_CHECK(writer.Write(MakeVector2(3.0f, 4.0f)) == 8);
+    MX_CHECK(writer.Write(5u) == 16);
+    // vec3 and vec4 are aligned by 16 bytes
+    MX_CHECK(writer.Write(MakeVector3(6.0f, 7.0f, 8.0f)) == 32);
+    // scalar is packed into the last component of preceding vec3
+    MX_CHECK(writer.Write(9.0f) == 44);
+    MX_CHECK(writer.Write(MakeVector4(10.0f, 11.0f, 12.0f, 13.0f)) == 48);
+    MX_CHECK(writer.GetSize() == 64);
+
+    MX_CHECK(ReadFloat(writer, 0) == 1.0f);
+    MX_CHECK(ReadFloat(writer, 12) == 4.0f);
+    MX_CHECK(ReadFloat(writer, 40) == 8.0f);
+    MX_CHECK(ReadFloat(writer, 44) == 9.0f);
+    MX_CHECK(ReadFloat(writer, 60) == 13.0f);
+
+    writer.Clear();
+    MX_CHECK(writer.GetSize() == 0);
+    MX_CHECK(writer.Write(MakeVector4(0.0f, 0.0f, 0.0f, 0.0f)) == 0);
+}
+
+MX_TEST(UniformBlockWriterMatrices)
+{
+    UniformBlockWriter writer;
+    writer.Write(1.0f);
+
+    // mat3 is stored as three columns, each padded to vec4
+    Matrix3x3 rotation(1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f, 8.0f, 9.0f);
+    MX_CHECK(writer.Write(rotation) == 16);
+    MX_CHECK(writer.GetSize() == 16 + 48);
+    MX_CHECK(ReadFloat(writer, 16) == 1.0f);
+    MX_CHECK(ReadFloat(writer, 32) == 4.0f);
+    MX_CHECK(ReadFloat(writer, 48 + 8) == 9.0f);
+
+    writer.Write(2.0f);
+    Matrix4x4 transform(1.0f);
+    transform[3] = MakeVector4(10.0f, 20.0f, 30.0f, 1.0f);
+    MX_CHECK(writer.Write(transform) == 80);
+    MX_CHECK(writer.GetSize() == 80 + 64);
+    MX_CHECK(ReadFloat(writer, 80) == 1.0f);
+    MX_CHECK(ReadFloat(writer, 80 + 48 + 4) == 20.0f);
+}
+
+MX_TEST(UniformBlockWriterArraysAndStructs)
+{
+    UniformBlockWriter writer;
+    writer.Write(1);
+
+    // every array element has a stride of 16 bytes, even scalar ones
+    float values[] = { 1.0f, 2.0f, 3.0f };
+    MX_CHECK(writer.WriteArray(values, 3) == 16);
+    MX_CHECK(writer.GetSize() == 16 + 3 * 16);
+    MX_CHECK(ReadFloat(writer, 16) == 1.0f);
+    MX_CHECK(ReadFloat(writer, 32) == 2.0f);
+    MX_CHECK(ReadFloat(writer, 48) == 3.0f);
+
+    // struct { vec3 direction; float intensity; vec2 size; } followed by int
+    MX_CHECK(writer.BeginStruct() == 64);
+    MX_CHECK(writer.Write(MakeVector3(0.0f, -1.0f, 0.0f)) == 64);
+    MX_CHECK(writer.Write(0.5f) == 76);
+    MX_CHECK(writer.Write(MakeVector2(1.0f, 1.0f)) == 80);
+    MX_CHECK(writer.EndStruct() == 96);
+    MX_CHECK(writer.Write(7) == 96);
+    MX_CHECK(writer.GetSize() == 100);
+    MX_CHECK(ReadFloat(writer, 76) == 0.5f);
+
+    // padding bytes are zeroed, so uploaded block is deterministic
+    MX_CHECK(ReadFloat(writer, 88) == 0.0f);
+    MX_CHECK(ReadFloat(writer, 4) == 0.0f);
+}
@@ -0,0 +1,109 @@
+#include "TestUtilities.h"
+
+#include "Platform/GraphicAPI.h"
+
+#include <iterator>
+
+#if defined(MXENGINE_USE_NULLGRAPHICS)
+#include "Platform/Null/GraphicRecorder.h"
+#endif
+
+using namespace MxEngine;
+
+MX_TEST(UniformSlotRegistry)
+{
+    // slots with equal names share index, so they can be created in any translation unit which uses the uniform
+    UniformSlot first("uniformSlotTestFirst");
+    UniformSlot second("uniformSlotTestSecond");
+    UniformSlot firstAgain("uniformSlotTestFirst");
+
+    MX_CHECK(first.GetIndex() == firstAgain.GetIndex());
+    MX_CHECK(first.GetIndex() != second.GetIndex());
+    MX_CHECK(first.GetName() == "uniformSlotTestFirst" && second.GetName() == "uniformSlotTestSecond");
+}
+
+#if defined(MXENGINE_USE_NULLGRAPHICS)
+// uniforms set for each draw by RenderController: view-projection matrix, displacement and material texture units
+static const UniformSlot ViewProjMatrixSlot("ViewProjMatrix");
+static const UniformSlot DisplacementSlot("displacement");
+static const UniformSlot GammaSlot("gamma");
+static const MxVector<UniformSlot> MaterialMapSlots = {
+    UniformSlot("map_albedo"), UniformSlot("map_specular"), UniformSlot("map_emmisive"),
+    UniformSlot("map_normal"), UniformSlot("map_height"), UniformSlot("map_occlusion"),
+};
+static const char* MaterialMapNames[] = { "map_albedo", "map_specular", "map_emmisive", "map_normal", "map_height", "map_occlusion" };
+
+static void SetDrawUniformsBySlot(const Shader& shader, const Matrix4x4& viewProjection, float displacement)
+{
+    shader.SetUniformMat4(ViewProjMatrixSlot, viewProjection);
+    shader.SetUniformFloat(GammaSlot, 2.2f);
+    shader.SetUniformFloat(DisplacementSlot, displacement);
+    for (size_t i = 0; i < MaterialMapSlots.size(); i++)
+        shader.SetUniformInt(MaterialMapSlots[i], (int)i);
+}
+
+static void SetDrawUniformsByName(const Shader& shader, const Matrix4x4& viewProjection, float displacement)
+{
+    shader.SetUniformMat4("ViewProjMatrix", viewProjection);
+    shader.SetUniformFloat("gamma", 2.2f);
+    shader.SetUniformFloat("displacement", displacement);
+    for (size_t i = 0; i < std::size(MaterialMapNames); i++)
+        shader.SetUniformInt(MaterialMapNames[i], (int)i);
+}
+
+MX_TEST(UniformSlotResolvedOncePerProgram)
+{
+    Shader shader;
+    shader.LoadFromString("vertex", "fragment");
+    GraphicRecorder::Reset();
+
+    constexpr size_t drawCount = 100;
+    for (size_t i = 0; i < drawCount; i++)
+        SetDrawUniformsBySlot(shader, Matrix4x4(1.0f), 0.5f);
+
+    // each slot is resolved by name only on first use, all other updates reuse cached location
+    size_t uniformCount = 3 + MaterialMapSlots.size();
+    const auto& statistics = GraphicRecorder::GetFrameStatistics();
+    MX_CHECK(statistics.UniformNameLookups == uniformCount);
+    MX_CHECK(statistics.UniformUpdates == drawCount * uniformCount);
+
+    // relinked program may have different locations, so slots are resolved again
+    shader.LoadFromString("vertex", "fragment");
+    SetDrawUniformsBySlot(shader, Matrix4x4(1.0f), 0.5f);
+    MX_CHECK(GraphicRecorder::GetFrameStatistics().UniformNameLookups == 2 * uniformCount);
+
+    GraphicRecorder::Reset();
+}
+
+MX_TEST(UniformSlotDrawLoopBenchmark)
+{
+    // null backend performs the same name lookup as OpenGL one, so difference between loops is the cost of strings in draw loop
+    constexpr size_t drawCount = 1000000;
+    Shader shader;
+    shader.LoadFromString("vertex", "fragment");
+    Matrix4x4 viewProjection = MakePerspectiveMatrix(Radians(60.0f), 16.0f / 9.0f, 0.1f, 1000.0f);
+
+    GraphicRecorder::Reset();
+    {
+        EngineTests::ScopedBenchmark benchmark("Shader uniforms by name", drawCount);
+        for (size_t i = 0; i < drawCount; i++)
+            SetDrawUniformsByName(shader, viewProjection, (float)i);
+    }
+    size_t nameLookups = GraphicRecorder::GetFrameStatistics().UniformNameLookups;
+
+    GraphicRecorder::Reset();
+    {
+        EngineTests::ScopedBenchmark benchmark("Shader uniforms by slot", drawCount);
+        for (size_t i = 0; i < drawCount; i++)
+            SetDrawUniformsBySlot(shader, viewProjection, (float)i);
+    }
+    size_t slotLookups = GraphicRecorder::GetFrameStatistics().UniformNameLookups;
+
+    // slots are resolved only during first draw, later draws do not touch strings at all
+    size_t uniformCount = 3 + MaterialMapSlots.size();
+    MX_CHECK(nameLookups == drawCount * uniformCount);
+    MX_CHECK(slotLookups == uniformCount);
+    std::cout << "    name lookups: " << nameLookups << " by name, " << slotLookups << " by slot" << std::endl;
+    GraphicRecorder::Reset();
+}
+#endif
@@ -0,0 +1,191 @@
+#include "TestUtilities.h"
+
+#include "Core/Application/UpdateScheduler.h"
+
+#include <atomic>
+
+using namespace MxEngine;
+
+namespace
+{
+    // types which are only used in read/write declarations of test components
+    struct SharedInput { };
+    struct SharedOutput { };
+
+    struct ParallelReaderA
+    {
+        MAKE_COMPONENT(ParallelReaderA);
+    public:
+        using UpdateReads = ComponentTypes<SharedInput>;
+        using UpdateWrites = ComponentTypes<>;
+        constexpr static UpdatePolicy UpdateMode = UpdatePolicy::PARALLEL_FOR_EACH;
+
+        inline static std::atomic<size_t> UpdatedCount{ 0 };
+        size_t Updates = 0;
+
+        void OnUpdate(float) { this->Updates++; UpdatedCount.fetch_add(1, std::memory_order_relaxed); }
+    };
+
+    struct ParallelReaderB
+    {
+        MAKE_COMPONENT(ParallelReaderB);
+    public:
+        using UpdateReads = ComponentTypes<SharedInput>;
+        using UpdateWrites = ComponentTypes<SharedOutput>;
+        constexpr static UpdatePolicy UpdateMode = UpdatePolicy::ANY_THREAD;
+
+        inline static std::atomic<size_t> UpdatedCount{ 0 };
+
+        void OnUpdate(float) { UpdatedCount.fetch_add(1, std::memory_order_relaxed); }
+    };
+
+    struct InputWriter
+    {
+        MAKE_COMPONENT(InputWriter);
+    public:
+        using UpdateReads = ComponentTypes<>;
+        using UpdateWrites = ComponentTypes<SharedInput>;
+        constexpr static UpdatePolicy UpdateMode = UpdatePolicy::MAIN_THREAD;
+
+        void OnUpdate(float) { }
+    };
+
+    struct OutputReader
+    {
+        MAKE_COMPONENT(OutputReader);
+    public:
+        using UpdateReads = ComponentTypes<SharedOutput, ParallelReaderA>;
+        using UpdateWrites = ComponentTypes<>;
+        constexpr static UpdatePolicy UpdateMode = UpdatePolicy::ANY_THREAD;
+
+        void OnUpdate(float) { }
+    };
+
+    // component without declarations, which must be isolated from all others
+    struct UndeclaredUpdate
+    {
+        MAKE_COMPONENT(UndeclaredUpdate);
+    public:
+        void OnUpdate(float) { }
+    };
+
+    struct LateRegistered
+    {
+        MAKE_COMPONENT(LateRegistered);
+    public:
+        inline static size_t UpdatedCount = 0;
+
+        void OnUpdate(float) { UpdatedCount++; }
+    };
+
+    struct RegisteringUpdate
+    {
+        MAKE_COMPONENT(RegisteringUpdate);
+    public:
+        inline static UpdateScheduler* Scheduler = nullptr;
+
+        // user code may register new updates while scheduler is running
+        void OnUpdate(float) { Scheduler->Register<LateRegistered>(); }
+    };
+}
+
+MX_TEST(UpdateSchedulerLevels)
+{
+    UpdateScheduler scheduler;
+    scheduler.Register<ParallelReaderA>();  // 0
+    scheduler.Register<ParallelReaderB>();  // 1: shares only reads with 0
+    scheduler.Register<InputWriter>();      // 2: writes what 0 and 1 read
+    scheduler.Register<OutputReader>();     // 3: reads what 1 writes and component 0 itself
+    scheduler.Register<UndeclaredUpdate>(); // 4: barrier
+    scheduler.Register<ParallelReaderA>();  // 5: placed after barrier
+
+    const auto& levels = scheduler.GetLevels();
+    MX_CHECK(scheduler.GetUpdateCount() == 6);
+    MX_CHECK(levels.size() == 4);
+    if (levels.size() != 4) return;
+
+    MX_CHECK(levels[0].size() == 2 && levels[0][0] == 0 && levels[0][1] == 1);
+    // write-read and read-write conflicts place both updates one level after their dependencies
+    MX_CHECK(levels[1].size() == 2 && levels[1][0] == 2 && levels[1][1] == 3);
+    MX_CHECK(levels[2].size() == 1 && levels[2][0] == 4);
+    MX_CHECK(levels[3].size() == 1 && levels[3][0] == 5);
+}
+
+MX_TEST(UpdateSchedulerConflicts)
+{
+    // two updates of the same component always conflict, as each component writes itself
+    UpdateScheduler sameType;
+    sameType.Register<ParallelReaderB>();
+    sameType.Register<ParallelReaderB>();
+    MX_CHECK(sameType.GetLevels().size() == 2);
+
+    // reads of the same type never conflict
+    UpdateScheduler readers;
+    readers.Register<ParallelReaderA>();
+    readers.Register<ParallelReaderB>();
+    MX_CHECK(readers.GetLevels().size() == 1);
+
+    // barrier conflicts with updates registered both before and after it
+    UpdateScheduler barrier;
+    barrier.Register<InputWriter>();
+    barrier.Register<UndeclaredUpdate>();
+    barrier.Register<OutputReader>();
+    MX_CHECK(barrier.GetLevels().size() == 3);
+}
+
+MX_TEST(UpdateSchedulerParallelInvoke)
+{
+    constexpr size_t componentCount = 10000;
+    MxVector<CResource<ParallelReaderA>> components;
+    for (size_t i = 0; i < componentCount; i++)
+        components.push_back(ComponentFactory::CreateComponent<ParallelReaderA>());
+    auto other = ComponentFactory::CreateComponent<ParallelReaderB>();
+
+    UpdateScheduler scheduler;
+    scheduler.Register<ParallelReaderA>();
+    scheduler.Register<ParallelReaderB>();
+    MX_CHECK(scheduler.GetLevels().size() == 1);
+
+    ParallelReaderA::UpdatedCount = 0;
+    ParallelReaderB::UpdatedCount = 0;
+    {
+        EngineTests::ScopedBenchmark benchmark("parallel update of 10k components", componentCount);
+        scheduler.Invoke(0.016f);
+    }
+    MX_CHECK(ParallelReaderA::UpdatedCount.load() == componentCount);
+    MX_CHECK(ParallelReaderB::UpdatedCount.load() == 1);
+
+    // every component is updated exactly once, even if its chunk is executed by another worker
+    bool isUpdatedOnce = true;
+    for (auto& component : components)
+        isUpdatedOnce &= component->Updates == 1;
+    MX_CHECK(isUpdatedOnce);
+
+    for (auto& component : components)
+        ComponentFactory::Destroy(component);
+    ComponentFactory::Destroy(other);
+}
+
+MX_TEST(UpdateSchedulerRegisterDuringInvoke)
+{
+    auto registering = ComponentFactory::CreateComponent<RegisteringUpdate>();
+    auto late = ComponentFactory::CreateComponent<LateRegistered>();
+
+    UpdateScheduler scheduler;
+    RegisteringUpdate::Scheduler = &scheduler;
+    LateRegistered::UpdatedCount = 0;
+    scheduler.Register<RegisteringUpdate>();
+
+    // update registered during frame is deferred, so it runs starting from next frame
+    scheduler.Invoke(0.016f);
+    MX_CHECK(scheduler.GetUpdateCount() == 2);
+    MX_CHECK(LateRegistered::UpdatedCount == 0);
+
+    scheduler.Invoke(0.016f);
+    MX_CHECK(LateRegistered::UpdatedCount == 1);
+    MX_CHECK(scheduler.GetUpdateCount() == 3);
+
+    RegisteringUpdate::Scheduler = nullptr;
+    ComponentFactory::Destroy(registering);
+    ComponentFactory::Destroy(late);
+}
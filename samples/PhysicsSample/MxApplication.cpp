@@ -145,7 +145,7 @@ namespace PhysicsSample
             rb->MakeTrigger();
             rb->SetCollisionCallback([](MxObject& self, MxObject& other)
             {
-                Logger::Log(VerbosityType::INFO, self.Name, "collided with: " + other.Name);
+                Logger::Log(VerbosityType::INFO, self.GetDisplayName(), "collided with: " + other.GetDisplayName());
                 if (other.Name == "Cube Instance")
                     MxObject::Destroy(other);
             });
@@ -220,7 +220,7 @@ namespace PhysicsSample
                 if (lookingAt.IsValid())
                 {
                     ImGui::Text("distance to object: %f", distance);
-                    ImGui::Text("object name: %s", lookingAt->Name.c_str());
+                    ImGui::Text("object name: %s", lookingAt->GetDisplayName().c_str());
                 }
                 else
                 {
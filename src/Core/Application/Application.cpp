@@ -32,6 +32,7 @@
 // platform modules and api functions
 #include "Platform/GraphicAPI.h"
 #include "Platform/Modules/GraphicModule.h"
+#include "Platform/RenderStateCache.h"
 #include "Platform/AudioAPI.h"
 #include "Platform/Modules/AudioModule.h"
 #include "Platform/PhysicsAPI.h"
@@ -43,13 +44,20 @@
 
 // utilities
 #include "Utilities/FileSystem/FileManager.h"
+#include "Utilities/JobSystem/JobSystem.h"
 #include "Utilities/Json/Json.h"
 #include "Utilities/ImGui/Editors/ComponentEditor.h"
 #include "Utilities/Format/Format.h"
+#include "Core/Application/SceneIndex.h"
+#include "Core/Resources/GeometryArena.h"
 
 // components
 #include "Core/Components/Components.h"
 
+#if defined(MXENGINE_USE_NULLGRAPHICS)
+#include "Platform/Null/GraphicRecorder.h"
+#endif
+
 // editor
 #include "Core/Runtime/RuntimeEditor.h"
 
@@ -185,10 +193,7 @@ namespace MxEngine
 			// invoke all components waiting for updates
 			{
 				MAKE_SCOPE_PROFILER("Application::UpdateComponents");
-				for (const auto& callback : this->updateCallbacks)
-				{
-					callback(this->timeDelta);
-				}
+				this->updateScheduler.Invoke(this->timeDelta);
 			}
 
 			// invoke update event
@@ -201,6 +206,10 @@ namespace MxEngine
 				this->OnUpdate();
 			}
 		}
+
+		// world matrices are recomputed once per frame, after all systems changed local transforms
+		TransformHierarchy::Update();
+		SceneIndex::Update();
 	}
 
 	void Application::InvokePhysics()
@@ -313,15 +322,33 @@ namespace MxEngine
 			MAKE_SCOPE_TIMER("MxEngine::Application", "Application::Run()");
 			MXLOG_INFO("MxEngine::Application", "starting main loop...");
 
+			RenderStateCache::ResetStatistics();
+			#if defined(MXENGINE_USE_NULLGRAPHICS)
+			GraphicRecorder::Reset();
+			TimeStep headlessStart = Time::Current();
+			#endif
+
 			while (this->GetWindow().IsOpen()) //-V807
 			{
 				this->UpdateTimeDelta(frameEnd, secondEnd, frameCount);
 				this->InvokeUpdate();
 				this->DrawObjects();
 				this->GetWindow().PullEvents();
+				RenderStateCache::EndFrame();
+
+				#if defined(MXENGINE_USE_NULLGRAPHICS)
+				GraphicRecorder::EndFrame();
+				if (this->config.HeadlessFrameCount != 0 && GraphicRecorder::GetFrameCount() >= this->config.HeadlessFrameCount)
+					this->shouldClose = true;
+				#endif
+
 				if (this->shouldClose) break;
 			}
 
+			#if defined(MXENGINE_USE_NULLGRAPHICS)
+			this->LogHeadlessStatistics(Time::Current() - headlessStart);
+			#endif
+
 			// application exit
 			{
 				MAKE_SCOPE_PROFILER("Application::CloseApplication");
@@ -335,6 +362,28 @@ namespace MxEngine
 		}
 	}
 
+	void Application::LogHeadlessStatistics(TimeStep elapsedTime)
+	{
+		#if defined(MXENGINE_USE_NULLGRAPHICS)
+		size_t frames = GraphicRecorder::GetFrameCount();
+		if (frames == 0) return;
+		const auto& stats = GraphicRecorder::GetTotalStatistics();
+		auto perFrame = [frames](size_t value) { return float(value) / float(frames); };
+
+		MXLOG_INFO("MxEngine::Application", MxFormat("headless run finished: {} frames, {:.3f} ms per frame",
+			frames, elapsedTime * 1000.0f / float(frames)));
+		MXLOG_INFO("MxEngine::Application", MxFormat("per frame: {:.1f} draw calls, {:.1f} instances, {:.1f} shader binds, {:.1f} texture binds, {:.1f} vertex array binds",
+			perFrame(stats.DrawCalls), perFrame(stats.DrawnInstances), perFrame(stats.ShaderBinds), perFrame(stats.TextureBinds), perFrame(stats.VertexArrayBinds)));
+		MXLOG_INFO("MxEngine::Application", MxFormat("per frame: {:.1f} framebuffer binds, {:.1f} uniform updates, {:.1f} state changes, {:.1f} uploaded bytes",
+			perFrame(stats.FrameBufferBinds), perFrame(stats.UniformUpdates), perFrame(stats.StateChanges), perFrame(stats.BufferUploadBytes + stats.TextureUploadBytes)));
+		MXLOG_INFO("MxEngine::Application", MxFormat("per frame: {:.1f} uniform name lookups, {:.1f} buffer uploads",
+			perFrame(stats.UniformNameLookups), perFrame(stats.BufferUploads)));
+		const auto& stateStats = RenderStateCache::GetTotalStatistics();
+		MXLOG_INFO("MxEngine::Application", MxFormat("per frame: {:.1f} issued state calls, {:.1f} skipped state calls ({:.1f}% skipped)",
+			perFrame(stateStats.IssuedCalls), perFrame(stateStats.SkippedCalls), stateStats.GetSkippedPercentage()));
+		#endif
+	}
+
 	bool Application::IsRunning() const
 	{
 		return this->isRunning;
@@ -366,6 +415,7 @@ namespace MxEngine
 
 		Logger::Init();
 		FileManager::Init();
+		JobSystem::Init();
 		AudioModule::Init();
 		GraphicModule::Init();
 		PhysicsModule::Init();
@@ -376,14 +426,18 @@ namespace MxEngine
 		AudioFactory::Init();
 		PhysicsFactory::Init();
 		MxObject::Factory::Init();
+		TransformHierarchy::Init();
+		SceneIndex::Init();
 	}
 
 	Application::ModuleManager::~ModuleManager()
 	{
 		PhysicsModule::Destroy();
+		GeometryArena::Destroy(); // arena buffers must be deleted while graphic context is alive
 		GraphicModule::Destroy();
 		AudioFactory::DeInit(); // OpenAL is angry when buffers are not deleted
 		AudioModule::Destroy();
+		JobSystem::Destroy();
 
 		#if defined(MXENGINE_PROFILING_ENABLED)
 		Profiler::Finish();
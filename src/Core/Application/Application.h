@@ -34,6 +34,7 @@
 #include "Core/MxObject/MxObject.h"
 #include "Utilities/FileSystem/File.h"
 #include "Core/Config/Config.h"
+#include "Core/Application/UpdateScheduler.h"
 #include "Utilities/Profiler/Profiler.h"
 #include "Platform/Window/Window.h"
 
@@ -51,7 +52,6 @@ namespace MxEngine
 			~ModuleManager();
 		} manager;
 
-		using CallbackList = MxVector<std::function<void(TimeStep)>>;
 		using CollisionList = MxVector<std::pair<MxObject::Handle, MxObject::Handle>>;
 	private:
 		static inline Application* Current = nullptr;
@@ -59,7 +59,7 @@ namespace MxEngine
 		RenderAdaptor renderAdaptor;
 		EventDispatcherImpl<EventBase>* dispatcher;
 		RuntimeEditor* editor;
-		CallbackList updateCallbacks;
+		UpdateScheduler updateScheduler;
 		CollisionList collisions;
 		Config config;
 		TimeStep timeDelta = 0.0f;
@@ -77,6 +77,7 @@ namespace MxEngine
 		void InvokePhysics();
 		void InvokeCreate();
 		bool VerifyApplicationState();
+		void LogHeadlessStatistics(TimeStep elapsedTime);
 	protected:
 
 		Application();
@@ -118,14 +119,6 @@ namespace MxEngine
 	inline void Application::RegisterComponentUpdate()
 	{
 		static_assert(has_method_OnUpdate<T>::value, "object must contain OnUpdate(TimeDelta) method");
-		this->updateCallbacks.push_back([](TimeStep dt)
-		{
-			MAKE_SCOPE_PROFILER(typeid(T).name());
-			auto view = ComponentFactory::GetView<T>();
-			for (auto& component : view)
-			{
-				component.OnUpdate(dt);
-			}
-		});
+		this->updateScheduler.Register<T>();
 	}
 }
\ No newline at end of file
@@ -133,6 +133,16 @@ namespace MxEngine
         return FWD(GetShadowBlurIterations);
     }
 
+    void Rendering::SetSubmissionWorkerCount(size_t count)
+    {
+        FWD(SetSubmissionWorkerCount, count);
+    }
+
+    size_t Rendering::GetSubmissionWorkerCount()
+    {
+        return FWD(GetSubmissionWorkerCount);
+    }
+
     #define DRW Application::Get()->GetRenderAdaptor().DebugDrawer
 
     void Rendering::Draw(const Line& line, const Vector4& color)
@@ -0,0 +1,281 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "SceneIndex.h"
+#include "Core/Components/Rendering/MeshSource.h"
+#include "Core/Components/Instancing/InstanceFactory.h"
+#include "Core/Components/TransformHierarchy.h"
+#include "Utilities/Profiler/Profiler.h"
+#include "Utilities/Memory/Memory.h"
+
+namespace MxEngine
+{
+    struct SceneIndexData
+    {
+        struct Entry
+        {
+            AABBTree::ProxyId Proxy = AABBTree::InvalidProxy;
+            uint32_t LastSeenFrame = 0;
+            // versions of object, its transform and mesh which were used to compute world box
+            uint32_t ObjectGeneration = 0;
+            uint32_t LocalVersion = 0;
+            uint32_t WorldVersion = 0;
+            uint32_t MeshHandle = 0;
+            uint32_t MeshGeneration = 0;
+            uint32_t SubmeshVersion = 0;
+            AABB MeshBox;
+            AABB WorldBox;
+        };
+
+        AABBTree Tree;
+        // entries indexed by object native handle. Objects which are not indexed have invalid proxy
+        MxVector<Entry> Entries;
+        // per-object visibility stamps, indexed by object native handle. They allow to reset state without touching all objects
+        MxVector<uint32_t> VisibleFrames;
+        size_t IndexedCount = 0;
+        uint32_t Frame = 0;
+        uint32_t VisibilityFrame = 0;
+    };
+
+    static uint32_t GetSubmeshVersion(const Mesh& mesh)
+    {
+        uint32_t version = (uint32_t)mesh.Submeshes.size();
+        for (const auto& submesh : mesh.Submeshes)
+            version = version * 31 + submesh.BorrowTransform().GetUnchecked()->GetVersion();
+        return version;
+    }
+
+    static AABB ComputeMeshBoundingBox(const Mesh& mesh)
+    {
+        // submeshes can be moved relative to mesh, so box is built from transformed submesh boxes
+        AABB result{ MakeVector3(0.0f), MakeVector3(0.0f) };
+        for (size_t i = 0; i < mesh.Submeshes.size(); i++)
+        {
+            const auto& submesh = mesh.Submeshes[i];
+            auto box = submesh.GetBoundingBox() * submesh.BorrowTransform().GetUnchecked()->GetMatrix();
+            if (i == 0)
+            {
+                result = box;
+            }
+            else
+            {
+                result.Min = VectorMin(result.Min, box.Min);
+                result.Max = VectorMax(result.Max, box.Max);
+            }
+        }
+        return result;
+    }
+
+    void SceneIndex::Init()
+    {
+        data = Alloc<SceneIndexData>();
+    }
+
+    void SceneIndex::Destroy()
+    {
+        Free(data);
+        data = nullptr;
+    }
+
+    SceneIndexData* SceneIndex::GetImpl()
+    {
+        return data;
+    }
+
+    void SceneIndex::Clone(SceneIndexData* other)
+    {
+        data = other;
+    }
+
+    void SceneIndex::Update()
+    {
+        MAKE_SCOPE_PROFILER("SceneIndex::Update()");
+
+        data->Frame++;
+        size_t objectCapacity = MxObject::Factory::Get<MxObject>().Capacity();
+        data->Entries.resize(objectCapacity);
+        data->VisibleFrames.resize(objectCapacity, 0);
+
+        // only versions are compared for each object, world box is recomputed and tree is touched only when object transform or mesh changes
+        // this loop visits every object with MeshSource each frame, as transforms do not notify about their changes
+        size_t seenCount = 0;
+        for (auto entry : ComponentFactory::Query<MeshSource>())
+        {
+            const auto& meshSource = entry.Get<MeshSource>();
+            if (!meshSource.Mesh.IsValid()) continue;
+            auto& object = MxObject::GetByComponent(meshSource);
+            if (object.HasComponent<InstanceFactory>()) continue;
+
+            auto handle = object.GetNativeHandle();
+            auto& indexed = data->Entries[handle];
+            const auto& mesh = *meshSource.Mesh.GetUnchecked();
+            uint32_t objectGeneration = MxObject::Factory::Get<MxObject>().GetGeneration(handle);
+            uint32_t localVersion = object.Transform.GetVersion();
+            uint32_t worldVersion = TransformHierarchy::GetWorldVersion(object);
+            uint32_t meshHandle = (uint32_t)meshSource.Mesh.GetHandle();
+            uint32_t meshGeneration = meshSource.Mesh.GetGeneration();
+            uint32_t submeshVersion = GetSubmeshVersion(mesh);
+
+            bool isNew = indexed.Proxy == AABBTree::InvalidProxy;
+            bool isMeshChanged = indexed.MeshHandle != meshHandle || indexed.MeshGeneration != meshGeneration ||
+                indexed.SubmeshVersion != submeshVersion || indexed.MeshBox != mesh.BoundingBox;
+            bool isMoved = indexed.ObjectGeneration != objectGeneration || indexed.LocalVersion != localVersion || indexed.WorldVersion != worldVersion;
+            if (isNew || isMeshChanged || isMoved)
+            {
+                indexed.ObjectGeneration = objectGeneration;
+                indexed.LocalVersion = localVersion;
+                indexed.WorldVersion = worldVersion;
+                indexed.MeshHandle = meshHandle;
+                indexed.MeshGeneration = meshGeneration;
+                indexed.SubmeshVersion = submeshVersion;
+                indexed.MeshBox = mesh.BoundingBox;
+                indexed.WorldBox = ComputeMeshBoundingBox(mesh) * object.GetWorldMatrix();
+
+                if (isNew)
+                {
+                    indexed.Proxy = data->Tree.Insert(indexed.WorldBox, handle);
+                    data->IndexedCount++;
+                }
+                else
+                {
+                    data->Tree.Move(indexed.Proxy, indexed.WorldBox);
+                }
+            }
+            indexed.LastSeenFrame = data->Frame;
+            seenCount++;
+        }
+
+        // remove objects which were destroyed or lost their MeshSource. All indexed objects are seen in most frames, so entries are not scanned
+        if (seenCount != data->IndexedCount)
+        {
+            for (auto& indexed : data->Entries)
+            {
+                if (indexed.Proxy != AABBTree::InvalidProxy && indexed.LastSeenFrame != data->Frame)
+                {
+                    data->Tree.Remove(indexed.Proxy);
+                    indexed = SceneIndexData::Entry{ };
+                    data->IndexedCount--;
+                }
+            }
+        }
+    }
+
+    void SceneIndex::ComputeVisibility(const FrustrumCuller* cullers, size_t count)
+    {
+        MAKE_SCOPE_PROFILER("SceneIndex::ComputeVisibility()");
+
+        data->VisibilityFrame = data->Frame;
+        for (size_t i = 0; i < count; i++)
+        {
+            data->Tree.QueryFrustrum(cullers[i], [](AABBTree::UserData object, bool)
+            {
+                data->VisibleFrames[object] = data->VisibilityFrame;
+                return true;
+            });
+        }
+    }
+
+    bool SceneIndex::IsVisible(MxObject::EngineHandle object)
+    {
+        if (object >= data->Entries.size() || data->Entries[object].Proxy == AABBTree::InvalidProxy) return true;
+        return data->VisibilityFrame == data->Frame && data->VisibleFrames[object] == data->VisibilityFrame;
+    }
+
+    MxVector<MxObject::Handle> SceneIndex::QueryAABB(const AABB& box)
+    {
+        MxVector<MxObject::Handle> result;
+        data->Tree.QueryAABB(box, [&result, &box](AABBTree::UserData object)
+        {
+            if (AABBTree::Overlaps(data->Entries[object].WorldBox, box))
+                result.push_back(MxObject::GetByHandle(object));
+            return true;
+        });
+        return result;
+    }
+
+    MxVector<MxObject::Handle> SceneIndex::QuerySphere(const BoundingSphere& sphere)
+    {
+        MxVector<MxObject::Handle> result;
+        data->Tree.QuerySphere(sphere, [&result, &sphere](AABBTree::UserData object)
+        {
+            if (AABBTree::DistanceSquared(data->Entries[object].WorldBox, sphere.Center) <= sphere.Radius * sphere.Radius)
+                result.push_back(MxObject::GetByHandle(object));
+            return true;
+        });
+        return result;
+    }
+
+    MxVector<MxObject::Handle> SceneIndex::QueryNearest(const Vector3& point, size_t count)
+    {
+        MxVector<AABBTree::UserData> objects;
+        data->Tree.QueryNearest(point, count, objects);
+
+        MxVector<MxObject::Handle> result;
+        result.reserve(objects.size());
+        for (auto object : objects)
+            result.push_back(MxObject::GetByHandle(object));
+        return result;
+    }
+
+    MxObject::Handle SceneIndex::RayCast(const Vector3& from, const Vector3& to)
+    {
+        float rayFraction = 0.0f;
+        return SceneIndex::RayCast(from, to, rayFraction);
+    }
+
+    MxObject::Handle SceneIndex::RayCast(const Vector3& from, const Vector3& to, float& rayFraction)
+    {
+        auto direction = to - from;
+        MxObject::EngineHandle closest = std::numeric_limits<MxObject::EngineHandle>::max();
+        rayFraction = 1.0f;
+
+        data->Tree.RayCast(from, to, [&](AABBTree::UserData object, float)
+        {
+            // tree reports hits of fat boxes, so exact box is tested before accepting hit
+            float fraction = AABBTree::IntersectRay(data->Entries[object].WorldBox, from, direction, rayFraction);
+            if (fraction < 0.0f) return rayFraction;
+
+            closest = object;
+            rayFraction = fraction;
+            return fraction;
+        });
+
+        if (closest == std::numeric_limits<MxObject::EngineHandle>::max()) return MxObject::Handle{ };
+        return MxObject::GetByHandle(closest);
+    }
+
+    size_t SceneIndex::GetObjectCount()
+    {
+        return data->Tree.GetLeafCount();
+    }
+
+    const AABBTree& SceneIndex::GetTree()
+    {
+        return data->Tree;
+    }
+}
@@ -0,0 +1,81 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include "Core/MxObject/MxObject.h"
+#include "Core/BoundingObjects/AABBTree.h"
+
+namespace MxEngine
+{
+    struct SceneIndexData;
+
+    /*!
+    scene index is a dynamic AABB tree of all objects with MeshSource component. It is updated once per frame from object world matrices
+    and is used by renderer for hierarchical frustrum culling. Objects with InstanceFactory are not indexed, as their bounds are not known
+    queries are performed against exact world bounding boxes of objects, except nearest query, which uses enlarged tree boxes
+    */
+    class SceneIndex
+    {
+        inline static SceneIndexData* data = nullptr;
+    public:
+        static void Init();
+        static void Destroy();
+        static SceneIndexData* GetImpl();
+        static void Clone(SceneIndexData* other);
+
+        /*!
+        inserts new objects into tree, moves changed ones and removes objects which lost their MeshSource. Called once per frame by Application
+        objects are considered changed when version of their transform, world matrix, mesh or submesh transforms differs from indexed one
+        changes are detected by polling, so cost is O(N) in number of objects with MeshSource even if nothing moved: each object
+        costs a few version comparisons (plus one per submesh), and only changed objects touch the tree
+        */
+        static void Update();
+        /*!
+        marks objects which are inside of any of provided frustrums as visible. Result is valid until next call
+        \param cullers array of frustrum cullers
+        \param count number of cullers in array
+        */
+        static void ComputeVisibility(const FrustrumCuller* cullers, size_t count);
+        /*!
+        checks if object was found visible by last ComputeVisibility() call
+        \param object native handle of object
+        \returns false if object is indexed and outside of all frustrums, true either
+        */
+        static bool IsVisible(MxObject::EngineHandle object);
+
+        static MxVector<MxObject::Handle> QueryAABB(const AABB& box);
+        static MxVector<MxObject::Handle> QuerySphere(const BoundingSphere& sphere);
+        static MxVector<MxObject::Handle> QueryNearest(const Vector3& point, size_t count);
+        static MxObject::Handle RayCast(const Vector3& from, const Vector3& to);
+        static MxObject::Handle RayCast(const Vector3& from, const Vector3& to, float& rayFraction);
+
+        static size_t GetObjectCount();
+        static const AABBTree& GetTree();
+    };
+}
@@ -0,0 +1,127 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "UpdateScheduler.h"
+
+#include <algorithm>
+
+namespace MxEngine
+{
+	bool UpdateScheduler::HasIntersection(const MxVector<TypeKey>& v1, const MxVector<TypeKey>& v2)
+	{
+		for (TypeKey key : v1)
+		{
+			if (std::find(v2.begin(), v2.end(), key) != v2.end())
+				return true;
+		}
+		return false;
+	}
+
+	bool UpdateScheduler::HasConflict(const UpdateEntry& e1, const UpdateEntry& e2)
+	{
+		if (e1.IsBarrier || e2.IsBarrier) return true;
+
+		return HasIntersection(e1.Writes, e2.Writes) ||
+			   HasIntersection(e1.Writes, e2.Reads)  ||
+			   HasIntersection(e1.Reads,  e2.Writes);
+	}
+
+	void UpdateScheduler::RebuildLevels()
+	{
+		// each update is placed one level after the latest conflicting update registered before it
+		MxVector<size_t> entryLevels(this->entries.size(), 0);
+		size_t levelCount = 0;
+		for (size_t i = 0; i < this->entries.size(); i++)
+		{
+			for (size_t j = 0; j < i; j++)
+			{
+				if (HasConflict(this->entries[j], this->entries[i]))
+					entryLevels[i] = Max(entryLevels[i], entryLevels[j] + 1);
+			}
+			levelCount = Max(levelCount, entryLevels[i] + 1);
+		}
+
+		this->levels.clear();
+		this->levels.resize(levelCount);
+		for (size_t i = 0; i < this->entries.size(); i++)
+		{
+			this->levels[entryLevels[i]].push_back(i);
+		}
+		this->levelsInvalidated = false;
+	}
+
+	void UpdateScheduler::Invoke(TimeStep dt)
+	{
+		if (this->levelsInvalidated) this->RebuildLevels();
+
+		// jobs reference entries directly, so table must not change until all of them are finished
+		this->isInvoking = true;
+		for (const auto& level : this->levels)
+		{
+			JobCounter counter;
+			for (size_t index : level)
+			{
+				const auto& entry = this->entries[index];
+				if (entry.Policy != UpdatePolicy::MAIN_THREAD)
+					JobSystem::Schedule([&entry, dt]() { entry.Callback(dt); }, &counter);
+			}
+			for (size_t index : level)
+			{
+				const auto& entry = this->entries[index];
+				if (entry.Policy == UpdatePolicy::MAIN_THREAD)
+					entry.Callback(dt);
+			}
+			JobSystem::Wait(counter);
+		}
+		this->isInvoking = false;
+
+		if (!this->pendingEntries.empty())
+		{
+			for (auto& entry : this->pendingEntries)
+				this->entries.push_back(std::move(entry));
+			this->pendingEntries.clear();
+			this->levelsInvalidated = true;
+		}
+	}
+
+	const MxVector<MxVector<size_t>>& UpdateScheduler::GetLevels()
+	{
+		if (this->levelsInvalidated) this->RebuildLevels();
+		return this->levels;
+	}
+
+	size_t UpdateScheduler::GetLevelCount() const
+	{
+		return this->levels.size();
+	}
+
+	size_t UpdateScheduler::GetUpdateCount() const
+	{
+		return this->entries.size();
+	}
+}
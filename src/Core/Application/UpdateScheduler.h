@@ -0,0 +1,154 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <functional>
+#include <typeinfo>
+
+#include "Utilities/ECS/Component.h"
+#include "Utilities/JobSystem/JobSystem.h"
+#include "Utilities/Profiler/Profiler.h"
+#include "Utilities/Time/Time.h"
+#include "Utilities/STL/MxVector.h"
+
+namespace MxEngine
+{
+	template<typename T, typename = void>
+	struct has_update_declaration : std::false_type { };
+
+	template<typename T>
+	struct has_update_declaration<T, std::void_t<typename T::UpdateReads, typename T::UpdateWrites, decltype(T::UpdateMode)>> : std::true_type { };
+
+	/*!
+	update scheduler stores component update callbacks registered by Application and invokes them each frame using JobSystem
+	callbacks are grouped into levels using read/write declarations of components. Callbacks inside one level do not conflict and run concurrently,
+	levels themselves are executed in registration order. Components without declarations act as a barrier and form a separate level.
+	Updates registered while callbacks are invoked are deferred until the end of current frame, so callbacks never observe the table reallocated
+	*/
+	class UpdateScheduler
+	{
+	public:
+		using TypeKey = size_t;
+		using UpdateCallback = std::function<void(TimeStep)>;
+
+		/*!
+		number of components processed by one job when update policy is PARALLEL_FOR_EACH
+		*/
+		constexpr static size_t ParallelChunkSize = 256;
+	private:
+		struct UpdateEntry
+		{
+			UpdateCallback Callback;
+			MxVector<TypeKey> Reads;
+			MxVector<TypeKey> Writes;
+			UpdatePolicy Policy = UpdatePolicy::MAIN_THREAD;
+			bool IsBarrier = true;
+		};
+
+		MxVector<UpdateEntry> entries;
+		MxVector<UpdateEntry> pendingEntries;
+		MxVector<MxVector<size_t>> levels;
+		bool levelsInvalidated = false;
+		bool isInvoking = false;
+
+		template<typename... Ts>
+		static MxVector<TypeKey> GetTypeKeys(ComponentTypes<Ts...>)
+		{
+			return MxVector<TypeKey>{ typeid(Ts).hash_code()... };
+		}
+
+		template<typename T>
+		static UpdateCallback MakeCallback(UpdatePolicy policy)
+		{
+			if (policy == UpdatePolicy::PARALLEL_FOR_EACH)
+			{
+				return [](TimeStep dt)
+				{
+					MAKE_SCOPE_PROFILER(typeid(T).name());
+					auto& pool = ComponentFactory::Get<T>();
+					JobSystem::ParallelFor(pool.Capacity(), ParallelChunkSize, [&pool, dt](size_t begin, size_t end)
+					{
+						for (size_t i = begin; i < end; i++)
+						{
+							if (pool.IsAllocated(i)) pool[i].value.OnUpdate(dt);
+						}
+					});
+				};
+			}
+			return [](TimeStep dt)
+			{
+				MAKE_SCOPE_PROFILER(typeid(T).name());
+				auto view = ComponentFactory::GetView<T>();
+				for (auto& component : view)
+				{
+					component.OnUpdate(dt);
+				}
+			};
+		}
+
+		static bool HasIntersection(const MxVector<TypeKey>& v1, const MxVector<TypeKey>& v2);
+		static bool HasConflict(const UpdateEntry& e1, const UpdateEntry& e2);
+		void RebuildLevels();
+	public:
+		template<typename T>
+		void Register()
+		{
+			UpdateEntry entry;
+			if constexpr (has_update_declaration<T>::value)
+			{
+				entry.Reads = GetTypeKeys(typename T::UpdateReads{ });
+				entry.Writes = GetTypeKeys(typename T::UpdateWrites{ });
+				entry.Writes.push_back(typeid(T).hash_code());
+				entry.Policy = T::UpdateMode;
+				entry.IsBarrier = false;
+			}
+			entry.Callback = MakeCallback<T>(entry.Policy);
+
+			// make sure component pool exists before it is accessed from worker threads
+			(void)ComponentFactory::Get<T>();
+
+			if (this->isInvoking)
+			{
+				this->pendingEntries.push_back(std::move(entry));
+				return;
+			}
+			this->entries.push_back(std::move(entry));
+			this->levelsInvalidated = true;
+		}
+
+		void Invoke(TimeStep dt);
+		/*!
+		gets update levels, rebuilding them if new updates were registered
+		\returns indices of registered updates (in registration order) grouped by level
+		*/
+		const MxVector<MxVector<size_t>>& GetLevels();
+		size_t GetLevelCount() const;
+		size_t GetUpdateCount() const;
+	};
+}
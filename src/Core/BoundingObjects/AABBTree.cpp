@@ -0,0 +1,528 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "AABBTree.h"
+
+#include <queue>
+#include <vector>
+#include <functional>
+
+namespace MxEngine
+{
+    static AABB Union(const AABB& box1, const AABB& box2)
+    {
+        return AABB{ VectorMin(box1.Min, box2.Min), VectorMax(box1.Max, box2.Max) };
+    }
+
+    static float SurfaceArea(const AABB& box)
+    {
+        auto length = box.Length();
+        return 2.0f * (length.x * length.y + length.y * length.z + length.z * length.x);
+    }
+
+    static bool Contains(const AABB& outer, const AABB& inner)
+    {
+        return outer.Min.x <= inner.Min.x && outer.Min.y <= inner.Min.y && outer.Min.z <= inner.Min.z &&
+               outer.Max.x >= inner.Max.x && outer.Max.y >= inner.Max.y && outer.Max.z >= inner.Max.z;
+    }
+
+    bool AABBTree::Overlaps(const AABB& box1, const AABB& box2)
+    {
+        return box1.Min.x <= box2.Max.x && box1.Min.y <= box2.Max.y && box1.Min.z <= box2.Max.z &&
+               box1.Max.x >= box2.Min.x && box1.Max.y >= box2.Min.y && box1.Max.z >= box2.Min.z;
+    }
+
+    float AABBTree::DistanceSquared(const AABB& box, const Vector3& point)
+    {
+        auto delta = VectorMax(VectorMax(box.Min - point, point - box.Max), MakeVector3(0.0f));
+        return Dot(delta, delta);
+    }
+
+    float AABBTree::IntersectRay(const AABB& box, const Vector3& from, const Vector3& direction, float maxFraction)
+    {
+        float tmin = 0.0f;
+        float tmax = maxFraction;
+        for (int axis = 0; axis < 3; axis++)
+        {
+            if (std::abs(direction[axis]) < std::numeric_limits<float>::epsilon())
+            {
+                if (from[axis] < box.Min[axis] || from[axis] > box.Max[axis]) return -1.0f;
+                continue;
+            }
+            float inverse = 1.0f / direction[axis];
+            float t1 = (box.Min[axis] - from[axis]) * inverse;
+            float t2 = (box.Max[axis] - from[axis]) * inverse;
+            if (t1 > t2) std::swap(t1, t2);
+            tmin = Max(tmin, t1);
+            tmax = Min(tmax, t2);
+            if (tmin > tmax) return -1.0f;
+        }
+        return tmin;
+    }
+
+    AABBTree::ProxyId AABBTree::AllocateNode()
+    {
+        ProxyId node = this->freeList;
+        if (node != InvalidProxy)
+        {
+            this->freeList = this->nodes[node].Parent;
+            this->nodes[node] = Node{ };
+        }
+        else
+        {
+            node = (ProxyId)this->nodes.size();
+            this->nodes.emplace_back();
+        }
+        this->nodes[node].Height = 0;
+        return node;
+    }
+
+    void AABBTree::FreeNode(ProxyId node)
+    {
+        this->nodes[node].Parent = this->freeList;
+        this->nodes[node].Height = -1;
+        this->freeList = node;
+    }
+
+    AABBTree::ProxyId AABBTree::Insert(const AABB& box, UserData data)
+    {
+        ProxyId proxy = this->AllocateNode();
+        auto& node = this->nodes[proxy];
+        node.Box = AABB{ box.Min - MakeVector3(this->Margin), box.Max + MakeVector3(this->Margin) };
+        node.Data = data;
+
+        this->InsertLeaf(proxy);
+        this->leafCount++;
+        return proxy;
+    }
+
+    void AABBTree::Remove(ProxyId proxy)
+    {
+        MX_ASSERT(proxy < this->nodes.size() && this->nodes[proxy].IsLeaf());
+        this->RemoveLeaf(proxy);
+        this->FreeNode(proxy);
+        this->leafCount--;
+    }
+
+    bool AABBTree::Move(ProxyId proxy, const AABB& box)
+    {
+        MX_ASSERT(proxy < this->nodes.size() && this->nodes[proxy].IsLeaf());
+        if (Contains(this->nodes[proxy].Box, box)) return false;
+
+        this->RemoveLeaf(proxy);
+        this->nodes[proxy].Box = AABB{ box.Min - MakeVector3(this->Margin), box.Max + MakeVector3(this->Margin) };
+        this->InsertLeaf(proxy);
+        return true;
+    }
+
+    void AABBTree::Clear()
+    {
+        this->nodes.clear();
+        this->root = InvalidProxy;
+        this->freeList = InvalidProxy;
+        this->leafCount = 0;
+    }
+
+    void AABBTree::InsertLeaf(ProxyId leaf)
+    {
+        if (this->root == InvalidProxy)
+        {
+            this->root = leaf;
+            this->nodes[leaf].Parent = InvalidProxy;
+            return;
+        }
+
+        // find best sibling using surface area heuristic: cost of new parent node plus increase of area of all ancestors
+        AABB leafBox = this->nodes[leaf].Box;
+        ProxyId index = this->root;
+        while (!this->nodes[index].IsLeaf())
+        {
+            const auto& node = this->nodes[index];
+            float area = SurfaceArea(node.Box);
+            float combinedArea = SurfaceArea(Union(node.Box, leafBox));
+
+            float cost = 2.0f * combinedArea;
+            float inheritanceCost = 2.0f * (combinedArea - area);
+
+            auto descendCost = [this, &leafBox, inheritanceCost](ProxyId child)
+            {
+                const auto& childNode = this->nodes[child];
+                float unionArea = SurfaceArea(Union(childNode.Box, leafBox));
+                return (childNode.IsLeaf() ? unionArea : unionArea - SurfaceArea(childNode.Box)) + inheritanceCost;
+            };
+            float cost1 = descendCost(node.Child1);
+            float cost2 = descendCost(node.Child2);
+
+            if (cost < cost1 && cost < cost2) break;
+            index = cost1 < cost2 ? node.Child1 : node.Child2;
+        }
+
+        ProxyId sibling = index;
+        ProxyId oldParent = this->nodes[sibling].Parent;
+        ProxyId newParent = this->AllocateNode();
+        this->nodes[newParent].Parent = oldParent;
+        this->nodes[newParent].Box = Union(leafBox, this->nodes[sibling].Box);
+        this->nodes[newParent].Height = this->nodes[sibling].Height + 1;
+        this->nodes[newParent].Child1 = sibling;
+        this->nodes[newParent].Child2 = leaf;
+        this->nodes[sibling].Parent = newParent;
+        this->nodes[leaf].Parent = newParent;
+
+        if (oldParent != InvalidProxy)
+        {
+            if (this->nodes[oldParent].Child1 == sibling)
+                this->nodes[oldParent].Child1 = newParent;
+            else
+                this->nodes[oldParent].Child2 = newParent;
+        }
+        else
+        {
+            this->root = newParent;
+        }
+
+        // refit ancestors and restore balance
+        for (index = this->nodes[leaf].Parent; index != InvalidProxy; index = this->nodes[index].Parent)
+        {
+            index = this->Balance(index);
+            auto& node = this->nodes[index];
+            node.Height = 1 + Max(this->nodes[node.Child1].Height, this->nodes[node.Child2].Height);
+            node.Box = Union(this->nodes[node.Child1].Box, this->nodes[node.Child2].Box);
+        }
+    }
+
+    void AABBTree::RemoveLeaf(ProxyId leaf)
+    {
+        if (leaf == this->root)
+        {
+            this->root = InvalidProxy;
+            return;
+        }
+
+        ProxyId parent = this->nodes[leaf].Parent;
+        ProxyId grandParent = this->nodes[parent].Parent;
+        ProxyId sibling = this->nodes[parent].Child1 == leaf ? this->nodes[parent].Child2 : this->nodes[parent].Child1;
+
+        if (grandParent == InvalidProxy)
+        {
+            this->root = sibling;
+            this->nodes[sibling].Parent = InvalidProxy;
+            this->FreeNode(parent);
+            return;
+        }
+
+        // destroy parent and connect sibling to grand parent
+        if (this->nodes[grandParent].Child1 == parent)
+            this->nodes[grandParent].Child1 = sibling;
+        else
+            this->nodes[grandParent].Child2 = sibling;
+        this->nodes[sibling].Parent = grandParent;
+        this->FreeNode(parent);
+
+        for (ProxyId index = grandParent; index != InvalidProxy; index = this->nodes[index].Parent)
+        {
+            index = this->Balance(index);
+            auto& node = this->nodes[index];
+            node.Box = Union(this->nodes[node.Child1].Box, this->nodes[node.Child2].Box);
+            node.Height = 1 + Max(this->nodes[node.Child1].Height, this->nodes[node.Child2].Height);
+        }
+    }
+
+    // performs left or right rotation if node A is imbalanced. Returns new root of subtree
+    AABBTree::ProxyId AABBTree::Balance(ProxyId iA)
+    {
+        auto& A = this->nodes[iA];
+        if (A.IsLeaf() || A.Height < 2) return iA;
+
+        ProxyId iB = A.Child1;
+        ProxyId iC = A.Child2;
+        auto& B = this->nodes[iB];
+        auto& C = this->nodes[iC];
+        int32_t balance = C.Height - B.Height;
+
+        auto replaceChild = [this](ProxyId parent, ProxyId oldChild, ProxyId newChild)
+        {
+            if (parent == InvalidProxy)
+                this->root = newChild;
+            else if (this->nodes[parent].Child1 == oldChild)
+                this->nodes[parent].Child1 = newChild;
+            else
+                this->nodes[parent].Child2 = newChild;
+        };
+
+        // rotate C up
+        if (balance > 1)
+        {
+            ProxyId iF = C.Child1;
+            ProxyId iG = C.Child2;
+            auto& F = this->nodes[iF];
+            auto& G = this->nodes[iG];
+
+            C.Child1 = iA;
+            C.Parent = A.Parent;
+            A.Parent = iC;
+            replaceChild(C.Parent, iA, iC);
+
+            if (F.Height > G.Height)
+            {
+                C.Child2 = iF;
+                A.Child2 = iG;
+                G.Parent = iA;
+                A.Box = Union(B.Box, G.Box);
+                C.Box = Union(A.Box, F.Box);
+                A.Height = 1 + Max(B.Height, G.Height);
+                C.Height = 1 + Max(A.Height, F.Height);
+            }
+            else
+            {
+                C.Child2 = iG;
+                A.Child2 = iF;
+                F.Parent = iA;
+                A.Box = Union(B.Box, F.Box);
+                C.Box = Union(A.Box, G.Box);
+                A.Height = 1 + Max(B.Height, F.Height);
+                C.Height = 1 + Max(A.Height, G.Height);
+            }
+            return iC;
+        }
+
+        // rotate B up
+        if (balance < -1)
+        {
+            ProxyId iD = B.Child1;
+            ProxyId iE = B.Child2;
+            auto& D = this->nodes[iD];
+            auto& E = this->nodes[iE];
+
+            B.Child1 = iA;
+            B.Parent = A.Parent;
+            A.Parent = iB;
+            replaceChild(B.Parent, iA, iB);
+
+            if (D.Height > E.Height)
+            {
+                B.Child2 = iD;
+                A.Child1 = iE;
+                E.Parent = iA;
+                A.Box = Union(C.Box, E.Box);
+                B.Box = Union(A.Box, D.Box);
+                A.Height = 1 + Max(C.Height, E.Height);
+                B.Height = 1 + Max(A.Height, D.Height);
+            }
+            else
+            {
+                B.Child2 = iE;
+                A.Child1 = iD;
+                D.Parent = iA;
+                A.Box = Union(C.Box, D.Box);
+                B.Box = Union(A.Box, E.Box);
+                A.Height = 1 + Max(C.Height, D.Height);
+                B.Height = 1 + Max(A.Height, E.Height);
+            }
+            return iB;
+        }
+
+        return iA;
+    }
+
+    void AABBTree::QueryAABB(const AABB& box, const QueryCallback& callback) const
+    {
+        if (this->root == InvalidProxy) return;
+
+        MxVector<ProxyId> stack;
+        stack.push_back(this->root);
+        while (!stack.empty())
+        {
+            const auto& node = this->nodes[stack.back()];
+            stack.pop_back();
+            if (!Overlaps(node.Box, box)) continue;
+
+            if (node.IsLeaf())
+            {
+                if (!callback(node.Data)) return;
+            }
+            else
+            {
+                stack.push_back(node.Child1);
+                stack.push_back(node.Child2);
+            }
+        }
+    }
+
+    void AABBTree::QuerySphere(const BoundingSphere& sphere, const QueryCallback& callback) const
+    {
+        if (this->root == InvalidProxy) return;
+
+        float radiusSquared = sphere.Radius * sphere.Radius;
+        MxVector<ProxyId> stack;
+        stack.push_back(this->root);
+        while (!stack.empty())
+        {
+            const auto& node = this->nodes[stack.back()];
+            stack.pop_back();
+            if (DistanceSquared(node.Box, sphere.Center) > radiusSquared) continue;
+
+            if (node.IsLeaf())
+            {
+                if (!callback(node.Data)) return;
+            }
+            else
+            {
+                stack.push_back(node.Child1);
+                stack.push_back(node.Child2);
+            }
+        }
+    }
+
+    void AABBTree::QueryFrustrum(const FrustrumCuller& culler, const FrustrumCallback& callback) const
+    {
+        if (this->root == InvalidProxy) return;
+
+        // each node inherits planes which its parent intersects. If no planes are left, whole subtree is visible
+        MxVector<std::pair<ProxyId, uint8_t>> stack;
+        stack.emplace_back(this->root, FrustrumCuller::AllPlanesMask);
+        while (!stack.empty())
+        {
+            auto [index, planeMask] = stack.back();
+            stack.pop_back();
+            const auto& node = this->nodes[index];
+
+            if (planeMask != 0 && !culler.IsAABBVisible(node.Box.Min, node.Box.Max, planeMask)) continue;
+
+            if (node.IsLeaf())
+            {
+                if (!callback(node.Data, planeMask == 0)) return;
+            }
+            else
+            {
+                stack.emplace_back(node.Child1, planeMask);
+                stack.emplace_back(node.Child2, planeMask);
+            }
+        }
+    }
+
+    void AABBTree::RayCast(const Vector3& from, const Vector3& to, const RayCallback& callback) const
+    {
+        if (this->root == InvalidProxy) return;
+
+        auto direction = to - from;
+        float maxFraction = 1.0f;
+        MxVector<ProxyId> stack;
+        stack.push_back(this->root);
+        while (!stack.empty())
+        {
+            const auto& node = this->nodes[stack.back()];
+            stack.pop_back();
+
+            float fraction = IntersectRay(node.Box, from, direction, maxFraction);
+            if (fraction < 0.0f) continue;
+
+            if (node.IsLeaf())
+            {
+                float value = callback(node.Data, fraction);
+                if (value == 0.0f) return;
+                maxFraction = Min(maxFraction, value);
+            }
+            else
+            {
+                stack.push_back(node.Child1);
+                stack.push_back(node.Child2);
+            }
+        }
+    }
+
+    void AABBTree::QueryNearest(const Vector3& point, size_t count, MxVector<UserData>& result) const
+    {
+        result.clear();
+        if (this->root == InvalidProxy || count == 0) return;
+
+        // best-first traversal: node box distance is lower bound for distance of all its leaves
+        using Entry = std::pair<float, ProxyId>;
+        std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+        queue.emplace(DistanceSquared(this->nodes[this->root].Box, point), this->root);
+        while (!queue.empty() && result.size() < count)
+        {
+            ProxyId index = queue.top().second;
+            queue.pop();
+            const auto& node = this->nodes[index];
+
+            if (node.IsLeaf())
+            {
+                result.push_back(node.Data);
+            }
+            else
+            {
+                queue.emplace(DistanceSquared(this->nodes[node.Child1].Box, point), node.Child1);
+                queue.emplace(DistanceSquared(this->nodes[node.Child2].Box, point), node.Child2);
+            }
+        }
+    }
+
+    bool AABBTree::Validate() const
+    {
+        size_t freeCount = 0;
+        for (ProxyId node = this->freeList; node != InvalidProxy; node = this->nodes[node].Parent)
+        {
+            if (node >= this->nodes.size() || this->nodes[node].Height != -1) return false;
+            freeCount++;
+        }
+
+        if (this->root == InvalidProxy)
+            return this->leafCount == 0 && freeCount == this->nodes.size();
+        if (this->nodes[this->root].Parent != InvalidProxy) return false;
+
+        size_t visitedLeaves = 0;
+        size_t visitedNodes = 0;
+        MxVector<ProxyId> stack;
+        stack.push_back(this->root);
+        while (!stack.empty())
+        {
+            ProxyId index = stack.back();
+            stack.pop_back();
+            const auto& node = this->nodes[index];
+            visitedNodes++;
+
+            if (node.IsLeaf())
+            {
+                if (node.Child2 != InvalidProxy || node.Height != 0) return false;
+                visitedLeaves++;
+                continue;
+            }
+
+            if (node.Child1 >= this->nodes.size() || node.Child2 >= this->nodes.size()) return false;
+            const auto& child1 = this->nodes[node.Child1];
+            const auto& child2 = this->nodes[node.Child2];
+            if (child1.Parent != index || child2.Parent != index) return false;
+            if (node.Height != 1 + Max(child1.Height, child2.Height)) return false;
+            if (!Contains(node.Box, child1.Box) || !Contains(node.Box, child2.Box)) return false;
+
+            stack.push_back(node.Child1);
+            stack.push_back(node.Child2);
+        }
+        return visitedLeaves == this->leafCount && visitedNodes + freeCount == this->nodes.size();
+    }
+}
\ No newline at end of file
@@ -0,0 +1,150 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include "Core/BoundingObjects/AABB.h"
+#include "Core/BoundingObjects/BoundingSphere.h"
+#include "Core/BoundingObjects/FrustrumCuller.h"
+#include "Utilities/STL/MxVector.h"
+#include "Utilities/STL/MxFunction.h"
+
+namespace MxEngine
+{
+    /*!
+    dynamic bounding volume hierarchy of axis-aligned boxes. Leaves store fat boxes, enlarged by margin, so small movements
+    of objects do not require tree update. New leaves are inserted using surface area heuristic, and tree is kept balanced by rotations
+    each leaf is identified by proxy id and holds arbitrary user value
+    */
+    class AABBTree
+    {
+    public:
+        using ProxyId = uint32_t;
+        using UserData = size_t;
+        constexpr static ProxyId InvalidProxy = std::numeric_limits<ProxyId>::max();
+
+        // callbacks return false to stop query
+        using QueryCallback = MxFunction<bool(UserData)>::type;
+        // frustrum callback also receives flag if leaf is fully inside frustrum
+        using FrustrumCallback = MxFunction<bool(UserData, bool)>::type;
+        // ray callback receives fraction of ray at which leaf box is hit and returns new max fraction (0 to stop, old value to ignore hit)
+        using RayCallback = MxFunction<float(UserData, float)>::type;
+    private:
+        struct Node
+        {
+            AABB Box;
+            UserData Data = 0;
+            ProxyId Parent = InvalidProxy; // next free node if node is not used
+            ProxyId Child1 = InvalidProxy;
+            ProxyId Child2 = InvalidProxy;
+            int32_t Height = -1;
+
+            bool IsLeaf() const { return this->Child1 == InvalidProxy; }
+        };
+
+        MxVector<Node> nodes;
+        ProxyId root = InvalidProxy;
+        ProxyId freeList = InvalidProxy;
+        size_t leafCount = 0;
+
+        ProxyId AllocateNode();
+        void FreeNode(ProxyId node);
+        void InsertLeaf(ProxyId leaf);
+        void RemoveLeaf(ProxyId leaf);
+        ProxyId Balance(ProxyId node);
+    public:
+        // fat boxes are enlarged by this value in each direction
+        float Margin = 0.1f;
+
+        /*!
+        creates leaf for box
+        \param box bounding box of object
+        \param data user value which is passed to query callbacks
+        \returns proxy id of created leaf
+        */
+        ProxyId Insert(const AABB& box, UserData data);
+        /*!
+        destroys leaf. Proxy id can be reused by leaves created later
+        \param proxy id of existing leaf
+        */
+        void Remove(ProxyId proxy);
+        /*!
+        updates leaf box. Tree is modified only if new box is not contained in fat box of leaf
+        \param proxy id of existing leaf
+        \param box new bounding box of object
+        \returns true if leaf was reinserted, false either
+        */
+        bool Move(ProxyId proxy, const AABB& box);
+        void Clear();
+
+        UserData GetUserData(ProxyId proxy) const { return this->nodes[proxy].Data; }
+        const AABB& GetFatBox(ProxyId proxy) const { return this->nodes[proxy].Box; }
+        size_t GetLeafCount() const { return this->leafCount; }
+        int32_t GetHeight() const { return this->root == InvalidProxy ? 0 : this->nodes[this->root].Height; }
+
+        /*!
+        invokes callback for each leaf which fat box overlaps provided box
+        */
+        void QueryAABB(const AABB& box, const QueryCallback& callback) const;
+        /*!
+        invokes callback for each leaf which fat box overlaps provided sphere
+        */
+        void QuerySphere(const BoundingSphere& sphere, const QueryCallback& callback) const;
+        /*!
+        invokes callback for each leaf which fat box is inside frustrum. Subtrees fully inside frustrum are not tested against its planes
+        */
+        void QueryFrustrum(const FrustrumCuller& culler, const FrustrumCallback& callback) const;
+        /*!
+        invokes callback for each leaf which fat box is hit by ray segment [from, to]
+        */
+        void RayCast(const Vector3& from, const Vector3& to, const RayCallback& callback) const;
+        /*!
+        finds leaves which fat boxes are closest to point
+        \param point point from which distance is computed
+        \param count maximum number of leaves to find
+        \param result array to which user values of found leaves are written, sorted from closest to farthest
+        */
+        void QueryNearest(const Vector3& point, size_t count, MxVector<UserData>& result) const;
+        /*!
+        checks tree structure: parent-child links, node heights, enclosing boxes and number of leaves and free nodes
+        visits every node, so it is intended for tests and debug checks only
+        \returns true if tree is consistent, false either
+        */
+        bool Validate() const;
+
+        static bool Overlaps(const AABB& box1, const AABB& box2);
+        static float DistanceSquared(const AABB& box, const Vector3& point);
+        /*!
+        slab test of ray segment against box
+        \param direction segment direction, scaled so that fraction 1.0 corresponds to segment end
+        \param maxFraction maximum fraction of segment to test
+        \returns fraction at which box is hit or negative value if it is missed
+        */
+        static float IntersectRay(const AABB& box, const Vector3& from, const Vector3& direction, float maxFraction);
+    };
+}
@@ -0,0 +1,189 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "FrustrumCuller.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MXENGINE_CULLING_USE_SSE
+#include <emmintrin.h>
+#endif
+
+namespace MxEngine
+{
+	// distance is signed distance from volume center to plane, radius is projection of volume extents on plane normal
+	// volume is outside if it is fully behind any plane, and plane is not intersected if volume is fully in front of it
+	template<typename RadiusFunc>
+	static uint8_t TestVolumeScalar(const std::array<Vector4, 6>& planes, uint8_t planeMask, const Vector3& center, RadiusFunc&& getRadius, bool& isVisible)
+	{
+		uint8_t intersectedPlanes = 0;
+		isVisible = true;
+		for (size_t p = 0; p < planes.size(); p++)
+		{
+			if ((planeMask & (1 << p)) == 0) continue;
+			const auto& plane = planes[p];
+			float distance = Dot(Vector3(plane), center) + plane.w;
+			float radius = getRadius(plane);
+			if (distance + radius < 0.0f)
+			{
+				isVisible = false;
+				break;
+			}
+			if (distance - radius < 0.0f) intersectedPlanes |= (uint8_t)(1 << p);
+		}
+		return intersectedPlanes;
+	}
+
+	bool FrustrumCuller::IsAABBVisible(const Vector3& minp, const Vector3& maxp, uint8_t& planeMask) const
+	{
+		auto center = (maxp + minp) * 0.5f;
+		auto extent = (maxp - minp) * 0.5f;
+		bool isVisible = true;
+		planeMask = TestVolumeScalar(this->planes, planeMask, center,
+			[&extent](const Vector4& plane) { return Dot(Abs(Vector3(plane)), extent); }, isVisible);
+		return isVisible;
+	}
+
+	size_t FrustrumCuller::CullAABBs(const AABBArray& boxes, uint8_t* visibility, uint8_t planeMask, uint8_t* outPlaneMasks) const
+	{
+		size_t count = boxes.Size();
+		size_t visibleCount = 0;
+		size_t i = 0;
+
+		#if defined(MXENGINE_CULLING_USE_SSE)
+		const __m128 zero = _mm_setzero_ps();
+		const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+		for (; i + 4 <= count; i += 4)
+		{
+			__m128 cx = _mm_loadu_ps(boxes.CenterX.data() + i);
+			__m128 cy = _mm_loadu_ps(boxes.CenterY.data() + i);
+			__m128 cz = _mm_loadu_ps(boxes.CenterZ.data() + i);
+			__m128 ex = _mm_loadu_ps(boxes.ExtentX.data() + i);
+			__m128 ey = _mm_loadu_ps(boxes.ExtentY.data() + i);
+			__m128 ez = _mm_loadu_ps(boxes.ExtentZ.data() + i);
+
+			int outside = 0;
+			uint8_t intersected[4] = { 0, 0, 0, 0 };
+			for (size_t p = 0; p < this->planes.size() && outside != 0xF; p++)
+			{
+				if ((planeMask & (1 << p)) == 0) continue;
+				const auto& plane = this->planes[p];
+				__m128 nx = _mm_set1_ps(plane.x), ny = _mm_set1_ps(plane.y), nz = _mm_set1_ps(plane.z);
+
+				__m128 distance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(nx, cx), _mm_mul_ps(ny, cy)), _mm_add_ps(_mm_mul_ps(nz, cz), _mm_set1_ps(plane.w)));
+				__m128 radius = _mm_add_ps(_mm_add_ps(
+					_mm_mul_ps(_mm_and_ps(nx, absMask), ex),
+					_mm_mul_ps(_mm_and_ps(ny, absMask), ey)),
+					_mm_mul_ps(_mm_and_ps(nz, absMask), ez));
+
+				outside |= _mm_movemask_ps(_mm_cmplt_ps(_mm_add_ps(distance, radius), zero));
+				int intersects = _mm_movemask_ps(_mm_cmplt_ps(_mm_sub_ps(distance, radius), zero));
+				for (size_t lane = 0; lane < 4; lane++)
+					intersected[lane] |= (uint8_t)(((intersects >> lane) & 1) << p);
+			}
+
+			for (size_t lane = 0; lane < 4; lane++)
+			{
+				bool isVisible = ((outside >> lane) & 1) == 0;
+				visibility[i + lane] = (uint8_t)isVisible;
+				visibleCount += (size_t)isVisible;
+				if (outPlaneMasks != nullptr) outPlaneMasks[i + lane] = intersected[lane];
+			}
+		}
+		#endif
+
+		for (; i < count; i++)
+		{
+			Vector3 center{ boxes.CenterX[i], boxes.CenterY[i], boxes.CenterZ[i] };
+			Vector3 extent{ boxes.ExtentX[i], boxes.ExtentY[i], boxes.ExtentZ[i] };
+			bool isVisible = true;
+			uint8_t intersected = TestVolumeScalar(this->planes, planeMask, center,
+				[&extent](const Vector4& plane) { return Dot(Abs(Vector3(plane)), extent); }, isVisible);
+
+			visibility[i] = (uint8_t)isVisible;
+			visibleCount += (size_t)isVisible;
+			if (outPlaneMasks != nullptr) outPlaneMasks[i] = intersected;
+		}
+		return visibleCount;
+	}
+
+	size_t FrustrumCuller::CullSpheres(const SphereArray& spheres, uint8_t* visibility, uint8_t planeMask, uint8_t* outPlaneMasks) const
+	{
+		size_t count = spheres.Size();
+		size_t visibleCount = 0;
+		size_t i = 0;
+
+		#if defined(MXENGINE_CULLING_USE_SSE)
+		const __m128 zero = _mm_setzero_ps();
+		for (; i + 4 <= count; i += 4)
+		{
+			__m128 cx = _mm_loadu_ps(spheres.CenterX.data() + i);
+			__m128 cy = _mm_loadu_ps(spheres.CenterY.data() + i);
+			__m128 cz = _mm_loadu_ps(spheres.CenterZ.data() + i);
+			__m128 radius = _mm_loadu_ps(spheres.Radius.data() + i);
+
+			int outside = 0;
+			uint8_t intersected[4] = { 0, 0, 0, 0 };
+			for (size_t p = 0; p < this->planes.size() && outside != 0xF; p++)
+			{
+				if ((planeMask & (1 << p)) == 0) continue;
+				const auto& plane = this->planes[p];
+				__m128 nx = _mm_set1_ps(plane.x), ny = _mm_set1_ps(plane.y), nz = _mm_set1_ps(plane.z);
+
+				__m128 distance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(nx, cx), _mm_mul_ps(ny, cy)), _mm_add_ps(_mm_mul_ps(nz, cz), _mm_set1_ps(plane.w)));
+
+				outside |= _mm_movemask_ps(_mm_cmplt_ps(_mm_add_ps(distance, radius), zero));
+				int intersects = _mm_movemask_ps(_mm_cmplt_ps(_mm_sub_ps(distance, radius), zero));
+				for (size_t lane = 0; lane < 4; lane++)
+					intersected[lane] |= (uint8_t)(((intersects >> lane) & 1) << p);
+			}
+
+			for (size_t lane = 0; lane < 4; lane++)
+			{
+				bool isVisible = ((outside >> lane) & 1) == 0;
+				visibility[i + lane] = (uint8_t)isVisible;
+				visibleCount += (size_t)isVisible;
+				if (outPlaneMasks != nullptr) outPlaneMasks[i + lane] = intersected[lane];
+			}
+		}
+		#endif
+
+		for (; i < count; i++)
+		{
+			Vector3 center{ spheres.CenterX[i], spheres.CenterY[i], spheres.CenterZ[i] };
+			float radius = spheres.Radius[i];
+			bool isVisible = true;
+			uint8_t intersected = TestVolumeScalar(this->planes, planeMask, center,
+				[radius](const Vector4&) { return radius; }, isVisible);
+
+			visibility[i] = (uint8_t)isVisible;
+			visibleCount += (size_t)isVisible;
+			if (outPlaneMasks != nullptr) outPlaneMasks[i] = intersected;
+		}
+		return visibleCount;
+	}
+}
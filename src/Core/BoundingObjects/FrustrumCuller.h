@@ -29,10 +29,57 @@
 #pragma once
 
 #include "Utilities/Math/Math.h"
+#include "Utilities/STL/MxVector.h"
 #include <array>
 
 namespace MxEngine
 {
+	// axis-aligned boxes in SoA layout for batch culling. Boxes are stored as centers and half-extents
+	struct AABBArray
+	{
+		MxVector<float> CenterX, CenterY, CenterZ;
+		MxVector<float> ExtentX, ExtentY, ExtentZ;
+
+		size_t Size() const { return this->CenterX.size(); }
+
+		void Add(const Vector3& minp, const Vector3& maxp)
+		{
+			auto center = (maxp + minp) * 0.5f;
+			auto extent = (maxp - minp) * 0.5f;
+			this->CenterX.push_back(center.x); this->CenterY.push_back(center.y); this->CenterZ.push_back(center.z);
+			this->ExtentX.push_back(extent.x); this->ExtentY.push_back(extent.y); this->ExtentZ.push_back(extent.z);
+		}
+
+		void Resize(size_t size)
+		{
+			this->CenterX.resize(size); this->CenterY.resize(size); this->CenterZ.resize(size);
+			this->ExtentX.resize(size); this->ExtentY.resize(size); this->ExtentZ.resize(size);
+		}
+
+		void Clear() { this->Resize(0); }
+	};
+
+	// bounding spheres in SoA layout for batch culling
+	struct SphereArray
+	{
+		MxVector<float> CenterX, CenterY, CenterZ, Radius;
+
+		size_t Size() const { return this->CenterX.size(); }
+
+		void Add(const Vector3& center, float radius)
+		{
+			this->CenterX.push_back(center.x); this->CenterY.push_back(center.y); this->CenterZ.push_back(center.z);
+			this->Radius.push_back(radius);
+		}
+
+		void Resize(size_t size)
+		{
+			this->CenterX.resize(size); this->CenterY.resize(size); this->CenterZ.resize(size); this->Radius.resize(size);
+		}
+
+		void Clear() { this->Resize(0); }
+	};
+
 	// thanks to https://gist.github.com/podgorskiy/e698d18879588ada9014768e3e82a644
 	class FrustrumCuller
 	{
@@ -45,6 +92,33 @@ namespace MxEngine
 		// http://iquilezles.org/www/articles/frustumcorrect/frustumcorrect.htm
 		bool IsAABBVisible(const Vector3& minp, const Vector3& maxp) const;
 
+		// bit i of plane mask corresponds to i-th frustrum plane. Only planes with set bits are tested
+		constexpr static uint8_t AllPlanesMask = 0x3F;
+
+		/*!
+		tests multiple boxes against frustrum at once. Boxes are processed four at a time using SSE if it is available
+		\param boxes boxes to test
+		\param visibility output array of boxes.Size() elements. Set to 1 for visible boxes and to 0 for culled ones
+		\param planeMask planes to test. Useful for hierarchies, where children do not need to test planes their parent is fully inside of
+		\param outPlaneMasks optional output array of boxes.Size() elements. Contains planes of planeMask which each box intersects
+		\returns number of visible boxes
+		*/
+		size_t CullAABBs(const AABBArray& boxes, uint8_t* visibility, uint8_t planeMask = AllPlanesMask, uint8_t* outPlaneMasks = nullptr) const;
+		/*!
+		tests multiple spheres against frustrum at once. Spheres are processed four at a time using SSE if it is available
+		\param spheres spheres to test
+		\param visibility output array of spheres.Size() elements. Set to 1 for visible spheres and to 0 for culled ones
+		\param planeMask planes to test
+		\param outPlaneMasks optional output array of spheres.Size() elements. Contains planes of planeMask which each sphere intersects
+		\returns number of visible spheres
+		*/
+		size_t CullSpheres(const SphereArray& spheres, uint8_t* visibility, uint8_t planeMask = AllPlanesMask, uint8_t* outPlaneMasks = nullptr) const;
+		/*!
+		tests single box only against planes of plane mask
+		\param planeMask planes to test. Planes which box is fully inside of are removed from mask
+		\returns true if box is visible, false either
+		*/
+		bool IsAABBVisible(const Vector3& minp, const Vector3& maxp, uint8_t& planeMask) const;
 	private:
 		enum Planes
 		{
@@ -86,6 +160,10 @@ namespace MxEngine
 		this->planes[NEAR]   = m[3] + m[2];
 		this->planes[FAR]    = m[3] - m[2];
 
+		// planes are normalized so sphere radius can be compared with plane distance directly
+		for (auto& plane : this->planes)
+			plane /= Length(Vector3(plane));
+
 		std::array crosses = {
 			Cross(Vector3(this->planes[LEFT]),   Vector3(this->planes[RIGHT])),
 			Cross(Vector3(this->planes[LEFT]),   Vector3(this->planes[BOTTOM])),
@@ -0,0 +1,324 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "OcclusionCuller.h"
+#include "Core/Macro/Macro.h"
+#include "Utilities/JobSystem/JobSystem.h"
+#include "Utilities/Profiler/Profiler.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MXENGINE_OCCLUSION_USE_SSE
+#include <emmintrin.h>
+#endif
+
+namespace MxEngine
+{
+    // rows are split into bands, so each job writes only its own part of depth buffer
+    constexpr size_t RowsPerBand = 8;
+
+    OcclusionCuller::OcclusionCuller(size_t width, size_t height)
+    {
+        this->Resize(width, height);
+    }
+
+    void OcclusionCuller::Resize(size_t width, size_t height)
+    {
+        MX_ASSERT(width > 0 && height > 0);
+        this->width = width;
+        this->height = height;
+        this->depthBuffer.assign(width * height, std::numeric_limits<float>::max());
+    }
+
+    size_t OcclusionCuller::GetWidth() const
+    {
+        return this->width;
+    }
+
+    size_t OcclusionCuller::GetHeight() const
+    {
+        return this->height;
+    }
+
+    const MxVector<float>& OcclusionCuller::GetDepthBuffer() const
+    {
+        return this->depthBuffer;
+    }
+
+    const OcclusionStatistics& OcclusionCuller::GetStatistics() const
+    {
+        return this->statistics;
+    }
+
+    void OcclusionCuller::ResetStatistics()
+    {
+        this->statistics = OcclusionStatistics{ };
+    }
+
+    void OcclusionCuller::Clear(const Matrix4x4& viewProjection, float zNear)
+    {
+        this->viewProjection = viewProjection;
+        this->zNear = zNear;
+        this->ResetStatistics();
+        std::fill(this->depthBuffer.begin(), this->depthBuffer.end(), std::numeric_limits<float>::max());
+    }
+
+    void OcclusionCuller::RasterizeOccluders(ArrayView<OccluderMesh> occluders)
+    {
+        MAKE_SCOPE_PROFILER("OcclusionCuller::RasterizeOccluders()");
+
+        // triangles of each mesh are written to their own range, so transformed triangles keep submission order
+        MxVector<size_t> triangleOffsets(occluders.size() + 1, 0);
+        for (size_t i = 0; i < occluders.size(); i++)
+            triangleOffsets[i + 1] = triangleOffsets[i] + occluders[i].IndexCount / 3;
+        this->triangles.resize(triangleOffsets.back());
+
+        JobSystem::ParallelFor(occluders.size(), 1, [&](size_t begin, size_t end)
+        {
+            Vector2 screenSize{ (float)this->width, (float)this->height };
+            for (size_t i = begin; i < end; i++)
+            {
+                const auto& occluder = occluders[i];
+                auto transform = this->viewProjection * occluder.Transform;
+                auto* positions = reinterpret_cast<const uint8_t*>(occluder.Positions);
+
+                for (size_t t = 0; t < occluder.IndexCount / 3; t++)
+                {
+                    auto& triangle = this->triangles[triangleOffsets[i] + t];
+                    Vector2* screenVertices[3] = { &triangle.V0, &triangle.V1, &triangle.V2 };
+                    triangle.Depth = 0.0f;
+
+                    for (size_t v = 0; v < 3; v++)
+                    {
+                        auto* position = reinterpret_cast<const float*>(positions + occluder.Indices[3 * t + v] * occluder.PositionStride);
+                        auto clip = transform * Vector4(position[0], position[1], position[2], 1.0f);
+                        // triangles crossing near plane are dropped, as skipping occluder is always safe
+                        if (clip.w < this->zNear) { triangle.Depth = -1.0f; break; }
+
+                        *screenVertices[v] = (Vector2(clip.x, clip.y) / clip.w * 0.5f + 0.5f) * screenSize;
+                        triangle.Depth = Max(triangle.Depth, clip.w);
+                    }
+                }
+            }
+        });
+
+        this->BinTriangles();
+
+        size_t bandCount = this->bandOffsets.size() - 1;
+        JobSystem::ParallelFor(bandCount, 1, [this](size_t bandBegin, size_t bandEnd)
+        {
+            for (size_t band = bandBegin; band < bandEnd; band++)
+                this->RasterizeBand(band);
+        });
+        this->statistics.RasterizedTriangles += this->triangles.size();
+    }
+
+    bool OcclusionCuller::GetTriangleRows(const ScreenTriangle& triangle, int& rowBegin, int& rowEnd) const
+    {
+        if (triangle.Depth < 0.0f) return false;
+
+        float minX = Min(triangle.V0.x, triangle.V1.x, triangle.V2.x), maxX = Max(triangle.V0.x, triangle.V1.x, triangle.V2.x);
+        float minY = Min(triangle.V0.y, triangle.V1.y, triangle.V2.y), maxY = Max(triangle.V0.y, triangle.V1.y, triangle.V2.y);
+        if (maxX <= 0.0f || minX >= (float)this->width) return false;
+
+        rowBegin = Max((int)std::floor(minY), 0);
+        rowEnd = Min((int)std::ceil(maxY), (int)this->height);
+        return rowBegin < rowEnd;
+    }
+
+    void OcclusionCuller::BinTriangles()
+    {
+        // counting sort by band: first pass counts triangles of each band, second one writes their indices,
+        // so triangles overlapping several bands are stored in each of them
+        size_t bandCount = (this->height + RowsPerBand - 1) / RowsPerBand;
+        this->bandOffsets.assign(bandCount + 1, 0);
+
+        int rowBegin = 0, rowEnd = 0;
+        for (const auto& triangle : this->triangles)
+        {
+            if (!this->GetTriangleRows(triangle, rowBegin, rowEnd)) continue;
+            for (size_t band = size_t(rowBegin) / RowsPerBand; band <= size_t(rowEnd - 1) / RowsPerBand; band++)
+                this->bandOffsets[band + 1]++;
+        }
+        for (size_t band = 0; band < bandCount; band++)
+            this->bandOffsets[band + 1] += this->bandOffsets[band];
+
+        this->bandTriangles.resize(this->bandOffsets.back());
+        MxVector<uint32_t> bandCursors(this->bandOffsets.begin(), this->bandOffsets.end() - 1);
+        for (size_t i = 0; i < this->triangles.size(); i++)
+        {
+            if (!this->GetTriangleRows(this->triangles[i], rowBegin, rowEnd)) continue;
+            for (size_t band = size_t(rowBegin) / RowsPerBand; band <= size_t(rowEnd - 1) / RowsPerBand; band++)
+                this->bandTriangles[bandCursors[band]++] = (uint32_t)i;
+        }
+    }
+
+    void OcclusionCuller::RasterizeBand(size_t band)
+    {
+        size_t rowBegin = band * RowsPerBand;
+        size_t rowEnd = Min(rowBegin + RowsPerBand, this->height);
+        for (size_t i = this->bandOffsets[band]; i < this->bandOffsets[band + 1]; i++)
+        {
+            const auto& triangle = this->triangles[this->bandTriangles[i]];
+
+            Vector2 v0 = triangle.V0, v1 = triangle.V1, v2 = triangle.V2;
+            float area = (v1.x - v0.x) * (v2.y - v0.y) - (v1.y - v0.y) * (v2.x - v0.x);
+            if (area == 0.0f) continue;
+            if (area < 0.0f) std::swap(v1, v2);
+
+            float minX = Min(v0.x, v1.x, v2.x), maxX = Max(v0.x, v1.x, v2.x);
+            float minY = Min(v0.y, v1.y, v2.y), maxY = Max(v0.y, v1.y, v2.y);
+            int x0 = Max((int)std::floor(minX), 0), x1 = Min((int)std::ceil(maxX), (int)this->width);
+            int y0 = Max((int)std::floor(minY), (int)rowBegin), y1 = Min((int)std::ceil(maxY), (int)rowEnd);
+            if (x0 >= x1 || y0 >= y1) continue;
+
+            // edge function e(p) = (b - a) x (p - a) is positive inside triangle. Pixel is fully covered only if
+            // e(center) >= 0.5 * (|dx| + |dy|), which is max change of edge function inside pixel
+            const Vector2 edgeStart[3] = { v0, v1, v2 };
+            const Vector2 edgeEnd[3] = { v1, v2, v0 };
+            float stepX[3], stepY[3], threshold[3], rowStart[3];
+            for (size_t k = 0; k < 3; k++)
+            {
+                Vector2 d = edgeEnd[k] - edgeStart[k];
+                stepX[k] = -d.y;
+                stepY[k] = d.x;
+                threshold[k] = 0.5f * (std::abs(d.x) + std::abs(d.y));
+                rowStart[k] = d.x * (y0 + 0.5f - edgeStart[k].y) - d.y * (x0 + 0.5f - edgeStart[k].x);
+            }
+
+            for (int y = y0; y < y1; y++)
+            {
+                float* row = this->depthBuffer.data() + y * this->width;
+                float e0 = rowStart[0], e1 = rowStart[1], e2 = rowStart[2];
+                int x = x0;
+
+                #if defined(MXENGINE_OCCLUSION_USE_SSE)
+                const __m128 lanes = _mm_set_ps(3.0f, 2.0f, 1.0f, 0.0f);
+                __m128 edge0 = _mm_add_ps(_mm_set1_ps(e0), _mm_mul_ps(lanes, _mm_set1_ps(stepX[0])));
+                __m128 edge1 = _mm_add_ps(_mm_set1_ps(e1), _mm_mul_ps(lanes, _mm_set1_ps(stepX[1])));
+                __m128 edge2 = _mm_add_ps(_mm_set1_ps(e2), _mm_mul_ps(lanes, _mm_set1_ps(stepX[2])));
+                const __m128 step0 = _mm_set1_ps(4.0f * stepX[0]), step1 = _mm_set1_ps(4.0f * stepX[1]), step2 = _mm_set1_ps(4.0f * stepX[2]);
+                const __m128 threshold0 = _mm_set1_ps(threshold[0]), threshold1 = _mm_set1_ps(threshold[1]), threshold2 = _mm_set1_ps(threshold[2]);
+                const __m128 depth = _mm_set1_ps(triangle.Depth);
+                for (; x + 4 <= x1; x += 4)
+                {
+                    __m128 inside = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(edge0, threshold0), _mm_cmpge_ps(edge1, threshold1)), _mm_cmpge_ps(edge2, threshold2));
+                    __m128 current = _mm_loadu_ps(row + x);
+                    __m128 result = _mm_or_ps(_mm_and_ps(inside, _mm_min_ps(current, depth)), _mm_andnot_ps(inside, current));
+                    _mm_storeu_ps(row + x, result);
+
+                    edge0 = _mm_add_ps(edge0, step0);
+                    edge1 = _mm_add_ps(edge1, step1);
+                    edge2 = _mm_add_ps(edge2, step2);
+                }
+                e0 += (x - x0) * stepX[0];
+                e1 += (x - x0) * stepX[1];
+                e2 += (x - x0) * stepX[2];
+                #endif
+
+                for (; x < x1; x++)
+                {
+                    if (e0 >= threshold[0] && e1 >= threshold[1] && e2 >= threshold[2])
+                        row[x] = Min(row[x], triangle.Depth);
+                    e0 += stepX[0];
+                    e1 += stepX[1];
+                    e2 += stepX[2];
+                }
+
+                rowStart[0] += stepY[0];
+                rowStart[1] += stepY[1];
+                rowStart[2] += stepY[2];
+            }
+        }
+    }
+
+    bool OcclusionCuller::IsAABBVisible(const Vector3& minp, const Vector3& maxp) const
+    {
+        Vector2 screenMin{ std::numeric_limits<float>::max() };
+        Vector2 screenMax{ std::numeric_limits<float>::lowest() };
+        float boxDepth = std::numeric_limits<float>::max();
+        for (size_t i = 0; i < 8; i++)
+        {
+            Vector4 corner{ (i & 1) ? maxp.x : minp.x, (i & 2) ? maxp.y : minp.y, (i & 4) ? maxp.z : minp.z, 1.0f };
+            auto clip = this->viewProjection * corner;
+            if (clip.w < this->zNear) return true; // box crosses near plane, so it can cover whole screen
+
+            auto screen = (Vector2(clip.x, clip.y) / clip.w * 0.5f + 0.5f) * Vector2((float)this->width, (float)this->height);
+            screenMin = VectorMin(screenMin, screen);
+            screenMax = VectorMax(screenMax, screen);
+            boxDepth = Min(boxDepth, clip.w);
+        }
+
+        int x0 = Max((int)std::floor(screenMin.x), 0), x1 = Min((int)std::ceil(screenMax.x), (int)this->width);
+        int y0 = Max((int)std::floor(screenMin.y), 0), y1 = Min((int)std::ceil(screenMax.y), (int)this->height);
+        if (x0 >= x1 || y0 >= y1) return true; // boxes outside of screen are handled by frustrum culling
+
+        for (int y = y0; y < y1; y++)
+        {
+            const float* row = this->depthBuffer.data() + y * this->width;
+            for (int x = x0; x < x1; x++)
+            {
+                if (row[x] >= boxDepth) return true;
+            }
+        }
+        return false;
+    }
+
+    size_t OcclusionCuller::CullAABBs(const AABBArray& boxes, uint8_t* visibility)
+    {
+        MAKE_SCOPE_PROFILER("OcclusionCuller::CullAABBs()");
+        std::atomic<size_t> testedCount{ 0 }, occludedCount{ 0 };
+
+        JobSystem::ParallelFor(boxes.Size(), 256, [&](size_t begin, size_t end)
+        {
+            size_t tested = 0, occluded = 0;
+            for (size_t i = begin; i < end; i++)
+            {
+                if (!visibility[i]) continue;
+                Vector3 center{ boxes.CenterX[i], boxes.CenterY[i], boxes.CenterZ[i] };
+                Vector3 extent{ boxes.ExtentX[i], boxes.ExtentY[i], boxes.ExtentZ[i] };
+                tested++;
+                if (!this->IsAABBVisible(center - extent, center + extent))
+                {
+                    visibility[i] = 0;
+                    occluded++;
+                }
+            }
+            testedCount.fetch_add(tested, std::memory_order_relaxed);
+            occludedCount.fetch_add(occluded, std::memory_order_relaxed);
+        });
+
+        this->statistics.TestedBoxes += testedCount.load();
+        this->statistics.OccludedBoxes += occludedCount.load();
+        return occludedCount.load();
+    }
+}
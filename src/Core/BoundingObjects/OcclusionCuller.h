@@ -0,0 +1,110 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include "Core/BoundingObjects/FrustrumCuller.h"
+#include "Utilities/Array/ArrayView.h"
+
+namespace MxEngine
+{
+    // triangle mesh which hides objects behind it. Positions are read with byte stride, so vertex arrays can be used directly
+    struct OccluderMesh
+    {
+        const float* Positions = nullptr;
+        size_t PositionStride = 3 * sizeof(float);
+        const uint32_t* Indices = nullptr;
+        size_t IndexCount = 0;
+        Matrix4x4 Transform{ 1.0f };
+    };
+
+    struct OcclusionStatistics
+    {
+        size_t RasterizedTriangles = 0;
+        size_t TestedBoxes = 0;
+        size_t OccludedBoxes = 0;
+
+        float GetOccludedPercentage() const { return this->TestedBoxes == 0 ? 0.0f : 100.0f * float(this->OccludedBoxes) / float(this->TestedBoxes); }
+    };
+
+    /*
+    software occlusion culler. Occluders are rasterized into low resolution depth buffer of linear view depths, and boxes are
+    tested against it. Rasterization is conservative: pixel is written only if triangle covers it completely, and written depth
+    is the farthest depth of triangle, so occluded boxes are never visible. Works only with perspective projection.
+    Occluders are transformed and rasterized by JobSystem workers, each owning a band of rows, four pixels at a time using SSE.
+    Before rasterization triangles are binned by bands they overlap, so each band job visits only its own triangles
+    */
+    class OcclusionCuller
+    {
+        struct ScreenTriangle
+        {
+            Vector2 V0, V1, V2;
+            float Depth;
+        };
+
+        size_t width = 0;
+        size_t height = 0;
+        MxVector<float> depthBuffer;
+        MxVector<ScreenTriangle> triangles;
+        // triangles of band i are stored in bandTriangles[bandOffsets[i], bandOffsets[i + 1]) in submission order
+        MxVector<uint32_t> bandOffsets;
+        MxVector<uint32_t> bandTriangles;
+        Matrix4x4 viewProjection{ 1.0f };
+        float zNear = 0.1f;
+        OcclusionStatistics statistics;
+
+        bool GetTriangleRows(const ScreenTriangle& triangle, int& rowBegin, int& rowEnd) const;
+        void BinTriangles();
+        void RasterizeBand(size_t band);
+    public:
+        OcclusionCuller(size_t width = 256, size_t height = 128);
+
+        void Resize(size_t width, size_t height);
+        size_t GetWidth() const;
+        size_t GetHeight() const;
+        const MxVector<float>& GetDepthBuffer() const;
+        const OcclusionStatistics& GetStatistics() const;
+        void ResetStatistics();
+
+        /*!
+        resets depth buffer and statistics
+        \param viewProjection view-projection matrix of camera
+        \param zNear distance to camera near plane. Occluder triangles crossing it are ignored
+        */
+        void Clear(const Matrix4x4& viewProjection, float zNear);
+        void RasterizeOccluders(ArrayView<OccluderMesh> occluders);
+        bool IsAABBVisible(const Vector3& minp, const Vector3& maxp) const;
+        /*!
+        tests multiple boxes against depth buffer. Only boxes which are marked as visible are tested
+        \param boxes boxes to test
+        \param visibility array of boxes.Size() elements. Set to 0 for occluded boxes
+        \returns number of occluded boxes
+        */
+        size_t CullAABBs(const AABBArray& boxes, uint8_t* visibility);
+    };
+}
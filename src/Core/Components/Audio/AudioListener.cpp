@@ -8,7 +8,7 @@ namespace MxEngine
     void AudioListener::OnUpdate(float timeDelta)
     {
         auto& object = MxObject::GetByComponent(*this);
-        auto position = object.Transform.GetPosition();
+        auto position = object.GetWorldPosition();
         auto camera = object.GetComponent<CameraController>();
 
         if (camera.IsValid())
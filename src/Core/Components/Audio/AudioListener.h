@@ -33,6 +33,9 @@
 
 namespace MxEngine
 {
+    class TransformComponent;
+    class CameraController;
+
     enum class SoundModel
     {
         NONE,
@@ -53,6 +56,10 @@ namespace MxEngine
         float soundSpeed = 343.3f;
         float dopplerFactor = 1.0f;
     public:
+        using UpdateReads = ComponentTypes<TransformComponent>;
+        using UpdateWrites = ComponentTypes<CameraController>;
+        constexpr static UpdatePolicy UpdateMode = UpdatePolicy::MAIN_THREAD;
+
         void OnUpdate(float timeDelta);
 
         void SetVolume(float speed);
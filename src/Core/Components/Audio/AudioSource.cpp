@@ -33,7 +33,7 @@ namespace MxEngine
 {
     void AudioSource::OnUpdate(float timeDelta)
     {
-        auto position = MxObject::GetByComponent(*this).Transform.GetPosition();
+        auto position = MxObject::GetByComponent(*this).GetWorldPosition();
         this->player->SetPosition(position.x, position.y, position.z);
     }
 
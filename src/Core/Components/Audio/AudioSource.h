@@ -34,6 +34,8 @@
 
 namespace MxEngine
 {
+	class TransformComponent;
+
 	class AudioSource
 	{
 		MAKE_COMPONENT(AudioSource);
@@ -53,6 +55,10 @@ namespace MxEngine
 		bool isPlaying = false;
 		bool isRelative = false;
 	public:
+		using UpdateReads = ComponentTypes<TransformComponent>;
+		using UpdateWrites = ComponentTypes<>;
+		constexpr static UpdatePolicy UpdateMode = UpdatePolicy::MAIN_THREAD;
+
 		void OnUpdate(float timeDelta);
 		void Init();
 		AudioSource() = default;
@@ -52,7 +52,7 @@ namespace MxEngine
 		auto camera = object.GetComponent<CameraController>();
 		auto input = object.GetComponent<InputController>();
 
-		MXLOG_DEBUG("MxEngine::InputControl", "bound object movement: " + object.Name);
+		MXLOG_DEBUG("MxEngine::InputControl", "bound object movement: " + object.GetDisplayName());
 	
 		Event::AddEventListener<UpdateEvent>(input.GetUUID(),
 			[forward, back, right, left, up, down, camera, input, object = MxObject::GetHandleByComponent(*this)](auto& event) mutable
@@ -124,7 +124,7 @@ namespace MxEngine
 			return;
 		}
 
-		MXLOG_DEBUG("MxEngine::InputControl", "bound object rotation: " + object.Name);
+		MXLOG_DEBUG("MxEngine::InputControl", "bound object rotation: " + object.GetDisplayName());
 		MxString uuid = object.GetComponent<InputController>().GetUUID();
 
 		Event::AddEventListener<MouseMoveEvent>(uuid, [camera](auto& event) mutable
@@ -148,7 +148,7 @@ namespace MxEngine
 			return;
 		}
 
-		MXLOG_DEBUG("MxEngine::InputControl", "bound object rotation: " + object.Name);
+		MXLOG_DEBUG("MxEngine::InputControl", "bound object rotation: " + object.GetDisplayName());
 		MxString uuid = object.GetComponent<InputController>().GetUUID();
 	
 		Event::AddEventListener<MouseMoveEvent>(uuid, [camera](auto& event) mutable
@@ -172,7 +172,7 @@ namespace MxEngine
 			return;
 		}
 
-		MXLOG_DEBUG("MxEngine::InputControl", "bound object rotation: " + object.Name);
+		MXLOG_DEBUG("MxEngine::InputControl", "bound object rotation: " + object.GetDisplayName());
 		MxString uuid = object.GetComponent<InputController>().GetUUID();
 	
 		Event::AddEventListener<MouseMoveEvent>(uuid, [camera](auto& event) mutable
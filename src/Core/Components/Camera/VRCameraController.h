@@ -32,6 +32,8 @@
 
 namespace MxEngine
 {
+	class TransformComponent;
+
 	class VRCameraController
 	{
 		MAKE_COMPONENT(VRCameraController);
@@ -41,6 +43,10 @@ namespace MxEngine
 		void UpdateEyes(CameraController::Handle& leftCamera, CameraController::Handle& rightCamera);
 		void Render(TextureHandle& target, const TextureHandle& leftEye, const TextureHandle& rightEye);
 	public:
+		using UpdateReads = ComponentTypes<TransformComponent>;
+		using UpdateWrites = ComponentTypes<CameraController>;
+		constexpr static UpdatePolicy UpdateMode = UpdatePolicy::MAIN_THREAD;
+
 		void OnUpdate(float timeDelta);
 
 		CameraController::Handle LeftEye;
@@ -25,4 +25,5 @@
 #include "Physics/CharacterController.h"
 #include "Physics/RigidBody.h"
 #include "Transform.h"
+#include "TransformHierarchy.h"
 #include "Behaviour.h"
\ No newline at end of file
@@ -2,6 +2,8 @@
 #include "Core/Components/Rendering/MeshSource.h"
 #include "Utilities/Profiler/Profiler.h"
 
+#include <algorithm>
+
 namespace MxEngine
 {
     void InstanceFactory::InitMesh()
@@ -11,9 +13,10 @@ namespace MxEngine
         if (meshSource.IsValid())
         {
             auto& mesh = *meshSource->Mesh;
-            auto modelBufferIndex = this->AddInstancedBuffer(mesh, this->GetModelData());
-            (void)this->AddInstancedBuffer(mesh, this->GetNormalData());
-            (void)this->AddInstancedBuffer(mesh, this->GetColorData());
+            this->BufferInstanceData();
+            auto modelBufferIndex = this->AddInstancedBuffer(mesh, this->models);
+            (void)this->AddInstancedBuffer(mesh, this->normals);
+            (void)this->AddInstancedBuffer(mesh, this->colors);
             this->bufferIndex = modelBufferIndex; // others will be `bufferIndex + 1`, `bufferIndex + 2`
         }
     }
@@ -57,7 +60,8 @@ namespace MxEngine
     void InstanceFactory::OnUpdate(float timeDelta)
     {
         this->RemoveDanglingHandles();
-        if (!this->IsStatic) this->SendInstancesToGPU();
+        // culled instances are uploaded during rendering, when camera frustrum is known
+        if (!this->IsStatic && !this->UseFrustrumCulling) this->SendInstancesToGPU();
     }
 
     void InstanceFactory::SubmitInstances()
@@ -85,55 +89,41 @@ namespace MxEngine
             MxObject::Destroy(object);
         }
         this->pool.Clear();
+        this->storage.Clear();
     }
 
-    InstanceFactory::ModelData& InstanceFactory::GetModelData()
+    void InstanceFactory::BufferInstanceData()
     {
-        MAKE_SCOPE_PROFILER("Instancing::BufferModelData");
-
-        this->models.resize(this->GetCount());
-        auto model = this->models.begin();
-        auto instance = this->GetInstancePool().begin();
-
-        for (; model != this->models.end(); model++, instance++)
-        {
-            instance->GetUnchecked()->Transform.GetMatrix(*model);
-        }
-        if (this->models.empty()) this->models.emplace_back(0.0f);
+        MAKE_SCOPE_PROFILER("Instancing::BufferInstanceData");
 
-        return this->models;
-    }
+        size_t objectCount = this->GetInstancePool().Allocated();
+        size_t count = this->GetCount();
+        size_t bufferSize = Max(count, (size_t)1); // buffers can not be empty, so at least one element is uploaded
+        this->models.resize(bufferSize);
+        this->normals.resize(bufferSize);
+        this->colors.resize(bufferSize);
 
-    InstanceFactory::NormalData& InstanceFactory::GetNormalData()
-    {
-        MAKE_SCOPE_PROFILER("Instancing::BufferNormalData");
-
-        this->normals.resize(this->GetCount());
-        auto normal = this->normals.begin();
-        auto model = this->models.begin();
         auto instance = this->GetInstancePool().begin();
-        for (; normal != this->normals.end(); model++, normal++, instance++)
+        for (size_t i = 0; i < objectCount; i++, instance++)
         {
-            instance->GetUnchecked()->Transform.GetNormalMatrix(*model, *normal);
+            auto& object = *instance->GetUnchecked();
+            object.Transform.GetMatrix(this->models[i]);
+            object.Transform.GetNormalMatrix(this->models[i], this->normals[i]);
+            this->colors[i] = object.GetComponent<Instance>()->GetColor();
         }
-        if (this->normals.empty()) this->normals.emplace_back(0.0f);
 
-        return this->normals;
-    }
+        // lightweight instances are placed right after MxObject instances
+        this->storage.ComputeMatrices(this->models.data() + objectCount, this->normals.data() + objectCount);
+        std::copy(this->storage.GetColors(), this->storage.GetColors() + this->storage.GetCount(), this->colors.begin() + objectCount);
+        this->storage.ResetModified();
 
-    InstanceFactory::ColorData& InstanceFactory::GetColorData()
-    {
-        MAKE_SCOPE_PROFILER("Instancing::BufferColorData");
-
-        this->colors.resize(this->GetCount());
-        auto instance = this->GetInstancePool().begin();
-        for (auto it = this->colors.begin(); it != this->colors.end(); it++, instance++)
+        if (count == 0)
         {
-            *it = instance->GetUnchecked()->GetComponent<Instance>()->GetColor();
+            this->models.front() = Matrix4x4(0.0f);
+            this->normals.front() = Matrix3x3(0.0f);
+            this->colors.front() = MakeVector3(0.0f);
         }
-        if (this->colors.empty()) this->colors.emplace_back(0.0f);
-
-        return this->colors;
+        this->uploadedCount = count;
     }
 
     InstanceFactory::~InstanceFactory()
@@ -153,12 +143,86 @@ namespace MxEngine
             {
                 this->InitMesh(); // MeshSource was updated, re-init mesh
             }
-            else
+            // MxObject instances can change their transform at any moment, but lightweight instances are uploaded only when modified
+            else if (this->GetInstancePool().Allocated() != 0 || this->storage.IsModified() || this->uploadedCount != this->GetCount())
             {
-                this->BufferDataByIndex(mesh, (size_t)this->bufferIndex + 0, this->GetModelData());
-                this->BufferDataByIndex(mesh, (size_t)this->bufferIndex + 1, this->GetNormalData());
-                this->BufferDataByIndex(mesh, (size_t)this->bufferIndex + 2, this->GetColorData());
+                this->BufferInstanceData();
+                this->UploadInstanceData(mesh);
             }
         }
     }
-}
\ No newline at end of file
+
+    void InstanceFactory::UploadInstanceData(const Mesh& mesh)
+    {
+        this->BufferDataByIndex(mesh, (size_t)this->bufferIndex + 0, this->models);
+        this->BufferDataByIndex(mesh, (size_t)this->bufferIndex + 1, this->normals);
+        this->BufferDataByIndex(mesh, (size_t)this->bufferIndex + 2, this->colors);
+    }
+
+    size_t InstanceFactory::SubmitVisibleInstances(const FrustrumCuller& culler, const AABB& boundingBox)
+    {
+        MAKE_SCOPE_PROFILER("Instancing::SubmitVisibleInstances");
+
+        auto& object = MxObject::GetByComponent(*this);
+        auto meshSource = object.GetComponent<MeshSource>();
+        this->visibleCount = 0;
+        if (!meshSource.IsValid()) return 0;
+
+        auto& mesh = *meshSource->Mesh;
+        if ((uint16_t)mesh.GetBufferCount() < this->bufferIndex + 2)
+            this->InitMesh(); // MeshSource was updated, re-init mesh
+
+        size_t visibleCount = this->CullInstances(culler, boundingBox);
+        if (visibleCount != 0) this->UploadInstanceData(mesh);
+        this->visibleCount = visibleCount;
+        return visibleCount;
+    }
+
+    size_t InstanceFactory::CullInstances(const FrustrumCuller& culler, const AABB& boundingBox)
+    {
+        this->RemoveDanglingHandles();
+        this->BufferInstanceData();
+
+        // instance box center is transformed as point, extents are projected on world axes using absolute values of model matrix
+        size_t count = this->GetCount();
+        auto center = boundingBox.GetCenter();
+        auto extent = boundingBox.Length() * 0.5f;
+        this->cullingBoxes.Resize(count);
+        for (size_t i = 0; i < count; i++)
+        {
+            const auto& model = this->models[i];
+            auto worldCenter = Vector3(model * Vector4(center, 1.0f));
+            auto worldExtent = Abs(Vector3(model[0])) * extent.x + Abs(Vector3(model[1])) * extent.y + Abs(Vector3(model[2])) * extent.z;
+            this->cullingBoxes.CenterX[i] = worldCenter.x;
+            this->cullingBoxes.CenterY[i] = worldCenter.y;
+            this->cullingBoxes.CenterZ[i] = worldCenter.z;
+            this->cullingBoxes.ExtentX[i] = worldExtent.x;
+            this->cullingBoxes.ExtentY[i] = worldExtent.y;
+            this->cullingBoxes.ExtentZ[i] = worldExtent.z;
+        }
+        this->cullingVisibility.resize(count);
+        size_t visibleCount = culler.CullAABBs(this->cullingBoxes, this->cullingVisibility.data());
+
+        // compact visible instances to the beginning of upload buffers, keeping their order
+        size_t visibleIndex = 0;
+        for (size_t i = 0; i < count; i++)
+        {
+            if (!this->cullingVisibility[i]) continue;
+            if (visibleIndex != i)
+            {
+                this->models[visibleIndex] = this->models[i];
+                this->normals[visibleIndex] = this->normals[i];
+                this->colors[visibleIndex] = this->colors[i];
+            }
+            visibleIndex++;
+        }
+
+        size_t bufferSize = Max(visibleCount, (size_t)1);
+        this->models.resize(bufferSize);
+        this->normals.resize(bufferSize);
+        this->colors.resize(bufferSize);
+        // uploaded data no longer matches full instance list, so next unculled submission must re-upload it
+        this->uploadedCount = std::numeric_limits<size_t>::max();
+        return visibleCount;
+    }
+}
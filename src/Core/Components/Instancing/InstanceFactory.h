@@ -29,10 +29,14 @@
 #pragma once
 
 #include "Core/Components/Instancing/Instance.h"
+#include "Core/Components/Instancing/InstanceStorage.h"
 #include "Core/Resources/Mesh.h"
+#include "Core/BoundingObjects/FrustrumCuller.h"
 
 namespace MxEngine
 {
+    class MeshSource;
+
     class InstanceView
     {
     public:
@@ -143,10 +147,15 @@ namespace MxEngine
 		using BufferIndex = uint16_t;
 	private:
 		InstancePool pool;
+		InstanceStorage storage;
 		ModelData models;
 		NormalData normals;
 		ColorData colors;
 		BufferIndex bufferIndex = std::numeric_limits<BufferIndex>::max();
+		size_t uploadedCount = 0;
+		size_t visibleCount = 0;
+		AABBArray cullingBoxes;
+		MxVector<uint8_t> cullingVisibility;
 
 		template<typename T>
 		BufferIndex AddInstancedBuffer(Mesh& mesh, const MxVector<T>& data)
@@ -171,21 +180,34 @@ namespace MxEngine
         void SendInstancesToGPU();
 		void Destroy();
 
-        ModelData& GetModelData();
-        NormalData& GetNormalData();
-        ColorData& GetColorData();
+        void BufferInstanceData();
+        void UploadInstanceData(const Mesh& mesh);
 	public:
+		using UpdateReads = ComponentTypes<TransformComponent>;
+		using UpdateWrites = ComponentTypes<MeshSource>;
+		constexpr static UpdatePolicy UpdateMode = UpdatePolicy::MAIN_THREAD;
+
 		bool IsStatic = false;
+		// if set, instances outside of main camera frustrum are not uploaded and not rendered (including shadow passes)
+		bool UseFrustrumCulling = false;
 
 		const InstancePool& GetInstancePool() const { return this->pool; }
 		InstancePool& GetInstancePool() { return this->pool; };
-		size_t GetCount() const { return this->GetInstancePool().Allocated(); }
+		const InstanceStorage& GetInstanceStorage() const { return this->storage; }
+		// lightweight instances without MxObject. They are rendered after all MxObject instances
+		InstanceStorage& GetInstanceStorage() { return this->storage; }
+		size_t GetCount() const { return this->GetInstancePool().Allocated() + this->GetInstanceStorage().GetCount(); }
         InstanceView GetInstances() { return InstanceView{ this->GetInstancePool() }; }
 
 		void Init();
 		void OnUpdate(float timeDelta);
 		MxObject::Handle MakeInstance();
         void SubmitInstances();
+		size_t SubmitVisibleInstances(const FrustrumCuller& culler, const AABB& boundingBox);
+		// computes instance matrices and moves instances visible by culler to the beginning of upload buffers without uploading them
+		size_t CullInstances(const FrustrumCuller& culler, const AABB& boundingBox);
+		// number of instances uploaded by last SubmitVisibleInstances() call
+		size_t GetVisibleCount() const { return this->visibleCount; }
 		void DestroyInstances();
 
 		InstanceFactory() = default;
@@ -0,0 +1,254 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "InstanceStorage.h"
+#include "Utilities/JobSystem/JobSystem.h"
+#include "Utilities/Profiler/Profiler.h"
+
+#include <algorithm>
+
+namespace MxEngine
+{
+    constexpr uint32_t InvalidIndex = std::numeric_limits<uint32_t>::max();
+
+    size_t InstanceStorage::IndexOf(InstanceId id) const
+    {
+        MX_ASSERT(this->IsValid(id));
+        return (size_t)this->idToDense[id];
+    }
+
+    InstanceStorage::InstanceId InstanceStorage::Add(const Vector3& position, const Quaternion& rotation, const Vector3& scale, const Vector3& color)
+    {
+        InstanceId id = InvalidId;
+        this->Add(1, &id, &position, &rotation, &scale, &color);
+        return id;
+    }
+
+    void InstanceStorage::Add(size_t count, InstanceId* ids, const Vector3* positions, const Quaternion* rotations, const Vector3* scales, const Vector3* colors)
+    {
+        size_t first = this->GetCount();
+        size_t newCount = first + count;
+
+        this->positions.resize(newCount, MakeVector3(0.0f));
+        this->rotations.resize(newCount, Quaternion{ 1.0f, 0.0f, 0.0f, 0.0f });
+        this->scales.resize(newCount, MakeVector3(1.0f));
+        this->colors.resize(newCount, MakeVector3(1.0f));
+        this->denseToId.resize(newCount);
+
+        if (positions != nullptr) std::copy(positions, positions + count, this->positions.begin() + first);
+        if (rotations != nullptr) std::copy(rotations, rotations + count, this->rotations.begin() + first);
+        if (scales    != nullptr) std::copy(scales,    scales    + count, this->scales.begin()    + first);
+        if (colors != nullptr)
+        {
+            for (size_t i = 0; i < count; i++)
+                this->colors[first + i] = Clamp(colors[i], MakeVector3(0.0f), MakeVector3(1.0f));
+        }
+
+        for (size_t i = first; i < newCount; i++)
+        {
+            InstanceId id;
+            if (!this->freeIds.empty())
+            {
+                id = this->freeIds.back();
+                this->freeIds.pop_back();
+            }
+            else
+            {
+                id = (InstanceId)this->idToDense.size();
+                this->idToDense.push_back(InvalidIndex);
+            }
+            this->idToDense[id] = (uint32_t)i;
+            this->denseToId[i] = id;
+            if (ids != nullptr) ids[i - first] = id;
+        }
+        this->isModified = true;
+    }
+
+    void InstanceStorage::Remove(InstanceId id)
+    {
+        size_t index = this->IndexOf(id);
+        size_t last = this->GetCount() - 1;
+
+        // move last instance in place of removed one to keep arrays dense
+        if (index != last)
+        {
+            this->positions[index] = this->positions[last];
+            this->rotations[index] = this->rotations[last];
+            this->scales[index] = this->scales[last];
+            this->colors[index] = this->colors[last];
+            this->denseToId[index] = this->denseToId[last];
+            this->idToDense[this->denseToId[index]] = (uint32_t)index;
+        }
+        this->positions.pop_back();
+        this->rotations.pop_back();
+        this->scales.pop_back();
+        this->colors.pop_back();
+        this->denseToId.pop_back();
+
+        this->idToDense[id] = InvalidIndex;
+        this->freeIds.push_back(id);
+        this->isModified = true;
+    }
+
+    void InstanceStorage::Remove(const InstanceId* ids, size_t count)
+    {
+        for (size_t i = 0; i < count; i++)
+            this->Remove(ids[i]);
+    }
+
+    void InstanceStorage::Clear()
+    {
+        this->positions.clear();
+        this->rotations.clear();
+        this->scales.clear();
+        this->colors.clear();
+        this->denseToId.clear();
+        this->idToDense.clear();
+        this->freeIds.clear();
+        this->isModified = true;
+    }
+
+    bool InstanceStorage::IsValid(InstanceId id) const
+    {
+        return id < this->idToDense.size() && this->idToDense[id] != InvalidIndex;
+    }
+
+    void InstanceStorage::Update(const InstanceId* ids, size_t count, const Vector3* positions, const Quaternion* rotations, const Vector3* scales, const Vector3* colors)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            size_t index = this->IndexOf(ids[i]);
+            if (positions != nullptr) this->positions[index] = positions[i];
+            if (rotations != nullptr) this->rotations[index] = rotations[i];
+            if (scales    != nullptr) this->scales[index]    = scales[i];
+            if (colors    != nullptr) this->colors[index]    = Clamp(colors[i], MakeVector3(0.0f), MakeVector3(1.0f));
+        }
+        this->isModified = true;
+    }
+
+    void InstanceStorage::SetPosition(InstanceId id, const Vector3& position)
+    {
+        this->positions[this->IndexOf(id)] = position;
+        this->isModified = true;
+    }
+
+    void InstanceStorage::SetRotation(InstanceId id, const Quaternion& rotation)
+    {
+        this->rotations[this->IndexOf(id)] = rotation;
+        this->isModified = true;
+    }
+
+    void InstanceStorage::SetScale(InstanceId id, const Vector3& scale)
+    {
+        this->scales[this->IndexOf(id)] = scale;
+        this->isModified = true;
+    }
+
+    void InstanceStorage::SetColor(InstanceId id, const Vector3& color)
+    {
+        this->colors[this->IndexOf(id)] = Clamp(color, MakeVector3(0.0f), MakeVector3(1.0f));
+        this->isModified = true;
+    }
+
+    const Vector3& InstanceStorage::GetPosition(InstanceId id) const
+    {
+        return this->positions[this->IndexOf(id)];
+    }
+
+    const Quaternion& InstanceStorage::GetRotation(InstanceId id) const
+    {
+        return this->rotations[this->IndexOf(id)];
+    }
+
+    const Vector3& InstanceStorage::GetScale(InstanceId id) const
+    {
+        return this->scales[this->IndexOf(id)];
+    }
+
+    const Vector3& InstanceStorage::GetColor(InstanceId id) const
+    {
+        return this->colors[this->IndexOf(id)];
+    }
+
+    Vector3* InstanceStorage::GetPositions()
+    {
+        this->isModified = true;
+        return this->positions.data();
+    }
+
+    Quaternion* InstanceStorage::GetRotations()
+    {
+        this->isModified = true;
+        return this->rotations.data();
+    }
+
+    Vector3* InstanceStorage::GetScales()
+    {
+        this->isModified = true;
+        return this->scales.data();
+    }
+
+    void InstanceStorage::ComputeMatrices(Matrix4x4* models, Matrix3x3* normals) const
+    {
+        MAKE_SCOPE_PROFILER("InstanceStorage::ComputeMatrices()");
+
+        const Vector3* positions = this->positions.data();
+        const Quaternion* rotations = this->rotations.data();
+        const Vector3* scales = this->scales.data();
+
+        // model = T * R * S and normal = (R * S)^-T = R * S^-1, both are built from rotation columns without any matrix products
+        JobSystem::ParallelFor(this->GetCount(), 4096, [=](size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; i++)
+            {
+                const auto& q = rotations[i];
+                const auto& s = scales[i];
+                const auto& p = positions[i];
+
+                float xx = q.x * q.x, yy = q.y * q.y, zz = q.z * q.z;
+                float xy = q.x * q.y, xz = q.x * q.z, yz = q.y * q.z;
+                float wx = q.w * q.x, wy = q.w * q.y, wz = q.w * q.z;
+
+                Vector3 r0{ 1.0f - 2.0f * (yy + zz), 2.0f * (xy + wz), 2.0f * (xz - wy) };
+                Vector3 r1{ 2.0f * (xy - wz), 1.0f - 2.0f * (xx + zz), 2.0f * (yz + wx) };
+                Vector3 r2{ 2.0f * (xz + wy), 2.0f * (yz - wx), 1.0f - 2.0f * (xx + yy) };
+
+                auto& model = models[i];
+                model[0] = Vector4(r0 * s.x, 0.0f);
+                model[1] = Vector4(r1 * s.y, 0.0f);
+                model[2] = Vector4(r2 * s.z, 0.0f);
+                model[3] = Vector4(p, 1.0f);
+
+                auto& normal = normals[i];
+                normal[0] = r0 / s.x;
+                normal[1] = r1 / s.y;
+                normal[2] = r2 / s.z;
+            }
+        });
+    }
+}
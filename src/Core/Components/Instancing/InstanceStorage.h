@@ -0,0 +1,140 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include "Utilities/Math/Math.h"
+#include "Utilities/STL/MxVector.h"
+
+namespace MxEngine
+{
+    /*!
+    instance storage keeps lightweight instances as plain SoA arrays (position, rotation, scale, color)
+    in contrast to MxObject-based instances, they have no name, uuid or components, so hundreds of thousands of them can be updated every frame
+    instances are stored densely and addressed by stable ids. Removal moves last instance in place of removed one, but ids stay valid
+    */
+    class InstanceStorage
+    {
+    public:
+        using InstanceId = uint32_t;
+        constexpr static InstanceId InvalidId = std::numeric_limits<InstanceId>::max();
+    private:
+        MxVector<Vector3> positions;
+        MxVector<Quaternion> rotations;
+        MxVector<Vector3> scales;
+        MxVector<Vector3> colors;
+        MxVector<InstanceId> denseToId;
+        MxVector<uint32_t> idToDense;
+        MxVector<InstanceId> freeIds;
+        bool isModified = true;
+
+        size_t IndexOf(InstanceId id) const;
+    public:
+        /*!
+        creates new instance with provided transform and color
+        \returns stable id of created instance
+        */
+        InstanceId Add(const Vector3& position = MakeVector3(0.0f), const Quaternion& rotation = Quaternion{ 1.0f, 0.0f, 0.0f, 0.0f }, const Vector3& scale = MakeVector3(1.0f), const Vector3& color = MakeVector3(1.0f));
+        /*!
+        creates multiple instances at once. Any of data arrays may be nullptr, in that case default value is used
+        \param count number of instances to create
+        \param ids output array of count elements, filled with ids of created instances. May be nullptr
+        */
+        void Add(size_t count, InstanceId* ids, const Vector3* positions = nullptr, const Quaternion* rotations = nullptr, const Vector3* scales = nullptr, const Vector3* colors = nullptr);
+        /*!
+        destroys instance. Its id may be reused by instances created later
+        \param id id of existing instance
+        */
+        void Remove(InstanceId id);
+        /*!
+        destroys multiple instances at once
+        \param ids array of count ids of existing instances
+        */
+        void Remove(const InstanceId* ids, size_t count);
+        /*!
+        destroys all instances
+        */
+        void Clear();
+        /*!
+        checks if instance with provided id exists
+        \returns true if instance exists, false either
+        */
+        bool IsValid(InstanceId id) const;
+        /*!
+        getter for number of instances
+        \returns instance count
+        */
+        size_t GetCount() const { return this->denseToId.size(); }
+
+        /*!
+        updates transforms of multiple instances at once. Any of data arrays may be nullptr, in that case corresponding property is not changed
+        \param ids array of count ids of existing instances
+        */
+        void Update(const InstanceId* ids, size_t count, const Vector3* positions, const Quaternion* rotations = nullptr, const Vector3* scales = nullptr, const Vector3* colors = nullptr);
+
+        void SetPosition(InstanceId id, const Vector3& position);
+        void SetRotation(InstanceId id, const Quaternion& rotation);
+        void SetScale(InstanceId id, const Vector3& scale);
+        void SetColor(InstanceId id, const Vector3& color);
+        const Vector3& GetPosition(InstanceId id) const;
+        const Quaternion& GetRotation(InstanceId id) const;
+        const Vector3& GetScale(InstanceId id) const;
+        const Vector3& GetColor(InstanceId id) const;
+
+        /*!
+        dense arrays of instance data, ordered in the same way as instances are uploaded to GPU. Non-const getters mark storage as modified
+        \returns array of GetCount() elements
+        */
+        Vector3* GetPositions();
+        Quaternion* GetRotations();
+        Vector3* GetScales();
+        const Vector3* GetPositions() const { return this->positions.data(); }
+        const Quaternion* GetRotations() const { return this->rotations.data(); }
+        const Vector3* GetScales() const { return this->scales.data(); }
+        const Vector3* GetColors() const { return this->colors.data(); }
+        /*!
+        getter for stable id of instance by its dense index
+        \param index index in range [0, GetCount())
+        \returns instance id
+        */
+        InstanceId GetId(size_t index) const { return this->denseToId[index]; }
+
+        /*!
+        computes model and normal matrices of all instances directly into provided buffers. Work is split between JobSystem workers
+        \param models output array of GetCount() model matrices
+        \param normals output array of GetCount() normal matrices
+        */
+        void ComputeMatrices(Matrix4x4* models, Matrix3x3* normals) const;
+        /*!
+        checks if any instance was added, removed or changed since last ResetModified() call
+        \returns true if storage needs to be uploaded to GPU
+        */
+        bool IsModified() const { return this->isModified; }
+        void ResetModified() { this->isModified = false; }
+    };
+}
@@ -89,7 +89,7 @@ namespace MxEngine
         {
             auto viewport = Rendering::GetViewport();
             if (viewport.IsValid()) 
-                object->Transform.SetPosition(MxObject::GetByComponent(*viewport).Transform.GetPosition());
+                object->Transform.SetPosition(MxObject::GetByComponent(*viewport).GetWorldPosition());
         });
     }
 }
\ No newline at end of file
@@ -38,5 +38,7 @@ namespace MxEngine
         Vector3 AmbientColor  = MakeVector3(0.3f);
         Vector3 DiffuseColor  = MakeVector3(0.7f);
         Vector3 SpecularColor = MakeVector3(1.0f);
+        // shadow map is refreshed at most once per this number of frames. Unchanged shadow maps are not refreshed at all
+        size_t ShadowUpdateInterval = 1;
     };
 }
\ No newline at end of file
@@ -62,19 +62,19 @@ namespace MxEngine
 
     AABB BoxCollider::GetAABB() const
     {
-        auto& transform = MxObject::GetByComponent(*this).Transform;
+        auto transform = MxObject::GetByComponent(*this).GetWorldTransform();
         return this->boxShape->GetAABB(transform);
     }
 
     BoundingBox BoxCollider::GetBoundingBox() const
     {
-        auto& transform = MxObject::GetByComponent(*this).Transform;
+        auto transform = MxObject::GetByComponent(*this).GetWorldTransform();
         return this->boxShape->GetBoundingBox(transform);
     }
 
     BoundingSphere BoxCollider::GetBoundingSphere() const
     {
-        auto& transform = MxObject::GetByComponent(*this).Transform;
+        auto transform = MxObject::GetByComponent(*this).GetWorldTransform();
         return this->boxShape->GetBoundingSphere(transform);
     }
 
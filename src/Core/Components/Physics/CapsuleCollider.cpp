@@ -74,19 +74,19 @@ namespace MxEngine
 
     AABB CapsuleCollider::GetAABB() const
     {
-        auto& transform = MxObject::GetByComponent(*this).Transform;
+        auto transform = MxObject::GetByComponent(*this).GetWorldTransform();
         return this->capsuleShape->GetAABB(transform);
     }
 
     BoundingSphere CapsuleCollider::GetBoundingSphere() const
     {
-        auto& transform = MxObject::GetByComponent(*this).Transform;
+        auto transform = MxObject::GetByComponent(*this).GetWorldTransform();
         return this->capsuleShape->GetBoundingSphere(transform);
     }
 
     Capsule CapsuleCollider::GetBoundingCapsule() const
     {
-        auto& transform = MxObject::GetByComponent(*this).Transform;
+        auto transform = MxObject::GetByComponent(*this).GetWorldTransform();
         return this->capsuleShape->GetBoundingCapsule(transform);
     }
 
@@ -32,6 +32,10 @@
 namespace MxEngine
 {
     class KeyEvent;
+    class TransformComponent;
+    class RigidBody;
+    class CameraController;
+    class InputController;
 
     class CharacterController
     {
@@ -45,6 +49,10 @@ namespace MxEngine
         bool isGrounded = false;
 
     public:
+        using UpdateReads = ComponentTypes<TransformComponent>;
+        using UpdateWrites = ComponentTypes<RigidBody, CameraController, InputController>;
+        constexpr static UpdatePolicy UpdateMode = UpdatePolicy::MAIN_THREAD;
+
         void OnUpdate(float dt);
 
         bool IsGrounded() const;
@@ -90,13 +90,13 @@ namespace MxEngine
 
     AABB CompoundCollider::GetAABB() const
     {
-        auto& transform = MxObject::GetByComponent(*this).Transform;
+        auto transform = MxObject::GetByComponent(*this).GetWorldTransform();
         return this->compoundShape->GetAABB(transform);
     }
 
     BoundingSphere CompoundCollider::GetBoundingSphere() const
     {
-        auto& transform = MxObject::GetByComponent(*this).Transform;
+        auto transform = MxObject::GetByComponent(*this).GetWorldTransform();
         return this->compoundShape->GetBoundingSphere(transform);
     }
 }
\ No newline at end of file
@@ -74,19 +74,19 @@ namespace MxEngine
 
     AABB CylinderCollider::GetAABB() const
     {
-        auto& transform = MxObject::GetByComponent(*this).Transform;
+        auto transform = MxObject::GetByComponent(*this).GetWorldTransform();
         return this->cylinderShape->GetAABB(transform);
     }
 
     BoundingSphere CylinderCollider::GetBoundingSphere() const
     {
-        auto& transform = MxObject::GetByComponent(*this).Transform;
+        auto transform = MxObject::GetByComponent(*this).GetWorldTransform();
         return this->cylinderShape->GetBoundingSphere(transform);
     }
 
     Cylinder CylinderCollider::GetBoundingCylinder() const
     {
-        auto& transform = MxObject::GetByComponent(*this).Transform;
+        auto transform = MxObject::GetByComponent(*this).GetWorldTransform();
         return this->cylinderShape->GetBoundingCylinder(transform);
     }
 
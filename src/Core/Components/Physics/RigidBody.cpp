@@ -42,19 +42,33 @@ namespace MxEngine
     void RigidBody::UpdateTransform()
     {
         auto& self = MxObject::GetByComponent(*this);
-        auto& selfScale = self.Transform.GetScale();
+        // bullet simulates bodies in world space, so objects attached to parents are converted between world and local space
+        auto parent = self.GetParent();
+        auto worldTransform = self.GetWorldTransform();
+        auto& selfScale = worldTransform.GetScale();
 
         if (this->IsKinematic())
         {
             // if body is kinematic, MxObject's Transform component controls its position
             btTransform tr;
-            ToBulletTransform(tr, self.Transform);
+            ToBulletTransform(tr, worldTransform);
             this->rigidBody->GetNativeHandle()->getMotionState()->setWorldTransform(tr);
         }
         else if (this->rigidBody->HasTransformUpdate())
         {
             // if body is not kinematic, transform is controlled by physics engine
-            FromBulletTransform(self.Transform, this->rigidBody->GetNativeHandle()->getWorldTransform());
+            auto& bodyTransform = this->rigidBody->GetNativeHandle()->getWorldTransform();
+            if (!parent.IsValid())
+            {
+                FromBulletTransform(self.Transform, bodyTransform);
+            }
+            else
+            {
+                FromBulletTransform(worldTransform, bodyTransform);
+                auto parentRotation = parent->GetWorldTransform().GetRotation();
+                self.Transform.SetPosition(Vector3(Inverse(parent->GetWorldMatrix()) * Vector4(worldTransform.GetPosition(), 1.0f)));
+                self.Transform.SetRotation(Inverse(parentRotation) * worldTransform.GetRotation());
+            }
             this->rigidBody->SetTransformUpdateFlag(false);
         }
 
@@ -101,7 +115,7 @@ namespace MxEngine
     void RigidBody::Init()
     {
         auto& self = MxObject::GetByComponent(*this);
-        this->rigidBody = PhysicsFactory::Create<NativeRigidBody>(self.Transform);
+        this->rigidBody = PhysicsFactory::Create<NativeRigidBody>(self.GetWorldTransform());
 
         Physics::SetRigidBodyParent(this->rigidBody->GetNativeHandle(), self);
         // initialized with a bit of bounce. Just because I like it
@@ -35,6 +35,12 @@
 namespace MxEngine
 {
     class MxObject;
+    class TransformComponent;
+    class BoxCollider;
+    class SphereCollider;
+    class CylinderCollider;
+    class CapsuleCollider;
+    class CompoundCollider;
 
     enum class AnisotropicFriction
     {
@@ -54,6 +60,11 @@ namespace MxEngine
     public:
         MXENGINE_MAKE_MOVEONLY(RigidBody);
 
+        using UpdateReads = ComponentTypes<>;
+        using UpdateWrites = ComponentTypes<TransformComponent, BoxCollider, SphereCollider, CylinderCollider, CapsuleCollider, CompoundCollider>;
+        // collider and scale updates modify Bullet collision shapes, which is not safe outside of main thread
+        constexpr static UpdatePolicy UpdateMode = UpdatePolicy::MAIN_THREAD;
+
         NativeRigidBodyHandle GetNativeHandle() const;
 
         void Init();
@@ -62,13 +62,13 @@ namespace MxEngine
 
     AABB SphereCollider::GetAABB() const
     {
-        auto& transform = MxObject::GetByComponent(*this).Transform;
+        auto transform = MxObject::GetByComponent(*this).GetWorldTransform();
         return this->sphereShape->GetAABB(transform);
     }
 
     BoundingSphere SphereCollider::GetBoundingSphere() const
     {
-        auto& transform = MxObject::GetByComponent(*this).Transform;
+        auto transform = MxObject::GetByComponent(*this).GetWorldTransform();
         return this->sphereShape->GetBoundingSphere(transform);
     }
 
@@ -40,7 +40,7 @@ namespace MxEngine
         auto meshSource = object.GetComponent<MeshSource>();
         if (!meshSource.IsValid() || !meshSource->Mesh.IsValid())
         {
-            MXLOG_WARNING("MxEngine::MeshLOD", "LODs are not generated as object has no mesh: " + object.Name);
+            MXLOG_WARNING("MxEngine::MeshLOD", "LODs are not generated as object has no mesh: " + object.GetDisplayName());
             return;
         }
 
@@ -63,7 +63,7 @@ namespace MxEngine
                 submeshLOD.Data = lod.CreateObject(factor);
                 totalIndicies += submeshLOD.Data.GetIndicies().size();
             }
-            MXLOG_DEBUG("MxEngine::MeshLOD", MxFormat("generated LOD with {0} indicies for object: {1}", totalIndicies, object.Name.c_str()));
+            MXLOG_DEBUG("MxEngine::MeshLOD", MxFormat("generated LOD with {0} indicies for object: {1}", totalIndicies, object.GetDisplayName().c_str()));
         }
     }
 
@@ -71,14 +71,15 @@ namespace MxEngine
     {
         if (!this->AutoLODSelection) return;
         auto& object = MxObject::GetByComponent(*this);
-        auto meshSource = object.GetComponent<MeshSource>();
-        if (!meshSource.IsValid()) 
+        // called by renderer from worker threads, so mesh source handle is not copied
+        auto* meshSource = object.BorrowComponent<MeshSource>();
+        if (meshSource == nullptr) 
         {
             this->CurrentLOD = 0; 
             return;
         }
 
-        auto box = meshSource->Mesh->BoundingBox * object.Transform.GetMatrix();
+        auto box = meshSource->Mesh->BoundingBox * object.GetWorldMatrix();
 
         float distance = Length(box.GetCenter() - viewportPosition);
         Vector3 length = box.Length();
@@ -103,4 +104,12 @@ namespace MxEngine
         else
             return this->LODs[this->CurrentLOD - 1];
     }
+
+    BorrowedResource<Mesh, ResourceFactory> MeshLOD::BorrowMeshLOD() const
+    {
+        if (this->CurrentLOD == 0 || this->CurrentLOD >= this->LODs.size())
+            return MxObject::GetByComponent(*this).BorrowComponent<MeshSource>()->Mesh.Borrow();
+        else
+            return this->LODs[this->CurrentLOD - 1].Borrow();
+    }
 }
\ No newline at end of file
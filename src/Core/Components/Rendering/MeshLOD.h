@@ -53,5 +53,7 @@ namespace MxEngine
         void Generate(const LODConfig& config = LODConfig{ });
         void FixBestLOD(const Vector3& viewportPosition, float viewportZoom = 1.0f);
         LODInstance GetMeshLOD() const;
+        // same as GetMeshLOD(), but does not change mesh refcount, so it can be called for objects sharing mesh from several threads
+        BorrowedResource<Mesh, ResourceFactory> BorrowMeshLOD() const;
     };
 }
\ No newline at end of file
@@ -41,6 +41,10 @@ namespace MxEngine
         using MaterialArray = MxVector<MaterialRef>;
 
         MaterialArray Materials;
+        // occluders are rasterized into software depth buffer each frame and hide objects behind them from main camera
+        bool IsOccluder = false;
+        // static objects are merged with other static objects into shared pre-transformed buffers. Object must not have LODs, instances or transparent materials
+        bool IsStatic = false;
 
         MeshRenderer() : MeshRenderer(ResourceFactory::Create<Material>()) { }
         MeshRenderer(MaterialRef material) : Materials(1, std::move(material)) { }
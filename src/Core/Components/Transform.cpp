@@ -44,6 +44,7 @@ namespace MxEngine
         other.GetNormalMatrix(this->transform, this->normalMatrix);
         this->needTransformUpdate = false;
         this->needRotationUpdate = false;
+        this->version++;
     }
 
     TransformComponent::TransformComponent(const TransformComponent& other)
@@ -126,6 +127,11 @@ namespace MxEngine
             inPlaceMatrix = Transpose(Inverse(model));
     }
 
+    uint32_t TransformComponent::GetVersion() const
+    {
+        return this->version;
+    }
+
     const Vector3& TransformComponent::GetTranslation() const
     {
         return this->translation;
@@ -160,6 +166,7 @@ namespace MxEngine
     {
         this->translation = dist;
         this->needTransformUpdate = true;
+        this->version++;
         return *this;
     }
 
@@ -173,6 +180,7 @@ namespace MxEngine
         this->rotation = q;
         this->needRotationUpdate = true;
         this->needTransformUpdate = true;
+        this->version++;
         return *this;
     }
 
@@ -180,6 +188,7 @@ namespace MxEngine
     {
         this->scale = scale;
         this->needTransformUpdate = true;
+        this->version++;
         return *this;
     }
 
@@ -202,6 +211,7 @@ namespace MxEngine
     {
         this->scale *= scale;
         this->needTransformUpdate = true;
+        this->version++;
         return *this;
     }
 
@@ -230,6 +240,7 @@ namespace MxEngine
         this->rotation *= q;
         this->needRotationUpdate = true;
         this->needTransformUpdate = true;
+        this->version++;
         return *this;
     }
 
@@ -252,6 +263,7 @@ namespace MxEngine
     {
         this->translation += dist;
         this->needTransformUpdate = true;
+        this->version++;
         return *this;
     }
 
@@ -45,6 +45,8 @@ namespace MxEngine
 		mutable bool needTransformUpdate = true;
 		mutable bool needRotationUpdate = true;
 		mutable Matrix3x3 normalMatrix{ 0.0f };
+		// incremented on each local transform change, used by TransformHierarchy to detect dirty nodes
+		uint32_t version = 0;
 
 		void Copy(const TransformComponent& other) noexcept;
 	public:
@@ -63,6 +65,7 @@ namespace MxEngine
 		const Matrix3x3& GetNormalMatrix() const;
 		void GetMatrix(Matrix4x4& inPlaceMatrix) const;
 		void GetNormalMatrix(const Matrix4x4& model, Matrix3x3& inPlaceMatrix) const;
+		uint32_t GetVersion() const;
 
 		const Vector3& GetTranslation() const;
 		const Quaternion& GetRotation() const;
@@ -0,0 +1,296 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "TransformHierarchy.h"
+#include "Core/MxObject/MxObject.h"
+#include "Utilities/JobSystem/JobSystem.h"
+#include "Utilities/Profiler/Profiler.h"
+#include "Utilities/Logging/Logger.h"
+#include "Utilities/Memory/Memory.h"
+
+#include <atomic>
+#include <algorithm>
+
+namespace MxEngine
+{
+    struct TransformHierarchyData
+    {
+        using EngineHandle = TransformHierarchy::EngineHandle;
+        constexpr static uint32_t InvalidNode = std::numeric_limits<uint32_t>::max();
+
+        // parent relations are source of truth, node arrays are rebuilt from them when hierarchy structure changes
+        MxHashMap<EngineHandle, EngineHandle> ParentByObject;
+        MxHashMap<EngineHandle, size_t> ChildCount;
+        // node index of each object, indexed by object handle. World matrices are requested for every rendered object each frame,
+        // so lookup must not hash. Objects outside of hierarchy (or with handle past the end) have InvalidNode
+        MxVector<uint32_t> NodeByObject;
+
+        // node arrays, sorted by depth. LevelOffsets[i] is index of first node with depth i
+        MxVector<EngineHandle> Objects;
+        MxVector<uint32_t> Parents;
+        MxVector<uint32_t> LocalVersions;
+        MxVector<uint8_t> Dirty;
+        MxVector<uint32_t> WorldVersions;
+        MxVector<Matrix4x4> WorldMatrices;
+        MxVector<Matrix3x3> NormalMatrices;
+        MxVector<size_t> LevelOffsets;
+
+        size_t UpdatedNodeCount = 0;
+        uint32_t UpdateCount = 0;
+        bool NeedsRebuild = false;
+    };
+
+    void TransformHierarchy::Init()
+    {
+        data = Alloc<TransformHierarchyData>();
+    }
+
+    void TransformHierarchy::Destroy()
+    {
+        Free(data);
+        data = nullptr;
+    }
+
+    TransformHierarchyData* TransformHierarchy::GetImpl()
+    {
+        return data;
+    }
+
+    void TransformHierarchy::Clone(TransformHierarchyData* other)
+    {
+        data = other;
+    }
+
+    bool TransformHierarchy::SetParent(EngineHandle child, EngineHandle parent)
+    {
+        MX_ASSERT(child != InvalidHandle);
+        if (TransformHierarchy::GetParent(child) == parent) return true;
+
+        // check that child is not an ancestor of new parent
+        for (EngineHandle node = parent; node != InvalidHandle; node = TransformHierarchy::GetParent(node))
+        {
+            if (node == child)
+            {
+                MXLOG_WARNING("MxEngine::TransformHierarchy", "cannot set parent of object as it would create a cycle in hierarchy");
+                return false;
+            }
+        }
+
+        TransformHierarchy::RemoveRelation(child);
+        if (parent != InvalidHandle)
+        {
+            data->ParentByObject[child] = parent;
+            data->ChildCount[parent]++;
+        }
+        data->NeedsRebuild = true;
+        return true;
+    }
+
+    TransformHierarchy::EngineHandle TransformHierarchy::GetParent(EngineHandle child)
+    {
+        auto it = data->ParentByObject.find(child);
+        return it != data->ParentByObject.end() ? it->second : InvalidHandle;
+    }
+
+    void TransformHierarchy::RemoveRelation(EngineHandle child)
+    {
+        auto it = data->ParentByObject.find(child);
+        if (it == data->ParentByObject.end()) return;
+
+        auto parentIt = data->ChildCount.find(it->second);
+        if (--parentIt->second == 0) data->ChildCount.erase(parentIt);
+        data->ParentByObject.erase(it);
+    }
+
+    void TransformHierarchy::Remove(EngineHandle object)
+    {
+        TransformHierarchy::RemoveRelation(object);
+
+        if (data->ChildCount.find(object) != data->ChildCount.end())
+        {
+            for (auto it = data->ParentByObject.begin(); it != data->ParentByObject.end();)
+            {
+                if (it->second == object)
+                    it = data->ParentByObject.erase(it);
+                else
+                    it++;
+            }
+            data->ChildCount.erase(object);
+        }
+
+        // handle may be reused by new object before next rebuild, so cached node is dropped immediately
+        if (object < data->NodeByObject.size() && data->NodeByObject[object] != TransformHierarchyData::InvalidNode)
+        {
+            data->NodeByObject[object] = TransformHierarchyData::InvalidNode;
+            data->NeedsRebuild = true;
+        }
+    }
+
+    void TransformHierarchy::Rebuild()
+    {
+        MAKE_SCOPE_PROFILER("TransformHierarchy::Rebuild()");
+
+        // pairs of (depth, object). Roots have zero depth and are added only if they have children
+        MxVector<std::pair<uint32_t, EngineHandle>> nodes;
+        nodes.reserve(data->ParentByObject.size() + data->ChildCount.size());
+        for (const auto& [child, parent] : data->ParentByObject)
+        {
+            uint32_t depth = 1;
+            for (auto it = data->ParentByObject.find(parent); it != data->ParentByObject.end(); it = data->ParentByObject.find(it->second))
+                depth++;
+            nodes.emplace_back(depth, child);
+        }
+        for (const auto& [parent, count] : data->ChildCount)
+        {
+            if (data->ParentByObject.find(parent) == data->ParentByObject.end())
+                nodes.emplace_back(0, parent);
+        }
+        std::sort(nodes.begin(), nodes.end());
+
+        // only entries of previous nodes are reset, so rebuild does not depend on total object count
+        for (EngineHandle object : data->Objects)
+        {
+            if (object < data->NodeByObject.size()) data->NodeByObject[object] = TransformHierarchyData::InvalidNode;
+        }
+
+        size_t nodeCount = nodes.size();
+        data->Objects.resize(nodeCount);
+        data->Parents.resize(nodeCount);
+        data->LocalVersions.resize(nodeCount);
+        data->Dirty.resize(nodeCount);
+        data->WorldVersions.resize(nodeCount);
+        data->WorldMatrices.resize(nodeCount);
+        data->NormalMatrices.resize(nodeCount);
+        data->LevelOffsets.clear();
+
+        for (size_t i = 0; i < nodeCount; i++)
+        {
+            auto [depth, object] = nodes[i];
+            while (data->LevelOffsets.size() <= depth)
+                data->LevelOffsets.push_back(i);
+            data->Objects[i] = object;
+            if (object >= data->NodeByObject.size())
+                data->NodeByObject.resize(object + 1, TransformHierarchyData::InvalidNode);
+            data->NodeByObject[object] = (uint32_t)i;
+        }
+        data->LevelOffsets.push_back(nodeCount);
+
+        // parents always precede children, so their node indices are already known
+        for (size_t i = 0; i < nodeCount; i++)
+        {
+            auto it = data->ParentByObject.find(data->Objects[i]);
+            data->Parents[i] = it != data->ParentByObject.end() ? data->NodeByObject[it->second] : TransformHierarchyData::InvalidNode;
+        }
+
+        data->NeedsRebuild = false;
+    }
+
+    void TransformHierarchy::Update()
+    {
+        MAKE_SCOPE_PROFILER("TransformHierarchy::Update()");
+
+        // after rebuild node indices are shuffled, so all cached matrices must be recomputed
+        bool forceUpdate = data->NeedsRebuild;
+        if (data->NeedsRebuild) TransformHierarchy::Rebuild();
+        uint32_t updateCount = ++data->UpdateCount;
+
+        auto& objects = MxObject::Factory::Get<MxObject>();
+        std::atomic<size_t> updatedNodeCount{ 0 };
+        for (size_t level = 0; level + 1 < data->LevelOffsets.size(); level++)
+        {
+            size_t levelBegin = data->LevelOffsets[level];
+            size_t levelEnd = data->LevelOffsets[level + 1];
+
+            // all parents are in previous levels and are already updated, so nodes of current level are independent
+            JobSystem::ParallelFor(levelEnd - levelBegin, 256, [&objects, &updatedNodeCount, levelBegin, forceUpdate, updateCount](size_t begin, size_t end)
+            {
+                size_t updated = 0;
+                for (size_t i = levelBegin + begin; i < levelBegin + end; i++)
+                {
+                    auto& transform = objects[data->Objects[i]].value.Transform;
+                    uint32_t parent = data->Parents[i];
+                    bool isParentDirty = parent != TransformHierarchyData::InvalidNode && data->Dirty[parent];
+                    bool isDirty = forceUpdate || isParentDirty || transform.GetVersion() != data->LocalVersions[i];
+
+                    data->Dirty[i] = isDirty;
+                    if (!isDirty) continue;
+
+                    data->LocalVersions[i] = transform.GetVersion();
+                    data->WorldVersions[i] = updateCount;
+                    if (parent == TransformHierarchyData::InvalidNode)
+                    {
+                        data->WorldMatrices[i] = transform.GetMatrix();
+                        data->NormalMatrices[i] = transform.GetNormalMatrix();
+                    }
+                    else
+                    {
+                        // inverse-transpose of product is product of inverse-transposes, so parent normal matrix can be reused
+                        data->WorldMatrices[i] = data->WorldMatrices[parent] * transform.GetMatrix();
+                        data->NormalMatrices[i] = data->NormalMatrices[parent] * transform.GetNormalMatrix();
+                    }
+                    updated++;
+                }
+                updatedNodeCount.fetch_add(updated, std::memory_order_relaxed);
+            });
+        }
+        data->UpdatedNodeCount = updatedNodeCount.load();
+    }
+
+    static uint32_t GetNode(TransformHierarchyData& data, TransformHierarchy::EngineHandle object)
+    {
+        return object < data.NodeByObject.size() ? data.NodeByObject[object] : TransformHierarchyData::InvalidNode;
+    }
+
+    const Matrix4x4& TransformHierarchy::GetWorldMatrix(const MxObject& object)
+    {
+        uint32_t node = GetNode(*data, object.GetNativeHandle());
+        return node != TransformHierarchyData::InvalidNode ? data->WorldMatrices[node] : object.Transform.GetMatrix();
+    }
+
+    const Matrix3x3& TransformHierarchy::GetWorldNormalMatrix(const MxObject& object)
+    {
+        uint32_t node = GetNode(*data, object.GetNativeHandle());
+        return node != TransformHierarchyData::InvalidNode ? data->NormalMatrices[node] : object.Transform.GetNormalMatrix();
+    }
+
+    uint32_t TransformHierarchy::GetWorldVersion(const MxObject& object)
+    {
+        uint32_t node = GetNode(*data, object.GetNativeHandle());
+        return node != TransformHierarchyData::InvalidNode ? data->WorldVersions[node] : 0;
+    }
+
+    size_t TransformHierarchy::GetNodeCount()
+    {
+        return data->Objects.size();
+    }
+
+    size_t TransformHierarchy::GetUpdatedNodeCount()
+    {
+        return data->UpdatedNodeCount;
+    }
+}
@@ -0,0 +1,115 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include "Utilities/Math/Math.h"
+#include "Utilities/STL/MxVector.h"
+#include "Utilities/STL/MxHashMap.h"
+
+namespace MxEngine
+{
+    class MxObject;
+
+    struct TransformHierarchyData;
+
+    /*!
+    transform hierarchy stores parent-child relations between MxObjects and caches their world matrices
+    nodes are kept in SoA arrays sorted by depth, so parents are always processed before children. World matrices are
+    recomputed once per frame only for nodes which local transform or parent changed. Nodes of same depth are updated in parallel
+    objects which are not part of any hierarchy have world matrix equal to their local transform matrix
+    */
+    class TransformHierarchy
+    {
+    public:
+        using EngineHandle = size_t;
+        constexpr static EngineHandle InvalidHandle = std::numeric_limits<EngineHandle>::max();
+    private:
+        inline static TransformHierarchyData* data = nullptr;
+
+        static void Rebuild();
+        static void RemoveRelation(EngineHandle child);
+    public:
+        static void Init();
+        static void Destroy();
+        static TransformHierarchyData* GetImpl();
+        static void Clone(TransformHierarchyData* other);
+
+        /*!
+        attaches object to parent. Object local transform becomes relative to parent world transform
+        \param child native handle of child object
+        \param parent native handle of parent object. If InvalidHandle is passed, child is detached from its current parent
+        \returns true if parent was set, false if relation would create a cycle
+        */
+        static bool SetParent(EngineHandle child, EngineHandle parent);
+        /*!
+        getter for object parent
+        \param child native handle of object
+        \returns native handle of parent object or InvalidHandle if object has no parent
+        */
+        static EngineHandle GetParent(EngineHandle child);
+        /*!
+        removes object from hierarchy. All its children are detached and become roots
+        \param object native handle of object
+        */
+        static void Remove(EngineHandle object);
+        /*!
+        recomputes world and normal matrices of all dirty nodes in topological order. Called once per frame by Application
+        */
+        static void Update();
+
+        /*!
+        getter for cached world matrix of object
+        \param object object which world matrix is requested
+        \returns world matrix computed by last Update() or local transform matrix if object is not in hierarchy
+        */
+        static const Matrix4x4& GetWorldMatrix(const MxObject& object);
+        /*!
+        getter for cached world normal matrix of object
+        \param object object which normal matrix is requested
+        \returns normal matrix computed by last Update() or local normal matrix if object is not in hierarchy
+        */
+        static const Matrix3x3& GetWorldNormalMatrix(const MxObject& object);
+        /*!
+        getter for version of object world matrix. Can be used together with local transform version to detect world matrix changes
+        \param object object which world version is requested
+        \returns number of Update() call which last recomputed object world matrix or zero if object is not in hierarchy
+        */
+        static uint32_t GetWorldVersion(const MxObject& object);
+        /*!
+        getter for number of objects in hierarchy
+        \returns node count (including root objects which have children)
+        */
+        static size_t GetNodeCount();
+        /*!
+        getter for number of world matrices recomputed by last Update() call
+        \returns number of dirty nodes
+        */
+        static size_t GetUpdatedNodeCount();
+    };
+}
@@ -116,6 +116,7 @@ namespace MxEngine
         FromJson(config.PointLightTextureSize,  json["renderer"],    "point-light-texture-size");
         FromJson(config.SpotLightTextureSize,   json["renderer"],    "spot-light-texture-size" );
         FromJson(config.EngineTextureSize,      json["renderer"],    "engine-texture-size"     );
+        FromJson(config.HeadlessFrameCount,     json["renderer"],    "headless-frame-count"    );
         FromJson(config.ProjectRootDirectory,   json["filesystem"],  "root"                    );
         FromJson(config.ShaderSourceDirectory,  json["filesystem"],  "shader-source-directory" );
         FromJson(config.ApplicationCloseKey,    json["debug-build"], "app-close-key"           );
@@ -140,6 +141,7 @@ namespace MxEngine
         json["renderer"   ]["point-light-texture-size"] = config.PointLightTextureSize;
         json["renderer"   ]["spot-light-texture-size" ] = config.SpotLightTextureSize;
         json["renderer"   ]["engine-texture-size"     ] = config.EngineTextureSize;
+        json["renderer"   ]["headless-frame-count"    ] = config.HeadlessFrameCount;
         json["filesystem" ]["root"                    ] = config.ProjectRootDirectory;
         json["filesystem" ]["shader-source-directory" ] = config.ShaderSourceDirectory;
         json["debug-build"]["app-close-key"           ] = config.ApplicationCloseKey;
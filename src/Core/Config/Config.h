@@ -89,6 +89,7 @@ namespace MxEngine
         size_t PointLightTextureSize = 512;
         size_t SpotLightTextureSize = 512;
         size_t EngineTextureSize = 512;
+        size_t HeadlessFrameCount = 0; // frames to run with null graphic backend, 0 means unlimited
 
         // Filesystem settings
         MxString ProjectRootDirectory = "Resources";
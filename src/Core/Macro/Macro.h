@@ -21,7 +21,11 @@
 #endif
 
 // graphic api
-#define MXENGINE_USE_OPENGL
+#if defined(MXENGINE_HEADLESS)
+    #define MXENGINE_USE_NULLGRAPHICS
+#else
+    #define MXENGINE_USE_OPENGL
+#endif
 
 // audio api
 #define MXENGINE_USE_OPENAL
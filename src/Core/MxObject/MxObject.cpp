@@ -33,6 +33,9 @@
 #include "Utilities/Format/Format.h"
 #include "Core/Components/Rendering/MeshSource.h"
 #include "Core/Components/Rendering/MeshRenderer.h"
+#include "Core/Components/TransformHierarchy.h"
+
+#include <sstream>
 
 namespace MxEngine
 {
@@ -62,10 +65,16 @@ namespace MxEngine
 
 	MxObject::Handle MxObject::GetByName(const MxString& name)
 	{
+		// unnamed objects are looked up by their uuid. Parse it once instead of formatting every object uuid
+		UUID uuid = UUIDGenerator::GetNull();
+		std::istringstream stream(name.c_str());
+		bool isUUID = static_cast<bool>(stream >> uuid) && stream.peek() == std::char_traits<char>::eof();
+
 		auto& factory = Factory::Get<MxObject>();
 		for (auto& resource : factory)
 		{
-			if (resource.value.Name == name)
+			bool isNameEqual = resource.value.Name.empty() ? isUUID && resource.uuid == uuid : resource.value.Name == name;
+			if (isNameEqual)
 				return MxObject::Handle{ resource.uuid, factory.IndexOf(resource) };
 		}
 		return MxObject::Handle{ };
@@ -84,6 +93,13 @@ namespace MxEngine
 		return MxObject::Handle(managedObject.uuid, handle);
 	}
 
+	MxString MxObject::GetDisplayName() const
+	{
+		if (!this->Name.empty() || this->handle == InvalidHandle) return this->Name;
+		// unnamed objects are displayed by their uuid, which is formatted only on request
+		return (MxString)Factory::Get<MxObject>()[this->handle].uuid;
+	}
+
 	void MxObject::SetDisplayInRuntimeEditor(bool value)
     {
 		#if defined(MXENGINE_MXOBJECT_EDITOR)
@@ -105,8 +121,62 @@ namespace MxEngine
 		return this->handle;
     }
 
+	void MxObject::SetParent(const Handle& parent)
+	{
+		MX_ASSERT(parent.IsValid());
+		TransformHierarchy::SetParent(this->handle, parent->GetNativeHandle());
+	}
+
+	void MxObject::RemoveParent()
+	{
+		TransformHierarchy::SetParent(this->handle, TransformHierarchy::InvalidHandle);
+	}
+
+	MxObject::Handle MxObject::GetParent() const
+	{
+		auto parent = TransformHierarchy::GetParent(this->handle);
+		return parent != TransformHierarchy::InvalidHandle ? MxObject::GetByHandle(parent) : MxObject::Handle{ };
+	}
+
+	const Matrix4x4& MxObject::GetWorldMatrix() const
+	{
+		return TransformHierarchy::GetWorldMatrix(*this);
+	}
+
+	const Matrix3x3& MxObject::GetWorldNormalMatrix() const
+	{
+		return TransformHierarchy::GetWorldNormalMatrix(*this);
+	}
+
+	Vector3 MxObject::GetWorldPosition() const
+	{
+		return Vector3(this->GetWorldMatrix()[3]);
+	}
+
+	TransformComponent MxObject::GetWorldTransform() const
+	{
+		if (TransformHierarchy::GetParent(this->handle) == TransformHierarchy::InvalidHandle)
+			return this->Transform;
+
+		// world matrix is decomposed assuming no shear, which holds as long as non-uniform scale is applied only to leaf objects
+		const auto& world = this->GetWorldMatrix();
+		auto scale = MakeVector3(Length(Vector3(world[0])), Length(Vector3(world[1])), Length(Vector3(world[2])));
+		Matrix3x3 rotation(Vector3(world[0]) / scale.x, Vector3(world[1]) / scale.y, Vector3(world[2]) / scale.z);
+
+		TransformComponent result;
+		result.SetPosition(Vector3(world[3]));
+		result.SetRotation(ToQuaternion(rotation));
+		result.SetScale(scale);
+		return result;
+	}
+
     MxObject::~MxObject()
     {
+		if (this->handle != InvalidHandle)
+		{
+			ComponentFactory::OnObjectDestroyed(this->handle);
+			TransformHierarchy::Remove(this->handle);
+		}
 		this->components.RemoveAllComponents();
     }
 }
\ No newline at end of file
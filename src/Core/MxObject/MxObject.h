@@ -44,6 +44,8 @@ namespace MxEngine
 		using EngineHandle = size_t;
 		using Factory = AbstractFactoryImpl<MxObject>;
 		using Handle = Resource<MxObject, Factory>;
+		// objects are created in large numbers and referenced by address in engine code, so they are stored in stable pages
+		constexpr static bool UsePagedPool = true;
 	private:
 		constexpr static EngineHandle InvalidHandle = std::numeric_limits<EngineHandle>::max();
 		EngineHandle handle = InvalidHandle;
@@ -51,7 +53,8 @@ namespace MxEngine
 		bool displayedInEditorList = true;
 		#endif
 	public:
-		MxString Name = UUIDGenerator::Get();
+		// empty name means that object is unnamed. Use GetDisplayName() to get uuid-based name for such objects
+		MxString Name;
 		TransformComponent Transform;
 	private:
 		// placed here to be destroyed before other members
@@ -77,9 +80,18 @@ namespace MxEngine
 		static MxObject::Handle GetByHandle(EngineHandle handle);
 
 		void SetDisplayInRuntimeEditor(bool value);
+		MxString GetDisplayName() const;
 		bool IsDisplayedInRuntimeEditor() const;
 		EngineHandle GetNativeHandle() const;
 
+		void SetParent(const Handle& parent);
+		void RemoveParent();
+		Handle GetParent() const;
+		const Matrix4x4& GetWorldMatrix() const;
+		const Matrix3x3& GetWorldNormalMatrix() const;
+		Vector3 GetWorldPosition() const;
+		TransformComponent GetWorldTransform() const;
+
 		template<typename T>
 		static Handle GetHandleByComponent(T& component)
 		{
@@ -99,8 +111,13 @@ namespace MxEngine
 		{
 			static_assert(!std::is_same_v<T, TransformComponent>, "Transform component is already present in MxObject");
 
+			size_t type = ComponentFactory::GetTypeIndex<T>();
+			if (this->components.HasComponent<T>())
+				ComponentFactory::OnComponentRemoved(type, this->handle);
+
 			auto component = this->components.AddComponent<T>(std::forward<Args>(args)...);
 			component->UserData = reinterpret_cast<void*>(this->handle);
+			ComponentFactory::OnComponentAdded(type, this->handle, this->components);
 			if constexpr (has_method_Init<T>::value) 
 				component->Init();
 			return component;
@@ -112,6 +129,13 @@ namespace MxEngine
 			return this->components.GetComponent<T>();
 		}
 
+		// returns non-owning pointer to component or nullptr. Does not touch component refcount, so it can be used from worker threads
+		template<typename T>
+		T* BorrowComponent() const
+		{
+			return this->components.BorrowComponent<T>();
+		}
+
 		template<typename T>
 		auto GetOrAddComponent()
 		{
@@ -125,6 +149,7 @@ namespace MxEngine
 		void RemoveComponent()
 		{
 			static_assert(!std::is_same_v<T, MxEngine::TransformComponent>, "Transform component cannot be deleted");
+			ComponentFactory::OnComponentRemoved(ComponentFactory::GetTypeIndex<T>(), this->handle);
 			this->components.RemoveComponent<T>();
 		}
 
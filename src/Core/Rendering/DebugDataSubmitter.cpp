@@ -34,85 +34,94 @@
 
 namespace MxEngine
 {
-    void Process(DebugBuffer& buffer, const DebugDraw& debugDraw, MxObject& object, const MeshSource::Handle& meshSource)
+    // objects can be attached to parents, so debug geometry is placed using cached world matrix instead of local transform
+    static Vector3 GetWorldScale(const MxObject& object)
     {
-        if (meshSource.IsValid())
+        const auto& world = object.GetWorldMatrix();
+        return MakeVector3(Length(Vector3(world[0])), Length(Vector3(world[1])), Length(Vector3(world[2])));
+    }
+
+    void Process(DebugBuffer& buffer, const DebugDraw& debugDraw, MxObject& object, const MeshSource& meshSource)
+    {
+        if (meshSource.Mesh.IsValid())
         {
             if (debugDraw.RenderBoundingBox)
             {
-                for (const auto& submesh : meshSource->Mesh->Submeshes)
+                for (const auto& submesh : meshSource.Mesh->Submeshes)
                 {
-                    auto box = submesh.GetBoundingBox() * (object.Transform.GetMatrix() * submesh.GetTransform()->GetMatrix());
+                    auto box = submesh.GetBoundingBox() * (object.GetWorldMatrix() * submesh.GetTransform()->GetMatrix());
                     buffer.Submit(box, debugDraw.BoundingBoxColor);
                 }
             }
             if (debugDraw.RenderBoundingSphere)
             {
-                for (const auto& submesh : meshSource->Mesh->Submeshes)
+                auto worldScale = GetWorldScale(object);
+                for (const auto& submesh : meshSource.Mesh->Submeshes)
                 {
                     auto sphere = submesh.GetBoundingSphere();
-                    sphere.Center += object.Transform.GetPosition() + submesh.GetTransform()->GetPosition();
-                    sphere.Radius *= ComponentMax(object.Transform.GetScale() * submesh.GetTransform()->GetScale());
+                    auto transform = object.GetWorldMatrix() * submesh.GetTransform()->GetMatrix();
+                    sphere.Center = Vector3(transform * Vector4(sphere.Center, 1.0f));
+                    sphere.Radius *= ComponentMax(worldScale * submesh.GetTransform()->GetScale());
                     buffer.Submit(sphere, debugDraw.BoundingSphereColor);
                 }
             }
         }
     }
 
-    void Process(DebugBuffer& buffer, const DebugDraw& debugDraw, MxObject& object, const PointLight::Handle& pointLight)
+    void Process(DebugBuffer& buffer, const DebugDraw& debugDraw, MxObject& object, const PointLight& pointLight)
     {
-        if (debugDraw.RenderLightingBounds && pointLight.IsValid())
+        if (debugDraw.RenderLightingBounds)
         {
-            BoundingSphere sphere(object.Transform.GetPosition(), pointLight->GetRadius());
+            BoundingSphere sphere(object.GetWorldPosition(), pointLight.GetRadius());
             buffer.Submit(sphere, debugDraw.LightSourceColor);
         }
     }
 
-    void Process(DebugBuffer& buffer, const DebugDraw& debugDraw, MxObject& object, const SpotLight::Handle& spotLight)
+    void Process(DebugBuffer& buffer, const DebugDraw& debugDraw, MxObject& object, const SpotLight& spotLight)
     {
-        if (debugDraw.RenderLightingBounds && spotLight.IsValid())
+        if (debugDraw.RenderLightingBounds)
         {
-            Cone cone(object.Transform.GetPosition(), spotLight->Direction, 3.0f, spotLight->GetOuterAngle());
+            Cone cone(object.GetWorldPosition(), spotLight.Direction, 3.0f, spotLight.GetOuterAngle());
             buffer.Submit(cone, debugDraw.LightSourceColor);
         }
     }
 
-    void Process(DebugBuffer& buffer, const DebugDraw& debugDraw, MxObject& object, const AudioSource::Handle& audioSource)
+    void Process(DebugBuffer& buffer, const DebugDraw& debugDraw, MxObject& object, const AudioSource& audioSource)
     {
-        if (debugDraw.RenderSoundBounds && audioSource.IsValid())
+        if (debugDraw.RenderSoundBounds)
         {
-            if (!audioSource->IsRelative())
+            if (!audioSource.IsRelative())
             {
-                if (audioSource->IsOmnidirectional())
+                if (audioSource.IsOmnidirectional())
                 {
-                    BoundingSphere sphere(object.Transform.GetPosition(), 3.0f);
+                    BoundingSphere sphere(object.GetWorldPosition(), 3.0f);
                     buffer.Submit(sphere, debugDraw.SoundSourceColor);
                 }
                 else
                 {
-                    Cone cone(object.Transform.GetPosition(), audioSource->GetDirection(), 3.0f, audioSource->GetOuterAngle());
+                    Cone cone(object.GetWorldPosition(), audioSource.GetDirection(), 3.0f, audioSource.GetOuterAngle());
                     buffer.Submit(cone, debugDraw.SoundSourceColor);
                 }
             }
         }
     }
 
-    void Process(DebugBuffer& buffer, const DebugDraw& debugDraw, MxObject& object, const CameraController::Handle& cameraController)
+    void Process(DebugBuffer& buffer, const DebugDraw& debugDraw, MxObject& object, const CameraController& cameraController)
     {
-        if (debugDraw.RenderFrustrumBounds && cameraController.IsValid())
+        if (debugDraw.RenderFrustrumBounds)
         {
-            auto direction = cameraController->GetDirection();
-            auto up = cameraController->GetDirectionUp();
-            auto aspect = cameraController->Camera.GetAspectRatio();
-            auto zoom = cameraController->Camera.GetZoom() * 65.0f;
-            Frustrum frustrum(object.Transform.GetPosition() + Normalize(direction), direction, up, zoom, aspect);
+            auto direction = cameraController.GetDirection();
+            auto up = cameraController.GetDirectionUp();
+            auto aspect = cameraController.Camera.GetAspectRatio();
+            auto zoom = cameraController.Camera.GetZoom() * 65.0f;
+            Frustrum frustrum(object.GetWorldPosition() + Normalize(direction), direction, up, zoom, aspect);
             buffer.Submit(frustrum, debugDraw.FrustrumColor);
         }
     }
 
-    void Process(DebugBuffer& buffer, const DebugDraw& debugDraw, MxObject& object, const RigidBody::Handle& rigidBody)
+    void Process(DebugBuffer& buffer, const DebugDraw& debugDraw, MxObject& object, const RigidBody& rigidBody)
     {
-        if (rigidBody.IsValid() && debugDraw.RenderPhysicsCollider)
+        if (debugDraw.RenderPhysicsCollider)
         {
             auto boxCollider = object.GetComponent<BoxCollider>();
             auto sphereCollider = object.GetComponent<SphereCollider>();
@@ -133,7 +142,7 @@ namespace MxEngine
             {
                 for (size_t i = 0; i < compoundCollider->GetShapeCount(); i++)
                 {
-                    auto transform = compoundCollider->GetShapeTransformByIndex(i) * object.Transform;
+                    auto transform = compoundCollider->GetShapeTransformByIndex(i) * object.GetWorldTransform();
                     auto box = compoundCollider->GetShapeByIndex<BoxShape>(i);
                     if (box.IsValid()) buffer.Submit(box->GetBoundingBox(transform), debugDraw.BoundingBoxColor);
 
@@ -150,29 +159,47 @@ namespace MxEngine
         }
     }
 
-    void DebugDataSubmitter::ProcessObject(MxObject& object)
+    template<typename T, typename F>
+    void ForEachDrawn(F&& func)
     {
-        auto debugDrawHandle = object.GetComponent<DebugDraw>();
-        if (!debugDrawHandle.IsValid()) return;
-        auto& debugDraw = *debugDrawHandle.GetUnchecked();
-
-        auto instanceFactory = object.GetComponent<InstanceFactory>();
-        auto instance = object.GetComponent<Instance>();
-        auto meshSource = object.GetComponent<MeshSource>();
-        auto spotLight = object.GetComponent<SpotLight>();
-        auto pointLight = object.GetComponent<PointLight>();
-        auto cameraController = object.GetComponent<CameraController>();
-        auto audioSource = object.GetComponent<AudioSource>();
-        auto rigidBody = object.GetComponent<RigidBody>();
-
-        if (instance.IsValid()) meshSource = instance->GetParent()->GetComponent<MeshSource>();
-        if (instanceFactory.IsValid()) meshSource = { }; // do not show meshSource for factory objects
+        for (auto entry : ComponentFactory::Query<DebugDraw, T>())
+        {
+            auto& component = entry.template Get<T>();
+            func(entry.template Get<DebugDraw>(), MxObject::GetByComponent(component), component);
+        }
+    }
 
-        Process(this->debug, debugDraw, object, meshSource);
-        Process(this->debug, debugDraw, object, pointLight);
-        Process(this->debug, debugDraw, object, spotLight);
-        Process(this->debug, debugDraw, object, audioSource);
-        Process(this->debug, debugDraw, object, cameraController);
-        Process(this->debug, debugDraw, object, rigidBody);
+    void DebugDataSubmitter::ProcessComponents()
+    {
+        ForEachDrawn<MeshSource>([this](const DebugDraw& debugDraw, MxObject& object, const MeshSource& meshSource)
+        {
+            // do not show meshSource for factory objects
+            if (!object.HasComponent<InstanceFactory>()) Process(this->debug, debugDraw, object, meshSource);
+        });
+        ForEachDrawn<Instance>([this](const DebugDraw& debugDraw, MxObject& object, Instance& instance)
+        {
+            auto meshSource = instance.GetParent()->GetComponent<MeshSource>();
+            if (meshSource.IsValid()) Process(this->debug, debugDraw, object, *meshSource);
+        });
+        ForEachDrawn<PointLight>([this](const DebugDraw& debugDraw, MxObject& object, const PointLight& pointLight)
+        {
+            Process(this->debug, debugDraw, object, pointLight);
+        });
+        ForEachDrawn<SpotLight>([this](const DebugDraw& debugDraw, MxObject& object, const SpotLight& spotLight)
+        {
+            Process(this->debug, debugDraw, object, spotLight);
+        });
+        ForEachDrawn<AudioSource>([this](const DebugDraw& debugDraw, MxObject& object, const AudioSource& audioSource)
+        {
+            Process(this->debug, debugDraw, object, audioSource);
+        });
+        ForEachDrawn<CameraController>([this](const DebugDraw& debugDraw, MxObject& object, const CameraController& cameraController)
+        {
+            Process(this->debug, debugDraw, object, cameraController);
+        });
+        ForEachDrawn<RigidBody>([this](const DebugDraw& debugDraw, MxObject& object, const RigidBody& rigidBody)
+        {
+            Process(this->debug, debugDraw, object, rigidBody);
+        });
     }
 }
\ No newline at end of file
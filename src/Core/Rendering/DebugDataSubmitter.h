@@ -30,7 +30,6 @@
 
 namespace MxEngine
 {
-    class MxObject;
     class DebugBuffer;
 
     class DebugDataSubmitter
@@ -39,6 +38,10 @@ namespace MxEngine
     public:
         DebugDataSubmitter(DebugBuffer& debug) : debug(debug) { }
 
-        void ProcessObject(MxObject& object);
+        /*!
+        submits debug geometry of all objects which have DebugDraw component. Objects are taken from component queries,
+        one for each type of component which can be drawn
+        */
+        void ProcessComponents();
     };
 }
\ No newline at end of file
@@ -44,11 +44,34 @@
 #include "Core/Components/Lighting/SpotLight.h"
 #include "Core/Components/Instancing/InstanceFactory.h"
 #include "Core/Rendering/DebugDataSubmitter.h"
+#include "Core/Application/SceneIndex.h"
 #include "Utilities/Profiler/Profiler.h"
+#include "Utilities/JobSystem/JobSystem.h"
 #include "Utilities/FileSystem/FileManager.h"
 
 namespace MxEngine
 {
+    static bool IsStaticBatched(const MxObject& object, const MeshSource& meshSource, const MeshRenderer& meshRenderer)
+    {
+        if (!meshRenderer.IsStatic || !meshSource.IsDrawn || !meshSource.Mesh.IsValid()) return false;
+        // LODs and instances change geometry of object at runtime, so such objects are always submitted separately
+        if (object.HasComponent<MeshLOD>() || object.HasComponent<InstanceFactory>()) return false;
+
+        for (const auto& submesh : meshSource.Mesh->Submeshes)
+        {
+            if (submesh.Data.GetVertecies().empty() || submesh.Data.GetIndicies().empty()) return false;
+
+            // transparent primitives must be sorted back to front each frame, so they cannot be merged into static geometry
+            auto materialId = submesh.GetMaterialId();
+            if (materialId < meshRenderer.Materials.size())
+            {
+                const auto& material = meshRenderer.Materials[materialId];
+                if (material.IsValid() && material->Transparency < 1.0f) return false;
+            }
+        }
+        return true;
+    }
+
     void RenderAdaptor::InitRendererEnvironment()
     {
         MAKE_SCOPE_PROFILER("RenderAdaptor::InitEnvironment()");
@@ -67,25 +90,30 @@ namespace MxEngine
         environment.SkyboxCubeObject.Init();
         this->DebugDrawer.Init();
         environment.DebugBufferObject.VAO = this->DebugDrawer.GetVAO();
+        this->StaticBatchTransform = ComponentFactory::CreateComponent<TransformComponent>();
 
-        // light bounding objects
+        // light bounding objects. Helper objects draw whole index buffer and attach instanced buffers, so they do not use geometry arena
         auto pyramid = Primitives::CreatePyramid();
         auto& pyramidMesh = pyramid->Submeshes.front();
+        pyramidMesh.Data.DetachFromArena();
         this->Renderer.GetLightInformation().PyramidLight =
             RenderHelperObject(pyramidMesh.Data.GetVBO(), pyramidMesh.Data.GetVAO(), pyramidMesh.Data.GetIBO());
 
         auto sphere = Primitives::CreateSphere(8);
         auto& sphereMesh = sphere->Submeshes.front();
+        sphereMesh.Data.DetachFromArena();
         this->Renderer.GetLightInformation().SphereLight =
             RenderHelperObject(sphereMesh.Data.GetVBO(), sphereMesh.Data.GetVAO(), sphereMesh.Data.GetIBO());
 
         auto pyramidInstanced = Primitives::CreatePyramid();
         auto& pyramidInstancedMesh = pyramidInstanced->Submeshes.front();
+        pyramidInstancedMesh.Data.DetachFromArena();
         this->Renderer.GetLightInformation().SpotLightsInstanced = 
             SpotLightInstancedObject(pyramidInstancedMesh.Data.GetVBO(), pyramidInstancedMesh.Data.GetVAO(), pyramidInstancedMesh.Data.GetIBO());
 
         auto sphereInstanced = Primitives::CreateSphere(8);
         auto& sphereInstancedMesh = sphereInstanced->Submeshes.front();
+        sphereInstancedMesh.Data.DetachFromArena();
         this->Renderer.GetLightInformation().PointLigthsInstanced =
             PointLightInstancedObject(sphereInstancedMesh.Data.GetVBO(), sphereInstancedMesh.Data.GetVAO(), sphereInstancedMesh.Data.GetIBO());
 
@@ -235,6 +263,17 @@ namespace MxEngine
         environment.DepthFrameBuffer->UseOnlyDepth();
         environment.PostProcessFrameBuffer = GraphicFactory::Create<FrameBuffer>();
 
+        // uniform blocks of all shaders are repacked every frame, so buffer is resized on first submission
+        environment.FrameUniformBuffer = GraphicFactory::Create<UniformBuffer>();
+
+        // instance buffer is refilled by each instanced pass, layouts are used when vertex array of new geometry is built
+        environment.DynamicInstanceBuffer = GraphicFactory::Create<VertexBuffer>();
+        environment.DynamicInstanceLayout = GraphicFactory::Create<VertexBufferLayout>();
+        environment.DynamicInstanceLayout->Push<Matrix4x4>(); // model
+        environment.DynamicInstanceLayout->Push<Matrix3x3>(); // normal
+        environment.DynamicInstanceLayout->Push<Vector3>(); // color
+        environment.MeshVertexLayout = MeshData::CreateVertexLayout();
+
         auto bloomBufferSize = (int)GlobalConfig::GetEngineTextureSize();
         for (auto& bloomBuffer : environment.BloomBuffers)
         {
@@ -258,7 +297,7 @@ namespace MxEngine
         float viewportZoom = 0.0f;
         if (this->Viewport.IsValid())
         {
-            viewportPosition = MxObject::GetByComponent(*this->Viewport).Transform.GetPosition();
+            viewportPosition = MxObject::GetByComponent(*this->Viewport).GetWorldPosition();
             viewportZoom = this->Viewport->Camera.GetZoom();
         }
 
@@ -278,10 +317,12 @@ namespace MxEngine
         {
             MAKE_SCOPE_PROFILER("RenderAdaptor::SubmitCameras()");
             auto cameraView = ComponentFactory::GetView<CameraController>();
+            this->CameraCullers.clear();
             for (const auto& camera : cameraView)
             {
+                // cameras and lights can be attached to other objects, so they are placed using world transform
                 auto& object = MxObject::GetByComponent(camera);
-                auto& transform = object.Transform;
+                auto transform = object.GetWorldTransform();
 
                 auto skyboxComponent = object.GetComponent<Skybox>();
                 auto effectsComponent = object.GetComponent<CameraEffects>();
@@ -293,43 +334,113 @@ namespace MxEngine
                 CameraSSR* ssr                 = ssrComponent.IsValid()         ? ssrComponent.GetUnchecked()         : nullptr;
 
                 this->Renderer.SubmitCamera(camera, transform, skybox, effects, toneMapping, ssr);
+                this->CameraCullers.push_back(camera.GetFrustrumCuller());
                 TrackMainCameraIndex(camera);
             }
         }
 
-        // submit render units
-        auto meshSourceView = ComponentFactory::GetView<MeshSource>();
+        // objects outside of all camera frustrums are submitted only as shadow casters
+        SceneIndex::ComputeVisibility(this->CameraCullers.data(), this->CameraCullers.size());
+
+        // instance culling uploads data to GPU, so it is performed on main thread before parallel submission
+        if (this->Viewport.IsValid())
+        {
+            MAKE_SCOPE_PROFILER("RenderAdaptor::CullInstances()");
+            auto instanceView = ComponentFactory::GetView<InstanceFactory>();
+            for (auto& instances : instanceView)
+            {
+                if (!instances.UseFrustrumCulling) continue;
+                auto meshSource = MxObject::GetByComponent(instances).GetComponent<MeshSource>();
+                if (!meshSource.IsValid() || !meshSource->IsDrawn) continue;
+                instances.SubmitVisibleInstances(this->Viewport->GetFrustrumCuller(), meshSource->Mesh->BoundingBox);
+            }
+        }
+
+        if (this->UseStaticBatching)
+        {
+            this->UpdateStaticBatches();
+        }
+
+        // submesh transforms are shared by all objects using the same mesh, so their matrices are updated once here
+        // and submission jobs below only read them
+        this->UpdateSubmeshTransforms();
+
+        // submit render units. Objects with mesh source and mesh renderer are taken from component query and split into slices,
+        // each slice is prepared by its own job into separate buffer and then buffers are merged in slice order,
+        // so resulting render units have the same order for any number of submission workers. Note that this order is the order
+        // of query match list, not of MeshSource pool: the list is seeded by iterating MxHashMap in ComponentFactory::RegisterQuery
+        // and then changed by appends and swap-removes, so render unit order must not be relied on beyond being deterministic
         {
             MAKE_SCOPE_PROFILER("RenderAdaptor::SubmitMeshPrimitives()");
-            for (const auto& meshSource : meshSourceView)
+            auto meshQuery = ComponentFactory::Query<MeshSource, MeshRenderer>();
+            bool isViewportValid = this->Viewport.IsValid();
+
+            RenderAdaptor::GatherSlices(meshQuery.size(), this->GetSubmissionWorkerCount(), this->SubmissionSlices,
+                [&](size_t i, MxVector<PrimitiveSubmission>& primitives)
             {
+                auto entry = meshQuery[i];
+                const auto& meshSource = entry.Get<MeshSource>();
+                const auto& meshRenderer = entry.Get<MeshRenderer>();
+                if (!meshSource.IsDrawn) return;
+
                 auto& object = MxObject::GetByComponent(meshSource);
-                auto& transform = object.Transform;
-                auto meshRenderer = object.GetComponent<MeshRenderer>();
-                auto meshLOD = object.GetComponent<MeshLOD>();
-                auto instances = object.GetComponent<InstanceFactory>();
+                if (this->UseStaticBatching && IsStaticBatched(object, meshSource, meshRenderer)) return;
+
+                // components are borrowed, as copying their handles would change refcounts from worker threads
+                auto* meshLOD = object.BorrowComponent<MeshLOD>();
+                auto* instances = object.BorrowComponent<InstanceFactory>();
+                auto& worldMatrix = object.GetWorldMatrix();
+                auto& worldNormalMatrix = object.GetWorldNormalMatrix();
+                // borrowed handles are used to avoid refcount changes, as mesh source and LOD keep meshes alive during frame
+                auto mesh = meshSource.Mesh.Borrow();
 
                 size_t instanceCount = 0;
-                if (instances.IsValid()) instanceCount = instances->GetCount();
-                auto mesh = meshSource.Mesh;
+                if (instances != nullptr)
+                {
+                    bool isCulled = instances->UseFrustrumCulling && isViewportValid;
+                    instanceCount = isCulled ? instances->GetVisibleCount() : instances->GetCount();
+                    if (isCulled && instanceCount == 0) return; // zero instance count means non-instanced draw, so whole object is skipped
+                }
 
-                if (!meshSource.IsDrawn || !meshRenderer.IsValid()) continue;
+                bool isVisible = instanceCount > 0 || SceneIndex::IsVisible(object.GetNativeHandle());
 
                 // we do not try to use LODs for instanced objects, as its quite hard and time consuming. TODO: fix this
-                if (meshLOD.IsValid() && instanceCount == 0)
+                if (meshLOD != nullptr && instanceCount == 0)
                 {
                     meshLOD->FixBestLOD(viewportPosition, viewportZoom);
-                    mesh = meshLOD->GetMeshLOD();
+                    mesh = meshLOD->BorrowMeshLOD();
                 }
 
-                auto& submeshes = mesh->Submeshes;
-                for (const auto& submesh : submeshes)
+                for (const auto& submesh : mesh->Submeshes)
                 {
                     auto materialId = submesh.GetMaterialId();
-                    if (materialId >= meshRenderer->Materials.size()) continue;
-                    auto material = meshRenderer->Materials[materialId];
+                    if (materialId >= meshRenderer.Materials.size()) continue;
+                    auto material = meshRenderer.Materials[materialId].Borrow();
+
+                    auto& primitive = primitives.emplace_back();
+                    RenderController::PreparePrimitive(submesh, *material, worldMatrix, worldNormalMatrix, instanceCount, isVisible, primitive);
+                    // static instances are uploaded once, so their shadows can be cached as for non-instanced objects
+                    if (instanceCount > 0 && instances->IsStatic && !instances->UseFrustrumCulling) primitive.IsDynamic = false;
+                    primitive.IsOccluder = meshRenderer.IsOccluder && instanceCount == 0;
+                }
+            });
+
+            // resource handles are copied only here, as their refcounts are not thread-safe
+            for (const auto& primitives : this->SubmissionSlices)
+            {
+                for (const auto& primitive : primitives)
+                    this->Renderer.SubmitPrimitive(primitive);
+            }
 
-                    this->Renderer.SubmitPrimitive(submesh, *material, transform, instanceCount);
+            // batches are stored in world space and culled by their bounding boxes, as they do not belong to any object
+            if (this->UseStaticBatching)
+            {
+                PrimitiveSubmission primitive;
+                for (const auto& batch : this->StaticBatches)
+                {
+                    RenderController::PreparePrimitive(batch.Geometry, *batch.Material, Matrix4x4(1.0f), Matrix3x3(1.0f), 0, true, primitive);
+                    primitive.IsOccluder = batch.IsOccluder;
+                    this->Renderer.SubmitPrimitive(primitive);
                 }
             }
         }
@@ -339,21 +450,21 @@ namespace MxEngine
             auto dirLightView = ComponentFactory::GetView<DirectionalLight>();
             for (const auto& dirLight : dirLightView)
             {
-                auto& transform = MxObject::GetByComponent(dirLight).Transform;
+                auto transform = MxObject::GetByComponent(dirLight).GetWorldTransform();
                 this->Renderer.SubmitLightSource(dirLight, transform);
             }
 
             auto spotLightView = ComponentFactory::GetView<SpotLight>();
             for (const auto& spotLight : spotLightView)
             {
-                auto& transform = MxObject::GetByComponent(spotLight).Transform;
+                auto transform = MxObject::GetByComponent(spotLight).GetWorldTransform();
                 this->Renderer.SubmitLightSource(spotLight, transform);
             }
 
             auto pointLightView = ComponentFactory::GetView<PointLight>();
             for (const auto& pointLight : pointLightView)
             {
-                auto& transform = MxObject::GetByComponent(pointLight).Transform;
+                auto transform = MxObject::GetByComponent(pointLight).GetWorldTransform();
                 this->Renderer.SubmitLightSource(pointLight, transform);
             }
         }
@@ -362,14 +473,8 @@ namespace MxEngine
             MAKE_SCOPE_PROFILER("RenderAdaptor::SubmitDebugData()");
 
             DebugDataSubmitter debugProcessor(this->DebugDrawer);
+            debugProcessor.ProcessComponents();
 
-            auto debugDrawView = ComponentFactory::GetView<DebugDraw>();
-            for (auto& debugDraw : debugDrawView)
-            {
-                auto& object = MxObject::GetByComponent(debugDraw);
-                debugProcessor.ProcessObject(object);
-            }
-                
             environment.DebugBufferObject.VertexCount = this->DebugDrawer.GetSize();
             environment.OverlayDebugDraws = this->DebugDrawer.DrawAsScreenOverlay;
             this->DebugDrawer.SubmitBuffer();
@@ -381,6 +486,111 @@ namespace MxEngine
         this->Renderer.StartPipeline();
     }
 
+    void RenderAdaptor::UpdateSubmeshTransforms()
+    {
+        MAKE_SCOPE_PROFILER("RenderAdaptor::UpdateSubmeshTransforms()");
+        // cached matrices are recomputed only for changed transforms, so this pass costs one flag check per submesh of each loaded mesh
+        for (const auto& mesh : ResourceFactory::Get<Mesh>())
+        {
+            for (const auto& submesh : mesh.value.Submeshes)
+                (void)submesh.BorrowTransform()->GetNormalMatrix();
+        }
+    }
+
+    void RenderAdaptor::UpdateStaticBatches()
+    {
+        MAKE_SCOPE_PROFILER("RenderAdaptor::UpdateStaticBatches()");
+        auto meshQuery = ComponentFactory::Query<MeshSource, MeshRenderer>();
+
+        // static set is compared by its hash, so batches are rebuilt only when static objects are added, removed or changed.
+        // Query order changes when other objects are removed, so hashes of objects are summed to make signature independent of it
+        uint64_t signature = 0;
+        for (auto entry : meshQuery)
+        {
+            const auto& meshSource = entry.Get<MeshSource>();
+            const auto& meshRenderer = entry.Get<MeshRenderer>();
+            auto& object = MxObject::GetByComponent(meshSource);
+            if (!IsStaticBatched(object, meshSource, meshRenderer)) continue;
+
+            uint64_t objectHash = HashCombine(0, object.GetNativeHandle());
+            objectHash = HashCombine(objectHash, meshSource.Mesh.GetUUID().GetHashCode());
+            objectHash = HashCombine(objectHash, meshRenderer.IsOccluder);
+            objectHash = HashFloats(objectHash, &object.GetWorldMatrix()[0][0], 16);
+            for (const auto& material : meshRenderer.Materials)
+                objectHash = HashCombine(objectHash, material.IsValid() ? material.GetUUID().GetHashCode() : 0);
+            for (const auto& submesh : meshSource.Mesh->Submeshes)
+            {
+                objectHash = HashFloats(objectHash, &submesh.BorrowTransform().GetUnchecked()->GetMatrix()[0][0], 16);
+                objectHash = HashCombine(objectHash, submesh.Data.GetGeometryVersion());
+            }
+            signature += objectHash;
+        }
+        if (signature == this->StaticBatchSignature) return;
+        this->StaticBatchSignature = signature;
+
+        // each pair of material and occluder flag forms its own group, so batches can be submitted as ordinary render units
+        MxVector<std::pair<MaterialHandle, bool>> groups;
+        MxHashMap<uint64_t, size_t> groupIds;
+        PrimitiveSubmission primitive;
+        for (auto entry : meshQuery)
+        {
+            const auto& meshSource = entry.Get<MeshSource>();
+            const auto& meshRenderer = entry.Get<MeshRenderer>();
+            auto& object = MxObject::GetByComponent(meshSource);
+            if (!IsStaticBatched(object, meshSource, meshRenderer)) continue;
+
+            for (const auto& submesh : meshSource.Mesh->Submeshes)
+            {
+                auto materialId = submesh.GetMaterialId();
+                if (materialId >= meshRenderer.Materials.size()) continue;
+                const auto& material = meshRenderer.Materials[materialId];
+                if (!material.IsValid()) continue;
+
+                uint64_t groupKey = HashCombine(material.GetUUID().GetHashCode(), meshRenderer.IsOccluder);
+                auto it = groupIds.find(groupKey);
+                if (it == groupIds.end())
+                {
+                    it = groupIds.emplace(groupKey, groups.size()).first;
+                    groups.emplace_back(material, meshRenderer.IsOccluder);
+                }
+
+                RenderController::PreparePrimitive(submesh, *material, object.GetWorldMatrix(), object.GetWorldNormalMatrix(), 0, true, primitive);
+                this->StaticBatcher.AddSource(submesh.Data, primitive.ModelMatrix, primitive.NormalMatrix, it->second);
+            }
+        }
+
+        this->StaticBatcher.Build();
+        auto& batches = this->StaticBatcher.GetBatches();
+
+        this->StaticBatches.clear();
+        this->StaticBatches.reserve(batches.size());
+        for (auto& batch : batches)
+        {
+            const auto& group = groups[batch.GroupId];
+            auto& unit = this->StaticBatches.emplace_back(StaticBatchUnit{ SubMesh(0, this->StaticBatchTransform), group.first, group.second });
+            unit.Geometry.Name = "StaticBatch";
+            unit.Geometry.Data.GetVertecies() = std::move(batch.Vertecies);
+            unit.Geometry.Data.GetIndicies() = std::move(batch.Indicies);
+        }
+
+        JobSystem::ParallelFor(this->StaticBatches.size(), 1, [this](size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; i++)
+                this->StaticBatches[i].Geometry.Data.UpdateBoundingGeometry();
+        });
+
+        // buffers are created on main thread, as graphic API calls are not thread-safe. Occluders keep CPU copy for software rasterization
+        for (auto& unit : this->StaticBatches)
+        {
+            unit.Geometry.Data.BufferVertecies();
+            unit.Geometry.Data.BufferIndicies();
+            if (!unit.IsOccluder) unit.Geometry.Data.FreeMeshDataCopy();
+        }
+
+        // sources point to mesh data owned by scene objects, so they are not kept between rebuilds
+        this->StaticBatcher.Clear();
+    }
+
     void RenderAdaptor::SubmitRenderedFrame()
     {
         this->Renderer.EndPipeline();
@@ -444,4 +654,30 @@ namespace MxEngine
     {
         return (size_t)this->Renderer.GetEnvironment().ShadowBlurIterations;
     }
+
+    void RenderAdaptor::SetSubmissionWorkerCount(size_t count)
+    {
+        this->SubmissionWorkerCount = count;
+    }
+
+    size_t RenderAdaptor::GetSubmissionWorkerCount() const
+    {
+        return this->SubmissionWorkerCount != 0 ? this->SubmissionWorkerCount : JobSystem::GetThreadCount();
+    }
+    void RenderAdaptor::SetStaticBatching(bool value)
+    {
+        this->UseStaticBatching = value;
+        if (!value) this->InvalidateStaticBatches();
+    }
+
+    bool RenderAdaptor::IsStaticBatchingEnabled() const
+    {
+        return this->UseStaticBatching;
+    }
+
+    void RenderAdaptor::InvalidateStaticBatches()
+    {
+        this->StaticBatches.clear();
+        this->StaticBatchSignature = 0;
+    }
 }
\ No newline at end of file
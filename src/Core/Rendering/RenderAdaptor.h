@@ -30,14 +30,67 @@
 
 #include "Core/Rendering/RenderController.h"
 #include "Core/Components/Camera/CameraController.h"
+#include "Core/Resources/SubMesh.h"
+#include "RenderUtilities/StaticBatchBuilder.h"
+#include "Utilities/JobSystem/JobSystem.h"
 
 namespace MxEngine
 {
+    // merged geometry of static submeshes sharing one material and one spatial cell
+    struct StaticBatchUnit
+    {
+        SubMesh Geometry;
+        MaterialHandle Material;
+        bool IsOccluder;
+    };
+
     struct RenderAdaptor
     {
         RenderController Renderer;
         DebugBuffer DebugDrawer;
         CameraController::Handle Viewport;
+        MxVector<FrustrumCuller> CameraCullers;
+        MxVector<MxVector<PrimitiveSubmission>> SubmissionSlices;
+        // number of jobs used to prepare render units. Zero means that all job system threads are used
+        size_t SubmissionWorkerCount = 0;
+        StaticBatchBuilder StaticBatcher;
+        MxVector<StaticBatchUnit> StaticBatches;
+        TransformComponent::Handle StaticBatchTransform;
+        // hash of all static objects used in last batch build. Batches are rebuilt only when it changes
+        uint64_t StaticBatchSignature = 0;
+        bool UseStaticBatching = true;
+
+        void UpdateStaticBatches();
+        void UpdateSubmeshTransforms();
+
+        /*!
+        splits items into slices, each slice is gathered by its own job into separate buffer. Items are assigned to slices in order,
+        so iterating slices one by one gives the same sequence of results for any slice count
+        \param itemCount number of items to gather
+        \param sliceCount number of jobs to use. Clamped to [1, itemCount]
+        \param slices buffers for each slice. Resized to actual slice count and cleared before gathering
+        \param gather functor with signature void(size_t item, MxVector<T>& slice), called once for each item
+        */
+        template<typename T, typename F>
+        static void GatherSlices(size_t itemCount, size_t sliceCount, MxVector<MxVector<T>>& slices, F&& gather)
+        {
+            sliceCount = Max(Min(sliceCount, itemCount), (size_t)1);
+            size_t sliceSize = (itemCount + sliceCount - 1) / sliceCount;
+            slices.resize(sliceCount);
+
+            JobSystem::ParallelFor(sliceCount, 1, [&](size_t sliceBegin, size_t sliceEnd)
+            {
+                for (size_t slice = sliceBegin; slice < sliceEnd; slice++)
+                {
+                    auto& results = slices[slice];
+                    results.clear();
+
+                    size_t end = Min((slice + 1) * sliceSize, itemCount);
+                    for (size_t item = slice * sliceSize; item < end; item++)
+                        gather(item, results);
+                }
+            });
+        }
 
         constexpr static TextureFormat HDRTextureFormat = TextureFormat::RGBA16F;
         void InitRendererEnvironment();
@@ -55,5 +108,10 @@ namespace MxEngine
         float GetFogDistance() const;
         void SetShadowBlurIterations(size_t iterations);
         size_t GetShadowBlurIterations() const;
+        void SetSubmissionWorkerCount(size_t count);
+        size_t GetSubmissionWorkerCount() const;
+        void SetStaticBatching(bool value);
+        bool IsStaticBatchingEnabled() const;
+        void InvalidateStaticBatches();
     };
 }
\ No newline at end of file
@@ -40,15 +40,53 @@
 #include "Utilities/Profiler/Profiler.h"
 #include "RenderUtilities/ShadowMapGenerator.h"
 
+#include <cstring>
+
 namespace MxEngine
 {
 	constexpr size_t MaxDirLightCount = 4;
 
+	// binding points of uniform blocks, shared by all shaders which declare them
+	constexpr unsigned int CameraBlockBinding = 0;
+	constexpr unsigned int DirLightBlockBinding = 1;
+	constexpr unsigned int MaterialBlockBinding = 2;
+
+	static const UniformSlot CameraBufferSlot("CameraBuffer");
+	static const UniformSlot DirLightBufferSlot("DirLightBuffer");
+	static const UniformSlot MaterialBufferSlot("MaterialBuffer");
+	static const UniformSlot ViewProjMatrixSlot("ViewProjMatrix");
+	static const UniformSlot GammaSlot("gamma");
+	static const UniformSlot DisplacementSlot("displacement");
+	static const UniformSlot PcfDistanceSlot("pcfDistance");
+	static const UniformSlot AlbedoMapSlot("map_albedo");
+	static const UniformSlot SpecularMapSlot("map_specular");
+	static const UniformSlot EmmisiveMapSlot("map_emmisive");
+	static const UniformSlot NormalMapSlot("map_normal");
+	static const UniformSlot HeightMapSlot("map_height");
+	static const UniformSlot OcclusionMapSlot("map_occlusion");
+
+	// samplers can not be stored in uniform blocks, so names of light depth map array elements are registered once
+	static const MxVector<UniformSlot>& GetLightDepthMapSlots()
+	{
+		static MxVector<UniformSlot> slots = []()
+		{
+			MxVector<UniformSlot> result;
+			for (size_t i = 0; i < MaxDirLightCount; i++)
+			{
+				for (size_t j = 0; j < DirectionalLight::TextureCount; j++)
+					result.emplace_back(MxFormat("lightDepthMaps[{}][{}]", i, j).c_str());
+			}
+			return result;
+		}();
+		return slots;
+	}
+
 	void RenderController::PrepareShadowMaps()
 	{
 		MAKE_SCOPE_PROFILER("RenderController::PrepareShadowMaps()");
 
-		ShadowMapGenerator generator(this->Pipeline.ShadowCasterUnits, this->Pipeline.MaterialUnits);
+		this->shadowMapStatistics = ShadowMapStatistics{ };
+		ShadowMapGenerator generator(this->Pipeline.ShadowCasterUnits, this->Pipeline.MaterialUnits, this->shadowCasterCulling, this->shadowMapCache, this->shadowMapStatistics);
 
 		{
 			MAKE_SCOPE_PROFILER("RenderController::PrepareDirectionalLightMaps()");
@@ -66,28 +104,260 @@ namespace MxEngine
 		}
 	}
 
-	void RenderController::DrawObjects(const CameraUnit& camera, const Shader& shader, const MxVector<RenderUnit>& objects)
+	void RenderController::BuildLightClusters()
+	{
+		MAKE_SCOPE_PROFILER("RenderController::BuildLightClusters()");
+
+		auto mainCameraIndex = this->Pipeline.Environment.MainCameraIndex;
+		if (mainCameraIndex >= this->Pipeline.Cameras.size() || !this->Pipeline.Cameras[mainCameraIndex].IsPerspective)
+		{
+			this->lightClusters.Clear();
+			return;
+		}
+
+		const auto& lighting = this->Pipeline.Lighting;
+		auto& bounds = this->lightClusterBounds;
+		bounds.Clear();
+		for (const auto& light : lighting.PointLights)
+			bounds.Add(light.Position, light.Radius);
+		for (const auto& light : lighting.PointLigthsInstanced.Instances)
+			bounds.Add(light.Position, light.Radius);
+
+		// spot light cone is bounded by sphere around its apex with radius equal to cone slant height
+		auto addSpotLight = [&bounds](const SpotLightBaseData& light)
+		{
+			float height = Length(Vector3(light.Transform[2]));
+			float base = Length(Vector3(light.Transform[0]));
+			bounds.Add(light.Position, std::sqrt(height * height + base * base));
+		};
+		for (const auto& light : lighting.SpotLights)
+			addSpotLight(light);
+		for (const auto& light : lighting.SpotLightsInstanced.Instances)
+			addSpotLight(light);
+
+		const auto& camera = this->Pipeline.Cameras[mainCameraIndex];
+		this->lightClusters.Build(bounds, camera.ViewMatrix, camera.ProjectionMatrix, camera.ZNear, camera.ZFar);
+	}
+
+	void RenderController::PrepareOcclusionBuffer()
+	{
+		this->occlusionCamera = nullptr;
+		this->occlusionCuller.ResetStatistics();
+
+		auto mainCameraIndex = this->Pipeline.Environment.MainCameraIndex;
+		if (this->Pipeline.Occluders.empty() || mainCameraIndex >= this->Pipeline.Cameras.size()) return;
+		const auto& camera = this->Pipeline.Cameras[mainCameraIndex];
+		// depth buffer stores linear view depth, which is not available for orthographic projection
+		if (!camera.IsPerspective) return;
+
+		MAKE_SCOPE_PROFILER("RenderController::PrepareOcclusionBuffer()");
+		this->occlusionCuller.Clear(camera.ViewProjectionMatrix, camera.ZNear);
+		this->occlusionCuller.RasterizeOccluders(this->Pipeline.Occluders);
+		this->occlusionCamera = &camera;
+	}
+
+	void RenderController::SubmitUniformBlocks()
+	{
+		MAKE_SCOPE_PROFILER("RenderController::SubmitUniformBlocks()");
+		auto& writer = this->frameUniformBlocks;
+		size_t alignment = UniformBuffer::GetOffsetAlignment();
+		writer.Clear();
+
+		// each block starts at offset suitable for UniformBuffer::BindRange(), so all blocks of one type have equal stride
+		auto writeBlocks = [&writer, alignment](UniformBlockRange& range, size_t count, auto&& writeBlock)
+		{
+			range.Offset = writer.AlignTo(alignment);
+			for (size_t i = 0; i < count; i++)
+			{
+				size_t offset = writer.AlignTo(alignment);
+				writer.BeginStruct();
+				writeBlock(i);
+				writer.EndStruct();
+				range.Stride = writer.AlignTo(alignment) - offset;
+			}
+		};
+
+		// layout must match Library/camera.glsl
+		writeBlocks(this->cameraBlocks, this->Pipeline.Cameras.size(), [this, &writer](size_t index)
+		{
+			const auto& camera = this->Pipeline.Cameras[index];
+			writer.Write(camera.ViewProjectionMatrix);
+			writer.Write(camera.InverseViewProjMatrix);
+			writer.Write(camera.ViewportPosition);
+		});
+
+		// layout must match DirLightBuffer of global_illum_fragment.glsl and transparent_fragment.glsl
+		writeBlocks(this->dirLightBlocks, 1, [this, &writer](size_t)
+		{
+			const auto& dirLights = this->Pipeline.Lighting.DirectionalLights;
+			size_t lightCount = Min(MaxDirLightCount, dirLights.size());
+			for (size_t i = 0; i < MaxDirLightCount; i++)
+			{
+				// all array elements are written, as block size is fixed by shader declaration
+				writer.BeginStruct();
+				if (i < lightCount)
+				{
+					const auto& dirLight = dirLights[i];
+					writer.WriteArray(dirLight.BiasedProjectionMatrices.data(), dirLight.BiasedProjectionMatrices.size());
+					writer.Write(dirLight.AmbientColor);
+					writer.Write(dirLight.DiffuseColor);
+					writer.Write(dirLight.SpecularColor);
+					writer.Write(dirLight.Direction);
+				}
+				else
+				{
+					std::array<Matrix4x4, DirectionalLight::TextureCount> emptyTransforms{ };
+					writer.WriteArray(emptyTransforms.data(), emptyTransforms.size());
+					for (size_t j = 0; j < 4; j++) writer.Write(MakeVector3(0.0f));
+				}
+				writer.EndStruct();
+			}
+			writer.Write((int)lightCount);
+		});
+
+		// layout must match Library/material.glsl
+		writeBlocks(this->materialBlocks, this->Pipeline.MaterialUnits.size(), [this, &writer](size_t index)
+		{
+			const auto& material = this->Pipeline.MaterialUnits[index];
+			writer.Write(material.Emmision);
+			writer.Write(material.Reflection);
+			writer.Write(material.SpecularFactor);
+			writer.Write(material.SpecularIntensity);
+			writer.Write(material.Transparency);
+		});
+
+		this->Pipeline.Environment.FrameUniformBuffer->BufferDataWithResize(writer.GetData(), writer.GetSize());
+	}
+
+	void RenderController::DrawObjects(const CameraUnit& camera, const Shader& shader, const MxVector<RenderUnit>& objects, RenderSortOrder order)
 	{
 		MAKE_SCOPE_PROFILER("RenderController::DrawObjects()");
 
 		if (objects.empty()) return;
-		shader.SetUniformMat4("ViewProjMatrix", camera.ViewProjectionMatrix);
-		shader.SetUniformFloat("gamma", camera.Gamma);
+		shader.SetUniformMat4(ViewProjMatrixSlot, camera.ViewProjectionMatrix);
+		shader.SetUniformFloat(GammaSlot, camera.Gamma);
 
+		this->cullingBoxes.Clear();
 		for (const auto& unit : objects)
 		{
-			bool isUnitVisible = unit.InstanceCount > 0 || camera.Culler.IsAABBVisible(unit.MinAABB, unit.MaxAABB);
+			this->cullingBoxes.Add(unit.MinAABB, unit.MaxAABB);
+		}
+		this->cullingVisibility.resize(objects.size());
+		camera.Culler.CullAABBs(this->cullingBoxes, this->cullingVisibility.data());
+		if (&camera == this->occlusionCamera)
+			this->occlusionCuller.CullAABBs(this->cullingBoxes, this->cullingVisibility.data());
+
+		auto shaderId = (uint32_t)shader.GetNativeHandle();
+		this->renderQueue.Clear();
+		this->renderQueue.Reserve(objects.size());
+		this->batchableUnits.resize(objects.size());
+		for (size_t i = 0; i < objects.size(); i++)
+		{
+			const auto& unit = objects[i];
+			// instanced units are culled per instance by InstanceFactory if it is enabled, as unit AABB covers only base mesh
+			bool isUnitVisible = unit.InstanceCount > 0 || this->cullingVisibility[i];
+			if (!isUnitVisible) continue;
+
+			// units with their own instance buffers already occupy instance attributes of vertex array
+			this->batchableUnits[i] = this->useDynamicInstancing && unit.InstanceCount == 0 && unit.VBO.IsValid();
+
+			auto toCenter = (unit.MinAABB + unit.MaxAABB) * 0.5f - camera.ViewportPosition;
+			auto geometryId = unit.GeometryId;
+			auto materialId = (uint32_t)unit.materialIndex;
+			auto key = RenderCommandQueue::MakeKey(order, 0, shaderId, materialId, geometryId, Dot(toCenter, toCenter));
+			this->renderQueue.Push(key, (uint32_t)i, shaderId, materialId, geometryId);
+		}
+		this->renderQueue.Sort();
+
+		this->instancingStatistics += this->instanceBatcher.Build(this->renderQueue.GetCommands(), this->batchableUnits);
+		this->SubmitInstanceData(objects);
+
+		// batch commands store index of batch instead of unit index, material id is index of material unit
+		struct DrawVisitor
+		{
+			RenderController& controller;
+			const Shader& shader;
+			const MxVector<RenderUnit>& objects;
+
+			void BindShader(const RenderCommand&) { } // shader is bound by draw call
+			void BindGeometry(const RenderCommand&) { } // vertex array is bound by draw call
+			void BindMaterial(const RenderCommand& command) 
+			{ 
+				controller.BindMaterial((size_t)command.MaterialId, shader);
+			}
+			void Draw(const RenderCommand& command) 
+			{ 
+				const auto& batch = controller.instanceBatcher.GetBatches()[command.UnitIndex];
+				controller.DrawInstanceBatch(batch, objects, shader);
+			}
+		};
+		RenderCommandQueue::Replay(this->instanceBatcher.GetCommands(), DrawVisitor{ *this, shader, objects });
+	}
+
+	void RenderController::SubmitInstanceData(const MxVector<RenderUnit>& objects)
+	{
+		MAKE_SCOPE_PROFILER("RenderController::SubmitInstanceData()");
+
+		const auto& commands = this->renderQueue.GetCommands();
+		this->dynamicInstances.clear();
+		this->dynamicInstances.reserve(this->instanceBatcher.GetInstanceCount());
+		for (const auto& batch : this->instanceBatcher.GetBatches())
+		{
+			if (!batch.IsInstanced()) continue;
 
-			if (isUnitVisible) this->DrawObject(unit, shader);
+			// all units of batch share material, but color is per-instance attribute, as in InstanceFactory buffers
+			const auto& material = this->Pipeline.MaterialUnits[commands[batch.FirstCommand].MaterialId];
+			for (size_t i = batch.FirstCommand; i < batch.FirstCommand + batch.CommandCount; i++)
+			{
+				const auto& unit = objects[commands[i].UnitIndex];
+				auto& instance = this->dynamicInstances.emplace_back();
+				instance.ModelMatrix = unit.ModelMatrix;
+				instance.NormalMatrix = unit.NormalMatrix;
+				instance.Color = material.BaseColor;
+			}
 		}
+
+		if (this->dynamicInstances.empty()) return;
+		auto data = reinterpret_cast<float*>(this->dynamicInstances.data());
+		this->Pipeline.Environment.DynamicInstanceBuffer->BufferDataWithResize(data, this->dynamicInstances.size() * DynamicInstanceData::Size);
 	}
 
-	void RenderController::DrawObject(const RenderUnit& unit, const Shader& shader)
+	const VertexArray& RenderController::GetInstancedGeometry(const RenderUnit& unit)
+	{
+		auto& entry = this->instancedGeometries.Entries[(unsigned int)unit.VAO->GetNativeHandle()];
+		entry.LastUsedFrame = this->instancedGeometries.FrameIndex;
+
+		if (!entry.VAO.IsValid() || entry.VBO != unit.VBO)
+		{
+			const auto& environment = this->Pipeline.Environment;
+			entry.VBO = unit.VBO;
+			entry.VAO = GraphicFactory::Create<VertexArray>();
+			entry.VAO->AddBuffer(*unit.VBO, *environment.MeshVertexLayout);
+			entry.VAO->AddInstancedBuffer(*environment.DynamicInstanceBuffer, *environment.DynamicInstanceLayout);
+		}
+		return *entry.VAO;
+	}
+
+	void RenderController::ReleaseUnusedInstancedGeometries()
+	{
+		// cached arrays hold mesh vertex buffers, so arrays of meshes which are not drawn for a while are released
+		constexpr size_t InstancedGeometryLifetime = 120;
+
+		auto& cache = this->instancedGeometries;
+		cache.FrameIndex++;
+		for (auto it = cache.Entries.begin(); it != cache.Entries.end();)
+		{
+			if (it->second.LastUsedFrame + InstancedGeometryLifetime < cache.FrameIndex)
+				it = cache.Entries.erase(it);
+			else
+				it++;
+		}
+	}
+
+	void RenderController::BindMaterial(size_t materialIndex, const Shader& shader)
 	{
+		const auto& material = this->Pipeline.MaterialUnits[materialIndex];
 		Texture::TextureBindId textureBindIndex = 0;
-		const auto& material = this->Pipeline.MaterialUnits[unit.materialIndex];
-		shader.IgnoreNonExistingUniform("material.transparency");
-		shader.IgnoreNonExistingUniform("material.reflection");
 
 		material.AlbedoMap->Bind(textureBindIndex++);
 		material.SpecularMap->Bind(textureBindIndex++);
@@ -96,25 +366,44 @@ namespace MxEngine
 		material.HeightMap->Bind(textureBindIndex++);
 		material.AmbientOcclusionMap->Bind(textureBindIndex++);
 
-		shader.SetUniformInt("map_albedo", material.AlbedoMap->GetBoundId());
-		shader.SetUniformInt("map_specular", material.SpecularMap->GetBoundId());
-		shader.SetUniformInt("map_emmisive", material.EmmisiveMap->GetBoundId());
-		shader.SetUniformInt("map_normal", material.NormalMap->GetBoundId());
-		shader.SetUniformInt("map_height", material.HeightMap->GetBoundId());
-		shader.SetUniformInt("map_occlusion", material.AmbientOcclusionMap->GetBoundId());
+		shader.SetUniformInt(AlbedoMapSlot, material.AlbedoMap->GetBoundId());
+		shader.SetUniformInt(SpecularMapSlot, material.SpecularMap->GetBoundId());
+		shader.SetUniformInt(EmmisiveMapSlot, material.EmmisiveMap->GetBoundId());
+		shader.SetUniformInt(NormalMapSlot, material.NormalMap->GetBoundId());
+		shader.SetUniformInt(HeightMapSlot, material.HeightMap->GetBoundId());
+		shader.SetUniformInt(OcclusionMapSlot, material.AmbientOcclusionMap->GetBoundId());
+		shader.SetUniformFloat(DisplacementSlot, material.Displacement);
 
-		shader.SetUniformFloat("material.specularFactor", material.SpecularFactor);
-		shader.SetUniformFloat("material.specularIntensity", material.SpecularIntensity);
-		shader.SetUniformFloat("material.emmisive", material.Emmision);
-		shader.SetUniformFloat("material.reflection", material.Reflection);
-		shader.SetUniformFloat("material.transparency", material.Transparency);
-		shader.SetUniformFloat("displacement", material.Displacement);
+		// scalar material parameters were packed into frame uniform buffer by SubmitUniformBlocks()
+		this->BindUniformBlock(shader, MaterialBufferSlot, MaterialBlockBinding, this->materialBlocks, materialIndex);
+	}
+
+	void RenderController::DrawObject(const RenderUnit& unit, const Shader& shader)
+	{
+		// base color is set per draw, as it is a vertex attribute
+		const auto& material = this->Pipeline.MaterialUnits[unit.materialIndex];
 
 		this->GetRenderEngine().SetDefaultVertexAttribute(5, unit.ModelMatrix); //-V807
 		this->GetRenderEngine().SetDefaultVertexAttribute(9, unit.NormalMatrix);
 		this->GetRenderEngine().SetDefaultVertexAttribute(12, material.BaseColor);
 		
-		this->GetRenderEngine().DrawTrianglesInstanced(*unit.VAO, *unit.IBO, shader, unit.InstanceCount);
+		const auto& range = unit.Range;
+		this->GetRenderEngine().DrawTrianglesRange(*unit.VAO, *unit.IBO, shader, range.IndexCount, range.FirstIndex, range.BaseVertex, unit.InstanceCount);
+	}
+
+	void RenderController::DrawInstanceBatch(const InstanceBatch& batch, const MxVector<RenderUnit>& objects, const Shader& shader)
+	{
+		const auto& unit = objects[this->renderQueue.GetCommands()[batch.FirstCommand].UnitIndex];
+		if (!batch.IsInstanced())
+		{
+			this->DrawObject(unit, shader);
+			return;
+		}
+
+		const auto& instancedVAO = this->GetInstancedGeometry(unit);
+		const auto& range = unit.Range;
+		this->GetRenderEngine().DrawTrianglesRange(instancedVAO, *unit.IBO, shader, range.IndexCount, range.FirstIndex, range.BaseVertex, 
+			batch.CommandCount, batch.FirstInstance);
 	}
 
 	void RenderController::ComputeBloomEffect(CameraUnit& camera)
@@ -164,7 +453,6 @@ namespace MxEngine
 		MAKE_SCOPE_PROFILER("RenderController::ComputeAmbientOcclusion()");
 
 		auto& computeShader = this->Pipeline.Environment.Shaders["AmbientOcclusion"_id];
-		computeShader->IgnoreNonExistingUniform("camera.position");
 		computeShader->IgnoreNonExistingUniform("materialTex");
 		this->BindGBuffer(camera, *computeShader);
 		this->BindCameraInformation(camera, *computeShader);
@@ -248,46 +536,12 @@ namespace MxEngine
 		MAKE_SCOPE_PROFILER("RenderController::DrawDirectionalLights()");
 		auto& illumShader = this->Pipeline.Environment.Shaders["GlobalIllumination"_id];
 
-		illumShader->IgnoreNonExistingUniform("camera.viewProjMatrix");
 		this->BindGBuffer(camera, *illumShader);
 		this->BindCameraInformation(camera, *illumShader);
 
-		Texture::TextureBindId textureId = 4;
-
 		// submit directional light information
-		constexpr size_t MaxDirLightCount = 4;
-		const auto& dirLights = this->Pipeline.Lighting.DirectionalLights;
-		size_t lightCount = Min(MaxDirLightCount, dirLights.size());
-
-		illumShader->SetUniformInt("lightCount", (int)lightCount);
-		illumShader->SetUniformInt("pcfDistance", this->Pipeline.Environment.ShadowBlurIterations);
-
-		for (size_t i = 0; i < lightCount; i++)
-		{
-			auto& dirLight = this->Pipeline.Lighting.DirectionalLights[i];
+		this->BindDirectionalLights(*illumShader, 4);
 
-			illumShader->SetUniformVec3(MxFormat("lights[{}].ambient", i), dirLight.AmbientColor);
-			illumShader->SetUniformVec3(MxFormat("lights[{}].diffuse", i), dirLight.DiffuseColor);
-			illumShader->SetUniformVec3(MxFormat("lights[{}].specular", i), dirLight.SpecularColor);
-			illumShader->SetUniformVec3(MxFormat("lights[{}].direction", i), dirLight.Direction);
-
-			for (size_t j = 0; j < dirLight.ShadowMaps.size(); j++)
-			{
-				dirLight.ShadowMaps[j]->Bind(textureId++);
-				illumShader->SetUniformInt(MxFormat("lightDepthMaps[{}][{}]", i, j), dirLight.ShadowMaps[j]->GetBoundId());
-				illumShader->SetUniformMat4(MxFormat("lights[{}].transform[{}]", i, j), dirLight.BiasedProjectionMatrices[j]);
-			}
-		}
-
-		this->Pipeline.Environment.DefaultBlackMap->Bind(textureId);
-		for (size_t i = lightCount; i < MaxDirLightCount; i++)
-		{
-			for (size_t j = 0; j < DirectionalLight::TextureCount; j++)
-			{
-				illumShader->SetUniformInt(MxFormat("lightDepthMaps[{}][{}]", i, j),
-					this->Pipeline.Environment.DefaultBlackMap->GetBoundId());
-			}
-		}
 		// render global illumination
 		this->RenderToTexture(camera.HDRTexture, illumShader);
 	}
@@ -317,47 +571,13 @@ namespace MxEngine
 		this->ToggleFaceCulling(false);
 
 		auto& shader = this->Pipeline.Environment.Shaders["Transparent"_id];
+		// viewport position is taken from camera block, gamma is set by DrawObjects() together with view-projection matrix
+		this->BindCameraInformation(camera, *shader);
 
-		shader->SetUniformVec3("viewportPosition", camera.ViewportPosition);
-		shader->SetUniformFloat("gamma", camera.Gamma);
-
-		Texture::TextureBindId textureId = 6; // assume there are 6 textures in material structure
-
-		// submit directional light information
-		const auto& dirLights = this->Pipeline.Lighting.DirectionalLights;
-		size_t lightCount = Min(MaxDirLightCount, dirLights.size());
-
-		shader->SetUniformInt("lightCount", (int)lightCount);
-		shader->SetUniformInt("pcfDistance", this->Pipeline.Environment.ShadowBlurIterations);
-
-		for (size_t i = 0; i < lightCount; i++)
-		{
-			auto& dirLight = this->Pipeline.Lighting.DirectionalLights[i];
-
-			shader->SetUniformVec3(MxFormat("lights[{}].ambient", i), dirLight.AmbientColor);
-			shader->SetUniformVec3(MxFormat("lights[{}].diffuse", i), dirLight.DiffuseColor);
-			shader->SetUniformVec3(MxFormat("lights[{}].specular", i), dirLight.SpecularColor);
-			shader->SetUniformVec3(MxFormat("lights[{}].direction", i), dirLight.Direction);
-
-			for (size_t j = 0; j < dirLight.ShadowMaps.size(); j++)
-			{
-				dirLight.ShadowMaps[j]->Bind(textureId++);
-				shader->SetUniformInt(MxFormat("lightDepthMaps[{}][{}]", i, j), dirLight.ShadowMaps[j]->GetBoundId());
-				shader->SetUniformMat4(MxFormat("lights[{}].transform[{}]", i, j), dirLight.BiasedProjectionMatrices[j]);
-			}
-		}
-
-		this->Pipeline.Environment.DefaultBlackMap->Bind(textureId);
-		for (size_t i = lightCount; i < MaxDirLightCount; i++)
-		{
-			for (size_t j = 0; j < DirectionalLight::TextureCount; j++)
-			{
-				shader->SetUniformInt(MxFormat("lightDepthMaps[{}][{}]", i, j),
-					this->Pipeline.Environment.DefaultBlackMap->GetBoundId());
-			}
-		}
+		// submit directional light information, assuming there are 6 textures in material structure
+		this->BindDirectionalLights(*shader, 6);
 
-		this->DrawObjects(camera, *shader, this->Pipeline.TransparentRenderUnits);
+		this->DrawObjects(camera, *shader, this->Pipeline.TransparentRenderUnits, RenderSortOrder::BACK_TO_FRONT);
 
 		this->ToggleFaceCulling(true);
 		this->GetRenderEngine().UseBlending(BlendFactor::ONE, BlendFactor::ZERO);
@@ -371,7 +591,6 @@ namespace MxEngine
 		MAKE_SCOPE_PROFILER("RenderController::ApplyFogEffect()");
 
 		auto fogShader = this->Pipeline.Environment.Shaders["Fog"_id];
-		fogShader->IgnoreNonExistingUniform("camera.viewProjMatrix");
 		fogShader->IgnoreNonExistingUniform("normalTex");
 		fogShader->IgnoreNonExistingUniform("albedoTex");
 		fogShader->IgnoreNonExistingUniform("materialTex");
@@ -612,9 +831,45 @@ namespace MxEngine
 
 	void RenderController::BindCameraInformation(const CameraUnit& camera, const Shader& shader)
 	{
-		shader.SetUniformVec3("camera.position", camera.ViewportPosition);
-		shader.SetUniformMat4("camera.viewProjMatrix", camera.ViewProjectionMatrix);
-		shader.SetUniformMat4("camera.invViewProjMatrix", camera.InverseViewProjMatrix);
+		size_t cameraIndex = size_t(&camera - this->Pipeline.Cameras.data());
+		MX_ASSERT(cameraIndex < this->Pipeline.Cameras.size());
+		this->BindUniformBlock(shader, CameraBufferSlot, CameraBlockBinding, this->cameraBlocks, cameraIndex);
+	}
+
+	void RenderController::BindDirectionalLights(const Shader& shader, Texture::TextureBindId textureId)
+	{
+		const auto& dirLights = this->Pipeline.Lighting.DirectionalLights;
+		const auto& depthMapSlots = GetLightDepthMapSlots();
+		size_t lightCount = Min(MaxDirLightCount, dirLights.size());
+
+		this->BindUniformBlock(shader, DirLightBufferSlot, DirLightBlockBinding, this->dirLightBlocks, 0);
+		shader.SetUniformInt(PcfDistanceSlot, this->Pipeline.Environment.ShadowBlurIterations);
+
+		for (size_t i = 0; i < lightCount; i++)
+		{
+			auto& dirLight = dirLights[i];
+			for (size_t j = 0; j < dirLight.ShadowMaps.size(); j++)
+			{
+				dirLight.ShadowMaps[j]->Bind(textureId++);
+				shader.SetUniformInt(depthMapSlots[i * DirectionalLight::TextureCount + j], dirLight.ShadowMaps[j]->GetBoundId());
+			}
+		}
+
+		this->Pipeline.Environment.DefaultBlackMap->Bind(textureId);
+		for (size_t i = lightCount; i < MaxDirLightCount; i++)
+		{
+			for (size_t j = 0; j < DirectionalLight::TextureCount; j++)
+			{
+				shader.SetUniformInt(depthMapSlots[i * DirectionalLight::TextureCount + j],
+					this->Pipeline.Environment.DefaultBlackMap->GetBoundId());
+			}
+		}
+	}
+
+	void RenderController::BindUniformBlock(const Shader& shader, const UniformSlot& block, unsigned int bindingPoint, const UniformBlockRange& range, size_t index)
+	{
+		shader.BindUniformBlock(block, bindingPoint);
+		this->Pipeline.Environment.FrameUniformBuffer->BindRange(bindingPoint, range.Offset + index * range.Stride, range.Stride);
 	}
 
 	void RenderController::BindGBuffer(const CameraUnit& camera, const Shader& shader)
@@ -640,6 +895,52 @@ namespace MxEngine
 		return this->renderer;
 	}
 
+	const ShadowMapStatistics& RenderController::GetShadowMapStatistics() const
+	{
+		return this->shadowMapStatistics;
+	}
+
+	void RenderController::InvalidateShadowMaps()
+	{
+		this->shadowMapCache.Entries.clear();
+	}
+
+	void RenderController::ToggleLightClusters(bool value)
+	{
+		this->useLightClusters = value;
+		if (!value) this->lightClusters.Clear();
+	}
+
+	bool RenderController::IsLightClustersEnabled() const
+	{
+		return this->useLightClusters;
+	}
+
+	const LightClusterBuilder& RenderController::GetLightClusters() const
+	{
+		return this->lightClusters;
+	}
+
+	const OcclusionStatistics& RenderController::GetOcclusionStatistics() const
+	{
+		return this->occlusionCuller.GetStatistics();
+	}
+
+	void RenderController::ToggleDynamicInstancing(bool value)
+	{
+		this->useDynamicInstancing = value;
+	}
+
+	bool RenderController::IsDynamicInstancingEnabled() const
+	{
+		return this->useDynamicInstancing;
+	}
+
+	const InstanceBatchStatistics& RenderController::GetInstancingStatistics() const
+	{
+		return this->instancingStatistics;
+	}
+
 	void RenderController::Render() const
 	{
 		this->GetRenderEngine().Flush();
@@ -804,7 +1105,9 @@ namespace MxEngine
 		this->Pipeline.TransparentRenderUnits.clear();
 		this->Pipeline.ShadowCasterUnits.clear();
 		this->Pipeline.MaterialUnits.clear();
+		this->Pipeline.Occluders.clear();
 		this->Pipeline.Cameras.clear();
+		this->materialUnitIndices.clear();
 	}
 
 	void RenderController::SubmitLightSource(const DirectionalLight& light, const TransformComponent& parentTransform)
@@ -816,6 +1119,7 @@ namespace MxEngine
 		dirLight.DiffuseColor = light.DiffuseColor;
 		dirLight.SpecularColor = light.SpecularColor;
 		dirLight.Direction = light.Direction;
+		dirLight.ShadowUpdateInterval = light.ShadowUpdateInterval;
 
 		for (size_t i = 0; i < DirectionalLight::TextureCount; i++)
 		{
@@ -834,6 +1138,7 @@ namespace MxEngine
 			baseLightData = &pointLight;
 
 			pointLight.ShadowMap = light.GetDepthCubeMap();
+			pointLight.ShadowUpdateInterval = light.ShadowUpdateInterval;
 			for (size_t i = 0; i < std::size(pointLight.ProjectionMatrices); i++)
 				pointLight.ProjectionMatrices[i] = light.GetMatrix(i, parentTransform.GetPosition());
 		}
@@ -862,6 +1167,7 @@ namespace MxEngine
 			spotLight.ProjectionMatrix = light.GetMatrix(parentTransform.GetPosition());
 			spotLight.BiasedProjectionMatrix = MakeBiasMatrix() * light.GetMatrix(parentTransform.GetPosition());
 			spotLight.ShadowMap = light.GetDepthTexture();
+			spotLight.ShadowUpdateInterval = light.ShadowUpdateInterval;
 		}
 		else
 		{
@@ -888,6 +1194,10 @@ namespace MxEngine
 		camera.StaticViewProjectionMatrix = controller.GetMatrix(MakeVector3(0.0f));
 		camera.ViewProjectionMatrix       = controller.GetMatrix(parentTransform.GetPosition());
 		camera.InverseViewProjMatrix      = Inverse(camera.ViewProjectionMatrix);
+		camera.ViewMatrix                 = controller.GetViewMatrix(parentTransform.GetPosition());
+		camera.ProjectionMatrix           = controller.GetProjectionMatrix();
+		camera.ZNear                      = controller.Camera.GetZNear();
+		camera.ZFar                       = controller.Camera.GetZFar();
 		camera.Culler                     = controller.GetFrustrumCuller();
 		camera.IsPerspective              = controller.GetCameraType() == CameraType::PERSPECTIVE;
 		camera.GBuffer                    = controller.GetGBuffer();
@@ -908,32 +1218,108 @@ namespace MxEngine
 		camera.SSR                        = ssr;
 	}
 
-    void RenderController::SubmitPrimitive(const SubMesh& object, const Material& material, const TransformComponent& parentTransform, size_t instanceCount)
+    void RenderController::PreparePrimitive(const SubMesh& object, const Material& material, const Matrix4x4& parentMatrix, const Matrix3x3& parentNormalMatrix, 
+		size_t instanceCount, bool isVisible, PrimitiveSubmission& result)
+	{
+		// submesh transforms are shared between objects and this method may run on several threads, so cached matrices are only read here.
+		// RenderAdaptor updates them on main thread before submission, in other cases they are updated on first access
+		auto transform = object.BorrowTransform();
+		const auto& localMatrix = transform->GetMatrix();
+		const auto& localNormalMatrix = transform->GetNormalMatrix();
+
+		result.Object = &object;
+		result.MaterialData = &material;
+		result.ModelMatrix  = parentMatrix * localMatrix; //-V807
+		result.NormalMatrix = parentNormalMatrix * localNormalMatrix;
+		result.InstanceCount = instanceCount;
+		result.IsVisible = isVisible;
+		result.IsDynamic = instanceCount > 0;
+		result.IsOccluder = false;
+
+		// compute aabb of primitive object for later frustrum culling
+		auto aabb = object.Data.GetBoundingBox() * result.ModelMatrix;
+		result.MinAABB = aabb.Min;
+		result.MaxAABB = aabb.Max;
+
+		// we need to change displacement to account object scale, so we take average of world scale components as multiplier
+		auto worldScale = MakeVector3(Length(result.ModelMatrix[0]), Length(result.ModelMatrix[1]), Length(result.ModelMatrix[2]));
+		result.DisplacementScale = Dot(worldScale, MakeVector3(1.0f / 3.0f));
+	}
+
+    void RenderController::SubmitPrimitive(const SubMesh& object, const Material& material, const Matrix4x4& parentMatrix, const Matrix3x3& parentNormalMatrix, size_t instanceCount, bool isVisible)
     {
+		PrimitiveSubmission primitive;
+		RenderController::PreparePrimitive(object, material, parentMatrix, parentNormalMatrix, instanceCount, isVisible, primitive);
+		this->SubmitPrimitive(primitive);
+    }
+
+	void RenderController::SubmitPrimitive(const PrimitiveSubmission& submission)
+	{
+		const auto& material = *submission.MaterialData;
+		// invisible objects still can cast shadows on visible ones, so only non-casters are discarded
+		if (!submission.IsVisible && !material.CastsShadow) return;
+		// mesh data creates its buffers only when geometry is uploaded, so never buffered meshes have nothing to draw
+		if (!submission.Object->Data.GetVAO().IsValid()) return;
+
+		RenderUnit shadowCasterUnit;
 		RenderUnit* primitivePtr = nullptr;
 		// filter transparent object to render in separate order
-		if (material.Transparency < 1.0f)
+		if (!submission.IsVisible)
+			primitivePtr = &shadowCasterUnit;
+		else if (material.Transparency < 1.0f)
 			primitivePtr = &this->Pipeline.TransparentRenderUnits.emplace_back();
 		else
 			primitivePtr = &this->Pipeline.OpaqueRenderUnits.emplace_back();
 		auto& primitive = *primitivePtr;
 
-		primitive.VAO = object.Data.GetVAO();
-		primitive.IBO = object.Data.GetIBO();
-		primitive.materialIndex = this->Pipeline.MaterialUnits.size();
-		primitive.ModelMatrix  = parentTransform.GetMatrix() * object.GetTransform()->GetMatrix(); //-V807
-		primitive.NormalMatrix = parentTransform.GetNormalMatrix() * object.GetTransform()->GetNormalMatrix();
-		primitive.InstanceCount = instanceCount;
+		primitive.VAO = submission.Object->Data.GetVAO();
+		primitive.IBO = submission.Object->Data.GetIBO();
+		primitive.VBO = submission.Object->Data.GetVBO();
+		primitive.Range = submission.Object->Data.GetDrawRange();
+		primitive.GeometryId = submission.Object->Data.GetGeometryId();
+		primitive.materialIndex = this->InternMaterial(material, submission.DisplacementScale);
+		primitive.ModelMatrix = submission.ModelMatrix;
+		primitive.NormalMatrix = submission.NormalMatrix;
+		primitive.InstanceCount = submission.InstanceCount;
+		primitive.IsDynamic = submission.IsDynamic;
+		primitive.MinAABB = submission.MinAABB;
+		primitive.MaxAABB = submission.MaxAABB;
+
+		if (material.CastsShadow) this->Pipeline.ShadowCasterUnits.push_back(primitive);
+
+		// occluders outside of camera frustrum can not hide anything visible, transparent objects do not hide objects behind them,
+		// and meshes without CPU copy can not be rasterized
+		const auto& vertecies = submission.Object->Data.GetVertecies();
+		const auto& indicies = submission.Object->Data.GetIndicies();
+		if (submission.IsOccluder && submission.IsVisible && material.Transparency >= 1.0f && !vertecies.empty())
+		{
+			auto& occluder = this->Pipeline.Occluders.emplace_back();
+			occluder.Positions = &vertecies.front().Position.x;
+			occluder.PositionStride = sizeof(Vertex);
+			occluder.Indices = indicies.data();
+			occluder.IndexCount = indicies.size();
+			occluder.Transform = submission.ModelMatrix;
+		}
+	}
 
-		// compute aabb of primitive object for later frustrum culling
-		auto aabb = object.Data.GetBoundingBox() * primitive.ModelMatrix;
-		primitive.MinAABB = aabb.Min;
-		primitive.MaxAABB = aabb.Max;
+	size_t MaterialUnitKeyHash::operator()(const MaterialUnitKey& key) const
+	{
+		uint32_t scaleBits = 0;
+		std::memcpy(&scaleBits, &key.DisplacementScale, sizeof(scaleBits));
+		return eastl::hash<const Material*>()(key.Source) ^ (size_t(scaleBits) * 0x9E3779B97F4A7C15ull);
+	}
+
+	size_t RenderController::InternMaterial(const Material& material, float displacementScale)
+	{
+		auto it = this->materialUnitIndices.find(MaterialUnitKey{ &material, displacementScale });
+		if (it != this->materialUnitIndices.end()) return it->second;
 
-		auto& renderMaterial = this->Pipeline.MaterialUnits.emplace_back(material); // create a copy of material for future work
+		size_t index = this->Pipeline.MaterialUnits.size();
+		this->materialUnitIndices.emplace(MaterialUnitKey{ &material, displacementScale }, index);
+
+		auto& renderMaterial = this->Pipeline.MaterialUnits.emplace_back(material); // create a copy of material once per frame
+		renderMaterial.Displacement *= displacementScale;
 
-		// we need to change displacement to account object scale, so we take average of object scale components as multiplier
-		renderMaterial.Displacement *= Dot(parentTransform.GetScale() * object.GetTransform()->GetScale(), MakeVector3(1.0f / 3.0f));
 		// set default textures if they are not exist
 		if (!renderMaterial.AlbedoMap.IsValid())           renderMaterial.AlbedoMap           = this->Pipeline.Environment.DefaultMaterialMap;
 		if (!renderMaterial.SpecularMap.IsValid())         renderMaterial.SpecularMap         = this->Pipeline.Environment.DefaultMaterialMap;
@@ -942,8 +1328,8 @@ namespace MxEngine
 		if (!renderMaterial.NormalMap.IsValid())           renderMaterial.NormalMap           = this->Pipeline.Environment.DefaultNormalMap;
 		if (!renderMaterial.HeightMap.IsValid())           renderMaterial.HeightMap           = this->Pipeline.Environment.DefaultBlackMap;
 
-		if (renderMaterial.CastsShadow) this->Pipeline.ShadowCasterUnits.push_back(primitive);
-    }
+		return index;
+	}
 
 	void RenderController::SubmitImage(const TextureHandle& texture)
 	{
@@ -966,7 +1352,12 @@ namespace MxEngine
 			return;
 		}
 
+		this->SubmitUniformBlocks();
+		this->ReleaseUnusedInstancedGeometries();
+		this->instancingStatistics = InstanceBatchStatistics{ };
 		this->PrepareShadowMaps();
+		if (this->useLightClusters) this->BuildLightClusters();
+		this->PrepareOcclusionBuffer();
 
 		for (auto& camera : this->Pipeline.Cameras)
 		{
@@ -976,7 +1367,7 @@ namespace MxEngine
 			this->ToggleReversedDepth(camera.IsPerspective);
 			this->AttachFrameBuffer(camera.GBuffer);
 
-			this->DrawObjects(camera, *this->Pipeline.Environment.Shaders["GBuffer"_id], this->Pipeline.OpaqueRenderUnits);
+			this->DrawObjects(camera, *this->Pipeline.Environment.Shaders["GBuffer"_id], this->Pipeline.OpaqueRenderUnits, RenderSortOrder::FRONT_TO_BACK);
 			this->PerformLightPass(camera);
 			this->PerformPostProcessing(camera);
 
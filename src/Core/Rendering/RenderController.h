@@ -32,6 +32,11 @@
 #include "Platform/OpenGL/Renderer.h"
 #include "RenderPipeline.h"
 #include "RenderObjects/DebugBuffer.h"
+#include "RenderUtilities/RenderCommandQueue.h"
+#include "RenderUtilities/ShadowMapGenerator.h"
+#include "RenderUtilities/LightClusterBuilder.h"
+#include "RenderUtilities/UniformBlockWriter.h"
+#include "RenderUtilities/InstanceBatcher.h"
 
 namespace MxEngine
 {
@@ -46,16 +51,108 @@ namespace MxEngine
 	class SubMesh;
 	class TransformComponent;
 
+	// render unit data which does not require any resource handle copies, so it can be prepared by multiple threads in parallel
+	struct PrimitiveSubmission
+	{
+		const SubMesh* Object;
+		const Material* MaterialData;
+		Matrix4x4 ModelMatrix;
+		Matrix3x3 NormalMatrix;
+		Vector3 MinAABB, MaxAABB;
+		float DisplacementScale;
+		size_t InstanceCount;
+		bool IsVisible;
+		bool IsDynamic;
+		bool IsOccluder;
+	};
+
+	// key of material interned into render pipeline. Displacement is part of key, as it is rescaled by object transform
+	struct MaterialUnitKey
+	{
+		const Material* Source;
+		float DisplacementScale;
+
+		bool operator==(const MaterialUnitKey& other) const
+		{
+			return this->Source == other.Source && this->DisplacementScale == other.DisplacementScale;
+		}
+	};
+
+	struct MaterialUnitKeyHash
+	{
+		size_t operator()(const MaterialUnitKey& key) const;
+	};
+
+	// vertex array which reads mesh vertex buffer and dynamic instance buffer. Source buffer is kept to detect reuse of mesh vertex array id
+	struct InstancedGeometry
+	{
+		VertexBufferHandle VBO;
+		VertexArrayHandle VAO;
+		size_t LastUsedFrame = 0;
+	};
+
+	// instanced vertex arrays built in previous frames, keyed by native handle of mesh vertex array
+	struct InstancedGeometryCache
+	{
+		MxHashMap<unsigned int, InstancedGeometry> Entries;
+		size_t FrameIndex = 0;
+	};
+
+	// location of uniform blocks of one type inside frame uniform buffer. Block i starts at Offset + i * Stride
+	struct UniformBlockRange
+	{
+		size_t Offset = 0;
+		size_t Stride = 0;
+	};
+
 	class RenderController
 	{
 		Renderer renderer;
 		RenderPipeline Pipeline;
+		// scratch buffers for batch frustrum culling, reused between frames to avoid allocations
+		AABBArray cullingBoxes;
+		MxVector<uint8_t> cullingVisibility;
+		// sorted draw commands of current DrawObjects call and materials interned during current frame
+		RenderCommandQueue renderQueue;
+		MxHashMap<MaterialUnitKey, size_t, MaterialUnitKeyHash> materialUnitIndices;
+		// scratch buffers of per-light shadow caster culling and its results for current frame
+		ShadowCasterCullingData shadowCasterCulling;
+		ShadowMapCache shadowMapCache;
+		ShadowMapStatistics shadowMapStatistics;
+		// light lists of main camera clusters and world bounds of lights they index
+		LightClusterBuilder lightClusters;
+		SphereArray lightClusterBounds;
+		bool useLightClusters = false;
+		// software depth buffer of main camera occluders. Units are tested against it only when drawn by occlusion camera
+		OcclusionCuller occlusionCuller;
+		const CameraUnit* occlusionCamera = nullptr;
+		// camera, directional light and material uniform blocks of current frame, packed into single buffer uploaded once
+		UniformBlockWriter frameUniformBlocks;
+		UniformBlockRange cameraBlocks;
+		UniformBlockRange dirLightBlocks;
+		UniformBlockRange materialBlocks;
+		// units sharing shader, material and geometry are merged into instanced draws, their attributes are uploaded per DrawObjects call
+		InstanceBatcher instanceBatcher;
+		MxVector<uint8_t> batchableUnits;
+		MxVector<DynamicInstanceData> dynamicInstances;
+		InstancedGeometryCache instancedGeometries;
+		InstanceBatchStatistics instancingStatistics;
+		bool useDynamicInstancing = true;
 
 		void PrepareShadowMaps();
+		void BuildLightClusters();
+		void PrepareOcclusionBuffer();
+		void SubmitUniformBlocks();
 		void DrawSkybox(const CameraUnit& camera);
-		void DrawObjects(const CameraUnit& camera, const Shader& shader, const MxVector<RenderUnit>& objects);
+		void DrawObjects(const CameraUnit& camera, const Shader& shader, const MxVector<RenderUnit>& objects, RenderSortOrder order);
 		void DrawDebugBuffer(const CameraUnit& camera);
+		void BindMaterial(size_t materialIndex, const Shader& shader);
 		void DrawObject(const RenderUnit& unit, const Shader& shader);
+		void DrawInstanceBatch(const InstanceBatch& batch, const MxVector<RenderUnit>& objects, const Shader& shader);
+		void SubmitInstanceData(const MxVector<RenderUnit>& objects);
+		void ReleaseUnusedInstancedGeometries();
+		const VertexArray& GetInstancedGeometry(const RenderUnit& unit);
+		size_t InternMaterial(const Material& material, float displacementScale);
 		void ComputeBloomEffect(CameraUnit& camera);
 		TextureHandle ComputeAverageWhite(CameraUnit& camera);
 		void PerformPostProcessing(CameraUnit& camera);
@@ -76,9 +173,29 @@ namespace MxEngine
 		void BindGBuffer(const CameraUnit& camera, const Shader& shader);
 		void BindFogInformation(const Shader& shader);
 		void BindCameraInformation(const CameraUnit& camera, const Shader& shader);
+		void BindDirectionalLights(const Shader& shader, Texture::TextureBindId textureId);
+		void BindUniformBlock(const Shader& shader, const UniformSlot& block, unsigned int bindingPoint, const UniformBlockRange& range, size_t index);
 	public:
 		const Renderer& GetRenderEngine() const;
 		Renderer& GetRenderEngine();
+		const ShadowMapStatistics& GetShadowMapStatistics() const;
+		void InvalidateShadowMaps();
+		void ToggleLightClusters(bool value);
+		bool IsLightClustersEnabled() const;
+		/*!
+		getter for light clusters of main camera. Light indices refer to shadowed point lights, then non-shadowed point lights,
+		then shadowed spot lights and then non-shadowed spot lights, in order of their submission
+		\returns cluster builder, which contains clusters built in last frame (empty if clustering is disabled)
+		*/
+		const LightClusterBuilder& GetLightClusters() const;
+		const OcclusionStatistics& GetOcclusionStatistics() const;
+		void ToggleDynamicInstancing(bool value);
+		bool IsDynamicInstancingEnabled() const;
+		/*!
+		getter for statistics of automatic instancing, summed over all opaque and transparent passes of current frame
+		\returns commands submitted to render queues and commands merged into instanced draws
+		*/
+		const InstanceBatchStatistics& GetInstancingStatistics() const;
 		void Render() const;
 		void Clear() const;
 		void ToggleDepthOnlyMode(bool value);
@@ -105,7 +222,10 @@ namespace MxEngine
 		void SubmitLightSource(const SpotLight& light, const TransformComponent& parentTransform);
 		void SubmitCamera(const CameraController& controller, const TransformComponent& parentTransform, 
 			const Skybox& skybox, const CameraEffects* effects = nullptr, const CameraToneMapping* toneMapping = nullptr, const CameraSSR* ssr = nullptr);
-		void SubmitPrimitive(const SubMesh& object, const Material& material, const TransformComponent& parentTransform, size_t instanceCount);
+		void SubmitPrimitive(const SubMesh& object, const Material& material, const Matrix4x4& parentMatrix, const Matrix3x3& parentNormalMatrix, size_t instanceCount, bool isVisible = true);
+		void SubmitPrimitive(const PrimitiveSubmission& primitive);
+		static void PreparePrimitive(const SubMesh& object, const Material& material, const Matrix4x4& parentMatrix, const Matrix3x3& parentNormalMatrix, 
+			size_t instanceCount, bool isVisible, PrimitiveSubmission& result);
 		void SubmitImage(const TextureHandle& texture);
 		void StartPipeline();
 		void EndPipeline();
@@ -29,12 +29,14 @@
 #pragma once
 
 #include "Core/BoundingObjects/FrustrumCuller.h"
+#include "Core/BoundingObjects/OcclusionCuller.h"
 #include "RenderObjects/Rectangle.h"
 #include "RenderObjects/SkyboxObject.h"
 #include "RenderObjects/RenderHelperObject.h"
 #include "RenderObjects/PointLightInstancedObject.h"
 #include "RenderObjects/SpotLightInstancedObject.h"
 #include "Core/Resources/ACESCurve.h"
+#include "Core/Resources/GeometryArena.h"
 #include "Core/Resources/Material.h"
 
 #include "Utilities/STL/MxHashMap.h"
@@ -68,6 +70,10 @@ namespace MxEngine
         Matrix4x4 InverseViewProjMatrix;
         Matrix4x4 ViewProjectionMatrix;
         Matrix4x4 StaticViewProjectionMatrix;
+        Matrix4x4 ViewMatrix;
+        Matrix4x4 ProjectionMatrix;
+        float ZNear;
+        float ZFar;
 
         Vector3 ViewportPosition;
         TextureHandle OutputTexture;
@@ -101,6 +107,11 @@ namespace MxEngine
         FrameBufferHandle DepthFrameBuffer;
         FrameBufferHandle PostProcessFrameBuffer;
         std::array<FrameBufferHandle, 2> BloomBuffers;
+        UniformBufferHandle FrameUniformBuffer;
+        // per-instance data of automatically instanced render units, shared by vertex arrays of all instanced geometries
+        VertexBufferHandle DynamicInstanceBuffer;
+        VertexBufferLayoutHandle DynamicInstanceLayout;
+        VertexBufferLayoutHandle MeshVertexLayout;
 
         SkyboxObject SkyboxCubeObject;
         DebugBufferUnit DebugBufferObject;
@@ -127,12 +138,14 @@ namespace MxEngine
         Vector3 AmbientColor;
         Vector3 DiffuseColor;
         Vector3 SpecularColor;
+        size_t ShadowUpdateInterval;
     };
 
     struct PointLightUnit : PointLightBaseData
     {
         CubeMapHandle ShadowMap;
         Matrix4x4 ProjectionMatrices[6];
+        size_t ShadowUpdateInterval;
     };
 
     struct SpotLightUnit : SpotLightBaseData
@@ -140,6 +153,7 @@ namespace MxEngine
         TextureHandle ShadowMap;
         Matrix4x4 ProjectionMatrix;
         Matrix4x4 BiasedProjectionMatrix;
+        size_t ShadowUpdateInterval;
     };
 
     struct LightingSystem
@@ -153,18 +167,36 @@ namespace MxEngine
         RenderHelperObject PyramidLight;
     };
 
+    // per-instance attributes of automatically instanced render units, laid out as buffers of InstanceFactory
+    struct DynamicInstanceData
+    {
+        Matrix4x4 ModelMatrix;
+        Matrix3x3 NormalMatrix;
+        Vector3 Color;
+
+        constexpr static size_t Size = 16 + 9 + 3;
+    };
+
     struct RenderUnit
     {
         VertexArrayHandle VAO;
         IndexBufferHandle IBO;
+        // source vertex buffer of VAO, used to build vertex array with instance attributes
+        VertexBufferHandle VBO;
+        // meshes stored in GeometryArena share buffers, so unit geometry is identified by its range and geometry id
+        GeometryRange Range;
+        uint32_t GeometryId;
 
+        // index into RenderPipeline::MaterialUnits, shared by all units with same material and displacement scale
         size_t materialIndex;
-        
+
         Matrix4x4 ModelMatrix;
         Matrix3x3 NormalMatrix;
 
         Vector3 MinAABB, MaxAABB;
         size_t InstanceCount;
+        // content of dynamic units can change without change of unit data (i.e. instance buffers), so they are never cached
+        bool IsDynamic;
     };
 
     struct RenderPipeline
@@ -175,6 +207,7 @@ namespace MxEngine
         MxVector<RenderUnit> OpaqueRenderUnits;
         MxVector<RenderUnit> TransparentRenderUnits;
         MxVector<Material> MaterialUnits;
+        MxVector<OccluderMesh> Occluders;
         MxVector<CameraUnit> Cameras;
     };
 }
\ No newline at end of file
@@ -0,0 +1,128 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "InstanceBatcher.h"
+#include "Core/Macro/Macro.h"
+
+namespace MxEngine
+{
+    InstanceBatchStatistics& InstanceBatchStatistics::operator+=(const InstanceBatchStatistics& other)
+    {
+        this->SubmittedCommands += other.SubmittedCommands;
+        this->InstancedCommands += other.InstancedCommands;
+        this->InstancedBatches  += other.InstancedBatches;
+        return *this;
+    }
+
+    void InstanceBatcher::SetMinBatchSize(size_t size)
+    {
+        MX_ASSERT(size >= 2);
+        this->minBatchSize = size;
+    }
+
+    size_t InstanceBatcher::GetMinBatchSize() const
+    {
+        return this->minBatchSize;
+    }
+
+    void InstanceBatcher::PushBatch(const MxVector<RenderCommand>& commands, size_t first, size_t count, InstanceBatchStatistics& statistics)
+    {
+        if (count > 1 && count < this->minBatchSize)
+        {
+            // short runs are not worth instance data upload, so each command is drawn separately
+            for (size_t i = first; i < first + count; i++)
+                this->PushBatch(commands, i, 1, statistics);
+            return;
+        }
+
+        auto& command = this->batchCommands.emplace_back(commands[first]);
+        command.UnitIndex = (uint32_t)this->batches.size();
+
+        auto& batch = this->batches.emplace_back();
+        batch.FirstCommand = (uint32_t)first;
+        batch.CommandCount = (uint32_t)count;
+        batch.FirstInstance = (uint32_t)this->instanceCount;
+
+        if (batch.IsInstanced())
+        {
+            this->instanceCount += count;
+            statistics.InstancedCommands += count;
+            statistics.InstancedBatches++;
+        }
+    }
+
+    InstanceBatchStatistics InstanceBatcher::Build(const MxVector<RenderCommand>& commands, const MxVector<uint8_t>& batchableUnits)
+    {
+        this->Clear();
+        this->batches.reserve(commands.size());
+        this->batchCommands.reserve(commands.size());
+
+        InstanceBatchStatistics statistics;
+        statistics.SubmittedCommands = commands.size();
+
+        size_t runBegin = 0;
+        for (size_t i = 1; i <= commands.size(); i++)
+        {
+            const auto& first = commands[runBegin];
+            bool continuesRun = i < commands.size() &&
+                batchableUnits[first.UnitIndex] && batchableUnits[commands[i].UnitIndex] &&
+                first.ShaderId == commands[i].ShaderId &&
+                first.MaterialId == commands[i].MaterialId &&
+                first.GeometryId == commands[i].GeometryId;
+
+            if (!continuesRun)
+            {
+                this->PushBatch(commands, runBegin, i - runBegin, statistics);
+                runBegin = i;
+            }
+        }
+        return statistics;
+    }
+
+    void InstanceBatcher::Clear()
+    {
+        this->batches.clear();
+        this->batchCommands.clear();
+        this->instanceCount = 0;
+    }
+
+    const MxVector<InstanceBatch>& InstanceBatcher::GetBatches() const
+    {
+        return this->batches;
+    }
+
+    const MxVector<RenderCommand>& InstanceBatcher::GetCommands() const
+    {
+        return this->batchCommands;
+    }
+
+    size_t InstanceBatcher::GetInstanceCount() const
+    {
+        return this->instanceCount;
+    }
+}
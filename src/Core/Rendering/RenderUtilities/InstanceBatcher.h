@@ -0,0 +1,87 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include "RenderCommandQueue.h"
+
+namespace MxEngine
+{
+    // run of sorted draw commands with equal shader, material and geometry, drawn by single instanced call
+    struct InstanceBatch
+    {
+        uint32_t FirstCommand;
+        uint32_t CommandCount;
+        // offset of batch instances in instance buffer. Batches of single command are drawn as usual and do not have instances
+        uint32_t FirstInstance;
+
+        bool IsInstanced() const { return this->CommandCount > 1; }
+    };
+
+    struct InstanceBatchStatistics
+    {
+        size_t SubmittedCommands = 0;
+        size_t InstancedCommands = 0;
+        size_t InstancedBatches = 0;
+
+        size_t GetDrawCalls() const { return this->SubmittedCommands - this->InstancedCommands + this->InstancedBatches; }
+        InstanceBatchStatistics& operator+=(const InstanceBatchStatistics& other);
+    };
+
+    /*
+    merges sorted draw commands into instance batches. As commands are sorted by shader, material and geometry,
+    units which can be drawn by one instanced call are adjacent, so batches are found by single linear pass.
+    Batcher does not use graphic API: caller decides which units can be instanced, fills instance data
+    for each instanced batch and replays batch commands, where UnitIndex is replaced by index of batch
+    */
+    class InstanceBatcher
+    {
+        MxVector<InstanceBatch> batches;
+        MxVector<RenderCommand> batchCommands;
+        size_t instanceCount = 0;
+        size_t minBatchSize = 2;
+
+        void PushBatch(const MxVector<RenderCommand>& commands, size_t first, size_t count, InstanceBatchStatistics& statistics);
+    public:
+        void SetMinBatchSize(size_t size);
+        size_t GetMinBatchSize() const;
+
+        /*!
+        groups commands into batches. Runs shorter than minimal batch size are split into batches of single command
+        \param commands commands sorted by RenderCommandQueue
+        \param batchableUnits flag for each unit (indexed by UnitIndex of command), if unit can be drawn as instance
+        \returns statistics of merged commands
+        */
+        InstanceBatchStatistics Build(const MxVector<RenderCommand>& commands, const MxVector<uint8_t>& batchableUnits);
+        void Clear();
+
+        const MxVector<InstanceBatch>& GetBatches() const;
+        const MxVector<RenderCommand>& GetCommands() const;
+        size_t GetInstanceCount() const;
+    };
+}
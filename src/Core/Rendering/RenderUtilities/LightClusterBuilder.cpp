@@ -0,0 +1,251 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "LightClusterBuilder.h"
+#include "Core/Macro/Macro.h"
+#include "Utilities/JobSystem/JobSystem.h"
+#include "Utilities/Profiler/Profiler.h"
+
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MXENGINE_CLUSTERS_USE_SSE
+#include <emmintrin.h>
+#endif
+
+namespace MxEngine
+{
+    LightClusterBuilder::LightClusterBuilder()
+    {
+        this->Clear();
+    }
+
+    void LightClusterBuilder::SetGrid(const LightClusterGrid& grid)
+    {
+        MX_ASSERT(grid.TilesX > 0 && grid.TilesY > 0 && grid.SlicesZ > 0);
+        MX_ASSERT(grid.TilesX <= 0xFFFF && grid.TilesY <= 0xFFFF && grid.SlicesZ <= 0xFFFF);
+        this->grid = grid;
+        this->Clear();
+    }
+
+    const LightClusterGrid& LightClusterBuilder::GetGrid() const
+    {
+        return this->grid;
+    }
+
+    void LightClusterBuilder::Clear()
+    {
+        this->offsets.assign(this->grid.GetClusterCount() + 1, 0);
+        this->lightIndices.clear();
+    }
+
+    void LightClusterBuilder::StoreLightRange(size_t index, float ndcMinX, float ndcMaxX, float ndcMinY, float ndcMaxY, float depthMin, float depthMax, float zNear, float zFar)
+    {
+        bool isCulled = depthMax < zNear || depthMin > zFar || ndcMaxX < -1.0f || ndcMinX > 1.0f || ndcMaxY < -1.0f || ndcMinY > 1.0f;
+        if (isCulled)
+        {
+            this->minZ[index] = 1;
+            this->maxZ[index] = 0;
+            return;
+        }
+
+        auto toTile = [](float ndc, uint32_t tiles)
+        {
+            float tile = (ndc * 0.5f + 0.5f) * float(tiles);
+            return (uint16_t)Clamp(int(std::floor(tile)), 0, int(tiles) - 1);
+        };
+        // slice k covers depths [near * (far / near) ^ (k / slices), near * (far / near) ^ ((k + 1) / slices))
+        float sliceScale = float(this->grid.SlicesZ) / std::log(zFar / zNear);
+        auto toSlice = [this, sliceScale, zNear](float depth)
+        {
+            float slice = std::log(Max(depth, zNear) / zNear) * sliceScale;
+            return (uint16_t)Clamp(int(std::floor(slice)), 0, int(this->grid.SlicesZ) - 1);
+        };
+
+        this->minX[index] = toTile(ndcMinX, this->grid.TilesX);
+        this->maxX[index] = toTile(ndcMaxX, this->grid.TilesX);
+        this->minY[index] = toTile(ndcMinY, this->grid.TilesY);
+        this->maxY[index] = toTile(ndcMaxY, this->grid.TilesY);
+        this->minZ[index] = toSlice(depthMin);
+        this->maxZ[index] = toSlice(Min(depthMax, zFar));
+    }
+
+    void LightClusterBuilder::ComputeLightRanges(const SphereArray& lights, size_t begin, size_t end, const Matrix4x4& view, const Matrix4x4& projection, float zNear, float zFar)
+    {
+        // for perspective projection ndc.x = P00 * x / d - P20 and ndc.y = P11 * y / d - P21, where d = -z is view depth.
+        // Sphere is bounded by view-space box, and x / d reaches its extremes at box corners, so checking both depths is enough
+        float scaleX = projection[0][0], offsetX = -projection[2][0];
+        float scaleY = projection[1][1], offsetY = -projection[2][1];
+        size_t i = begin;
+
+        #if defined(MXENGINE_CLUSTERS_USE_SSE)
+        const __m128 nearPlane = _mm_set1_ps(zNear);
+        const __m128 farPlane = _mm_set1_ps(zFar);
+        for (; i + 4 <= end; i += 4)
+        {
+            __m128 x = _mm_loadu_ps(lights.CenterX.data() + i);
+            __m128 y = _mm_loadu_ps(lights.CenterY.data() + i);
+            __m128 z = _mm_loadu_ps(lights.CenterZ.data() + i);
+            __m128 r = _mm_loadu_ps(lights.Radius.data() + i);
+
+            auto transform = [&x, &y, &z, &view](size_t row)
+            {
+                return _mm_add_ps(
+                    _mm_add_ps(_mm_mul_ps(_mm_set1_ps(view[0][row]), x), _mm_mul_ps(_mm_set1_ps(view[1][row]), y)),
+                    _mm_add_ps(_mm_mul_ps(_mm_set1_ps(view[2][row]), z), _mm_set1_ps(view[3][row])));
+            };
+            __m128 vx = transform(0);
+            __m128 vy = transform(1);
+            __m128 depth = _mm_sub_ps(_mm_setzero_ps(), transform(2));
+
+            __m128 depthMin = _mm_sub_ps(depth, r);
+            __m128 depthMax = _mm_add_ps(depth, r);
+            __m128 invNear = _mm_div_ps(_mm_set1_ps(1.0f), _mm_max_ps(depthMin, nearPlane));
+            __m128 invFar = _mm_div_ps(_mm_set1_ps(1.0f), _mm_max_ps(_mm_min_ps(depthMax, farPlane), nearPlane));
+
+            auto bounds = [&r, &invNear, &invFar](__m128 center, float scale, float offset, __m128& outMin, __m128& outMax)
+            {
+                __m128 low = _mm_sub_ps(center, r), high = _mm_add_ps(center, r);
+                __m128 a = _mm_mul_ps(low, invNear), b = _mm_mul_ps(low, invFar);
+                __m128 c = _mm_mul_ps(high, invNear), d = _mm_mul_ps(high, invFar);
+                __m128 s = _mm_set1_ps(scale), o = _mm_set1_ps(offset);
+                outMin = _mm_add_ps(_mm_mul_ps(_mm_min_ps(a, b), s), o);
+                outMax = _mm_add_ps(_mm_mul_ps(_mm_max_ps(c, d), s), o);
+            };
+            __m128 ndcMinX, ndcMaxX, ndcMinY, ndcMaxY;
+            bounds(vx, scaleX, offsetX, ndcMinX, ndcMaxX);
+            bounds(vy, scaleY, offsetY, ndcMinY, ndcMaxY);
+
+            alignas(16) float minXs[4], maxXs[4], minYs[4], maxYs[4], minDs[4], maxDs[4];
+            _mm_store_ps(minXs, ndcMinX); _mm_store_ps(maxXs, ndcMaxX);
+            _mm_store_ps(minYs, ndcMinY); _mm_store_ps(maxYs, ndcMaxY);
+            _mm_store_ps(minDs, depthMin); _mm_store_ps(maxDs, depthMax);
+
+            for (size_t lane = 0; lane < 4; lane++)
+                this->StoreLightRange(i + lane, minXs[lane], maxXs[lane], minYs[lane], maxYs[lane], minDs[lane], maxDs[lane], zNear, zFar);
+        }
+        #endif
+
+        for (; i < end; i++)
+        {
+            Vector3 center = Vector3(view * Vector4(lights.CenterX[i], lights.CenterY[i], lights.CenterZ[i], 1.0f));
+            float r = lights.Radius[i];
+            float depthMin = -center.z - r;
+            float depthMax = -center.z + r;
+            float invNear = 1.0f / Max(depthMin, zNear);
+            float invFar = 1.0f / Max(Min(depthMax, zFar), zNear);
+
+            float ndcMinX = Min((center.x - r) * invNear, (center.x - r) * invFar) * scaleX + offsetX;
+            float ndcMaxX = Max((center.x + r) * invNear, (center.x + r) * invFar) * scaleX + offsetX;
+            float ndcMinY = Min((center.y - r) * invNear, (center.y - r) * invFar) * scaleY + offsetY;
+            float ndcMaxY = Max((center.y + r) * invNear, (center.y + r) * invFar) * scaleY + offsetY;
+            this->StoreLightRange(i, ndcMinX, ndcMaxX, ndcMinY, ndcMaxY, depthMin, depthMax, zNear, zFar);
+        }
+    }
+
+    template<typename F>
+    void LightClusterBuilder::ForEachCluster(size_t light, uint32_t sliceBegin, uint32_t sliceEnd, F&& func) const
+    {
+        uint32_t zBegin = Max((uint32_t)this->minZ[light], sliceBegin);
+        uint32_t zEnd = Min((uint32_t)this->maxZ[light] + 1, sliceEnd);
+        for (uint32_t z = zBegin; z < zEnd; z++)
+        {
+            for (uint32_t y = this->minY[light]; y <= this->maxY[light]; y++)
+            {
+                for (uint32_t x = this->minX[light]; x <= this->maxX[light]; x++)
+                {
+                    func(this->grid.GetClusterIndex(x, y, z));
+                }
+            }
+        }
+    }
+
+    void LightClusterBuilder::Build(const SphereArray& lights, const Matrix4x4& view, const Matrix4x4& projection, float zNear, float zFar)
+    {
+        MAKE_SCOPE_PROFILER("LightClusterBuilder::Build()");
+        MX_ASSERT(zNear > 0.0f && zFar > zNear);
+
+        size_t lightCount = lights.Size();
+        for (auto* range : { &this->minX, &this->maxX, &this->minY, &this->maxY, &this->minZ, &this->maxZ })
+            range->resize(lightCount);
+
+        JobSystem::ParallelFor(lightCount, 1024, [&](size_t begin, size_t end)
+        {
+            this->ComputeLightRanges(lights, begin, end, view, projection, zNear, zFar);
+        });
+
+        // each job owns whole slices, so clusters are counted and filled without any synchronization
+        size_t clusterCount = this->grid.GetClusterCount();
+        this->offsets.assign(clusterCount + 1, 0);
+        JobSystem::ParallelFor(this->grid.SlicesZ, 0, [&](size_t sliceBegin, size_t sliceEnd)
+        {
+            for (size_t light = 0; light < lightCount; light++)
+            {
+                this->ForEachCluster(light, (uint32_t)sliceBegin, (uint32_t)sliceEnd, [this](size_t cluster) { this->offsets[cluster + 1]++; });
+            }
+        });
+
+        for (size_t i = 0; i < clusterCount; i++)
+            this->offsets[i + 1] += this->offsets[i];
+
+        this->cursors.assign(this->offsets.begin(), this->offsets.end() - 1);
+        this->lightIndices.resize(this->offsets.back());
+        JobSystem::ParallelFor(this->grid.SlicesZ, 0, [&](size_t sliceBegin, size_t sliceEnd)
+        {
+            for (size_t light = 0; light < lightCount; light++)
+            {
+                this->ForEachCluster(light, (uint32_t)sliceBegin, (uint32_t)sliceEnd, [this, light](size_t cluster)
+                {
+                    this->lightIndices[this->cursors[cluster]++] = (uint32_t)light;
+                });
+            }
+        });
+    }
+
+    size_t LightClusterBuilder::GetLightCount(size_t clusterIndex) const
+    {
+        MX_ASSERT(clusterIndex + 1 < this->offsets.size());
+        return this->offsets[clusterIndex + 1] - this->offsets[clusterIndex];
+    }
+
+    const uint32_t* LightClusterBuilder::GetLights(size_t clusterIndex) const
+    {
+        MX_ASSERT(clusterIndex + 1 < this->offsets.size());
+        return this->lightIndices.data() + this->offsets[clusterIndex];
+    }
+
+    const MxVector<uint32_t>& LightClusterBuilder::GetOffsets() const
+    {
+        return this->offsets;
+    }
+
+    const MxVector<uint32_t>& LightClusterBuilder::GetLightIndices() const
+    {
+        return this->lightIndices;
+    }
+}
@@ -0,0 +1,88 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include "Core/BoundingObjects/FrustrumCuller.h"
+#include "Utilities/STL/MxVector.h"
+
+#include <cstdint>
+
+namespace MxEngine
+{
+    // view-space froxel grid. Tiles split screen evenly, slices are distributed exponentially between near and far planes
+    struct LightClusterGrid
+    {
+        uint32_t TilesX = 16;
+        uint32_t TilesY = 9;
+        uint32_t SlicesZ = 24;
+
+        size_t GetClusterCount() const { return size_t(this->TilesX) * this->TilesY * this->SlicesZ; }
+        size_t GetClusterIndex(uint32_t x, uint32_t y, uint32_t z) const { return (size_t(z) * this->TilesY + y) * this->TilesX + x; }
+    };
+
+    /*
+    bins light bounding spheres into view-space clusters of perspective camera. Lights of cluster i are stored as compact list
+    LightIndices[Offsets[i], Offsets[i + 1]) sorted by light index. Builder does not use graphic API, bounds of four lights
+    are computed at once using SSE if it is available, and clusters are filled by JobSystem workers, each owning range of slices
+    */
+    class LightClusterBuilder
+    {
+        LightClusterGrid grid;
+        // inclusive cluster range of each light. Lights outside of camera frustrum have MinZ > MaxZ
+        MxVector<uint16_t> minX, maxX, minY, maxY, minZ, maxZ;
+        MxVector<uint32_t> offsets;
+        MxVector<uint32_t> cursors;
+        MxVector<uint32_t> lightIndices;
+
+        void ComputeLightRanges(const SphereArray& lights, size_t begin, size_t end, const Matrix4x4& view, const Matrix4x4& projection, float zNear, float zFar);
+        void StoreLightRange(size_t index, float ndcMinX, float ndcMaxX, float ndcMinY, float ndcMaxY, float depthMin, float depthMax, float zNear, float zFar);
+        template<typename F> void ForEachCluster(size_t light, uint32_t sliceBegin, uint32_t sliceEnd, F&& func) const;
+    public:
+        LightClusterBuilder();
+
+        void SetGrid(const LightClusterGrid& grid);
+        const LightClusterGrid& GetGrid() const;
+
+        /*!
+        rebuilds cluster light lists. Lights are identified by their index in spheres array
+        \param lights world-space bounding spheres of lights
+        \param view view matrix of camera
+        \param projection perspective projection matrix of camera
+        \param zNear distance to camera near plane
+        \param zFar distance to camera far plane
+        */
+        void Build(const SphereArray& lights, const Matrix4x4& view, const Matrix4x4& projection, float zNear, float zFar);
+        void Clear();
+
+        size_t GetLightCount(size_t clusterIndex) const;
+        const uint32_t* GetLights(size_t clusterIndex) const;
+        const MxVector<uint32_t>& GetOffsets() const;
+        const MxVector<uint32_t>& GetLightIndices() const;
+    };
+}
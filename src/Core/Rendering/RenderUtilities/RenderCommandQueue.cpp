@@ -0,0 +1,153 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "RenderCommandQueue.h"
+#include "Core/Macro/Macro.h"
+
+#include <array>
+#include <cstring>
+
+namespace MxEngine
+{
+    constexpr RenderSortKey MaskBits(uint32_t value, size_t bits)
+    {
+        return (RenderSortKey)value & ((RenderSortKey(1) << bits) - 1);
+    }
+
+    RenderSortKey RenderCommandQueue::MakeKey(RenderSortOrder order, uint8_t pass, uint32_t shaderId, uint32_t materialId, uint32_t geometryId, float depth)
+    {
+        RenderSortKey key = MaskBits(pass, PassBits) << (64 - PassBits);
+        if (order == RenderSortOrder::FRONT_TO_BACK)
+        {
+            // state is more significant than depth, so draws are grouped by state and sorted front-to-back inside each group
+            key |= MaskBits(shaderId, 12) << 48;
+            key |= MaskBits(materialId, 16) << 32;
+            key |= MaskBits(geometryId, 16) << 16;
+            key |= MaskBits(QuantizeDepth(depth, 16), 16);
+        }
+        else
+        {
+            // depth is inverted, so farthest objects get the smallest keys and are drawn first
+            constexpr size_t depthBits = 24;
+            uint32_t invertedDepth = ((1u << depthBits) - 1) - QuantizeDepth(depth, depthBits);
+            key |= MaskBits(invertedDepth, depthBits) << 36;
+            key |= MaskBits(shaderId, 12) << 24;
+            key |= MaskBits(materialId, 12) << 12;
+            key |= MaskBits(geometryId, 12);
+        }
+        return key;
+    }
+
+    uint32_t RenderCommandQueue::QuantizeDepth(float depth, size_t bits)
+    {
+        MX_ASSERT(bits > 0 && bits < 32);
+        if (!(depth > 0.0f)) return 0; // also handles NaN
+
+        // bit representation of positive floats is monotonic, so its highest bits can be used as a compact ordered value
+        uint32_t representation = 0;
+        std::memcpy(&representation, &depth, sizeof(depth));
+        return representation >> (31 - bits);
+    }
+
+    void RenderCommandQueue::RadixSort(MxVector<RenderCommand>& commands, MxVector<RenderCommand>& buffer)
+    {
+        constexpr size_t RadixBits = 8;
+        constexpr size_t RadixSize = 1 << RadixBits;
+        constexpr size_t PassCount = sizeof(RenderSortKey) * 8 / RadixBits;
+
+        const size_t count = commands.size();
+        if (count < 2) return;
+        buffer.resize(count);
+
+        std::array<std::array<uint32_t, RadixSize>, PassCount> histograms{ };
+        for (const auto& command : commands)
+        {
+            for (size_t pass = 0; pass < PassCount; pass++)
+            {
+                histograms[pass][(command.Key >> (pass * RadixBits)) & (RadixSize - 1)]++;
+            }
+        }
+
+        RenderCommand* source = commands.data();
+        RenderCommand* destination = buffer.data();
+        for (size_t pass = 0; pass < PassCount; pass++)
+        {
+            auto& histogram = histograms[pass];
+            // all keys have the same digit, so this pass would not change the order
+            if (histogram[(source[0].Key >> (pass * RadixBits)) & (RadixSize - 1)] == count) continue;
+
+            uint32_t offset = 0;
+            for (auto& bucket : histogram)
+            {
+                uint32_t bucketSize = bucket;
+                bucket = offset;
+                offset += bucketSize;
+            }
+
+            for (size_t i = 0; i < count; i++)
+            {
+                auto digit = (source[i].Key >> (pass * RadixBits)) & (RadixSize - 1);
+                destination[histogram[digit]++] = source[i];
+            }
+            std::swap(source, destination);
+        }
+
+        if (source != commands.data())
+            std::memcpy(commands.data(), source, count * sizeof(RenderCommand));
+    }
+
+    void RenderCommandQueue::Clear()
+    {
+        this->commands.clear();
+    }
+
+    void RenderCommandQueue::Reserve(size_t count)
+    {
+        this->commands.reserve(count);
+    }
+
+    void RenderCommandQueue::Push(RenderSortKey key, uint32_t unitIndex, uint32_t shaderId, uint32_t materialId, uint32_t geometryId)
+    {
+        this->commands.push_back(RenderCommand{ key, unitIndex, shaderId, materialId, geometryId });
+    }
+
+    void RenderCommandQueue::Sort()
+    {
+        RenderCommandQueue::RadixSort(this->commands, this->sortBuffer);
+    }
+
+    size_t RenderCommandQueue::GetCount() const
+    {
+        return this->commands.size();
+    }
+
+    const MxVector<RenderCommand>& RenderCommandQueue::GetCommands() const
+    {
+        return this->commands;
+    }
+}
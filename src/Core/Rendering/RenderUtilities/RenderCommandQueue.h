@@ -0,0 +1,157 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include "Utilities/STL/MxVector.h"
+
+#include <cstdint>
+#include <utility>
+
+namespace MxEngine
+{
+    using RenderSortKey = uint64_t;
+
+    enum class RenderSortOrder : uint8_t
+    {
+        FRONT_TO_BACK,
+        BACK_TO_FRONT,
+    };
+
+    struct RenderCommand
+    {
+        RenderSortKey Key;
+        uint32_t UnitIndex;
+        uint32_t ShaderId;
+        uint32_t MaterialId;
+        uint32_t GeometryId;
+    };
+
+    struct RenderQueueStatistics
+    {
+        size_t DrawCalls = 0;
+        size_t ShaderBinds = 0;
+        size_t MaterialBinds = 0;
+        size_t GeometryBinds = 0;
+        size_t ElidedShaderBinds = 0;
+        size_t ElidedMaterialBinds = 0;
+        size_t ElidedGeometryBinds = 0;
+    };
+
+    /*
+    CPU-side list of draw commands. Each command is assigned a packed 64-bit key, so sorting the keys groups draws by
+    pass and render state (or by depth for transparent objects). Queue does not know anything about graphic API:
+    state changes are reported to a visitor object on replay, and redundant ones are skipped.
+    Key layouts (from most significant bits):
+      FRONT_TO_BACK: pass (4) | shader (12) | material (16) | geometry (16) | depth (16)
+      BACK_TO_FRONT: pass (4) | inverted depth (24) | shader (12) | material (12) | geometry (12)
+    */
+    class RenderCommandQueue
+    {
+        MxVector<RenderCommand> commands;
+        MxVector<RenderCommand> sortBuffer;
+    public:
+        constexpr static size_t PassBits = 4;
+
+        /*!
+        packs render state and depth into sort key. Ids are truncated to the size of their field, so they only affect ordering
+        \param order draw order of commands inside one pass
+        \param pass index of render pass, commands of smaller passes are replayed first
+        \param shaderId id of shader used by draw command
+        \param materialId id of material used by draw command
+        \param geometryId id of vertex array used by draw command
+        \param depth non-negative distance from viewer to object (any monotonic measure, for example squared distance)
+        \returns sort key
+        */
+        static RenderSortKey MakeKey(RenderSortOrder order, uint8_t pass, uint32_t shaderId, uint32_t materialId, uint32_t geometryId, float depth);
+        /*!
+        maps non-negative float to integer of specified bit count preserving order of values. Negative values and NaN are mapped to zero
+        \param depth value to quantize
+        \param bits bit count of result, must be in range [1, 31]
+        \returns quantized value
+        */
+        static uint32_t QuantizeDepth(float depth, size_t bits);
+        /*!
+        stable LSD radix sort of commands by key. Byte passes where all keys are equal are skipped
+        \param commands commands to sort
+        \param buffer scratch buffer, resized to commands size if needed
+        */
+        static void RadixSort(MxVector<RenderCommand>& commands, MxVector<RenderCommand>& buffer);
+
+        void Clear();
+        void Reserve(size_t count);
+        void Push(RenderSortKey key, uint32_t unitIndex, uint32_t shaderId, uint32_t materialId, uint32_t geometryId);
+        void Sort();
+        size_t GetCount() const;
+        const MxVector<RenderCommand>& GetCommands() const;
+
+        /*!
+        replays sorted commands, invoking visitor only if corresponding state differs from previous command.
+        Visitor must provide BindShader, BindMaterial, BindGeometry and Draw methods accepting const RenderCommand&.
+        Shader change also rebinds material, as material parameters are shader uniforms
+        \param visitor object which performs actual state changes and draw calls
+        \returns statistics of issued and skipped state changes
+        */
+        template<typename Visitor>
+        RenderQueueStatistics Replay(Visitor&& visitor) const
+        {
+            return RenderCommandQueue::Replay(this->commands, std::forward<Visitor>(visitor));
+        }
+
+        /*!
+        replays commands which were sorted outside of queue (for example, merged into instance batches). See Replay(visitor)
+        \param commands sorted commands to replay
+        \param visitor object which performs actual state changes and draw calls
+        \returns statistics of issued and skipped state changes
+        */
+        template<typename Visitor>
+        static RenderQueueStatistics Replay(const MxVector<RenderCommand>& commands, Visitor&& visitor)
+        {
+            RenderQueueStatistics statistics;
+            const RenderCommand* previous = nullptr;
+            for (const auto& command : commands)
+            {
+                bool shaderChanged = previous == nullptr || previous->ShaderId != command.ShaderId;
+                bool materialChanged = shaderChanged || previous->MaterialId != command.MaterialId;
+                bool geometryChanged = previous == nullptr || previous->GeometryId != command.GeometryId;
+
+                if (shaderChanged)   { visitor.BindShader(command);   statistics.ShaderBinds++;   }
+                else statistics.ElidedShaderBinds++;
+                if (materialChanged) { visitor.BindMaterial(command); statistics.MaterialBinds++; }
+                else statistics.ElidedMaterialBinds++;
+                if (geometryChanged) { visitor.BindGeometry(command); statistics.GeometryBinds++; }
+                else statistics.ElidedGeometryBinds++;
+
+                visitor.Draw(command);
+                statistics.DrawCalls++;
+                previous = &command;
+            }
+            return statistics;
+        }
+    };
+}
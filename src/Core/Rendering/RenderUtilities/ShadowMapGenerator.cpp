@@ -30,32 +30,179 @@
 #include "Core/Application/Rendering.h"
 #include "Core/Rendering/RenderPipeline.h"
 
+#include <limits>
+
 namespace MxEngine
 {
-    ShadowMapGenerator::ShadowMapGenerator(ArrayView<RenderUnit> shadowCasters, ArrayView<Material> materials)
-        : shadowCasters(shadowCasters), materials(materials)
+    static const UniformSlot DisplacementSlot("displacement");
+    static const UniformSlot HeightMapSlot("map_height");
+    static const UniformSlot FaceMaskSlot("faceMask");
+    static const UniformSlot LightProjMatrixSlot("LightProjMatrix");
+    static const UniformSlot PointLightProjMatrixSlots[] = {
+        UniformSlot("LightProjMatrix[0]"), UniformSlot("LightProjMatrix[1]"), UniformSlot("LightProjMatrix[2]"),
+        UniformSlot("LightProjMatrix[3]"), UniformSlot("LightProjMatrix[4]"), UniformSlot("LightProjMatrix[5]"),
+    };
+    static const UniformSlot ZFarSlot("zFar");
+    static const UniformSlot LightPositionSlot("lightPos");
+
+    ShadowMapGenerator::ShadowMapGenerator(ArrayView<RenderUnit> shadowCasters, ArrayView<Material> materials, ShadowCasterCullingData& culling, ShadowMapCache& cache, ShadowMapStatistics& statistics)
+        : shadowCasters(shadowCasters), materials(materials), culling(culling), cache(cache), statistics(statistics)
     {
         Rendering::GetController().ToggleReversedDepth(false);
         Rendering::GetController().ToggleDepthOnlyMode(true);
+
+        // caster boxes and signatures are shared by all lights, so they are gathered once per frame
+        this->culling.Boxes.Clear();
+        this->culling.CasterSignatures.clear();
+        for (const auto& unit : this->shadowCasters)
+        {
+            this->culling.Boxes.Add(unit.MinAABB, unit.MaxAABB);
+
+            const auto& material = this->materials[unit.materialIndex];
+            uint64_t signature = HashFloats(0, &unit.ModelMatrix[0][0], 16);
+            signature = HashCombine(signature, unit.VAO->GetNativeHandle());
+            signature = HashCombine(signature, unit.IBO->GetNativeHandle());
+            signature = HashCombine(signature, unit.GeometryId);
+            signature = HashCombine(signature, unit.InstanceCount);
+            signature = HashCombine(signature, material.HeightMap->GetNativeHandle());
+            signature = HashFloats(signature, &material.Displacement, 1);
+            this->culling.CasterSignatures.push_back(signature);
+        }
+        this->culling.Visibility.resize(this->shadowCasters.size());
+        this->culling.FaceVisibility.resize(this->shadowCasters.size());
+        this->culling.FaceMasks.resize(this->shadowCasters.size());
+
+        this->cache.FrameIndex++;
     }
 
     ShadowMapGenerator::~ShadowMapGenerator()
     {
         Rendering::GetController().ToggleDepthOnlyMode(false);
+
+        // forget maps of lights which were not submitted this frame, as their handles may be reused by new maps
+        for (auto it = this->cache.Entries.begin(); it != this->cache.Entries.end();)
+        {
+            if (it->second.LastUsedFrame != this->cache.FrameIndex)
+                it = this->cache.Entries.erase(it);
+            else
+                it++;
+        }
+    }
+
+    void ShadowMapGenerator::CullShadowCasters(const Matrix4x4& lightProjection)
+    {
+        FrustrumCuller culler(lightProjection);
+        culler.CullAABBs(this->culling.Boxes, this->culling.Visibility.data());
+
+        // instanced units are culled per instance by InstanceFactory, as unit AABB covers only base mesh
+        for (size_t i = 0; i < this->shadowCasters.size(); i++)
+        {
+            if (this->shadowCasters[i].InstanceCount > 0) this->culling.Visibility[i] = 1;
+        }
+    }
+
+    void ShadowMapGenerator::CullShadowCasters(const Vector3& lightPosition, float lightRadius, const Matrix4x4* faceProjections)
+    {
+        const auto& boxes = this->culling.Boxes;
+        auto& visibility = this->culling.Visibility;
+        auto& faceMasks = this->culling.FaceMasks;
+
+        // caster is affected by point light only if its box intersects light sphere
+        for (size_t i = 0; i < boxes.Size(); i++)
+        {
+            float dx = Max(std::abs(lightPosition.x - boxes.CenterX[i]) - boxes.ExtentX[i], 0.0f);
+            float dy = Max(std::abs(lightPosition.y - boxes.CenterY[i]) - boxes.ExtentY[i], 0.0f);
+            float dz = Max(std::abs(lightPosition.z - boxes.CenterZ[i]) - boxes.ExtentZ[i], 0.0f);
+            bool isInstanced = this->shadowCasters[i].InstanceCount > 0;
+            visibility[i] = uint8_t(isInstanced || dx * dx + dy * dy + dz * dz <= lightRadius * lightRadius);
+            faceMasks[i] = isInstanced ? 0x3F : 0;
+        }
+
+        for (uint8_t face = 0; face < 6; face++)
+        {
+            FrustrumCuller culler(faceProjections[face]);
+            culler.CullAABBs(boxes, this->culling.FaceVisibility.data());
+            for (size_t i = 0; i < boxes.Size(); i++)
+            {
+                faceMasks[i] |= uint8_t(this->culling.FaceVisibility[i] << face);
+            }
+        }
+
+        for (size_t i = 0; i < boxes.Size(); i++)
+        {
+            if (!visibility[i]) faceMasks[i] = 0;
+            if (faceMasks[i] == 0) visibility[i] = 0;
+        }
     }
 
-    void CastShadows(const Shader& shader, ArrayView<RenderUnit> shadowCasters, ArrayView<Material> materials)
+    uint64_t ShadowMapGenerator::ComputeSignature(const Matrix4x4* lightProjections, size_t projectionCount, size_t mapSize, bool& hasDynamicCasters) const
     {
-        for (const auto& unit : shadowCasters)
+        uint64_t signature = HashFloats(mapSize, &lightProjections[0][0][0], 16 * projectionCount);
+        hasDynamicCasters = false;
+        for (size_t i = 0; i < this->shadowCasters.size(); i++)
         {
-            const auto& material = materials[unit.materialIndex];
-            material.HeightMap->Bind(0);
-            shader.SetUniformFloat("displacement", material.Displacement);
-            shader.SetUniformInt("map_height", material.HeightMap->GetBoundId());
+            if (!this->culling.Visibility[i]) continue;
+            signature = HashCombine(signature, this->culling.CasterSignatures[i]);
+            hasDynamicCasters |= this->shadowCasters[i].IsDynamic;
+        }
+        return signature;
+    }
+
+    bool ShadowMapGenerator::ShouldRefresh(unsigned int mapId, uint64_t signature, bool hasDynamicCasters, size_t updateInterval, size_t lightIndex)
+    {
+        auto it = this->cache.Entries.find(mapId);
+        bool isCached = it != this->cache.Entries.end();
+        if (!isCached) it = this->cache.Entries.emplace(mapId, ShadowMapCacheEntry{ }).first;
+
+        auto& entry = it->second;
+        entry.LastUsedFrame = this->cache.FrameIndex;
+
+        if (isCached && entry.Signature == signature && !hasDynamicCasters)
+        {
+            this->statistics.CachedShadowMaps++;
+            return false;
+        }
+
+        // lights are updated in round-robin order, so maps with same interval are spread across frames
+        bool isThrottled = updateInterval > 1 && (this->cache.FrameIndex + lightIndex) % updateInterval != 0;
+        if (isCached && isThrottled)
+        {
+            this->statistics.ThrottledShadowMaps++;
+            return false;
+        }
+
+        entry.Signature = signature;
+        this->statistics.RefreshedShadowMaps++;
+        return true;
+    }
+
+    void ShadowMapGenerator::CastShadows(const Shader& shader, bool useFaceMasks)
+    {
+        // materials are interned per frame, so consecutive casters often share one and its uniforms can be kept
+        size_t boundMaterialIndex = std::numeric_limits<size_t>::max();
+        this->statistics.TestedCasters += this->shadowCasters.size();
+
+        for (size_t i = 0; i < this->shadowCasters.size(); i++)
+        {
+            if (!this->culling.Visibility[i]) continue;
+            const auto& unit = this->shadowCasters[i];
+
+            if (unit.materialIndex != boundMaterialIndex)
+            {
+                const auto& material = this->materials[unit.materialIndex];
+                material.HeightMap->Bind(0);
+                shader.SetUniformFloat(DisplacementSlot, material.Displacement);
+                shader.SetUniformInt(HeightMapSlot, material.HeightMap->GetBoundId());
+                boundMaterialIndex = unit.materialIndex;
+            }
+            if (useFaceMasks) shader.SetUniformInt(FaceMaskSlot, (int)this->culling.FaceMasks[i]);
 
             Rendering::GetController().GetRenderEngine().SetDefaultVertexAttribute(5, unit.ModelMatrix); //-V807
             Rendering::GetController().GetRenderEngine().SetDefaultVertexAttribute(9, unit.NormalMatrix);
-            Rendering::GetController().GetRenderEngine().DrawTrianglesInstanced(*unit.VAO, *unit.IBO, shader, unit.InstanceCount);
+            const auto& range = unit.Range;
+            Rendering::GetController().GetRenderEngine().DrawTrianglesRange(*unit.VAO, *unit.IBO, shader, 
+                range.IndexCount, range.FirstIndex, range.BaseVertex, unit.InstanceCount);
+            this->statistics.DrawnCasters++;
         }
     }
 
@@ -63,15 +210,23 @@ namespace MxEngine
     {
         auto& controller = Rendering::GetController();
 
-        for (auto& directionalLight : directionalLights)
+        for (size_t lightIndex = 0; lightIndex < directionalLights.size(); lightIndex++)
         {
+            auto& directionalLight = directionalLights[lightIndex];
             for (size_t i = 0; i < directionalLight.ShadowMaps.size(); i++)
             {
-                controller.AttachDepthMap(directionalLight.ShadowMaps[i]);
-                shader.SetUniformMat4("LightProjMatrix", directionalLight.ProjectionMatrices[i]);
+                auto& shadowMap = directionalLight.ShadowMaps[i];
+                bool hasDynamicCasters = false;
+                this->CullShadowCasters(directionalLight.ProjectionMatrices[i]);
+                auto signature = this->ComputeSignature(&directionalLight.ProjectionMatrices[i], 1, shadowMap->GetWidth(), hasDynamicCasters);
+                if (!this->ShouldRefresh(shadowMap->GetNativeHandle(), signature, hasDynamicCasters, directionalLight.ShadowUpdateInterval, lightIndex))
+                    continue;
+
+                controller.AttachDepthMap(shadowMap);
+                shader.SetUniformMat4(LightProjMatrixSlot, directionalLight.ProjectionMatrices[i]);
 
-                CastShadows(shader, this->shadowCasters, this->materials);
-                directionalLight.ShadowMaps[i]->GenerateMipmaps();
+                this->CastShadows(shader, false);
+                shadowMap->GenerateMipmaps();
             }
         }
     }
@@ -80,12 +235,19 @@ namespace MxEngine
     {
         auto& controller = Rendering::GetController();
 
-        for (auto& spotLight : spotLights)
+        for (size_t lightIndex = 0; lightIndex < spotLights.size(); lightIndex++)
         {
+            auto& spotLight = spotLights[lightIndex];
+            bool hasDynamicCasters = false;
+            this->CullShadowCasters(spotLight.ProjectionMatrix);
+            auto signature = this->ComputeSignature(&spotLight.ProjectionMatrix, 1, spotLight.ShadowMap->GetWidth(), hasDynamicCasters);
+            if (!this->ShouldRefresh(spotLight.ShadowMap->GetNativeHandle(), signature, hasDynamicCasters, spotLight.ShadowUpdateInterval, lightIndex))
+                continue;
+
             controller.AttachDepthMap(spotLight.ShadowMap);
-            shader.SetUniformMat4("LightProjMatrix", spotLight.ProjectionMatrix);
+            shader.SetUniformMat4(LightProjMatrixSlot, spotLight.ProjectionMatrix);
 
-            CastShadows(shader, this->shadowCasters, this->materials);
+            this->CastShadows(shader, false);
             spotLight.ShadowMap->GenerateMipmaps();
         }
     }
@@ -94,19 +256,35 @@ namespace MxEngine
     {
         auto& controller = Rendering::GetController();
 
-        for (auto& pointLight : pointLights)
+        for (size_t lightIndex = 0; lightIndex < pointLights.size(); lightIndex++)
         {
+            auto& pointLight = pointLights[lightIndex];
+            bool hasDynamicCasters = false;
+            this->CullShadowCasters(pointLight.Position, pointLight.Radius, pointLight.ProjectionMatrices);
+            auto signature = this->ComputeSignature(pointLight.ProjectionMatrices, std::size(pointLight.ProjectionMatrices), pointLight.ShadowMap->GetWidth(), hasDynamicCasters);
+            if (!this->ShouldRefresh(pointLight.ShadowMap->GetNativeHandle(), signature, hasDynamicCasters, pointLight.ShadowUpdateInterval, lightIndex))
+                continue;
+
             controller.AttachDepthMap(pointLight.ShadowMap);
-            shader.SetUniformMat4("LightProjMatrix[0]", pointLight.ProjectionMatrices[0]);
-            shader.SetUniformMat4("LightProjMatrix[1]", pointLight.ProjectionMatrices[1]);
-            shader.SetUniformMat4("LightProjMatrix[2]", pointLight.ProjectionMatrices[2]);
-            shader.SetUniformMat4("LightProjMatrix[3]", pointLight.ProjectionMatrices[3]);
-            shader.SetUniformMat4("LightProjMatrix[4]", pointLight.ProjectionMatrices[4]);
-            shader.SetUniformMat4("LightProjMatrix[5]", pointLight.ProjectionMatrices[5]);
-            shader.SetUniformFloat("zFar", pointLight.Radius);
-            shader.SetUniformVec3("lightPos", pointLight.Position);
-
-            CastShadows(shader, this->shadowCasters, this->materials);
+            for (size_t face = 0; face < std::size(PointLightProjMatrixSlots); face++)
+                shader.SetUniformMat4(PointLightProjMatrixSlots[face], pointLight.ProjectionMatrices[face]);
+            shader.SetUniformFloat(ZFarSlot, pointLight.Radius);
+            shader.SetUniformVec3(LightPositionSlot, pointLight.Position);
+
+            // geometry shader emits caster only into faces of its mask, so faces without casters receive no geometry
+            uint8_t usedFaces = 0;
+            for (size_t i = 0; i < this->shadowCasters.size(); i++)
+                usedFaces |= this->culling.FaceMasks[i];
+
+            for (uint8_t face = 0; face < 6; face++)
+            {
+                if (usedFaces & (1 << face))
+                    this->statistics.RenderedCubeFaces++;
+                else
+                    this->statistics.SkippedCubeFaces++;
+            }
+
+            if (usedFaces != 0) this->CastShadows(shader, true);
             pointLight.ShadowMap->GenerateMipmaps();
         }
     }
@@ -27,6 +27,8 @@
 // OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "Utilities/Array/ArrayView.h"
+#include "Core/BoundingObjects/FrustrumCuller.h"
+#include "Utilities/STL/MxHashMap.h"
 
 namespace MxEngine
 {
@@ -37,12 +39,58 @@ namespace MxEngine
     struct RenderUnit;
     struct Material;
 
+    // shadow casters drawn and culled during one frame, summed over all shadow maps
+    struct ShadowMapStatistics
+    {
+        size_t TestedCasters = 0;
+        size_t DrawnCasters = 0;
+        size_t RenderedCubeFaces = 0;
+        size_t SkippedCubeFaces = 0;
+        size_t RefreshedShadowMaps = 0;
+        size_t CachedShadowMaps = 0;
+        size_t ThrottledShadowMaps = 0;
+
+        size_t CulledCasters() const { return this->TestedCasters - this->DrawnCasters; }
+    };
+
+    // scratch buffers for per-light caster culling, owned by caller to be reused between frames
+    struct ShadowCasterCullingData
+    {
+        AABBArray Boxes;
+        MxVector<uint8_t> Visibility;
+        MxVector<uint8_t> FaceVisibility;
+        MxVector<uint8_t> FaceMasks;
+        MxVector<uint64_t> CasterSignatures;
+    };
+
+    struct ShadowMapCacheEntry
+    {
+        uint64_t Signature = 0;
+        size_t LastUsedFrame = 0;
+    };
+
+    // signatures of shadow map contents rendered in previous frames, keyed by native handle of shadow map
+    struct ShadowMapCache
+    {
+        MxHashMap<unsigned int, ShadowMapCacheEntry> Entries;
+        size_t FrameIndex = 0;
+    };
+
     class ShadowMapGenerator
     {
         ArrayView<RenderUnit> shadowCasters;
         ArrayView<Material> materials;
+        ShadowCasterCullingData& culling;
+        ShadowMapCache& cache;
+        ShadowMapStatistics& statistics;
+
+        void CullShadowCasters(const Matrix4x4& lightProjection);
+        void CullShadowCasters(const Vector3& lightPosition, float lightRadius, const Matrix4x4* faceProjections);
+        uint64_t ComputeSignature(const Matrix4x4* lightProjections, size_t projectionCount, size_t mapSize, bool& hasDynamicCasters) const;
+        bool ShouldRefresh(unsigned int mapId, uint64_t signature, bool hasDynamicCasters, size_t updateInterval, size_t lightIndex);
+        void CastShadows(const Shader& shader, bool useFaceMasks);
     public:
-        ShadowMapGenerator(ArrayView<RenderUnit> shadowCasters, ArrayView<Material> materials);
+        ShadowMapGenerator(ArrayView<RenderUnit> shadowCasters, ArrayView<Material> materials, ShadowCasterCullingData& culling, ShadowMapCache& cache, ShadowMapStatistics& statistics);
         ~ShadowMapGenerator();
 
         void GenerateFor(const Shader& shader, ArrayView<DirectionalLightUnit> directionalLights);
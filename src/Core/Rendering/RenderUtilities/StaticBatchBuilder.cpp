@@ -0,0 +1,201 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "StaticBatchBuilder.h"
+#include "Core/Macro/Macro.h"
+#include "Utilities/JobSystem/JobSystem.h"
+#include "Utilities/Profiler/Profiler.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace MxEngine
+{
+    void StaticBatchBuilder::SetCellSize(float size)
+    {
+        MX_ASSERT(size > 0.0f);
+        this->cellSize = size;
+    }
+
+    float StaticBatchBuilder::GetCellSize() const
+    {
+        return this->cellSize;
+    }
+
+    bool StaticBatchBuilder::AddSource(const MeshData& data, const Matrix4x4& modelMatrix, const Matrix3x3& normalMatrix, size_t groupId)
+    {
+        // static batching requires CPU copy of mesh, geometry which was already freed can not be merged
+        if (data.GetVertecies().empty() || data.GetIndicies().empty()) return false;
+        this->sources.push_back(StaticBatchSource{ &data, modelMatrix, normalMatrix, groupId });
+        return true;
+    }
+
+    size_t StaticBatchBuilder::GetSourceCount() const
+    {
+        return this->sources.size();
+    }
+
+    void StaticBatchBuilder::GroupSources()
+    {
+        size_t sourceCount = this->sources.size();
+        this->sourceCells.resize(sourceCount);
+        this->sourceOrder.resize(sourceCount);
+        this->sourceRanges.resize(sourceCount);
+
+        for (size_t i = 0; i < sourceCount; i++)
+        {
+            const auto& source = this->sources[i];
+            auto center = (source.Data->GetBoundingBox() * source.ModelMatrix).GetCenter() / this->cellSize;
+            this->sourceCells[i] = VectorInt3((int)std::floor(center.x), (int)std::floor(center.y), (int)std::floor(center.z));
+            this->sourceOrder[i] = (uint32_t)i;
+        }
+
+        // sorting by group and cell makes sources of each batch adjacent. Ties are broken by index, so result does not depend on sort stability
+        std::sort(this->sourceOrder.begin(), this->sourceOrder.end(), [this](uint32_t lhs, uint32_t rhs)
+        {
+            const auto& cellL = this->sourceCells[lhs];
+            const auto& cellR = this->sourceCells[rhs];
+            auto groupL = this->sources[lhs].GroupId;
+            auto groupR = this->sources[rhs].GroupId;
+            if (groupL != groupR) return groupL < groupR;
+            if (cellL.x != cellR.x) return cellL.x < cellR.x;
+            if (cellL.y != cellR.y) return cellL.y < cellR.y;
+            if (cellL.z != cellR.z) return cellL.z < cellR.z;
+            return lhs < rhs;
+        });
+
+        size_t vertexCount = 0;
+        size_t indexCount = 0;
+        for (size_t k = 0; k < sourceCount; k++)
+        {
+            auto index = this->sourceOrder[k];
+            const auto& source = this->sources[index];
+            const auto& cell = this->sourceCells[index];
+
+            bool startsBatch = this->batches.empty() || this->batches.back().GroupId != source.GroupId || this->batches.back().Cell != cell;
+            if (startsBatch)
+            {
+                if (!this->batches.empty())
+                {
+                    this->batches.back().Vertecies.resize(vertexCount);
+                    this->batches.back().Indicies.resize(indexCount);
+                }
+                auto& batch = this->batches.emplace_back();
+                batch.GroupId = source.GroupId;
+                batch.Cell = cell;
+                vertexCount = 0;
+                indexCount = 0;
+            }
+
+            this->sourceRanges[index] = SourceRange{ (uint32_t)(this->batches.size() - 1), (uint32_t)vertexCount, (uint32_t)indexCount };
+            vertexCount += source.Data->GetVertecies().size();
+            indexCount += source.Data->GetIndicies().size();
+        }
+
+        if (!this->batches.empty())
+        {
+            this->batches.back().Vertecies.resize(vertexCount);
+            this->batches.back().Indicies.resize(indexCount);
+        }
+    }
+
+    void StaticBatchBuilder::MergeSource(size_t sourceIndex)
+    {
+        const auto& source = this->sources[sourceIndex];
+        const auto& range = this->sourceRanges[sourceIndex];
+        auto& batch = this->batches[range.Batch];
+
+        // normals are not normalized here, as shaders normalize them after applying normal matrix anyway
+        const auto& vertecies = source.Data->GetVertecies();
+        auto* vertexOutput = batch.Vertecies.data() + range.FirstVertex;
+        for (size_t i = 0; i < vertecies.size(); i++)
+        {
+            const auto& vertex = vertecies[i];
+            auto& result = vertexOutput[i];
+            result.Position  = Vector3(source.ModelMatrix * Vector4(vertex.Position, 1.0f));
+            result.TexCoord  = vertex.TexCoord;
+            result.Normal    = source.NormalMatrix * vertex.Normal;
+            result.Tangent   = source.NormalMatrix * vertex.Tangent;
+            result.Bitangent = source.NormalMatrix * vertex.Bitangent;
+        }
+
+        const auto& indicies = source.Data->GetIndicies();
+        auto* indexOutput = batch.Indicies.data() + range.FirstIndex;
+        for (size_t i = 0; i < indicies.size(); i++)
+        {
+            indexOutput[i] = indicies[i] + range.FirstVertex;
+        }
+    }
+
+    void StaticBatchBuilder::Build()
+    {
+        MAKE_SCOPE_PROFILER("StaticBatchBuilder::Build()");
+        this->batches.clear();
+        this->GroupSources();
+
+        // sources differ a lot in size, so they are processed by small jobs to balance workers
+        constexpr size_t SourcesPerJob = 8;
+        JobSystem::ParallelFor(this->sources.size(), SourcesPerJob, [this](size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; i++)
+                this->MergeSource(i);
+        });
+
+        this->statistics.MergedSources = this->sources.size();
+        this->statistics.Batches = this->batches.size();
+        this->statistics.Vertecies = 0;
+        this->statistics.Indicies = 0;
+        for (const auto& batch : this->batches)
+        {
+            this->statistics.Vertecies += batch.Vertecies.size();
+            this->statistics.Indicies += batch.Indicies.size();
+        }
+        this->statistics.Rebuilds++;
+    }
+
+    void StaticBatchBuilder::Clear()
+    {
+        this->sources.clear();
+        this->batches.clear();
+    }
+
+    MxVector<StaticGeometryBatch>& StaticBatchBuilder::GetBatches()
+    {
+        return this->batches;
+    }
+
+    const MxVector<StaticGeometryBatch>& StaticBatchBuilder::GetBatches() const
+    {
+        return this->batches;
+    }
+
+    const StaticBatchStatistics& StaticBatchBuilder::GetStatistics() const
+    {
+        return this->statistics;
+    }
+}
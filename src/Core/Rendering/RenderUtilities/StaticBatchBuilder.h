@@ -0,0 +1,112 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include "Core/Resources/MeshData.h"
+
+namespace MxEngine
+{
+    // submesh merged into static batch. Mesh data must keep CPU copy of its vertecies and indicies
+    struct StaticBatchSource
+    {
+        const MeshData* Data;
+        Matrix4x4 ModelMatrix;
+        Matrix3x3 NormalMatrix;
+        // sources are merged only with sources of the same group, for example with ones sharing material
+        size_t GroupId;
+    };
+
+    // world-space geometry of all sources of one group which bounding box centers lie in the same spatial cell
+    struct StaticGeometryBatch
+    {
+        size_t GroupId;
+        VectorInt3 Cell;
+        MxVector<Vertex> Vertecies;
+        MxVector<uint32_t> Indicies;
+    };
+
+    struct StaticBatchStatistics
+    {
+        size_t MergedSources = 0;
+        size_t Batches = 0;
+        size_t Vertecies = 0;
+        size_t Indicies = 0;
+        size_t Rebuilds = 0;
+    };
+
+    /*
+    merges static submeshes into combined pre-transformed meshes. Sources are grouped by their group id and by spatial cell
+    of their bounding box center, so each batch stays compact and can still be culled by frustrum and occlusion tests.
+    Builder does not use graphic API. Vertex transformation is split between JobSystem workers, as each source
+    writes into its own range of batch buffers, computed before merge
+    */
+    class StaticBatchBuilder
+    {
+        struct SourceRange
+        {
+            uint32_t Batch;
+            uint32_t FirstVertex;
+            uint32_t FirstIndex;
+        };
+
+        MxVector<StaticBatchSource> sources;
+        MxVector<VectorInt3> sourceCells;
+        MxVector<uint32_t> sourceOrder;
+        MxVector<SourceRange> sourceRanges;
+        MxVector<StaticGeometryBatch> batches;
+        StaticBatchStatistics statistics;
+        float cellSize = 64.0f;
+
+        void GroupSources();
+        void MergeSource(size_t sourceIndex);
+    public:
+        void SetCellSize(float size);
+        float GetCellSize() const;
+
+        /*!
+        adds submesh to be merged by next Build() call. Mesh data is referenced, not copied, so it must stay alive until Clear() call
+        \param data geometry of submesh. Must keep CPU copy of its vertecies and indicies
+        \param modelMatrix transform from submesh space to world space
+        \param normalMatrix transform of submesh normals to world space
+        \param groupId id of group (for example material) of submesh. Sources of different groups are never merged
+        \returns true if source was added, false if mesh data has no CPU copy and was skipped
+        */
+        bool AddSource(const MeshData& data, const Matrix4x4& modelMatrix, const Matrix3x3& normalMatrix, size_t groupId);
+        size_t GetSourceCount() const;
+        /*!
+        merges all added sources into batches. Batches of previous build are discarded, sources are kept until Clear() call
+        */
+        void Build();
+        void Clear();
+
+        MxVector<StaticGeometryBatch>& GetBatches();
+        const MxVector<StaticGeometryBatch>& GetBatches() const;
+        const StaticBatchStatistics& GetStatistics() const;
+    };
+}
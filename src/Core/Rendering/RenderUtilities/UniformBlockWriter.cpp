@@ -0,0 +1,128 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "UniformBlockWriter.h"
+#include "Core/Macro/Macro.h"
+
+#include <cstring>
+
+namespace MxEngine
+{
+    size_t UniformBlockWriter::AlignOffset(size_t offset, size_t alignment)
+    {
+        MX_ASSERT(alignment != 0 && (alignment & (alignment - 1)) == 0);
+        return (offset + alignment - 1) & ~(alignment - 1);
+    }
+
+    size_t UniformBlockWriter::Write(const void* value, size_t size, size_t alignment)
+    {
+        size_t offset = this->AlignTo(alignment);
+        this->data.resize(offset + size);
+        std::memcpy(this->data.data() + offset, value, size);
+        return offset;
+    }
+
+    void UniformBlockWriter::Clear()
+    {
+        this->data.clear();
+    }
+
+    size_t UniformBlockWriter::AlignTo(size_t alignment)
+    {
+        size_t offset = AlignOffset(this->data.size(), alignment);
+        this->data.resize(offset, 0);
+        return offset;
+    }
+
+    size_t UniformBlockWriter::BeginStruct()
+    {
+        return this->AlignTo(VectorAlignment);
+    }
+
+    size_t UniformBlockWriter::EndStruct()
+    {
+        return this->AlignTo(VectorAlignment);
+    }
+
+    size_t UniformBlockWriter::Write(int value)
+    {
+        return this->Write(&value, sizeof(value), sizeof(value));
+    }
+
+    size_t UniformBlockWriter::Write(unsigned int value)
+    {
+        return this->Write(&value, sizeof(value), sizeof(value));
+    }
+
+    size_t UniformBlockWriter::Write(float value)
+    {
+        return this->Write(&value, sizeof(value), sizeof(value));
+    }
+
+    size_t UniformBlockWriter::Write(const Vector2& value)
+    {
+        return this->Write(&value[0], sizeof(value), 2 * sizeof(float));
+    }
+
+    size_t UniformBlockWriter::Write(const Vector3& value)
+    {
+        // vec3 is aligned as vec4, but next scalar may be placed into its last component
+        return this->Write(&value[0], sizeof(value), VectorAlignment);
+    }
+
+    size_t UniformBlockWriter::Write(const Vector4& value)
+    {
+        return this->Write(&value[0], sizeof(value), VectorAlignment);
+    }
+
+    size_t UniformBlockWriter::Write(const Matrix3x3& value)
+    {
+        size_t offset = this->AlignTo(VectorAlignment);
+        for (size_t i = 0; i < 3; i++)
+        {
+            this->Write(value[i]);
+            this->AlignTo(VectorAlignment);
+        }
+        return offset;
+    }
+
+    size_t UniformBlockWriter::Write(const Matrix4x4& value)
+    {
+        return this->Write(&value[0][0], sizeof(value), VectorAlignment);
+    }
+
+    const uint8_t* UniformBlockWriter::GetData() const
+    {
+        return this->data.data();
+    }
+
+    size_t UniformBlockWriter::GetSize() const
+    {
+        return this->data.size();
+    }
+}
@@ -0,0 +1,94 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include "Utilities/Math/Math.h"
+#include "Utilities/STL/MxVector.h"
+
+#include <cstdint>
+
+namespace MxEngine
+{
+    /*
+    packs values into byte array using std140 layout rules, so it can be uploaded into uniform buffer as is.
+    Scalars are aligned by 4 bytes, vec2 by 8, vec3 and vec4 by 16. Matrices are stored as arrays of column vectors,
+    array elements and structures are aligned by 16 bytes and padded to multiple of 16 bytes.
+    Writer does not use graphic API, each Write() call returns byte offset at which value was placed
+    */
+    class UniformBlockWriter
+    {
+        MxVector<uint8_t> data;
+
+        size_t Write(const void* value, size_t size, size_t alignment);
+    public:
+        constexpr static size_t VectorAlignment = 16;
+
+        static size_t AlignOffset(size_t offset, size_t alignment);
+
+        void Clear();
+        /*!
+        pads current block with zeros, so next value will be placed at offset which is multiple of alignment
+        \param alignment required alignment in bytes. Must be power of two
+        \returns aligned offset
+        */
+        size_t AlignTo(size_t alignment);
+        size_t BeginStruct();
+        size_t EndStruct();
+
+        size_t Write(int value);
+        size_t Write(unsigned int value);
+        size_t Write(float value);
+        size_t Write(const Vector2& value);
+        size_t Write(const Vector3& value);
+        size_t Write(const Vector4& value);
+        size_t Write(const Matrix3x3& value);
+        size_t Write(const Matrix4x4& value);
+
+        /*!
+        writes array of values, each element of which is aligned by 16 bytes as std140 requires
+        \param values pointer to first element of array
+        \param count number of elements in array
+        \returns offset of first array element
+        */
+        template<typename T>
+        size_t WriteArray(const T* values, size_t count)
+        {
+            size_t offset = this->AlignTo(VectorAlignment);
+            for (size_t i = 0; i < count; i++)
+            {
+                this->Write(values[i]);
+                this->AlignTo(VectorAlignment);
+            }
+            return offset;
+        }
+
+        const uint8_t* GetData() const;
+        size_t GetSize() const;
+    };
+}
@@ -0,0 +1,272 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "GeometryArena.h"
+#include "MeshData.h"
+#include "Utilities/Profiler/Profiler.h"
+
+namespace MxEngine
+{
+    static size_t RelocateOffset(const MxVector<RangeAllocator::Relocation>& relocations, size_t offset)
+    {
+        // relocations are sorted by source offset, ranges which are not listed were not moved
+        size_t begin = 0, end = relocations.size();
+        while (begin < end)
+        {
+            size_t middle = begin + (end - begin) / 2;
+            if (relocations[middle].From < offset)
+                begin = middle + 1;
+            else
+                end = middle;
+        }
+        return (begin < relocations.size() && relocations[begin].From == offset) ? relocations[begin].To : offset;
+    }
+
+    void GeometryArena::Reallocate(size_t vertexCapacity, size_t indexCapacity)
+    {
+        MAKE_SCOPE_PROFILER("GeometryArena::Reallocate()");
+
+        auto newVBO = GraphicFactory::Create<VertexBuffer>();
+        auto newIBO = GraphicFactory::Create<IndexBuffer>();
+        newVBO->Load(nullptr, vertexCapacity * Vertex::Size, UsageType::STATIC_DRAW);
+        newIBO->Load(nullptr, indexCapacity);
+
+        MxVector<RangeAllocator::Relocation> vertexRelocations;
+        MxVector<RangeAllocator::Relocation> indexRelocations;
+        vertexAllocator.Defragment(vertexRelocations);
+        indexAllocator.Defragment(indexRelocations);
+        vertexAllocator.Grow(vertexCapacity);
+        indexAllocator.Grow(indexCapacity);
+
+        // ranges are copied on GPU side, so arena does not need CPU copies of mesh geometry
+        for (auto& range : ranges)
+        {
+            if (range.VertexCount > 0)
+            {
+                size_t baseVertex = RelocateOffset(vertexRelocations, range.BaseVertex);
+                newVBO->CopySubData(*VBO, range.VertexCount * Vertex::Size, range.BaseVertex * Vertex::Size, baseVertex * Vertex::Size);
+                range.BaseVertex = baseVertex;
+            }
+            if (range.IndexCount > 0)
+            {
+                size_t firstIndex = RelocateOffset(indexRelocations, range.FirstIndex);
+                newIBO->CopySubData(*IBO, range.IndexCount, range.FirstIndex, firstIndex);
+                range.FirstIndex = firstIndex;
+            }
+        }
+
+        auto newVAO = GraphicFactory::Create<VertexArray>();
+        auto VBL = MeshData::CreateVertexLayout();
+        newVAO->AddBuffer(*newVBO, *VBL);
+
+        VBO = std::move(newVBO);
+        IBO = std::move(newIBO);
+        VAO = std::move(newVAO);
+        reallocationCount++;
+    }
+
+    size_t GeometryArena::AllocateVertecies(size_t count)
+    {
+        size_t offset = vertexAllocator.Allocate(count);
+        if (offset != RangeAllocator::InvalidOffset) return offset;
+
+        // if there is enough free space, it is only fragmented and compaction is enough. Else storage grows at least twice
+        size_t capacity = vertexAllocator.GetCapacity();
+        if (vertexAllocator.GetFreeSize() < count)
+            capacity = Max(2 * capacity, vertexAllocator.GetUsedSize() + count);
+        Reallocate(capacity, indexAllocator.GetCapacity());
+
+        offset = vertexAllocator.Allocate(count);
+        MX_ASSERT(offset != RangeAllocator::InvalidOffset);
+        return offset;
+    }
+
+    size_t GeometryArena::AllocateIndicies(size_t count)
+    {
+        size_t offset = indexAllocator.Allocate(count);
+        if (offset != RangeAllocator::InvalidOffset) return offset;
+
+        size_t capacity = indexAllocator.GetCapacity();
+        if (indexAllocator.GetFreeSize() < count)
+            capacity = Max(2 * capacity, indexAllocator.GetUsedSize() + count);
+        Reallocate(vertexAllocator.GetCapacity(), capacity);
+
+        offset = indexAllocator.Allocate(count);
+        MX_ASSERT(offset != RangeAllocator::InvalidOffset);
+        return offset;
+    }
+
+    void GeometryArena::Destroy()
+    {
+        VBO = VertexBufferHandle();
+        IBO = IndexBufferHandle();
+        VAO = VertexArrayHandle();
+        vertexAllocator.Init(0);
+        indexAllocator.Init(0);
+        ranges.clear();
+        freeIds.clear();
+        allocationCount = 0;
+    }
+
+    bool GeometryArena::IsInitialized()
+    {
+        return VAO.IsValid();
+    }
+
+    void GeometryArena::SetEnabled(bool value)
+    {
+        isEnabled = value;
+    }
+
+    bool GeometryArena::IsEnabled()
+    {
+        return isEnabled;
+    }
+
+    GeometryArena::AllocationId GeometryArena::Allocate()
+    {
+        if (!IsInitialized()) Reallocate(InitialVertexCapacity, InitialIndexCapacity);
+
+        AllocationId id = 0;
+        if (!freeIds.empty())
+        {
+            id = freeIds.back();
+            freeIds.pop_back();
+        }
+        else
+        {
+            id = (AllocationId)ranges.size();
+            ranges.emplace_back();
+        }
+        ranges[id] = GeometryRange();
+        allocationCount++;
+        return id;
+    }
+
+    void GeometryArena::Free(AllocationId id)
+    {
+        // meshes may outlive arena, as it is destroyed together with graphic context
+        if (id >= ranges.size()) return;
+
+        auto& range = ranges[id];
+        if (range.VertexCount > 0) vertexAllocator.Free(range.BaseVertex);
+        if (range.IndexCount > 0) indexAllocator.Free(range.FirstIndex);
+        range = GeometryRange();
+        freeIds.push_back(id);
+        allocationCount--;
+    }
+
+    void GeometryArena::BufferVertecies(AllocationId id, const float* data, size_t vertexCount)
+    {
+        MX_ASSERT(id < ranges.size());
+        auto& range = ranges[id];
+        if (range.VertexCount != vertexCount)
+        {
+            if (range.VertexCount > 0) vertexAllocator.Free(range.BaseVertex);
+            range.VertexCount = 0; // range is skipped if arena is reallocated during allocation
+            if (vertexCount > 0) range.BaseVertex = AllocateVertecies(vertexCount);
+            range.VertexCount = vertexCount;
+        }
+        if (vertexCount > 0) VBO->BufferSubData(data, vertexCount * Vertex::Size, range.BaseVertex * Vertex::Size);
+    }
+
+    void GeometryArena::BufferIndicies(AllocationId id, const uint32_t* data, size_t indexCount)
+    {
+        MX_ASSERT(id < ranges.size());
+        auto& range = ranges[id];
+        if (range.IndexCount != indexCount)
+        {
+            if (range.IndexCount > 0) indexAllocator.Free(range.FirstIndex);
+            range.IndexCount = 0;
+            if (indexCount > 0) range.FirstIndex = AllocateIndicies(indexCount);
+            range.IndexCount = indexCount;
+        }
+        if (indexCount > 0) IBO->BufferSubData(data, indexCount, range.FirstIndex);
+    }
+
+    const GeometryRange& GeometryArena::GetRange(AllocationId id)
+    {
+        MX_ASSERT(id < ranges.size());
+        return ranges[id];
+    }
+
+    uint32_t GeometryArena::GetGeometryId(AllocationId id)
+    {
+        return GeometryIdBit | id;
+    }
+
+    void GeometryArena::Defragment()
+    {
+        if (!IsInitialized()) return;
+        Reallocate(vertexAllocator.GetCapacity(), indexAllocator.GetCapacity());
+    }
+
+    GeometryArenaStatistics GeometryArena::GetStatistics()
+    {
+        GeometryArenaStatistics statistics;
+        statistics.Allocations = allocationCount;
+        statistics.VertexCapacity = vertexAllocator.GetCapacity();
+        statistics.UsedVertecies = vertexAllocator.GetUsedSize();
+        statistics.IndexCapacity = indexAllocator.GetCapacity();
+        statistics.UsedIndicies = indexAllocator.GetUsedSize();
+        statistics.VertexFragmentation = vertexAllocator.GetFragmentation();
+        statistics.IndexFragmentation = indexAllocator.GetFragmentation();
+        statistics.Reallocations = reallocationCount;
+        return statistics;
+    }
+
+    VertexArrayHandle GeometryArena::GetVAO()
+    {
+        return VAO;
+    }
+
+    VertexBufferHandle GeometryArena::GetVBO()
+    {
+        return VBO;
+    }
+
+    IndexBufferHandle GeometryArena::GetIBO()
+    {
+        return IBO;
+    }
+
+    GeometryAllocation::GeometryAllocation()
+        : id(GeometryArena::Allocate())
+    {
+    }
+
+    GeometryAllocation::~GeometryAllocation()
+    {
+        GeometryArena::Free(this->id);
+    }
+
+    GeometryArena::AllocationId GeometryAllocation::GetId() const
+    {
+        return this->id;
+    }
+}
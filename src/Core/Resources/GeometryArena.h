@@ -0,0 +1,136 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include "Platform/GraphicAPI.h"
+#include "Utilities/Memory/RangeAllocator.h"
+#include "Utilities/STL/MxVector.h"
+
+namespace MxEngine
+{
+    // location of mesh geometry inside of vertex and index buffers. Indicies are local to mesh, base vertex is added to them on draw
+    struct GeometryRange
+    {
+        size_t BaseVertex = 0;
+        size_t VertexCount = 0;
+        size_t FirstIndex = 0;
+        size_t IndexCount = 0;
+    };
+
+    struct GeometryArenaStatistics
+    {
+        size_t Allocations = 0;
+        size_t VertexCapacity = 0;
+        size_t UsedVertecies = 0;
+        size_t IndexCapacity = 0;
+        size_t UsedIndicies = 0;
+        float VertexFragmentation = 0.0f;
+        float IndexFragmentation = 0.0f;
+        size_t Reallocations = 0;
+    };
+
+    /*
+    shared storage of mesh geometry. All arena meshes are placed into one vertex buffer and one index buffer, which are bound
+    to one vertex array, so draws of different meshes differ only by base vertex and first index. Ranges are managed by CPU-side
+    RangeAllocator. When allocation does not fit, buffers are recreated, compacting all ranges and growing storage if needed,
+    so offsets of allocations must be queried by GetRange() each time they are used
+    */
+    class GeometryArena
+    {
+    public:
+        using AllocationId = uint32_t;
+        constexpr static AllocationId InvalidId = ~0u;
+    private:
+        constexpr static size_t InitialVertexCapacity = 256 * 1024;
+        constexpr static size_t InitialIndexCapacity = 1024 * 1024;
+        // arena geometry ids are marked by high bit, so they never collide with native handles of other vertex arrays
+        constexpr static uint32_t GeometryIdBit = 1u << 31;
+
+        inline static VertexBufferHandle VBO;
+        inline static IndexBufferHandle IBO;
+        inline static VertexArrayHandle VAO;
+        inline static RangeAllocator vertexAllocator;
+        inline static RangeAllocator indexAllocator;
+        inline static MxVector<GeometryRange> ranges;
+        inline static MxVector<AllocationId> freeIds;
+        inline static size_t allocationCount = 0;
+        inline static size_t reallocationCount = 0;
+        inline static bool isEnabled = true;
+
+        static void Reallocate(size_t vertexCapacity, size_t indexCapacity);
+        static size_t AllocateVertecies(size_t count);
+        static size_t AllocateIndicies(size_t count);
+    public:
+        static void Destroy();
+        static bool IsInitialized();
+        static void SetEnabled(bool value);
+        static bool IsEnabled();
+
+        static AllocationId Allocate();
+        static void Free(AllocationId id);
+        /*!
+        replaces vertecies of allocation, moving it to a new range if vertex count changed
+        \param id allocation to update
+        \param data pointer to vertex data, Vertex::Size floats per vertex
+        \param vertexCount number of vertecies in data
+        */
+        static void BufferVertecies(AllocationId id, const float* data, size_t vertexCount);
+        /*!
+        replaces indicies of allocation, moving it to a new range if index count changed
+        \param id allocation to update
+        \param data pointer to mesh-local indicies
+        \param indexCount number of indicies in data
+        */
+        static void BufferIndicies(AllocationId id, const uint32_t* data, size_t indexCount);
+        static const GeometryRange& GetRange(AllocationId id);
+        static uint32_t GetGeometryId(AllocationId id);
+        /*!
+        compacts all allocations to the begin of arena buffers. Is also performed automatically when allocation does not fit
+        */
+        static void Defragment();
+        static GeometryArenaStatistics GetStatistics();
+
+        static VertexArrayHandle GetVAO();
+        static VertexBufferHandle GetVBO();
+        static IndexBufferHandle GetIBO();
+    };
+
+    // owner of arena allocation, shared by all copies of MeshData. Allocation is returned to arena when owner is destroyed
+    class GeometryAllocation
+    {
+        GeometryArena::AllocationId id;
+    public:
+        GeometryAllocation();
+        ~GeometryAllocation();
+        GeometryAllocation(const GeometryAllocation&) = delete;
+        GeometryAllocation& operator=(const GeometryAllocation&) = delete;
+
+        GeometryArena::AllocationId GetId() const;
+    };
+}
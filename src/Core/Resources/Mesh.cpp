@@ -81,8 +81,15 @@ namespace MxEngine
 			SubMesh submesh(materialId, transform);
 			submesh.Data.GetVertecies() = std::move(meshData.vertecies);
 			submesh.Data.GetIndicies() = std::move(meshData.indicies);
-			submesh.Data.BufferVertecies();
-			submesh.Data.BufferIndicies();
+			if (GeometryArena::IsEnabled())
+			{
+				submesh.Data.MoveToArena();
+			}
+			else
+			{
+				submesh.Data.BufferVertecies();
+				submesh.Data.BufferIndicies();
+			}
 			submesh.Data.UpdateBoundingGeometry();
 			submesh.Name = std::move(meshData.name);
 
@@ -132,6 +139,8 @@ namespace MxEngine
 		this->VBLs.push_back(std::move(vbl));
 		for (auto& mesh : this->Submeshes)
 		{
+			// arena vertex array is shared by all arena meshes, so instanced submeshes need their own one
+			mesh.Data.DetachFromArena();
 			mesh.Data.GetVAO()->AddInstancedBuffer(*this->VBOs.back(), *this->VBLs.back());
 		}
 		return this->VBOs.size() - 1;
@@ -30,35 +30,71 @@
 
 namespace MxEngine
 {
-    MeshData::MeshData()
+    void MeshData::CreateOwnBuffers()
     {
+        if (this->VAO.IsValid()) return;
+
         this->VBO = GraphicFactory::Create<VertexBuffer>();
         this->VAO = GraphicFactory::Create<VertexArray>();
         this->IBO = GraphicFactory::Create<IndexBuffer>();
 
+        auto VBL = MeshData::CreateVertexLayout();
+        this->VAO->AddBuffer(*this->VBO, *VBL);
+    }
+
+    VertexBufferLayoutHandle MeshData::CreateVertexLayout()
+    {
         auto VBL = GraphicFactory::Create<VertexBufferLayout>();
         VBL->PushFloat(3); // position //-V525
         VBL->PushFloat(2); // texture
         VBL->PushFloat(3); // normal
         VBL->PushFloat(3); // tangent
         VBL->PushFloat(3); // bitangent
-
-        this->VAO->AddBuffer(*this->VBO, *VBL);
+        return VBL;
     }
 
     VertexArrayHandle MeshData::GetVAO() const
     {
-        return this->VAO;
+        return this->IsArenaBacked() ? GeometryArena::GetVAO() : this->VAO;
     }
 
     VertexBufferHandle MeshData::GetVBO() const
     {
-        return this->VBO;
+        return this->IsArenaBacked() ? GeometryArena::GetVBO() : this->VBO;
     }
 
     IndexBufferHandle MeshData::GetIBO() const
     {
-        return this->IBO;
+        return this->IsArenaBacked() ? GeometryArena::GetIBO() : this->IBO;
+    }
+
+    GeometryRange MeshData::GetDrawRange() const
+    {
+        if (this->IsArenaBacked())
+            return GeometryArena::GetRange(this->arenaAllocation->GetId());
+
+        GeometryRange range;
+        if (!this->VAO.IsValid()) return range;
+        range.VertexCount = this->VBO->GetSize() / Vertex::Size;
+        range.IndexCount = this->IBO->GetCount();
+        return range;
+    }
+
+    uint32_t MeshData::GetGeometryId() const
+    {
+        if (this->IsArenaBacked())
+            return GeometryArena::GetGeometryId(this->arenaAllocation->GetId());
+        return this->VAO.IsValid() ? (uint32_t)this->VAO->GetNativeHandle() : 0;
+    }
+
+    bool MeshData::IsArenaBacked() const
+    {
+        return this->arenaAllocation != nullptr;
+    }
+
+    uint32_t MeshData::GetGeometryVersion() const
+    {
+        return this->geometryVersion;
     }
 
     const AABB& MeshData::GetBoundingBox() const
@@ -92,8 +128,15 @@ namespace MxEngine
 
     void MeshData::BufferVertecies(UsageType usageType)
     {
+        this->geometryVersion++;
         auto data = reinterpret_cast<float*>(this->vertecies.data());
-        this->VBO->Load(data, this->vertecies.size() * Vertex::Size, usageType);
+        if (this->IsArenaBacked())
+            GeometryArena::BufferVertecies(this->arenaAllocation->GetId(), data, this->vertecies.size());
+        else
+        {
+            this->CreateOwnBuffers();
+            this->VBO->Load(data, this->vertecies.size() * Vertex::Size, usageType);
+        }
     }
 
     void MeshData::FreeMeshDataCopy()
@@ -104,8 +147,42 @@ namespace MxEngine
 
     void MeshData::BufferIndicies()
     {
+        this->geometryVersion++;
         auto data = reinterpret_cast<uint32_t*>(this->indicies.data());
-        this->IBO->Load(data, this->indicies.size());
+        if (this->IsArenaBacked())
+            GeometryArena::BufferIndicies(this->arenaAllocation->GetId(), data, this->indicies.size());
+        else
+        {
+            this->CreateOwnBuffers();
+            this->IBO->Load(data, this->indicies.size());
+        }
+    }
+
+    void MeshData::MoveToArena()
+    {
+        if (this->IsArenaBacked()) return;
+
+        this->arenaAllocation = MakeRef<GeometryAllocation>();
+        this->VBO = VertexBufferHandle();
+        this->VAO = VertexArrayHandle();
+        this->IBO = IndexBufferHandle();
+        this->BufferVertecies();
+        this->BufferIndicies();
+    }
+
+    void MeshData::DetachFromArena()
+    {
+        if (!this->IsArenaBacked()) return;
+
+        auto range = this->GetDrawRange();
+        this->CreateOwnBuffers();
+
+        // geometry is copied on GPU side, as CPU copy may be already freed
+        this->VBO->Load(nullptr, range.VertexCount * Vertex::Size, UsageType::STATIC_DRAW);
+        this->VBO->CopySubData(*GeometryArena::GetVBO(), range.VertexCount * Vertex::Size, range.BaseVertex * Vertex::Size);
+        this->IBO->Load(nullptr, range.IndexCount);
+        this->IBO->CopySubData(*GeometryArena::GetIBO(), range.IndexCount, range.FirstIndex);
+        this->arenaAllocation.reset();
     }
 
     void MeshData::UpdateBoundingGeometry()
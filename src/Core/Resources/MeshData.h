@@ -31,6 +31,8 @@
 #include "Core/Components/Transform.h"
 #include "Platform/GraphicAPI.h"
 #include "Core/BoundingObjects/BoundingSphere.h"
+#include "Utilities/Memory/Memory.h"
+#include "GeometryArena.h"
 #include "Vertex.h"
 
 namespace MxEngine
@@ -47,14 +49,48 @@ namespace MxEngine
         VertexBufferHandle VBO;
         VertexArrayHandle VAO;
         IndexBufferHandle IBO;
+        // if set, geometry is stored in GeometryArena and own buffers are not used
+        Ref<GeometryAllocation> arenaAllocation;
+        // incremented each time geometry is uploaded, so users of CPU copy can detect its changes
+        uint32_t geometryVersion = 0;
+
+        void CreateOwnBuffers();
     public:
-        MeshData();
+        /*!
+        creates empty mesh data. Graphic buffers are not created here: meshes placed into GeometryArena never need their own ones,
+        so own buffers are created on first BufferVertecies() / BufferIndicies() call of mesh which is not stored in arena.
+        This also allows to construct and process mesh data on CPU without graphic context
+        */
+        MeshData() = default;
+
+        /*!
+        creates layout of Vertex structure, which is used by vertex buffers of all meshes
+        \returns new vertex buffer layout
+        */
+        static VertexBufferLayoutHandle CreateVertexLayout();
 
+        // buffer getters return invalid handles if mesh is neither stored in arena nor buffered yet
         VertexArrayHandle GetVAO() const;
         VertexBufferHandle GetVBO() const;
         IndexBufferHandle GetIBO() const;
         const AABB& GetBoundingBox() const;
         const BoundingSphere& GetBoundingSphere() const;
+        /*!
+        getter for location of mesh geometry inside of buffers returned by GetVBO() and GetIBO()
+        \returns range which covers whole buffers if mesh is not stored in arena
+        */
+        GeometryRange GetDrawRange() const;
+        /*!
+        getter for id which is equal for meshes drawn with the same vertex array and geometry range
+        \returns native handle of own vertex array or unique id of arena allocation
+        */
+        uint32_t GetGeometryId() const;
+        bool IsArenaBacked() const;
+        /*!
+        getter for version of mesh geometry. Version changes each time vertecies or indicies are buffered
+        \returns current geometry version
+        */
+        uint32_t GetGeometryVersion() const;
 
         VertexData& GetVertecies();
         const VertexData& GetVertecies() const;
@@ -64,6 +100,14 @@ namespace MxEngine
         void BufferVertecies(UsageType usageType = UsageType::STATIC_DRAW);
         void FreeMeshDataCopy();
         void BufferIndicies();
+        /*!
+        places mesh geometry into shared GeometryArena, uploading CPU copy of vertecies and indicies. Own buffers are released
+        */
+        void MoveToArena();
+        /*!
+        copies mesh geometry from arena into own buffers. Required before attaching instanced buffers to mesh vertex array
+        */
+        void DetachFromArena();
         void UpdateBoundingGeometry();
         void RegenerateNormals();
         void RegenerateTangentSpace();
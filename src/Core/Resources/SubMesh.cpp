@@ -53,4 +53,9 @@ namespace MxEngine
         return this->transform;
     }
 
+    CBorrowedResource<TransformComponent> SubMesh::BorrowTransform() const
+    {
+        return this->transform.Borrow();
+    }
+
 }
\ No newline at end of file
@@ -49,6 +49,8 @@ namespace MxEngine
 		SubMesh(size_t materiaId, const TransformComponent::Handle& transform);
 
 		TransformComponent::Handle GetTransform() const;
+		// borrowed transform does not touch refcount, so it can be used when the same submesh is accessed from multiple threads
+		CBorrowedResource<TransformComponent> BorrowTransform() const;
 		MaterialId GetMaterialId() const;
 	};
 }
\ No newline at end of file
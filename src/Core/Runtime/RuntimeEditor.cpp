@@ -134,7 +134,7 @@ namespace MxEngine
 					if (object.IsDisplayedInRuntimeEditor())
 					{
 						ImGui::PushID(id++);
-						this->DrawMxObject(object.Name, object);
+						this->DrawMxObject(object.GetDisplayName(), object);
 						ImGui::PopID();
 					}
 				}
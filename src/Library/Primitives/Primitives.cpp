@@ -12,8 +12,15 @@ namespace MxEngine
         auto& submeshes = mesh->Submeshes;
         auto& submesh = submeshes.emplace_back(materialId, transform);
         submesh.Data = std::move(meshData);
-        submesh.Data.BufferVertecies();
-        submesh.Data.BufferIndicies();
+        if (GeometryArena::IsEnabled())
+        {
+            submesh.Data.MoveToArena();
+        }
+        else
+        {
+            submesh.Data.BufferVertecies();
+            submesh.Data.BufferIndicies();
+        }
         submesh.Data.UpdateBoundingGeometry();
 
         mesh->UpdateBoundingGeometry();
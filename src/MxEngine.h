@@ -33,6 +33,7 @@
 #include "Core/Application/Rendering.h"
 #include "Core/Application/Runtime.h"
 #include "Core/Application/Physics.h"
+#include "Core/Application/SceneIndex.h"
 #include "Core/Application/Timer.h"
 #include "Core/MxObject/MxObject.h"
 #include "Core/Config/GlobalConfig.h"
@@ -52,6 +53,7 @@
 #include "Utilities/ImGui/ImGuiUtils.h"
 #include "Utilities/Format/Format.h"
 #include "Utilities/Random/Random.h"
+#include "Utilities/JobSystem/JobSystem.h"
 #include "Utilities/Array/Array2D.h"
 #include "Utilities/Image/ImageConverter.h"
 #include "Utilities/Image/ImageManager.h"
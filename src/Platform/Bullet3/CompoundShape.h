@@ -49,9 +49,9 @@ namespace MxEngine
             auto handle = CompoundShape::GetShapeUserHandle(shape);
             auto& pool = Factory::template Get<Shape>();
 
-            if (pool.Capacity() <= handle) return { };
+            if (pool.Capacity() <= handle || !pool.IsAllocated(handle)) return { };
             auto& managedObject = pool[handle];
-            if(managedObject.refCount == 0 || managedObject.uuid == UUIDGenerator::GetNull())
+            if(managedObject.refCount == 0)
                 return { };
 
             if (managedObject.value.GetNativeHandle() != shape)
@@ -30,13 +30,15 @@
 
 #include "Core/Macro/Macro.h"
 
-#if defined(MXENGINE_USE_OPENGL)
+// null graphic backend implements the same classes, so it shares OpenGL headers
+#if defined(MXENGINE_USE_OPENGL) || defined(MXENGINE_USE_NULLGRAPHICS)
 #include "Platform/OpenGL/CubeMap.h"
 #include "Platform/OpenGL/FrameBuffer.h"
 #include "Platform/OpenGL/IndexBuffer.h"
 #include "Platform/OpenGL/RenderBuffer.h"
 #include "Platform/OpenGL/Shader.h"
 #include "Platform/OpenGL/Texture.h"
+#include "Platform/OpenGL/UniformBuffer.h"
 #include "Platform/OpenGL/VertexArray.h"
 #include "Platform/OpenGL/VertexBuffer.h"
 #include "Platform/OpenGL/VertexBufferLayout.h"
@@ -53,6 +55,7 @@ namespace MxEngine
         RenderBuffer,
         Shader,
         Texture,
+        UniformBuffer,
         VertexArray,
         VertexBuffer,
         VertexBufferLayout
@@ -69,6 +72,7 @@ namespace MxEngine
     CREATE_HANDLE(RenderBuffer)
     CREATE_HANDLE(Shader)
     CREATE_HANDLE(Texture)
+    CREATE_HANDLE(UniformBuffer)
     CREATE_HANDLE(VertexArray)
     CREATE_HANDLE(VertexBuffer)
     CREATE_HANDLE(VertexBufferLayout)
@@ -29,6 +29,7 @@
 #include "GraphicModule.h"
 #include "Core/Config/GlobalConfig.h"
 #include "Platform/OpenGL/GLUtilities.h"
+#include "Platform/RenderStateCache.h"
 #include "Utilities/Logging/Logger.h"
 #include "Utilities/Profiler/Profiler.h"
 #include "Utilities/ImGui/ImGuiBase.h"
@@ -149,6 +150,8 @@ namespace MxEngine
 	{
 		ImGui::Render();
 		ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+		// ImGui renderer changes and restores graphic state directly, so cached one cannot be trusted anymore
+		RenderStateCache::Invalidate();
 	}
 
 	void GraphicModule::Destroy()
@@ -0,0 +1,188 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "Platform/OpenGL/FrameBuffer.h"
+#include "Platform/Null/GraphicRecorder.h"
+#include "Utilities/Logging/Logger.h"
+#include "Core/Macro/Macro.h"
+#include "Platform/GraphicAPI.h"
+
+namespace MxEngine
+{
+    FrameBuffer::FrameBuffer()
+    {
+        this->id = GraphicRecorder::CreateObject();
+        MXLOG_DEBUG("Null::FrameBuffer", "created framebuffer with id = " + ToMxString(id));
+    }
+
+    void FrameBuffer::OnTextureAttach(const Texture& texture, Attachment attachment)
+    {
+        this->Bind();
+        GraphicRecorder::GetFrameStatistics().StateChanges++;
+    }
+
+    void FrameBuffer::OnCubeMapAttach(const CubeMap& cubemap, Attachment attachment)
+    {
+        this->Bind();
+        GraphicRecorder::GetFrameStatistics().StateChanges++;
+    }
+
+    void FrameBuffer::FreeFrameBuffer()
+    {
+        this->DetachRenderTarget();
+        GraphicRecorder::DestroyObject(this->id);
+    }
+
+    void FrameBuffer::CopyFrameBufferContents(int screenWidth, int screenHeight) const
+    {
+        auto& statistics = GraphicRecorder::GetFrameStatistics();
+        statistics.FrameBufferBinds += 2;
+        statistics.FrameBufferCopies++;
+    }
+
+    void FrameBuffer::Validate() const
+    {
+        this->Bind();
+    }
+
+    void FrameBuffer::DetachRenderTarget()
+    {
+        if (this->currentAttachment == AttachmentType::TEXTURE)
+            std::launder(reinterpret_cast<TextureHandle*>(&this->attachmentStorage))->~Resource();
+        else if (this->currentAttachment == AttachmentType::CUBEMAP)
+            std::launder(reinterpret_cast<CubeMapHandle*>(&this->attachmentStorage))->~Resource();
+
+        this->currentAttachment = AttachmentType::NONE;
+
+        #if defined(MXENGINE_DEBUG)
+        this->_texturePtr = nullptr;
+        this->_cubemapPtr = nullptr;
+        #endif
+    }
+
+    void FrameBuffer::DetachExtraTarget(Attachment attachment)
+    {
+        GraphicRecorder::GetFrameStatistics().StateChanges++;
+    }
+
+    bool FrameBuffer::HasTextureAttached() const
+    {
+        return this->currentAttachment == AttachmentType::TEXTURE;
+    }
+
+    bool FrameBuffer::HasCubeMapAttached() const
+    {
+        return this->currentAttachment == AttachmentType::CUBEMAP;
+    }
+
+    void FrameBuffer::UseDrawBuffers(ArrayView<Attachment> attachments) const
+    {
+        this->Bind();
+        GraphicRecorder::GetFrameStatistics().StateChanges++;
+    }
+
+    void FrameBuffer::UseOnlyDepth() const
+    {
+        this->Bind();
+        GraphicRecorder::GetFrameStatistics().StateChanges++;
+    }
+
+    size_t FrameBuffer::GetWidth() const
+    {
+        auto* texture = reinterpret_cast<const Resource<Texture, GraphicFactory>*>(&this->attachmentStorage);
+        auto* cubemap = reinterpret_cast<const Resource<CubeMap, GraphicFactory>*>(&this->attachmentStorage);
+
+        if (this->currentAttachment == AttachmentType::TEXTURE && std::launder(texture)->IsValid())
+            return (*std::launder(texture))->GetWidth();
+        if (this->currentAttachment == AttachmentType::CUBEMAP && std::launder(cubemap)->IsValid())
+            return (*std::launder(cubemap))->GetWidth();
+
+        return 0;
+    }
+
+    size_t FrameBuffer::GetHeight() const
+    {
+        auto* texture = reinterpret_cast<const Resource<Texture, GraphicFactory>*>(&this->attachmentStorage);
+        auto* cubemap = reinterpret_cast<const Resource<CubeMap, GraphicFactory>*>(&this->attachmentStorage);
+
+        if (this->currentAttachment == AttachmentType::TEXTURE && std::launder(texture)->IsValid())
+            return (*std::launder(texture))->GetHeight();
+        if (this->currentAttachment == AttachmentType::CUBEMAP && std::launder(cubemap)->IsValid())
+            return (*std::launder(cubemap))->GetHeight();
+
+        return 0;
+    }
+
+    FrameBuffer::~FrameBuffer()
+    {
+        this->FreeFrameBuffer();
+    }
+
+    FrameBuffer::FrameBuffer(FrameBuffer&& framebuffer) noexcept
+    {
+        this->id = framebuffer.id;
+        this->currentAttachment = framebuffer.currentAttachment;
+        this->attachmentStorage = framebuffer.attachmentStorage;
+        framebuffer.currentAttachment = AttachmentType::NONE;
+        framebuffer.id = 0;
+    }
+
+    FrameBuffer& FrameBuffer::operator=(FrameBuffer&& framebuffer) noexcept
+    {
+        this->FreeFrameBuffer();
+
+        this->id = framebuffer.id;
+        this->currentAttachment = framebuffer.currentAttachment;
+        this->attachmentStorage = framebuffer.attachmentStorage;
+        framebuffer.currentAttachment = AttachmentType::NONE;
+        framebuffer.id = 0;
+        return *this;
+    }
+
+    void FrameBuffer::Bind() const
+    {
+        GraphicRecorder::GetFrameStatistics().FrameBufferBinds++;
+    }
+
+    void FrameBuffer::Unbind() const
+    {
+        GraphicRecorder::GetFrameStatistics().FrameBufferBinds++;
+    }
+
+    FrameBuffer::BindableId FrameBuffer::GetNativeHandle() const
+    {
+        return id;
+    }
+
+    void FrameBuffer::CopyFrameBufferContents(const FrameBuffer& framebuffer) const
+    {
+        auto& statistics = GraphicRecorder::GetFrameStatistics();
+        statistics.FrameBufferBinds += 2;
+        statistics.FrameBufferCopies++;
+    }
+}
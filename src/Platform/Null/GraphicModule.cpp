@@ -0,0 +1,91 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "Platform/Modules/GraphicModule.h"
+#include "Platform/Null/GraphicRecorder.h"
+#include "Core/Config/GlobalConfig.h"
+#include "Utilities/Logging/Logger.h"
+#include "Utilities/Profiler/Profiler.h"
+#include "Utilities/ImGui/ImGuiBase.h"
+
+namespace MxEngine
+{
+	// ImGui context is still created, so runtime editor and user code can call ImGui, but its draw data is never rendered
+
+	void UpdateImGuiDisplay()
+	{
+		auto& imguiIO = ImGui::GetIO();
+		imguiIO.DisplaySize = GlobalConfig::GetWindowSize();
+		imguiIO.DeltaTime = 1.0f / 60.0f;
+	}
+
+	void GraphicModule::Init()
+	{
+		MXLOG_INFO("Null::GraphicModule", "null graphic backend is used, graphic calls are recorded but not executed");
+		GraphicRecorder::Reset();
+	}
+
+	void GraphicModule::OnWindowCreate(WindowHandle window)
+	{
+		MAKE_SCOPE_PROFILER("ImGui::Init");
+		auto context = ImGui::CreateContext();
+		ImGui::SetCurrentContext(context);
+
+		auto& imguiIO = ImGui::GetIO();
+		imguiIO.ConfigFlags |= ImGuiConfigFlags_::ImGuiConfigFlags_DockingEnable;
+		imguiIO.ConfigDockingAlwaysTabBar = true;
+
+		// font atlas must be built before first frame, even if it is never uploaded
+		unsigned char* pixels = nullptr;
+		int width = 0, height = 0;
+		imguiIO.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+		UpdateImGuiDisplay();
+	}
+
+	void GraphicModule::OnWindowUpdate(WindowHandle window)
+	{
+		UpdateImGuiDisplay();
+		ImGui::NewFrame();
+	}
+
+	void GraphicModule::OnWindowDestroy(WindowHandle window)
+	{
+
+	}
+
+	void GraphicModule::OnRenderDraw()
+	{
+		ImGui::Render();
+	}
+
+	void GraphicModule::Destroy()
+	{
+		if (ImGui::GetCurrentContext() != nullptr)
+			ImGui::DestroyContext();
+	}
+}
@@ -0,0 +1,100 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "GraphicRecorder.h"
+
+namespace MxEngine
+{
+	GraphicStatistics& GraphicStatistics::operator+=(const GraphicStatistics& other)
+	{
+		this->DrawCalls              += other.DrawCalls;
+		this->DrawnInstances         += other.DrawnInstances;
+		this->DrawnElements          += other.DrawnElements;
+		this->ShaderBinds            += other.ShaderBinds;
+		this->TextureBinds           += other.TextureBinds;
+		this->VertexArrayBinds       += other.VertexArrayBinds;
+		this->BufferBinds            += other.BufferBinds;
+		this->FrameBufferBinds       += other.FrameBufferBinds;
+		this->UniformUpdates         += other.UniformUpdates;
+		this->UniformNameLookups     += other.UniformNameLookups;
+		this->VertexAttributeUpdates += other.VertexAttributeUpdates;
+		this->StateChanges           += other.StateChanges;
+		this->Clears                 += other.Clears;
+		this->FrameBufferCopies      += other.FrameBufferCopies;
+		this->BufferUploads          += other.BufferUploads;
+		this->BufferUploadBytes      += other.BufferUploadBytes;
+		this->BufferCopies           += other.BufferCopies;
+		this->BufferCopyBytes        += other.BufferCopyBytes;
+		this->TextureUploads         += other.TextureUploads;
+		this->TextureUploadBytes     += other.TextureUploadBytes;
+		this->ReadbackBytes          += other.ReadbackBytes;
+		this->CreatedObjects         += other.CreatedObjects;
+		this->DestroyedObjects       += other.DestroyedObjects;
+		return *this;
+	}
+
+	GraphicStatistics& GraphicRecorder::GetFrameStatistics()
+	{
+		return frameStatistics;
+	}
+
+	const GraphicStatistics& GraphicRecorder::GetTotalStatistics()
+	{
+		return totalStatistics;
+	}
+
+	size_t GraphicRecorder::GetFrameCount()
+	{
+		return frameCount;
+	}
+
+	void GraphicRecorder::EndFrame()
+	{
+		totalStatistics += frameStatistics;
+		frameStatistics = GraphicStatistics{ };
+		frameCount++;
+	}
+
+	void GraphicRecorder::Reset()
+	{
+		frameStatistics = GraphicStatistics{ };
+		totalStatistics = GraphicStatistics{ };
+		frameCount = 0;
+	}
+
+	unsigned int GraphicRecorder::CreateObject()
+	{
+		frameStatistics.CreatedObjects++;
+		return ++lastObjectId;
+	}
+
+	void GraphicRecorder::DestroyObject(unsigned int id)
+	{
+		if (id != 0) frameStatistics.DestroyedObjects++;
+	}
+}
@@ -0,0 +1,95 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <cstddef>
+
+namespace MxEngine
+{
+	struct GraphicStatistics
+	{
+		size_t DrawCalls = 0;
+		size_t DrawnInstances = 0;
+		size_t DrawnElements = 0;
+		size_t ShaderBinds = 0;
+		size_t TextureBinds = 0;
+		size_t VertexArrayBinds = 0;
+		size_t BufferBinds = 0;
+		size_t FrameBufferBinds = 0;
+		size_t UniformUpdates = 0;
+		size_t UniformNameLookups = 0;
+		size_t VertexAttributeUpdates = 0;
+		size_t StateChanges = 0;
+		size_t Clears = 0;
+		size_t FrameBufferCopies = 0;
+		size_t BufferUploads = 0;
+		size_t BufferUploadBytes = 0;
+		size_t BufferCopies = 0;
+		size_t BufferCopyBytes = 0;
+		size_t TextureUploads = 0;
+		size_t TextureUploadBytes = 0;
+		size_t ReadbackBytes = 0;
+		size_t CreatedObjects = 0;
+		size_t DestroyedObjects = 0;
+
+		GraphicStatistics& operator+=(const GraphicStatistics& other);
+	};
+
+	/*
+	null graphic backend does not execute any graphic commands, it only records them into GraphicRecorder.
+	Statistics are collected for current frame and accumulated into total ones when EndFrame() is called
+	*/
+	class GraphicRecorder
+	{
+		inline static GraphicStatistics frameStatistics;
+		inline static GraphicStatistics totalStatistics;
+		inline static size_t frameCount = 0;
+		inline static unsigned int lastObjectId = 0;
+	public:
+		/*!
+		gets statistics of commands recorded since last EndFrame() call
+		\returns mutable statistics of current frame
+		*/
+		static GraphicStatistics& GetFrameStatistics();
+		/*!
+		gets statistics of all commands recorded in finished frames since last Reset() call
+		\returns total statistics
+		*/
+		static const GraphicStatistics& GetTotalStatistics();
+		static size_t GetFrameCount();
+		static void EndFrame();
+		static void Reset();
+		/*!
+		generates native handle for new graphic object
+		\returns unique non-zero id
+		*/
+		static unsigned int CreateObject();
+		static void DestroyObject(unsigned int id);
+	};
+}
@@ -0,0 +1,128 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "Platform/OpenGL/IndexBuffer.h"
+#include "Platform/Null/GraphicRecorder.h"
+#include "Utilities/Logging/Logger.h"
+#include "Core/Macro/Macro.h"
+
+namespace MxEngine
+{
+	// equal to GL_UNSIGNED_INT, so index type id is the same for both backends
+	constexpr size_t NullUnsignedIntType = 0x1405;
+
+	void IndexBuffer::FreeIndexBuffer()
+	{
+		GraphicRecorder::DestroyObject(this->id);
+	}
+
+	IndexBuffer::IndexBuffer()
+	{
+		this->id = GraphicRecorder::CreateObject();
+		MXLOG_DEBUG("Null::IndexBuffer", "created index buffer with id = " + ToMxString(id));
+	}
+
+	IndexBuffer::IndexBuffer(const IndexType* data, size_t count)
+		: IndexBuffer()
+	{
+		Load(data, count);
+	}
+
+	IndexBuffer::IndexBuffer(IndexBuffer&& ibo) noexcept
+		: count(ibo.count)
+	{
+		this->id = ibo.id;
+		ibo.id = 0;
+		ibo.count = 0;
+	}
+
+	IndexBuffer& IndexBuffer::operator=(IndexBuffer&& ibo) noexcept
+	{
+		this->FreeIndexBuffer();
+
+		this->count = ibo.count;
+		this->id = ibo.id;
+		ibo.count = 0;
+		ibo.id = 0;
+		return *this;
+	}
+
+	IndexBuffer::~IndexBuffer()
+	{
+		this->FreeIndexBuffer();
+	}
+
+	void IndexBuffer::Load(const IndexType* data, size_t count)
+	{
+		this->count = count;
+		this->Bind();
+
+		auto& statistics = GraphicRecorder::GetFrameStatistics();
+		statistics.BufferUploads++;
+		if (data != nullptr) statistics.BufferUploadBytes += count * sizeof(IndexType);
+	}
+
+	void IndexBuffer::BufferSubData(const IndexType* data, size_t count, size_t offset)
+	{
+		auto& statistics = GraphicRecorder::GetFrameStatistics();
+		statistics.BufferUploads++;
+		statistics.BufferUploadBytes += count * sizeof(IndexType);
+	}
+
+	void IndexBuffer::CopySubData(const IndexBuffer& source, size_t count, size_t sourceOffset, size_t offset)
+	{
+		auto& statistics = GraphicRecorder::GetFrameStatistics();
+		statistics.BufferCopies++;
+		statistics.BufferCopyBytes += count * sizeof(IndexType);
+	}
+
+	void IndexBuffer::Unbind() const
+	{
+		GraphicRecorder::GetFrameStatistics().BufferBinds++;
+	}
+
+	size_t IndexBuffer::GetCount() const
+	{
+		return count;
+	}
+
+	size_t IndexBuffer::GetIndexTypeId() const
+	{
+		return NullUnsignedIntType;
+	}
+
+	IndexBuffer::BindableId IndexBuffer::GetNativeHandle() const
+	{
+		return id;
+	}
+
+	void IndexBuffer::Bind() const
+	{
+		GraphicRecorder::GetFrameStatistics().BufferBinds++;
+	}
+}
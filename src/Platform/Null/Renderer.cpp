@@ -0,0 +1,296 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "Platform/OpenGL/Renderer.h"
+#include "Platform/Null/GraphicRecorder.h"
+#include "Platform/RenderStateCache.h"
+#include "Platform/Modules/GraphicModule.h"
+#include "Utilities/Logging/Logger.h"
+#include "Utilities/Profiler/Profiler.h"
+
+namespace MxEngine
+{
+	void RecordDraw(size_t elementCount, size_t instanceCount)
+	{
+		auto& statistics = GraphicRecorder::GetFrameStatistics();
+		statistics.DrawCalls++;
+		statistics.DrawnElements += elementCount;
+		statistics.DrawnInstances += instanceCount;
+	}
+
+	void RecordStateChange()
+	{
+		GraphicRecorder::GetFrameStatistics().StateChanges++;
+	}
+
+	// native enums are kept equal to OpenGL ones, so state cache compares the same values as in OpenGL backend
+	constexpr unsigned int NullFrontFaceCW = 0x0900;
+	constexpr unsigned int NullFrontFaceCCW = 0x0901;
+	constexpr unsigned int NullCullFront = 0x0404;
+	constexpr unsigned int NullCullBack = 0x0405;
+
+	Renderer::Renderer()
+	{
+		this->clearMask = 1;
+	}
+
+	void Renderer::DrawTriangles(const VertexArray& vao, const IndexBuffer& ibo, const Shader& shader) const
+	{
+		vao.Bind();
+		ibo.Bind();
+		shader.Bind();
+		RecordDraw(ibo.GetCount(), 1);
+	}
+
+	void Renderer::DrawTriangles(const VertexArray& vao, size_t vertexCount, const Shader& shader) const
+	{
+		vao.Bind();
+		shader.Bind();
+		RecordDraw(vertexCount, 1);
+	}
+
+	void Renderer::DrawLines(const VertexArray& vao, const IndexBuffer& ibo, const Shader& shader) const
+	{
+		vao.Bind();
+		ibo.Bind();
+		shader.Bind();
+		RecordDraw(ibo.GetCount(), 1);
+	}
+
+	void Renderer::DrawLinesInstanced(const VertexArray& vao, const IndexBuffer& ibo, const Shader& shader, size_t count) const
+	{
+		if (count == 0) { this->DrawLines(vao, ibo, shader); return; }
+
+		vao.Bind();
+		ibo.Bind();
+		shader.Bind();
+		RecordDraw(ibo.GetCount(), count);
+	}
+
+	void Renderer::DrawLinesInstanced(const VertexArray& vao, size_t vertexCount, const Shader& shader, size_t count) const
+	{
+		if (count == 0) { this->DrawLines(vao, vertexCount, shader); return; }
+
+		vao.Bind();
+		shader.Bind();
+		RecordDraw(vertexCount, count);
+	}
+
+	void Renderer::DrawTrianglesInstanced(const VertexArray& vao, const IndexBuffer& ibo, const Shader& shader, size_t count) const
+	{
+		if (count == 0) { this->DrawTriangles(vao, ibo, shader); return; }
+
+		vao.Bind();
+		ibo.Bind();
+		shader.Bind();
+		RecordDraw(ibo.GetCount(), count);
+	}
+
+	void Renderer::DrawTrianglesInstanced(const VertexArray& vao, const IndexBuffer& ibo, const Shader& shader, size_t count, size_t baseInstance) const
+	{
+		vao.Bind();
+		ibo.Bind();
+		shader.Bind();
+		RecordDraw(ibo.GetCount(), count);
+	}
+
+	void Renderer::DrawTrianglesRange(const VertexArray& vao, const IndexBuffer& ibo, const Shader& shader, size_t indexCount, size_t firstIndex, size_t baseVertex, size_t count, size_t baseInstance) const
+	{
+		vao.Bind();
+		ibo.Bind();
+		shader.Bind();
+		RecordDraw(indexCount, count == 0 ? 1 : count);
+	}
+
+	void Renderer::DrawTrianglesInstanced(const VertexArray& vao, size_t vertexCount, const Shader& shader, size_t count) const
+	{
+		if (count == 0) { this->DrawTriangles(vao, vertexCount, shader); return; }
+
+		vao.Bind();
+		shader.Bind();
+		RecordDraw(vertexCount, count);
+	}
+
+	void Renderer::DrawLines(const VertexArray& vao, size_t vertexCount, const Shader& shader) const
+	{
+		vao.Bind();
+		shader.Bind();
+		RecordDraw(vertexCount, 1);
+	}
+
+	void Renderer::Clear() const
+	{
+		GraphicRecorder::GetFrameStatistics().Clears++;
+	}
+
+	void Renderer::Flush() const
+	{
+		MAKE_SCOPE_PROFILER("Renderer::Flush");
+		GraphicModule::OnRenderDraw();
+	}
+
+	void Renderer::Finish() const
+	{
+		MAKE_SCOPE_PROFILER("Renderer::Finish");
+		GraphicModule::OnRenderDraw();
+	}
+
+	void Renderer::SetViewport(int x, int y, int width, int height) const
+	{
+		RecordStateChange();
+	}
+
+	Renderer& Renderer::UseColorMask(bool r, bool g, bool b, bool a)
+	{
+		RecordStateChange();
+		return *this;
+	}
+
+	Renderer& Renderer::UseDepthBufferMask(bool value)
+	{
+		if (RenderStateCache::DepthMask(value))
+			RecordStateChange();
+		return *this;
+	}
+
+	Renderer& Renderer::UseSampling(bool value)
+	{
+		if (RenderStateCache::Enable(RenderCapability::MULTISAMPLE, value))
+			RecordStateChange();
+		return *this;
+	}
+
+	Renderer& Renderer::UseDepthBuffer(bool value)
+	{
+		depthBufferEnabled = value;
+		if (RenderStateCache::Enable(RenderCapability::DEPTH_TEST, value))
+			RecordStateChange();
+		return *this;
+	}
+
+	Renderer& Renderer::UseReversedDepth(bool value)
+	{
+		RecordStateChange();
+		this->UseDepthFunction(value ? DepthFunction::GREATER_EQUAL : DepthFunction::LESS);
+		return *this;
+	}
+
+	Renderer& Renderer::UseDepthFunction(DepthFunction function)
+	{
+		if (RenderStateCache::DepthFunction((unsigned int)function))
+			RecordStateChange();
+		return *this;
+	}
+
+	Renderer& Renderer::UseCulling(bool value, bool counterClockWise, bool cullBack)
+	{
+		if (RenderStateCache::Enable(RenderCapability::CULL_FACE, value))
+			RecordStateChange();
+		if (RenderStateCache::FrontFace(counterClockWise ? NullFrontFaceCCW : NullFrontFaceCW))
+			RecordStateChange();
+		if (RenderStateCache::CullFace(cullBack ? NullCullBack : NullCullFront))
+			RecordStateChange();
+		return *this;
+	}
+
+	Renderer& Renderer::UseClearColor(float r, float g, float b, float a)
+	{
+		RecordStateChange();
+		return *this;
+	}
+
+	Renderer& Renderer::UseBlending(BlendFactor src, BlendFactor dist)
+	{
+		if (src == BlendFactor::NONE || dist == BlendFactor::NONE)
+		{
+			if (RenderStateCache::Enable(RenderCapability::BLEND, false))
+				RecordStateChange();
+		}
+		else
+		{
+			if (RenderStateCache::Enable(RenderCapability::BLEND, true))
+				RecordStateChange();
+			if (RenderStateCache::BlendFunction((unsigned int)src, (unsigned int)dist))
+				RecordStateChange();
+		}
+		return *this;
+	}
+
+	Renderer& Renderer::UseAnisotropicFiltering(float factor)
+	{
+		RecordStateChange();
+		return *this;
+	}
+
+	Renderer& Renderer::UseLineWidth(size_t width)
+	{
+		RecordStateChange();
+		return *this;
+	}
+
+	float Renderer::GetLargestAnisotropicFactor() const
+	{
+		return 16.0f;
+	}
+
+	void Renderer::SetDefaultVertexAttribute(size_t index, float v) const
+	{
+		GraphicRecorder::GetFrameStatistics().VertexAttributeUpdates++;
+	}
+
+	void Renderer::SetDefaultVertexAttribute(size_t index, const Vector2& vec) const
+	{
+		GraphicRecorder::GetFrameStatistics().VertexAttributeUpdates++;
+	}
+
+	void Renderer::SetDefaultVertexAttribute(size_t index, const Vector3& vec) const
+	{
+		GraphicRecorder::GetFrameStatistics().VertexAttributeUpdates++;
+	}
+
+	void Renderer::SetDefaultVertexAttribute(size_t index, const Vector4& vec) const
+	{
+		GraphicRecorder::GetFrameStatistics().VertexAttributeUpdates++;
+	}
+
+	void Renderer::SetDefaultVertexAttribute(size_t index, const Matrix4x4& mat) const
+	{
+		for (size_t i = 0; i < 4; i++)
+		{
+			this->SetDefaultVertexAttribute(index + i, mat[(glm::length_t)i]);
+		}
+	}
+
+	void Renderer::SetDefaultVertexAttribute(size_t index, const Matrix3x3& mat) const
+	{
+		for (size_t i = 0; i < 3; i++)
+		{
+			this->SetDefaultVertexAttribute(index + i, mat[(glm::length_t)i]);
+		}
+	}
+}
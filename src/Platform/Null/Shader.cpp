@@ -0,0 +1,387 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "Platform/OpenGL/Shader.h"
+#include "Platform/Null/GraphicRecorder.h"
+#include "Platform/RenderStateCache.h"
+#include "Utilities/Logging/Logger.h"
+#include "Core/Macro/Macro.h"
+#include "Core/Config/GlobalConfig.h"
+
+namespace MxEngine
+{
+	MxString EmptyPath;
+
+	// slot cache entries which were not yet resolved into uniform locations of current program
+	constexpr int UnresolvedSlot = -2;
+
+	Shader::Shader()
+	{
+		this->id = 0;
+	}
+
+	Shader::Shader(const MxString& vertexShaderPath, const MxString& fragmentShaderPath)
+	{
+		this->Load(vertexShaderPath, fragmentShaderPath);
+	}
+
+	Shader::Shader(const MxString& vertexShaderPath, const MxString& geometryShaderPath, const MxString& fragmentShaderPath)
+	{
+		this->Load(vertexShaderPath, geometryShaderPath, fragmentShaderPath);
+	}
+
+	void Shader::Bind() const
+	{
+		if (RenderStateCache::UseProgram(id))
+			GraphicRecorder::GetFrameStatistics().ShaderBinds++;
+	}
+
+	void Shader::Unbind() const
+	{
+		if (RenderStateCache::UseProgram(0))
+			GraphicRecorder::GetFrameStatistics().ShaderBinds++;
+	}
+
+	void Shader::InvalidateUniformCache()
+	{
+		this->uniformCache.clear();
+		this->slotCache.clear();
+	}
+
+	Shader::BindableId Shader::GetNativeHandle() const
+	{
+		return id;
+	}
+
+	Shader::Shader(Shader&& shader) noexcept
+	{
+		#if defined(MXENGINE_DEBUG)
+		this->vertexShaderPath = shader.vertexShaderPath;
+		this->geometryShaderPath = shader.geometryShaderPath;
+		this->fragmentShaderPath = shader.fragmentShaderPath;
+		#endif
+		this->id = shader.id;
+		this->uniformCache = std::move(shader.uniformCache);
+		this->slotCache = std::move(shader.slotCache);
+		shader.id = 0;
+	}
+
+	Shader& Shader::operator=(Shader&& shader) noexcept
+	{
+		this->FreeShader();
+
+		#if defined(MXENGINE_DEBUG)
+		this->vertexShaderPath = shader.vertexShaderPath;
+		this->geometryShaderPath = shader.geometryShaderPath;
+		this->fragmentShaderPath = shader.fragmentShaderPath;
+		#endif
+		this->id = shader.id;
+		this->uniformCache = std::move(shader.uniformCache);
+		this->slotCache = std::move(shader.slotCache);
+		shader.id = 0;
+		return *this;
+	}
+
+	Shader::~Shader()
+	{
+		this->FreeShader();
+	}
+
+	void Shader::Load(const MxString& vertex, const MxString& fragment)
+	{
+		this->InvalidateUniformCache();
+		this->FreeShader();
+		#if defined(MXENGINE_DEBUG)
+		this->vertexShaderPath = vertex;
+		this->fragmentShaderPath = fragment;
+		#endif
+		// shader sources are not read, as null backend has nothing to compile them with
+		id = CreateProgram(CompileShader(0, vertex, vertex), CompileShader(0, fragment, fragment));
+		MXLOG_DEBUG("Null::Shader", "shader program created with id = " + ToMxString(id));
+	}
+
+	void Shader::Load(const MxString& vertex, const MxString& geometry, const MxString& fragment)
+	{
+		this->InvalidateUniformCache();
+		this->FreeShader();
+		#if defined(MXENGINE_DEBUG)
+		this->vertexShaderPath = vertex;
+		this->geometryShaderPath = geometry;
+		this->fragmentShaderPath = fragment;
+		#endif
+		id = CreateProgram(CompileShader(0, vertex, vertex), CompileShader(0, geometry, geometry), CompileShader(0, fragment, fragment));
+		MXLOG_DEBUG("Null::Shader", "shader program created with id = " + ToMxString(id));
+	}
+
+	void Shader::IgnoreNonExistingUniform(const MxString& name) const
+	{
+		this->IgnoreNonExistingUniform(name.c_str());
+	}
+
+	void Shader::IgnoreNonExistingUniform(const char* name) const
+	{
+		if (uniformCache.find_as(name) == uniformCache.end())
+		{
+			uniformCache[name] = (UniformType)uniformCache.size();
+		}
+	}
+
+	void Shader::LoadFromString(const MxString& vertex, const MxString& fragment)
+	{
+		this->InvalidateUniformCache();
+		this->FreeShader();
+		id = CreateProgram(CompileShader(0, vertex, "vertex.glsl"), CompileShader(0, fragment, "fragment.glsl"));
+		MXLOG_DEBUG("Null::Shader", "shader program created with id = " + ToMxString(id));
+	}
+
+	void Shader::LoadFromString(const MxString& vertex, const MxString& geometry, const MxString& fragment)
+	{
+		this->InvalidateUniformCache();
+		this->FreeShader();
+		id = CreateProgram(CompileShader(0, vertex, "vertex.glsl"), CompileShader(0, geometry, "geometry.glsl"), CompileShader(0, fragment, "fragment.glsl"));
+		MXLOG_DEBUG("Null::Shader", "shader program created with id = " + ToMxString(id));
+	}
+
+	// all uniform setters perform the same name lookup as OpenGL backend, so its cost is included into measurements
+	void Shader::SetUniformFloat(const MxString& name, float f) const
+	{
+		int location = GetUniformLocation(name);
+		if (location == -1) return;
+		Bind();
+		GraphicRecorder::GetFrameStatistics().UniformUpdates++;
+	}
+
+	void Shader::SetUniformVec2(const MxString& name, const Vector2& vec) const
+	{
+		int location = GetUniformLocation(name);
+		if (location == -1) return;
+		Bind();
+		GraphicRecorder::GetFrameStatistics().UniformUpdates++;
+	}
+
+	void Shader::SetUniformVec3(const MxString& name, const Vector3& vec) const
+	{
+		int location = GetUniformLocation(name);
+		if (location == -1) return;
+		Bind();
+		GraphicRecorder::GetFrameStatistics().UniformUpdates++;
+	}
+
+	void Shader::SetUniformVec4(const MxString& name, const Vector4& vec) const
+	{
+		int location = GetUniformLocation(name);
+		if (location == -1) return;
+		Bind();
+		GraphicRecorder::GetFrameStatistics().UniformUpdates++;
+	}
+
+	void Shader::SetUniformMat4(const MxString& name, const Matrix4x4& matrix) const
+	{
+		int location = GetUniformLocation(name);
+		if (location == -1) return;
+		Bind();
+		GraphicRecorder::GetFrameStatistics().UniformUpdates++;
+	}
+
+	void Shader::SetUniformMat3(const MxString& name, const Matrix3x3& matrix) const
+	{
+		int location = GetUniformLocation(name);
+		if (location == -1) return;
+		Bind();
+		GraphicRecorder::GetFrameStatistics().UniformUpdates++;
+	}
+
+	void Shader::SetUniformInt(const MxString& name, int i) const
+	{
+		int location = GetUniformLocation(name);
+		if (location == -1) return;
+		Bind();
+		GraphicRecorder::GetFrameStatistics().UniformUpdates++;
+	}
+
+	void Shader::SetUniformBool(const MxString& name, bool b) const
+	{
+		this->SetUniformInt(name, (int)b);
+	}
+
+	void Shader::SetUniformFloat(const UniformSlot& slot, float f) const
+	{
+		int location = GetUniformLocation(slot);
+		if (location == -1) return;
+		Bind();
+		GraphicRecorder::GetFrameStatistics().UniformUpdates++;
+	}
+
+	void Shader::SetUniformVec2(const UniformSlot& slot, const Vector2& vec) const
+	{
+		int location = GetUniformLocation(slot);
+		if (location == -1) return;
+		Bind();
+		GraphicRecorder::GetFrameStatistics().UniformUpdates++;
+	}
+
+	void Shader::SetUniformVec3(const UniformSlot& slot, const Vector3& vec) const
+	{
+		int location = GetUniformLocation(slot);
+		if (location == -1) return;
+		Bind();
+		GraphicRecorder::GetFrameStatistics().UniformUpdates++;
+	}
+
+	void Shader::SetUniformVec4(const UniformSlot& slot, const Vector4& vec) const
+	{
+		int location = GetUniformLocation(slot);
+		if (location == -1) return;
+		Bind();
+		GraphicRecorder::GetFrameStatistics().UniformUpdates++;
+	}
+
+	void Shader::SetUniformMat4(const UniformSlot& slot, const Matrix4x4& matrix) const
+	{
+		int location = GetUniformLocation(slot);
+		if (location == -1) return;
+		Bind();
+		GraphicRecorder::GetFrameStatistics().UniformUpdates++;
+	}
+
+	void Shader::SetUniformMat3(const UniformSlot& slot, const Matrix3x3& matrix) const
+	{
+		int location = GetUniformLocation(slot);
+		if (location == -1) return;
+		Bind();
+		GraphicRecorder::GetFrameStatistics().UniformUpdates++;
+	}
+
+	void Shader::SetUniformInt(const UniformSlot& slot, int i) const
+	{
+		int location = GetUniformLocation(slot);
+		if (location == -1) return;
+		Bind();
+		GraphicRecorder::GetFrameStatistics().UniformUpdates++;
+	}
+
+	void Shader::SetUniformBool(const UniformSlot& slot, bool b) const
+	{
+		this->SetUniformInt(slot, (int)b);
+	}
+
+	void Shader::BindUniformBlock(const UniformSlot& block, unsigned int bindingPoint) const
+	{
+		if (block.GetIndex() >= this->slotCache.size())
+			this->slotCache.resize(block.GetIndex() + 1, UnresolvedSlot);
+
+		auto& blockIndex = this->slotCache[block.GetIndex()];
+		if (blockIndex != UnresolvedSlot) return;
+
+		GraphicRecorder::GetFrameStatistics().UniformNameLookups++;
+		blockIndex = (int)bindingPoint;
+	}
+
+	const MxString& Shader::GetVertexShaderDebugFilePath() const
+	{
+		#if defined(MXENGINE_DEBUG)
+		return this->vertexShaderPath;
+		#else
+		return EmptyPath;
+		#endif
+	}
+
+	const MxString& Shader::GetGeometryShaderDebugFilePath() const
+	{
+		#if defined(MXENGINE_DEBUG)
+		return this->geometryShaderPath;
+		#else
+		return EmptyPath;
+		#endif
+	}
+
+	const MxString& Shader::GetFragmentShaderDebugFilePath() const
+	{
+		#if defined(MXENGINE_DEBUG)
+		return this->fragmentShaderPath;
+		#else
+		return EmptyPath;
+		#endif
+	}
+
+	Shader::ShaderId Shader::CompileShader(unsigned int type, const MxString& source, const MxString& path) const
+	{
+		MXLOG_DEBUG("Null::Shader", "skipping compilation of shader: " + path);
+		return GraphicRecorder::CreateObject();
+	}
+
+	Shader::BindableId Shader::CreateProgram(Shader::ShaderId vertexShader, Shader::ShaderId fragmentShader) const
+	{
+		GraphicRecorder::DestroyObject(vertexShader);
+		GraphicRecorder::DestroyObject(fragmentShader);
+		return GraphicRecorder::CreateObject();
+	}
+
+	Shader::BindableId Shader::CreateProgram(ShaderId vertexShader, ShaderId geometryShader, ShaderId fragmentShader) const
+	{
+		GraphicRecorder::DestroyObject(vertexShader);
+		GraphicRecorder::DestroyObject(geometryShader);
+		GraphicRecorder::DestroyObject(fragmentShader);
+		return GraphicRecorder::CreateObject();
+	}
+
+	int Shader::GetUniformLocation(const MxString& uniformName) const
+	{
+		GraphicRecorder::GetFrameStatistics().UniformNameLookups++;
+		if (uniformCache.find(uniformName) != uniformCache.end())
+			return uniformCache[uniformName];
+
+		// there is no program to query, so each new uniform is treated as existing one
+		int location = (int)uniformCache.size();
+		uniformCache[uniformName] = location;
+		return location;
+	}
+
+	int Shader::GetUniformLocation(const UniformSlot& slot) const
+	{
+		if (slot.GetIndex() >= this->slotCache.size())
+			this->slotCache.resize(slot.GetIndex() + 1, UnresolvedSlot);
+
+		auto& location = this->slotCache[slot.GetIndex()];
+		if (location == UnresolvedSlot)
+			location = this->GetUniformLocation(slot.GetName());
+		return location;
+	}
+
+	void Shader::FreeShader()
+	{
+		RenderStateCache::ForgetProgram(this->id);
+		GraphicRecorder::DestroyObject(this->id);
+		this->id = 0;
+	}
+
+	MxString Shader::GetShaderVersionString()
+	{
+		return "#version " + ToMxString(GlobalConfig::GetGraphicAPIMajorVersion() * 100 + GlobalConfig::GetGraphicAPIMinorVersion() * 10);
+	}
+}
@@ -0,0 +1,138 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "Platform/OpenGL/UniformBuffer.h"
+#include "Platform/Null/GraphicRecorder.h"
+#include "Utilities/Logging/Logger.h"
+
+namespace MxEngine
+{
+	void UniformBuffer::FreeUniformBuffer()
+	{
+		GraphicRecorder::DestroyObject(this->id);
+	}
+
+	UniformBuffer::UniformBuffer()
+	{
+		this->size = 0;
+		this->id = GraphicRecorder::CreateObject();
+		MXLOG_DEBUG("Null::UniformBuffer", "created uniform buffer with id = " + ToMxString(id));
+	}
+
+	UniformBuffer::UniformBuffer(BufferData data, size_t sizeInBytes, UsageType type)
+		: UniformBuffer()
+	{
+		Load(data, sizeInBytes, type);
+	}
+
+	UniformBuffer::~UniformBuffer()
+	{
+		this->FreeUniformBuffer();
+	}
+
+	UniformBuffer::UniformBuffer(UniformBuffer&& ubo) noexcept
+	{
+		this->id = ubo.id;
+		this->size = ubo.size;
+		ubo.id = 0;
+		ubo.size = 0;
+	}
+
+	UniformBuffer& UniformBuffer::operator=(UniformBuffer&& ubo) noexcept
+	{
+		this->FreeUniformBuffer();
+
+		this->id = ubo.id;
+		this->size = ubo.size;
+		ubo.id = 0;
+		ubo.size = 0;
+		return *this;
+	}
+
+	size_t UniformBuffer::GetOffsetAlignment()
+	{
+		return 256; // most strict alignment allowed by OpenGL specification
+	}
+
+	void UniformBuffer::Load(BufferData data, size_t sizeInBytes, UsageType type)
+	{
+		this->size = sizeInBytes;
+		this->Bind();
+
+		auto& statistics = GraphicRecorder::GetFrameStatistics();
+		statistics.BufferUploads++;
+		if (data != nullptr) statistics.BufferUploadBytes += sizeInBytes;
+	}
+
+	void UniformBuffer::BufferSubData(BufferData data, size_t sizeInBytes, size_t offsetInBytes)
+	{
+		this->Bind();
+
+		auto& statistics = GraphicRecorder::GetFrameStatistics();
+		statistics.BufferUploads++;
+		statistics.BufferUploadBytes += sizeInBytes;
+	}
+
+	void UniformBuffer::BufferDataWithResize(BufferData data, size_t sizeInBytes)
+	{
+		if (this->GetSize() < sizeInBytes)
+			this->Load(data, sizeInBytes, UsageType::DYNAMIC_DRAW);
+		else
+			this->BufferSubData(data, sizeInBytes);
+	}
+
+	size_t UniformBuffer::GetSize() const
+	{
+		return this->size;
+	}
+
+	UniformBuffer::BindableId UniformBuffer::GetNativeHandle() const
+	{
+		return id;
+	}
+
+	void UniformBuffer::Bind() const
+	{
+		GraphicRecorder::GetFrameStatistics().BufferBinds++;
+	}
+
+	void UniformBuffer::Unbind() const
+	{
+		GraphicRecorder::GetFrameStatistics().BufferBinds++;
+	}
+
+	void UniformBuffer::BindBase(unsigned int bindingPoint) const
+	{
+		GraphicRecorder::GetFrameStatistics().BufferBinds++;
+	}
+
+	void UniformBuffer::BindRange(unsigned int bindingPoint, size_t offsetInBytes, size_t sizeInBytes) const
+	{
+		GraphicRecorder::GetFrameStatistics().BufferBinds++;
+	}
+}
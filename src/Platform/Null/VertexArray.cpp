@@ -0,0 +1,117 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "Platform/OpenGL/VertexArray.h"
+#include "Platform/OpenGL/VertexBuffer.h"
+#include "Platform/OpenGL/VertexBufferLayout.h"
+#include "Platform/Null/GraphicRecorder.h"
+#include "Platform/RenderStateCache.h"
+#include "Utilities/Logging/Logger.h"
+
+namespace MxEngine
+{
+	void VertexArray::FreeVertexArray()
+	{
+		RenderStateCache::ForgetVertexArray(this->id);
+		GraphicRecorder::DestroyObject(this->id);
+	}
+
+	VertexArray::VertexArray()
+	{
+		this->id = 0;
+	}
+
+	VertexArray::~VertexArray()
+	{
+		this->FreeVertexArray();
+	}
+
+	VertexArray::VertexArray(VertexArray&& array) noexcept
+		: attributeIndex(array.attributeIndex)
+	{
+		this->id = array.id;
+		array.id = 0;
+		array.attributeIndex = 0;
+	}
+
+	VertexArray& VertexArray::operator=(VertexArray&& array) noexcept
+	{
+		this->FreeVertexArray();
+		this->attributeIndex = array.attributeIndex;
+		this->id = array.id;
+		array.id = 0;
+		return *this;
+	}
+
+	VertexArray::BindableId VertexArray::GetNativeHandle() const
+	{
+		return id;
+	}
+
+	void VertexArray::Bind() const
+	{
+		if (RenderStateCache::BindVertexArray(id))
+			GraphicRecorder::GetFrameStatistics().VertexArrayBinds++;
+	}
+
+	void VertexArray::Unbind() const
+	{
+		if (RenderStateCache::BindVertexArray(0))
+			GraphicRecorder::GetFrameStatistics().VertexArrayBinds++;
+	}
+
+	void VertexArray::AddBuffer(const VertexBuffer& buffer, const VertexBufferLayout& layout)
+	{
+		if (id == 0)
+		{
+			this->id = GraphicRecorder::CreateObject();
+			MXLOG_DEBUG("Null::VertexArray", "created vertex array with id = " + ToMxString(id));
+		}
+		this->Bind();
+		buffer.Bind();
+		this->attributeIndex += (int)layout.GetElements().size();
+		GraphicRecorder::GetFrameStatistics().StateChanges += layout.GetElements().size();
+	}
+
+	void VertexArray::AddInstancedBuffer(const VertexBuffer& buffer, const VertexBufferLayout& layout)
+	{
+		this->AddBuffer(buffer, layout);
+	}
+
+	void VertexArray::PopBuffer(const VertexBufferLayout& vbl)
+	{
+		this->Bind();
+		this->attributeIndex -= (int)vbl.GetElements().size();
+		GraphicRecorder::GetFrameStatistics().StateChanges += vbl.GetElements().size();
+	}
+
+	int VertexArray::GetAttributeCount() const
+	{
+		return this->attributeIndex;
+	}
+}
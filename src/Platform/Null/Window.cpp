@@ -0,0 +1,313 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "Platform/Window/Window.h"
+
+#include "Utilities/Logging/Logger.h"
+#include "Utilities/EventDispatcher/EventDispatcher.h"
+#include "Utilities/Memory/Memory.h"
+#include "Utilities/Profiler/Profiler.h"
+#include "Core/Events/WindowResizeEvent.h"
+#include "Platform/Modules/GraphicModule.h"
+
+namespace MxEngine
+{
+	// headless window does not create any native window or graphic context. It only keeps its size and dispatches empty input events
+
+	void Window::Destroy()
+	{
+		if (this->isVirtualCreated)
+		{
+			this->Close();
+			this->isVirtualCreated = false;
+			MXLOG_DEBUG("Null::Window", "window destroyed");
+		}
+	}
+
+	void Window::Move(Window&& other)
+	{
+		this->title = std::move(other.title);
+		this->width = other.width;
+		this->height = other.height;
+		this->window = other.window;
+		this->dispatcher = other.dispatcher;
+		this->keyHeld = other.keyHeld;
+		this->keyPressed = other.keyPressed;
+		this->keyReleased = other.keyReleased;
+		this->mouseHeld = other.mouseHeld;
+		this->mousePressed = other.mousePressed;
+		this->mouseReleased = other.mouseReleased;
+		this->cursorMode = other.cursorMode;
+		this->windowPosition = other.windowPosition;
+		this->isVirtualCreated = other.isVirtualCreated;
+		this->isVirtualClosed = other.isVirtualClosed;
+
+		other.width = 0;
+		other.height = 0;
+		other.window = nullptr;
+		other.dispatcher = nullptr;
+		other.cursorMode = CursorMode::NORMAL;
+		other.windowPosition = MakeVector2(0.0f);
+		other.isVirtualCreated = false;
+		other.isVirtualClosed = false;
+		other.keyHeld.reset();
+		other.keyReleased.reset();
+		other.keyPressed.reset();
+	}
+
+	Window::Window(int width, int height, const MxString& title)
+		: title(title), width(width), height(height)
+	{
+		MXLOG_DEBUG("Null::Window", "window object created");
+	}
+
+	Window::Window(Window&& other) noexcept
+	{
+		this->Move(std::move(other));
+	}
+
+	int Window::GetWidth() const
+	{
+		return this->width;
+	}
+
+	int Window::GetHeight() const
+	{
+		return this->height;
+	}
+
+	Window::WindowHandle Window::GetNativeHandle()
+	{
+		return this->window;
+	}
+
+	EventDispatcherImpl<EventBase>& Window::GetEventDispatcher()
+	{
+		return *this->dispatcher;
+	}
+
+	bool Window::IsCreated() const
+	{
+		return this->isVirtualCreated;
+	}
+
+	bool Window::IsOpen() const
+	{
+		if (!this->isVirtualCreated)
+		{
+			MXLOG_WARNING("Null::Window", "window was not created while calling Window::IsOpen");
+			return false;
+		}
+		return !this->isVirtualClosed;
+	}
+
+	void Window::PullEvents() const
+	{
+		MAKE_SCOPE_PROFILER("Window::PullEvents");
+		this->keyPressed.reset();
+		this->keyReleased.reset();
+		this->mousePressed.reset();
+		this->mouseReleased.reset();
+	}
+
+	void Window::OnUpdate()
+	{
+		GraphicModule::OnWindowUpdate(this->GetNativeHandle());
+
+		// input events are still dispatched, so subscribers are invoked the same way as with native window
+		if (this->dispatcher != nullptr)
+		{
+			auto keyEvent = MakeUnique<KeyEvent>(&this->keyHeld, &this->keyPressed, &this->keyReleased);
+			this->dispatcher->AddEvent(std::move(keyEvent));
+			auto mousePress = MakeUnique<MouseButtonEvent>(&this->mouseHeld, &this->mousePressed, &this->mouseReleased);
+			this->dispatcher->AddEvent(std::move(mousePress));
+
+			auto cursor = this->GetCursorPosition();
+			auto mouseMoveEvent = MakeUnique<MouseMoveEvent>(cursor.x, cursor.y);
+			this->dispatcher->AddEvent(std::move(mouseMoveEvent));
+		}
+
+		this->anyKeyEvent = false;
+		this->anyMouseEvent = false;
+	}
+
+	Window& Window::Close()
+	{
+		if (this->isVirtualCreated && IsOpen())
+		{
+			GraphicModule::OnWindowDestroy(this->GetNativeHandle());
+
+			this->isVirtualClosed = true;
+			MXLOG_DEBUG("Null::Window", "window closed");
+		}
+		return *this;
+	}
+
+	Vector2 Window::GetCursorPosition() const
+	{
+		return MakeVector2(0.5f * this->width, 0.5f * this->height);
+	}
+
+	Vector2 Window::GetWindowPosition() const
+	{
+		return this->windowPosition;
+	}
+
+	bool Window::IsKeyHeld(KeyCode key) const
+	{
+		return key != KeyCode::UNKNOWN && this->keyHeld[(size_t)key];
+	}
+
+	bool Window::IsKeyPressed(KeyCode key) const
+	{
+		return key != KeyCode::UNKNOWN && this->keyPressed[(size_t)key];
+	}
+
+	bool Window::IsKeyReleased(KeyCode key) const
+	{
+		return key != KeyCode::UNKNOWN && this->keyReleased[(size_t)key];
+	}
+
+	bool Window::IsMouseHeld(MouseButton button)
+	{
+		return this->mouseHeld[(size_t)button];
+	}
+
+	bool Window::IsMousePressed(MouseButton button)
+	{
+		return this->mousePressed[(size_t)button];
+	}
+
+	bool Window::IsMouseReleased(MouseButton button)
+	{
+		return this->mouseReleased[(size_t)button];
+	}
+
+	bool Window::IsKeyHeldUnchecked(KeyCode key)
+	{
+		return false;
+	}
+
+	bool Window::IsMouseHeldUnchecked(MouseButton button)
+	{
+		return false;
+	}
+
+	Window& Window::Create()
+	{
+		MAKE_SCOPE_PROFILER("Window::Create");
+		this->isVirtualCreated = true;
+		this->isVirtualClosed = false;
+		GraphicModule::OnWindowCreate(this->GetNativeHandle());
+		MXLOG_DEBUG("Null::Window", "headless window initialized");
+		return *this;
+	}
+
+	Window& Window::SwitchContext()
+	{
+		return *this;
+	}
+
+	Window& Window::UseProfile(int majorVersion, int minorVersion, RenderProfile profile)
+	{
+		return *this;
+	}
+
+	Window& Window::UseDebugging(bool value)
+	{
+		return *this;
+	}
+
+	Window& Window::UseDoubleBuffering(bool value)
+	{
+		this->doubleBuffer = value;
+		return *this;
+	}
+
+	Window& Window::UseCursorMode(CursorMode cursor)
+	{
+		this->cursorMode = cursor;
+		return *this;
+	}
+
+	Window& Window::UseCursorPosition(const Vector2& pos)
+	{
+		return *this;
+	}
+
+	Window& Window::UseTitle(const MxString& title)
+	{
+		this->title = title;
+		return *this;
+	}
+
+	Window& Window::UseWindowPosition(int xpos, int ypos)
+	{
+		this->windowPosition = { (float)xpos, (float)ypos };
+		return *this;
+	}
+
+	Window& Window::UseWindowSize(int width, int height)
+	{
+		if (this->isVirtualCreated && this->dispatcher != nullptr)
+		{
+			this->dispatcher->AddEvent(
+				MakeUnique<WindowResizeEvent>(MakeVector2((float)this->width, (float)this->height), MakeVector2((float)width, (float)height)));
+		}
+		this->width = width;
+		this->height = height;
+		return *this;
+	}
+
+	Window& Window::UseEventDispatcher(EventDispatcherImpl<EventBase>* dispatcher)
+	{
+		this->dispatcher = dispatcher;
+		return *this;
+	}
+
+	CursorMode Window::GetCursorMode() const
+	{
+		return this->cursorMode;
+	}
+
+	const MxString& Window::GetTitle() const
+	{
+		return this->title;
+	}
+
+	Window& Window::operator=(Window&& other) noexcept
+	{
+		this->Move(std::move(other));
+		return *this;
+	}
+
+	Window::~Window()
+	{
+		this->Destroy();
+	}
+}
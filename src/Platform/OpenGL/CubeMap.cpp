@@ -28,6 +28,7 @@
 
 #include "CubeMap.h"
 #include "Platform/OpenGL/GLUtilities.h"
+#include "Platform/RenderStateCache.h"
 #include "Utilities/Image/ImageLoader.h"
 #include "Utilities/Logging/Logger.h"
 
@@ -37,6 +38,7 @@ namespace MxEngine
 	{
 		if (id != 0)
 		{
+			RenderStateCache::ForgetTexture(id);
 			GLCALL(glDeleteTextures(1, &id));
 		}
 		id = 0;
@@ -95,14 +97,26 @@ namespace MxEngine
 
 	void CubeMap::Bind() const
 	{
-		GLCALL(glActiveTexture(GL_TEXTURE0 + this->activeId));
-		GLCALL(glBindTexture(GL_TEXTURE_CUBE_MAP, id));
+		if (RenderStateCache::ActiveTexture(this->activeId))
+		{
+			GLCALL(glActiveTexture(GL_TEXTURE0 + this->activeId));
+		}
+		if (RenderStateCache::BindTexture(this->activeId, GL_TEXTURE_CUBE_MAP, id))
+		{
+			GLCALL(glBindTexture(GL_TEXTURE_CUBE_MAP, id));
+		}
 	}
 
 	void CubeMap::Unbind() const
 	{
-		GLCALL(glActiveTexture(GL_TEXTURE0 + this->activeId));
-		GLCALL(glBindTexture(GL_TEXTURE_CUBE_MAP, 0));
+		if (RenderStateCache::ActiveTexture(this->activeId))
+		{
+			GLCALL(glActiveTexture(GL_TEXTURE0 + this->activeId));
+		}
+		if (RenderStateCache::BindTexture(this->activeId, GL_TEXTURE_CUBE_MAP, 0))
+		{
+			GLCALL(glBindTexture(GL_TEXTURE_CUBE_MAP, 0));
+		}
 	}
 
 	CubeMap::BindableId CubeMap::GetNativeHandle() const
@@ -135,7 +149,7 @@ namespace MxEngine
 		this->width = img.GetWidth();
 		this->height = img.GetHeight();
 
-		GLCALL(glBindTexture(GL_TEXTURE_CUBE_MAP, id));
+		this->Bind(0);
 		for (size_t i = 0; i < 6; i++)
 		{
 			GLCALL(glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + (GLenum)i, 0, GL_RGB, 
@@ -174,7 +188,7 @@ namespace MxEngine
 		this->channels = images.front().GetChannels();
 		this->filepath = "[[raw data]]";
 
-		GLCALL(glBindTexture(GL_TEXTURE_CUBE_MAP, id));
+		this->Bind(0);
 		for (size_t i = 0; i < images.size(); i++)
 		{
 			GLCALL(glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + (GLenum)i, 0, GL_RGB,
@@ -198,7 +212,7 @@ namespace MxEngine
 		this->channels = 3;
 		this->filepath = "[[raw data]]";
 
-		GLCALL(glBindTexture(GL_TEXTURE_CUBE_MAP, id));
+		this->Bind(0);
 		for (size_t i = 0; i < data.size(); i++)
 		{
 			GLCALL(glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + (GLenum)i, 0, GL_RGB,
@@ -222,7 +236,7 @@ namespace MxEngine
 		this->filepath = "[[depth]]";
 		this->channels = 1;
 		
-		GLCALL(glBindTexture(GL_TEXTURE_CUBE_MAP, id));
+		this->Bind(0);
 		for (size_t i = 0; i < 6; i++)
 		{
 			GLCALL(glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + (GLenum)i, 0, GL_DEPTH_COMPONENT, 
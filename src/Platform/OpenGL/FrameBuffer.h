@@ -70,9 +70,9 @@ namespace MxEngine
         BindableId id = 0;
         AttachmentType currentAttachment = AttachmentType::NONE;
         #if defined(MXENGINE_DEBUG)
-        std::aligned_storage_t<32> attachmentStorage;
+        std::aligned_storage_t<16> attachmentStorage;
         #else
-        std::aligned_storage_t<24> attachmentStorage;
+        std::aligned_storage_t<8> attachmentStorage;
         #endif
 
         #if defined(MXENGINE_DEBUG)
@@ -84,6 +84,20 @@ namespace MxEngine
 		GLCALL(glBufferData(GL_ELEMENT_ARRAY_BUFFER, count * sizeof(IndexType), data, GL_STATIC_DRAW));
 	}
 
+	void IndexBuffer::BufferSubData(const IndexType* data, size_t count, size_t offset)
+	{
+		// element array binding is part of vertex array state, so data is uploaded through copy target instead
+		GLCALL(glBindBuffer(GL_COPY_WRITE_BUFFER, id));
+		GLCALL(glBufferSubData(GL_COPY_WRITE_BUFFER, offset * sizeof(IndexType), count * sizeof(IndexType), data));
+	}
+
+	void IndexBuffer::CopySubData(const IndexBuffer& source, size_t count, size_t sourceOffset, size_t offset)
+	{
+		GLCALL(glBindBuffer(GL_COPY_READ_BUFFER, source.id));
+		GLCALL(glBindBuffer(GL_COPY_WRITE_BUFFER, this->id));
+		GLCALL(glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, sourceOffset * sizeof(IndexType), offset * sizeof(IndexType), count * sizeof(IndexType)));
+	}
+
 	void IndexBuffer::Unbind() const
 	{
 		GLCALL(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0));
@@ -55,6 +55,8 @@ namespace MxEngine
 		void Bind() const;
 		void Unbind() const;
 		void Load(const IndexType* data, size_t sizeInInts);
+		void BufferSubData(const IndexType* data, size_t sizeInInts, size_t offsetInInts = 0);
+		void CopySubData(const IndexBuffer& source, size_t sizeInInts, size_t sourceOffsetInInts = 0, size_t offsetInInts = 0);
 		size_t GetCount() const;
 		size_t GetIndexTypeId() const;
 	};
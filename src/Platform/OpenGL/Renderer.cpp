@@ -29,6 +29,7 @@
 #include "Renderer.h"
 #include "Utilities/Logging/Logger.h"
 #include "Platform/OpenGL/GLUtilities.h"
+#include "Platform/RenderStateCache.h"
 #include "Platform/Modules/GraphicModule.h"
 #include "Utilities/Profiler/Profiler.h"
 #include "Utilities/Format/Format.h"
@@ -110,6 +111,31 @@ namespace MxEngine
 		GLCALL(glDrawElementsInstanced(GL_TRIANGLES, (GLsizei)ibo.GetCount(), (GLenum)ibo.GetIndexTypeId(), nullptr, (GLsizei)count));
 	}
 
+	void Renderer::DrawTrianglesInstanced(const VertexArray& vao, const IndexBuffer& ibo, const Shader& shader, size_t count, size_t baseInstance) const
+	{
+		vao.Bind();
+		ibo.Bind();
+		shader.Bind();
+		GLCALL(glDrawElementsInstancedBaseInstance(GL_TRIANGLES, (GLsizei)ibo.GetCount(), (GLenum)ibo.GetIndexTypeId(), nullptr, (GLsizei)count, (GLuint)baseInstance));
+	}
+
+	void Renderer::DrawTrianglesRange(const VertexArray& vao, const IndexBuffer& ibo, const Shader& shader, size_t indexCount, size_t firstIndex, size_t baseVertex, size_t count, size_t baseInstance) const
+	{
+		vao.Bind();
+		ibo.Bind();
+		shader.Bind();
+		auto indexOffset = reinterpret_cast<const void*>(firstIndex * sizeof(IndexBuffer::IndexType));
+		if (count == 0)
+		{
+			GLCALL(glDrawElementsBaseVertex(GL_TRIANGLES, (GLsizei)indexCount, (GLenum)ibo.GetIndexTypeId(), indexOffset, (GLint)baseVertex));
+		}
+		else
+		{
+			GLCALL(glDrawElementsInstancedBaseVertexBaseInstance(GL_TRIANGLES, (GLsizei)indexCount, (GLenum)ibo.GetIndexTypeId(), indexOffset, 
+				(GLsizei)count, (GLint)baseVertex, (GLuint)baseInstance));
+		}
+	}
+
 	void Renderer::DrawTrianglesInstanced(const VertexArray& vao, size_t vertexCount, const Shader& shader, size_t count) const
 	{
 		if (count == 0) { this->DrawTriangles(vao, vertexCount, shader); return; }
@@ -160,21 +186,27 @@ namespace MxEngine
 
 	Renderer& Renderer::UseDepthBufferMask(bool value)
 	{
-		GLCALL(glDepthMask(value));
+		if (RenderStateCache::DepthMask(value))
+		{
+			GLCALL(glDepthMask(value));
+		}
 		return *this;
 	}
 
 	Renderer& Renderer::UseSampling(bool value)
 	{
-		if (value)
-		{
-			GLCALL(glEnable(GL_MULTISAMPLE));
-			MXLOG_DEBUG("OpenGL::Renderer", "native multisampling is enabled");
-		}
-		else
+		if (RenderStateCache::Enable(RenderCapability::MULTISAMPLE, value))
 		{
-			GLCALL(glDisable(GL_MULTISAMPLE));
-			MXLOG_DEBUG("OpenGL::Renderer", "native multisampling is disabled");
+			if (value)
+			{
+				GLCALL(glEnable(GL_MULTISAMPLE));
+				MXLOG_DEBUG("OpenGL::Renderer", "native multisampling is enabled");
+			}
+			else
+			{
+				GLCALL(glDisable(GL_MULTISAMPLE));
+				MXLOG_DEBUG("OpenGL::Renderer", "native multisampling is disabled");
+			}
 		}
 		return *this;
 	}
@@ -184,12 +216,18 @@ namespace MxEngine
 		depthBufferEnabled = value;
 		if (value)
 		{
-			GLCALL(glEnable(GL_DEPTH_TEST));
+			if (RenderStateCache::Enable(RenderCapability::DEPTH_TEST, true))
+			{
+				GLCALL(glEnable(GL_DEPTH_TEST));
+			}
 			clearMask |= GL_DEPTH_BUFFER_BIT;
 		}
 		else
 		{
-			GLCALL(glDisable(GL_DEPTH_TEST));
+			if (RenderStateCache::Enable(RenderCapability::DEPTH_TEST, false))
+			{
+				GLCALL(glDisable(GL_DEPTH_TEST));
+			}
 			clearMask &= ~GL_DEPTH_BUFFER_BIT;
 		}
 		return *this;
@@ -223,40 +261,41 @@ namespace MxEngine
 
 	Renderer& Renderer::UseDepthFunction(DepthFunction function)
 	{
-		GLCALL(glDepthFunc(depthFuncTable[(size_t)function]));
+		GLenum nativeFunction = depthFuncTable[(size_t)function];
+		if (RenderStateCache::DepthFunction(nativeFunction))
+		{
+			GLCALL(glDepthFunc(nativeFunction));
+		}
 		return *this;
 	}
 
 	Renderer& Renderer::UseCulling(bool value, bool counterClockWise, bool cullBack)
 	{
 		// culling 
-		if (value)
+		if (RenderStateCache::Enable(RenderCapability::CULL_FACE, value))
 		{
-			GLCALL(glEnable(GL_CULL_FACE));
-		}
-		else
-		{
-			GLCALL(glDisable(GL_CULL_FACE));
+			if (value)
+			{
+				GLCALL(glEnable(GL_CULL_FACE));
+			}
+			else
+			{
+				GLCALL(glDisable(GL_CULL_FACE));
+			}
 		}
 
 		// point order
-		if (counterClockWise)
-		{
-			GLCALL(glFrontFace(GL_CCW));
-		}
-		else
+		GLenum frontFace = counterClockWise ? GL_CCW : GL_CW;
+		if (RenderStateCache::FrontFace(frontFace))
 		{
-			GLCALL(glFrontFace(GL_CW));
+			GLCALL(glFrontFace(frontFace));
 		}
 
 		// back / front culling
-		if (cullBack)
-		{
-			GLCALL(glCullFace(GL_BACK));
-		}
-		else
+		GLenum cullFace = cullBack ? GL_BACK : GL_FRONT;
+		if (RenderStateCache::CullFace(cullFace))
 		{
-			GLCALL(glCullFace(GL_FRONT));
+			GLCALL(glCullFace(cullFace));
 		}
 
 		return *this;
@@ -272,12 +311,23 @@ namespace MxEngine
 	{
 		if (src == BlendFactor::NONE || dist == BlendFactor::NONE)
 		{
-			GLCALL(glDisable(GL_BLEND));
+			if (RenderStateCache::Enable(RenderCapability::BLEND, false))
+			{
+				GLCALL(glDisable(GL_BLEND));
+			}
 		}
 		else
 		{
-			GLCALL(glEnable(GL_BLEND));
-			GLCALL(glBlendFunc(BlendTable[(size_t)src], BlendTable[(size_t)dist]));
+			if (RenderStateCache::Enable(RenderCapability::BLEND, true))
+			{
+				GLCALL(glEnable(GL_BLEND));
+			}
+			GLenum source = BlendTable[(size_t)src];
+			GLenum destination = BlendTable[(size_t)dist];
+			if (RenderStateCache::BlendFunction(source, destination))
+			{
+				GLCALL(glBlendFunc(source, destination));
+			}
 		}
 		return *this;
 	}
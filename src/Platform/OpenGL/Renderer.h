@@ -71,6 +71,8 @@ namespace MxEngine
 		void DrawTriangles(const VertexArray& vao, size_t vertexCount, const Shader& shader) const;
 		void DrawTrianglesInstanced(const VertexArray& vao, const IndexBuffer& ibo, const Shader& shader, size_t count) const;
 		void DrawTrianglesInstanced(const VertexArray& vao, size_t vertexCount, const Shader& shader, size_t count) const;
+		void DrawTrianglesInstanced(const VertexArray& vao, const IndexBuffer& ibo, const Shader& shader, size_t count, size_t baseInstance) const;
+		void DrawTrianglesRange(const VertexArray& vao, const IndexBuffer& ibo, const Shader& shader, size_t indexCount, size_t firstIndex, size_t baseVertex, size_t count, size_t baseInstance = 0) const;
 		void DrawLines(const VertexArray& vao, size_t vertexCount, const Shader& shader) const;
 		void DrawLines(const VertexArray& vao, const IndexBuffer& ibo, const Shader& shader) const;
 		void DrawLinesInstanced(const VertexArray& vao, const IndexBuffer& ibo, const Shader& shader, size_t count) const;
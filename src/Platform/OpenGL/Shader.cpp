@@ -31,6 +31,7 @@
 #include "Utilities/Logging/Logger.h"
 #include "Core/Macro/Macro.h"
 #include "Platform/OpenGL/GLUtilities.h"
+#include "Platform/RenderStateCache.h"
 #include "Utilities/FileSystem/File.h"
 #include "Core/Config/GlobalConfig.h"
 #include "Utilities/Parsing/ShaderPreprocessor.h"
@@ -39,6 +40,9 @@ namespace MxEngine
 {
 	MxString EmptyPath;
 
+	// slot cache entries which were not yet resolved into uniform locations of current program
+	constexpr int UnresolvedSlot = -2;
+
 	enum class ShaderType
 	{
 		VERTEX_SHADER   = GL_VERTEX_SHADER,
@@ -63,17 +67,24 @@ namespace MxEngine
 
 	void Shader::Bind() const
 	{
-		GLCALL(glUseProgram(id));
+		if (RenderStateCache::UseProgram(id))
+		{
+			GLCALL(glUseProgram(id));
+		}
 	}
 
 	void Shader::Unbind() const
 	{
-		GLCALL(glUseProgram(0));
+		if (RenderStateCache::UseProgram(0))
+		{
+			GLCALL(glUseProgram(0));
+		}
 	}
 
     void Shader::InvalidateUniformCache()
     {
 		this->uniformCache.clear();
+		this->slotCache.clear();
     }
 
 	Shader::BindableId Shader::GetNativeHandle() const
@@ -90,6 +101,7 @@ namespace MxEngine
 		#endif
 		this->id = shader.id;
 		this->uniformCache = std::move(shader.uniformCache);
+		this->slotCache = std::move(shader.slotCache);
 		shader.id = 0;
 	}
 
@@ -104,6 +116,7 @@ namespace MxEngine
 		#endif
 		this->id = shader.id;
 		this->uniformCache = std::move(shader.uniformCache);
+		this->slotCache = std::move(shader.slotCache);
 		shader.id = 0;
 		return *this;
 	}
@@ -272,6 +285,85 @@ namespace MxEngine
 		this->SetUniformInt(name, (int)b);
 	}
 
+	void Shader::SetUniformFloat(const UniformSlot& slot, float f) const
+	{
+		int location = GetUniformLocation(slot);
+		if (location == -1) return;
+		Bind();
+		GLCALL(glUniform1f(location, f));
+	}
+
+	void Shader::SetUniformVec2(const UniformSlot& slot, const Vector2& vec) const
+	{
+		int location = GetUniformLocation(slot);
+		if (location == -1) return;
+		Bind();
+		GLCALL(glUniform2f(location, vec.x, vec.y));
+	}
+
+	void Shader::SetUniformVec3(const UniformSlot& slot, const Vector3& vec) const
+	{
+		int location = GetUniformLocation(slot);
+		if (location == -1) return;
+		Bind();
+		GLCALL(glUniform3f(location, vec.x, vec.y, vec.z));
+	}
+
+	void Shader::SetUniformVec4(const UniformSlot& slot, const Vector4& vec) const
+	{
+		int location = GetUniformLocation(slot);
+		if (location == -1) return;
+		Bind();
+		GLCALL(glUniform4f(location, vec.x, vec.y, vec.z, vec.w));
+	}
+
+	void Shader::SetUniformMat4(const UniformSlot& slot, const Matrix4x4& matrix) const
+	{
+		int location = GetUniformLocation(slot);
+		if (location == -1) return;
+		Bind();
+		GLCALL(glUniformMatrix4fv(location, 1, false, &matrix[0][0]));
+	}
+
+	void Shader::SetUniformMat3(const UniformSlot& slot, const Matrix3x3& matrix) const
+	{
+		int location = GetUniformLocation(slot);
+		if (location == -1) return;
+		Bind();
+		GLCALL(glUniformMatrix3fv(location, 1, false, &matrix[0][0]));
+	}
+
+	void Shader::SetUniformInt(const UniformSlot& slot, int i) const
+	{
+		int location = GetUniformLocation(slot);
+		if (location == -1) return;
+		Bind();
+		GLCALL(glUniform1i(location, i));
+	}
+
+	void Shader::SetUniformBool(const UniformSlot& slot, bool b) const
+	{
+		this->SetUniformInt(slot, (int)b);
+	}
+
+	void Shader::BindUniformBlock(const UniformSlot& block, unsigned int bindingPoint) const
+	{
+		if (block.GetIndex() >= this->slotCache.size())
+			this->slotCache.resize(block.GetIndex() + 1, UnresolvedSlot);
+
+		auto& blockIndex = this->slotCache[block.GetIndex()];
+		if (blockIndex != UnresolvedSlot) return;
+
+		GLCALL(GLuint index = glGetUniformBlockIndex(this->id, block.GetName().c_str()));
+		if (index == GL_INVALID_INDEX)
+		{
+			blockIndex = -1;
+			return;
+		}
+		GLCALL(glUniformBlockBinding(this->id, index, bindingPoint));
+		blockIndex = (int)index;
+	}
+
 	const MxString& Shader::GetVertexShaderDebugFilePath() const
 	{
 		#if defined(MXENGINE_DEBUG)
@@ -387,10 +479,23 @@ namespace MxEngine
 		return location;
 	}
 
+	int Shader::GetUniformLocation(const UniformSlot& slot) const
+	{
+		if (slot.GetIndex() >= this->slotCache.size())
+			this->slotCache.resize(slot.GetIndex() + 1, UnresolvedSlot);
+
+		// name is looked up only once per program, as slot cache is cleared when shader is relinked
+		auto& location = this->slotCache[slot.GetIndex()];
+		if (location == UnresolvedSlot)
+			location = this->GetUniformLocation(slot.GetName());
+		return location;
+	}
+
 	void Shader::FreeShader()
 	{
 		if (id != 0)
 		{
+			RenderStateCache::ForgetProgram(id);
 			GLCALL(glDeleteProgram(id));
 		}
 	}
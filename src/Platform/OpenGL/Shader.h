@@ -32,9 +32,51 @@
 #include "Core/Macro/Macro.h"
 #include "Utilities/STL/MxString.h"
 #include "Utilities/STL/MxHashMap.h"
+#include "Utilities/STL/MxVector.h"
 
 namespace MxEngine
 {
+	/*
+	uniform slot is an integer id assigned to uniform (or uniform block) name once per application.
+	Shaders map slots to their own locations on first use after linking, so setting uniform by slot
+	does not hash or allocate any strings. Slots are expected to be created once, as static objects
+	*/
+	class UniformSlot
+	{
+		struct Registry
+		{
+			MxHashMap<MxString, size_t> Indices;
+			MxVector<MxString> Names;
+		};
+
+		static Registry& GetRegistry()
+		{
+			static Registry registry;
+			return registry;
+		}
+
+		size_t index;
+	public:
+		explicit UniformSlot(const char* name)
+		{
+			auto& registry = GetRegistry();
+			auto it = registry.Indices.find_as(name);
+			if (it != registry.Indices.end())
+			{
+				this->index = it->second;
+			}
+			else
+			{
+				this->index = registry.Names.size();
+				registry.Names.emplace_back(name);
+				registry.Indices.emplace(registry.Names.back(), this->index);
+			}
+		}
+
+		size_t GetIndex() const { return this->index; }
+		const MxString& GetName() const { return GetRegistry().Names[this->index]; }
+	};
+
 	class Shader
 	{
 		#if defined(MXENGINE_DEBUG)
@@ -42,16 +84,19 @@ namespace MxEngine
 		#endif
 		using UniformType = int;
 		using UniformCache = MxHashMap<MxString, UniformType>;
+		using SlotCache = MxVector<UniformType>;
 		using ShaderId = unsigned int;
 		using BindableId = unsigned int;
 
 		BindableId id = 0;
 		mutable UniformCache uniformCache;
+		mutable SlotCache slotCache;
 
 		ShaderId CompileShader(unsigned int type, const MxString& source, const MxString& name) const;
 		BindableId CreateProgram(ShaderId vertexShader, ShaderId fragmentShader) const;
 		BindableId CreateProgram(ShaderId vertexShader, ShaderId geometryShader, ShaderId fragmentShader) const;
 		UniformType GetUniformLocation(const MxString& uniformName) const;
+		UniformType GetUniformLocation(const UniformSlot& slot) const;
 		void FreeShader();
 	public:
 		static MxString GetShaderVersionString();
@@ -83,6 +128,21 @@ namespace MxEngine
 		void SetUniformMat3(const MxString& name, const Matrix3x3& matrix) const;
 		void SetUniformInt(const MxString& name, int i) const;
 		void SetUniformBool(const MxString& name, bool b) const;
+		void SetUniformFloat(const UniformSlot& slot, float f) const;
+		void SetUniformVec2(const UniformSlot& slot, const Vector2& vec) const;
+		void SetUniformVec3(const UniformSlot& slot, const Vector3& vec) const;
+		void SetUniformVec4(const UniformSlot& slot, const Vector4& vec) const;
+		void SetUniformMat4(const UniformSlot& slot, const Matrix4x4& matrix) const;
+		void SetUniformMat3(const UniformSlot& slot, const Matrix3x3& matrix) const;
+		void SetUniformInt(const UniformSlot& slot, int i) const;
+		void SetUniformBool(const UniformSlot& slot, bool b) const;
+		/*!
+		attaches uniform block of shader program to uniform buffer binding point. Binding is done once per linked program,
+		so calling this method each frame is cheap. Blocks not present in program are silently ignored
+		\param block slot with name of uniform block
+		\param bindingPoint index of uniform buffer binding point (see UniformBuffer::BindBase)
+		*/
+		void BindUniformBlock(const UniformSlot& block, unsigned int bindingPoint) const;
 
 		const MxString& GetVertexShaderDebugFilePath() const;
 		const MxString& GetGeometryShaderDebugFilePath() const;
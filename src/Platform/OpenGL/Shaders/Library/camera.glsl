@@ -0,0 +1,6 @@
+layout(std140) uniform CameraBuffer
+{
+	mat4 viewProjMatrix;
+	mat4 invViewProjMatrix;
+	vec3 position;
+} camera;
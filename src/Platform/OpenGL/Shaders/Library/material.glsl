@@ -0,0 +1,8 @@
+layout(std140) uniform MaterialBuffer
+{
+	float emmisive;
+	float reflection;
+	float specularFactor;
+	float specularIntensity;
+	float transparency;
+} material;
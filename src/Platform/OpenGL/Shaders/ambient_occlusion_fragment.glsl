@@ -8,12 +8,7 @@ uniform sampler2D normalTex;
 uniform sampler2D materialTex;
 uniform sampler2D depthTex;
 
-struct Camera
-{
-    mat4 invViewProjMatrix;
-    mat4 viewProjMatrix;
-};
-uniform Camera camera;
+#include "Library/camera.glsl"
 
 uniform sampler2D noiseTex;
 uniform int sampleCount;
@@ -4,6 +4,8 @@ layout(triangle_strip, max_vertices = 18) out;
 out vec4 FragPos;
 
 uniform mat4 LightProjMatrix[6];
+// bit i is set if object is visible from i-th cubemap face, culled on CPU
+uniform int faceMask;
 
 void emitFace(mat4 lightMatrix)
 {
@@ -19,21 +21,39 @@ void emitFace(mat4 lightMatrix)
 void main()
 {
     // gl_Layer must be assigned to a constant to work on most devices
-    gl_Layer = 0;
-    emitFace(LightProjMatrix[0]);
+    if ((faceMask & 1) != 0)
+    {
+        gl_Layer = 0;
+        emitFace(LightProjMatrix[0]);
+    }
 
-    gl_Layer = 1;
-    emitFace(LightProjMatrix[1]);
+    if ((faceMask & 2) != 0)
+    {
+        gl_Layer = 1;
+        emitFace(LightProjMatrix[1]);
+    }
 
-    gl_Layer = 2;
-    emitFace(LightProjMatrix[2]);
+    if ((faceMask & 4) != 0)
+    {
+        gl_Layer = 2;
+        emitFace(LightProjMatrix[2]);
+    }
 
-    gl_Layer = 3;
-    emitFace(LightProjMatrix[3]);
+    if ((faceMask & 8) != 0)
+    {
+        gl_Layer = 3;
+        emitFace(LightProjMatrix[3]);
+    }
 
-    gl_Layer = 4;
-    emitFace(LightProjMatrix[4]);
+    if ((faceMask & 16) != 0)
+    {
+        gl_Layer = 4;
+        emitFace(LightProjMatrix[4]);
+    }
 
-    gl_Layer = 5;
-    emitFace(LightProjMatrix[5]);
+    if ((faceMask & 32) != 0)
+    {
+        gl_Layer = 5;
+        emitFace(LightProjMatrix[5]);
+    }
 }
\ No newline at end of file
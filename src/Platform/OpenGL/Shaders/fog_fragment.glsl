@@ -9,16 +9,10 @@ uniform sampler2D normalTex;
 uniform sampler2D materialTex;
 uniform sampler2D depthTex;
 
-struct Camera
-{
-	vec3 position;
-	mat4 invViewProjMatrix;
-	mat4 viewProjMatrix;
-};
+#include "Library/camera.glsl"
 
 uniform sampler2D cameraOutput;
 uniform Fog fog;
-uniform Camera camera;
 
 void main()
 {
@@ -11,21 +11,13 @@ layout(location = 0) out vec4 OutAlbedo;
 layout(location = 1) out vec4 OutNormal;
 layout(location = 2) out vec4 OutMaterial;
 
-struct Material
-{
-	float emmisive;
-	float reflection;
-	float specularFactor;
-	float specularIntensity;
-	float transparency;
-};
+#include "Library/material.glsl"
 
 uniform sampler2D map_albedo;
 uniform sampler2D map_specular;
 uniform sampler2D map_emmisive;
 uniform sampler2D map_normal;
 uniform sampler2D map_occlusion;
-uniform Material material;
 uniform float gamma;
 
 vec3 calcNormal(vec2 texcoord, mat3 TBN, sampler2D normalMap)
@@ -3,24 +3,21 @@
 out vec4 OutColor;
 in vec2 TexCoord;
 
-struct Camera
-{
-	vec3 position;
-	mat4 invViewProjMatrix;
-	mat4 viewProjMatrix;
-};
+#include "Library/camera.glsl"
 
 uniform sampler2D albedoTex;
 uniform sampler2D normalTex;
 uniform sampler2D materialTex;
 uniform sampler2D depthTex;
 
-uniform int lightCount;
 uniform int pcfDistance;
-uniform Camera camera;
 
 const int MaxLightCount = 4;
-uniform DirLight lights[MaxLightCount];
+layout(std140) uniform DirLightBuffer
+{
+	DirLight lights[MaxLightCount];
+	int lightCount;
+};
 uniform sampler2D lightDepthMaps[MaxLightCount][DirLightCascadeMapCount];
 
 void main()
@@ -25,16 +25,10 @@ struct PointLight
 	vec3 specular;
 };
 
-struct Camera
-{
-	vec3 position;
-	mat4 invViewProjMatrix;
-	mat4 viewProjMatrix;
-};
+#include "Library/camera.glsl"
 
 uniform samplerCube lightDepthMap;
 uniform bool castsShadows;
-uniform Camera camera;
 uniform int pcfDistance;
 uniform vec2 viewportSize;
 
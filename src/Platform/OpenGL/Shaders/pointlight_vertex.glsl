@@ -14,14 +14,8 @@ out PointLightInfo
 	vec3 specular;
 } pointLight;
 
-struct Camera
-{
-	vec3 position;
-	mat4 invViewProjMatrix;
-	mat4 viewProjMatrix;
-};
+#include "Library/camera.glsl"
 
-uniform Camera camera;
 
 void main()
 {
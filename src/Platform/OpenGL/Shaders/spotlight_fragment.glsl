@@ -29,17 +29,11 @@ struct SpotLight
 	vec3 specular;
 };
 
-struct Camera
-{
-	vec3 position;
-	mat4 invViewProjMatrix;
-	mat4 viewProjMatrix;
-};
+#include "Library/camera.glsl"
 
 uniform mat4 worldToLightTransform;
 uniform bool castsShadows;
 uniform sampler2D lightDepthMap;
-uniform Camera camera;
 uniform int pcfDistance;
 uniform vec2 viewportSize;
 
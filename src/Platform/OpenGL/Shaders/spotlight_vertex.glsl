@@ -17,14 +17,8 @@ out SpotLightInfo
 	vec3 specular;
 } spotLight;
 
-struct Camera
-{
-	vec3 position;
-	mat4 invViewProjMatrix;
-	mat4 viewProjMatrix;
-};
+#include "Library/camera.glsl"
 
-uniform Camera camera;
 
 void main()
 {
@@ -3,12 +3,7 @@
 in vec2 TexCoord;
 out vec4 OutColor;
 
-struct Camera
-{
-    vec3 position;
-    mat4 viewProjMatrix;
-    mat4 invViewProjMatrix;
-};
+#include "Library/camera.glsl"
 
 uniform sampler2D albedoTex;
 uniform sampler2D normalTex;
@@ -19,7 +14,6 @@ uniform sampler2D HDRTex;
 uniform samplerCube skyboxMap;
 uniform mat3 skyboxTransform;
 uniform float skyboxLuminance;
-uniform Camera camera;
 
 uniform int   steps;
 uniform float thickness;
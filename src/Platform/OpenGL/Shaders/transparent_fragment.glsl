@@ -1,4 +1,5 @@
 #include "Library/directional_light.glsl"
+#include "Library/camera.glsl"
 
 out vec4 OutColor;
 
@@ -11,14 +12,7 @@ in VSout
 	vec3 Position;
 } fsin;
 
-struct Material
-{
-	float emmisive;
-	float reflection;
-	float specularFactor;
-	float specularIntensity;
-	float transparency;
-};
+#include "Library/material.glsl"
 
 uniform sampler2D map_albedo;
 uniform sampler2D map_specular;
@@ -26,23 +20,16 @@ uniform sampler2D map_emmisive;
 uniform sampler2D map_normal;
 uniform sampler2D map_transparency;
 uniform sampler2D map_occlusion;
-uniform Material material;
 uniform float gamma;
 
-struct Camera
-{
-	vec3 position;
-	mat4 invProjMatrix;
-	mat4 invViewMatrix;
-	mat4 viewProjMatrix;
-};
-
-uniform int lightCount;
 uniform int pcfDistance;
-uniform vec3 viewportPosition;
 
 const int MaxLightCount = 4;
-uniform DirLight lights[MaxLightCount];
+layout(std140) uniform DirLightBuffer
+{
+	DirLight lights[MaxLightCount];
+	int lightCount;
+};
 uniform sampler2D lightDepthMaps[MaxLightCount][DirLightCascadeMapCount];
 
 vec3 calcNormal(vec2 texcoord, mat3 TBN, sampler2D normalMap)
@@ -69,9 +56,9 @@ void main()
 
 	float transparency = material.transparency * albedoAlphaTex.a;
 
-	float fragDistance = length(viewportPosition - fragment.position);
+	float fragDistance = length(camera.position - fragment.position);
 
-	vec3 viewDirection = normalize(viewportPosition - fragment.position);
+	vec3 viewDirection = normalize(camera.position - fragment.position);
 
 	vec3 totalColor = vec3(0.0f);
 	totalColor += fragment.albedo * fragment.emmisionFactor;
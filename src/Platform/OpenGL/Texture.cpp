@@ -28,6 +28,7 @@
 
 #include "Texture.h"
 #include "Platform/OpenGL/GLUtilities.h"
+#include "Platform/RenderStateCache.h"
 #include "Utilities/Logging/Logger.h"
 #include "Utilities/Time/Time.h"
 #include "Utilities/Image/ImageLoader.h"
@@ -60,6 +61,7 @@ namespace MxEngine
 	{
 		if (id != 0)
 		{
+			RenderStateCache::ForgetTexture(id);
 			GLCALL(glDeleteTextures(1, &id));
 		}
 		id = 0;
@@ -141,7 +143,7 @@ namespace MxEngine
 		this->height = image.GetHeight();
 		this->textureType = GL_TEXTURE_2D;
 
-		GLCALL(glBindTexture(GL_TEXTURE_2D, id));
+		this->Bind(0);
 		GLCALL(glTexImage2D(GL_TEXTURE_2D, 0, formatTable[(int)this->format], (GLsizei)width, (GLsizei)height, 0, GL_RGBA, GL_UNSIGNED_BYTE, image.GetRawData()));
 
 		GLCALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, wrapTable[(int)this->wrapType]));
@@ -161,7 +163,7 @@ namespace MxEngine
 
 		GLenum type = this->IsFloatingPoint() ? GL_FLOAT : GL_UNSIGNED_BYTE;
 
-		GLCALL(glBindTexture(GL_TEXTURE_2D, id));
+		this->Bind(0);
 		GLCALL(glTexImage2D(GL_TEXTURE_2D, 0, formatTable[(int)this->format], (GLsizei)width, (GLsizei)height, 0, GL_RGB, type, data));
 
 		GLCALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, wrapTable[(int)this->wrapType]));
@@ -302,14 +304,26 @@ namespace MxEngine
 
 	void Texture::Bind() const
 	{
-		GLCALL(glActiveTexture(GL_TEXTURE0 + this->activeId));
-		GLCALL(glBindTexture(this->textureType, id));
+		if (RenderStateCache::ActiveTexture(this->activeId))
+		{
+			GLCALL(glActiveTexture(GL_TEXTURE0 + this->activeId));
+		}
+		if (RenderStateCache::BindTexture(this->activeId, this->textureType, id))
+		{
+			GLCALL(glBindTexture(this->textureType, id));
+		}
 	}
 
 	void Texture::Unbind() const
 	{
-		GLCALL(glActiveTexture(GL_TEXTURE0 + this->activeId));
-		GLCALL(glBindTexture(this->textureType, 0));
+		if (RenderStateCache::ActiveTexture(this->activeId))
+		{
+			GLCALL(glActiveTexture(GL_TEXTURE0 + this->activeId));
+		}
+		if (RenderStateCache::BindTexture(this->activeId, this->textureType, 0))
+		{
+			GLCALL(glBindTexture(this->textureType, 0));
+		}
 	}
 
 	Texture::BindableId Texture::GetBoundId() const
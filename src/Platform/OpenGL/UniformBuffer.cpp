@@ -0,0 +1,143 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "UniformBuffer.h"
+#include "Platform/OpenGL/GLUtilities.h"
+#include "Utilities/Logging/Logger.h"
+
+namespace MxEngine
+{
+	extern GLenum DataType[]; // usage types are shared with VertexBuffer
+
+	void UniformBuffer::FreeUniformBuffer()
+	{
+		if (this->id != 0)
+		{
+			GLCALL(glDeleteBuffers(1, &id));
+		}
+	}
+
+	UniformBuffer::UniformBuffer()
+	{
+		this->size = 0;
+		GLCALL(glGenBuffers(1, &id));
+		MXLOG_DEBUG("OpenGL::UniformBuffer", "created uniform buffer with id = " + ToMxString(id));
+	}
+
+	UniformBuffer::UniformBuffer(BufferData data, size_t sizeInBytes, UsageType type)
+		: UniformBuffer()
+	{
+		Load(data, sizeInBytes, type);
+	}
+
+	UniformBuffer::~UniformBuffer()
+	{
+		this->FreeUniformBuffer();
+	}
+
+	UniformBuffer::UniformBuffer(UniformBuffer&& ubo) noexcept
+	{
+		this->id = ubo.id;
+		this->size = ubo.size;
+		ubo.id = 0;
+		ubo.size = 0;
+	}
+
+	UniformBuffer& UniformBuffer::operator=(UniformBuffer&& ubo) noexcept
+	{
+		this->FreeUniformBuffer();
+
+		this->id = ubo.id;
+		this->size = ubo.size;
+		ubo.id = 0;
+		ubo.size = 0;
+		return *this;
+	}
+
+	size_t UniformBuffer::GetOffsetAlignment()
+	{
+		static GLint alignment = 0;
+		if (alignment == 0)
+		{
+			GLCALL(glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment));
+			if (alignment <= 0) alignment = 256; // maximal value allowed by specification
+		}
+		return (size_t)alignment;
+	}
+
+	void UniformBuffer::Load(BufferData data, size_t sizeInBytes, UsageType type)
+	{
+		this->size = sizeInBytes;
+		GLCALL(glBindBuffer(GL_UNIFORM_BUFFER, id));
+		GLCALL(glBufferData(GL_UNIFORM_BUFFER, sizeInBytes, data, DataType[(int)type]));
+	}
+
+	void UniformBuffer::BufferSubData(BufferData data, size_t sizeInBytes, size_t offsetInBytes)
+	{
+		this->Bind();
+		GLCALL(glBufferSubData(GL_UNIFORM_BUFFER, offsetInBytes, sizeInBytes, data));
+	}
+
+	void UniformBuffer::BufferDataWithResize(BufferData data, size_t sizeInBytes)
+	{
+		if (this->GetSize() < sizeInBytes)
+			this->Load(data, sizeInBytes, UsageType::DYNAMIC_DRAW);
+		else
+			this->BufferSubData(data, sizeInBytes);
+	}
+
+	size_t UniformBuffer::GetSize() const
+	{
+		return this->size;
+	}
+
+	UniformBuffer::BindableId UniformBuffer::GetNativeHandle() const
+	{
+		return id;
+	}
+
+	void UniformBuffer::Bind() const
+	{
+		GLCALL(glBindBuffer(GL_UNIFORM_BUFFER, id));
+	}
+
+	void UniformBuffer::Unbind() const
+	{
+		GLCALL(glBindBuffer(GL_UNIFORM_BUFFER, 0));
+	}
+
+	void UniformBuffer::BindBase(unsigned int bindingPoint) const
+	{
+		GLCALL(glBindBufferBase(GL_UNIFORM_BUFFER, bindingPoint, id));
+	}
+
+	void UniformBuffer::BindRange(unsigned int bindingPoint, size_t offsetInBytes, size_t sizeInBytes) const
+	{
+		GLCALL(glBindBufferRange(GL_UNIFORM_BUFFER, bindingPoint, id, (GLintptr)offsetInBytes, (GLsizeiptr)sizeInBytes));
+	}
+}
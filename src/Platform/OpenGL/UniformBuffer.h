@@ -0,0 +1,73 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include "Platform/OpenGL/VertexBuffer.h"
+#include <cstdint>
+
+namespace MxEngine
+{
+	/*
+	uniform buffer stores data of std140 uniform blocks (see UniformBlockWriter). Single buffer may contain
+	multiple blocks of same type, each of them can be attached to binding point separately using BindRange()
+	*/
+	class UniformBuffer
+	{
+		using BindableId = unsigned int;
+		using BufferData = const uint8_t*;
+
+		BindableId id = 0;
+		size_t size;
+		void FreeUniformBuffer();
+	public:
+		explicit UniformBuffer();
+		explicit UniformBuffer(BufferData data, size_t sizeInBytes, UsageType type);
+		~UniformBuffer();
+		UniformBuffer(const UniformBuffer&) = delete;
+		UniformBuffer(UniformBuffer&& ubo) noexcept;
+		UniformBuffer& operator=(const UniformBuffer&) = delete;
+		UniformBuffer& operator=(UniformBuffer&&) noexcept;
+
+		/*!
+		gets minimal alignment of offset passed to BindRange() method, supported by graphic driver
+		\returns offset alignment in bytes
+		*/
+		static size_t GetOffsetAlignment();
+
+		BindableId GetNativeHandle() const;
+		void Bind() const;
+		void Unbind() const;
+		void BindBase(unsigned int bindingPoint) const;
+		void BindRange(unsigned int bindingPoint, size_t offsetInBytes, size_t sizeInBytes) const;
+		void Load(BufferData data, size_t sizeInBytes, UsageType type);
+		void BufferSubData(BufferData data, size_t sizeInBytes, size_t offsetInBytes = 0);
+		void BufferDataWithResize(BufferData data, size_t sizeInBytes);
+		size_t GetSize() const;
+	};
+}
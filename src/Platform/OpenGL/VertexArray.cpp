@@ -28,6 +28,7 @@
 
 #include "VertexArray.h"
 #include "Platform/OpenGL/GLUtilities.h"
+#include "Platform/RenderStateCache.h"
 #include "Platform/OpenGL/VertexBuffer.h"
 #include "Platform/OpenGL/VertexBufferLayout.h"
 #include "Utilities/Logging/Logger.h"
@@ -38,6 +39,7 @@ namespace MxEngine
 	{
 		if (id != 0)
 		{
+			RenderStateCache::ForgetVertexArray(id);
 			GLCALL(glDeleteVertexArrays(1, &id));
 		}
 	}
@@ -76,12 +78,18 @@ namespace MxEngine
 
     void VertexArray::Bind() const
 	{
-		glBindVertexArray(id);
+		if (RenderStateCache::BindVertexArray(id))
+		{
+			GLCALL(glBindVertexArray(id));
+		}
 	}
 
 	void VertexArray::Unbind() const
 	{
-		glBindVertexArray(0);
+		if (RenderStateCache::BindVertexArray(0))
+		{
+			GLCALL(glBindVertexArray(0));
+		}
 	}
 
 	void VertexArray::AddBuffer(const VertexBuffer& buffer, const VertexBufferLayout& layout)
@@ -111,6 +111,14 @@ namespace MxEngine
 			this->BufferSubData(data, sizeInFloats);
     }
 
+    void VertexBuffer::CopySubData(const VertexBuffer& source, size_t count, size_t sourceOffset, size_t offset)
+    {
+		// copy targets are used, as they do not affect any other binding
+		GLCALL(glBindBuffer(GL_COPY_READ_BUFFER, source.id));
+		GLCALL(glBindBuffer(GL_COPY_WRITE_BUFFER, this->id));
+		GLCALL(glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, sourceOffset * sizeof(float), offset * sizeof(float), count * sizeof(float)));
+    }
+
     size_t VertexBuffer::GetSize() const
     {
 		return this->size;
@@ -67,6 +67,7 @@ namespace MxEngine
 		void Load(BufferData data, size_t sizeInFloats, UsageType type);
 		void BufferSubData(BufferData data, size_t sizeInFloats, size_t offsetInFloats = 0);
 		void BufferDataWithResize(BufferData data, size_t sizeInFloats);
+		void CopySubData(const VertexBuffer& source, size_t sizeInFloats, size_t sourceOffsetInFloats = 0, size_t offsetInFloats = 0);
 		size_t GetSize() const;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,214 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "RenderStateCache.h"
+
+namespace MxEngine
+{
+	float RenderStateStatistics::GetSkippedPercentage() const
+	{
+		size_t totalCalls = this->IssuedCalls + this->SkippedCalls;
+		return totalCalls == 0 ? 0.0f : 100.0f * float(this->SkippedCalls) / float(totalCalls);
+	}
+
+	RenderStateStatistics& RenderStateStatistics::operator+=(const RenderStateStatistics& other)
+	{
+		this->IssuedCalls  += other.IssuedCalls;
+		this->SkippedCalls += other.SkippedCalls;
+		return *this;
+	}
+
+	bool RenderStateCache::Update(unsigned int& current, unsigned int value)
+	{
+		if (!isValid) Invalidate();
+
+		if (current == value)
+		{
+			frameStatistics.SkippedCalls++;
+			return false;
+		}
+		current = value;
+		frameStatistics.IssuedCalls++;
+		return true;
+	}
+
+	void RenderStateCache::Invalidate()
+	{
+		program = UnknownState;
+		vertexArray = UnknownState;
+		activeTexture = UnknownState;
+		depthMask = UnknownState;
+		depthFunction = UnknownState;
+		blendSource = UnknownState;
+		blendDestination = UnknownState;
+		cullFace = UnknownState;
+		frontFace = UnknownState;
+		capabilities.fill(UnknownState);
+		for (auto& unit : textureUnits)
+			unit.fill(TextureBinding{ UnknownState, UnknownState });
+		isValid = true;
+	}
+
+	bool RenderStateCache::UseProgram(unsigned int id)
+	{
+		return Update(program, id);
+	}
+
+	bool RenderStateCache::BindVertexArray(unsigned int id)
+	{
+		return Update(vertexArray, id);
+	}
+
+	bool RenderStateCache::ActiveTexture(unsigned int unit)
+	{
+		return Update(activeTexture, unit);
+	}
+
+	bool RenderStateCache::BindTexture(unsigned int unit, unsigned int target, unsigned int id)
+	{
+		if (!isValid) Invalidate();
+		if (unit >= MaxTextureUnits)
+		{
+			frameStatistics.IssuedCalls++;
+			return true;
+		}
+
+		// each unit stores separate binding for each texture target
+		auto& bindings = textureUnits[unit];
+		for (auto& binding : bindings)
+		{
+			if (binding.Target == target) return Update(binding.Id, id);
+		}
+		for (auto& binding : bindings)
+		{
+			if (binding.Target == UnknownState)
+			{
+				binding.Target = target;
+				return Update(binding.Id, id);
+			}
+		}
+		frameStatistics.IssuedCalls++;
+		return true;
+	}
+
+	bool RenderStateCache::Enable(RenderCapability capability, bool value)
+	{
+		return Update(capabilities[(size_t)capability], (unsigned int)value);
+	}
+
+	bool RenderStateCache::DepthMask(bool value)
+	{
+		return Update(depthMask, (unsigned int)value);
+	}
+
+	bool RenderStateCache::DepthFunction(unsigned int function)
+	{
+		return Update(depthFunction, function);
+	}
+
+	bool RenderStateCache::BlendFunction(unsigned int source, unsigned int destination)
+	{
+		if (!isValid) Invalidate();
+
+		// both factors are set by one call, so it is issued if any of them changed
+		if (blendSource == source && blendDestination == destination)
+		{
+			frameStatistics.SkippedCalls++;
+			return false;
+		}
+		blendSource = source;
+		blendDestination = destination;
+		frameStatistics.IssuedCalls++;
+		return true;
+	}
+
+	bool RenderStateCache::CullFace(unsigned int face)
+	{
+		return Update(cullFace, face);
+	}
+
+	bool RenderStateCache::FrontFace(unsigned int order)
+	{
+		return Update(frontFace, order);
+	}
+
+	unsigned int RenderStateCache::GetActiveTexture()
+	{
+		return isValid ? activeTexture : UnknownState;
+	}
+
+	void RenderStateCache::ForgetProgram(unsigned int id)
+	{
+		if (program == id) program = UnknownState;
+	}
+
+	void RenderStateCache::ForgetVertexArray(unsigned int id)
+	{
+		if (vertexArray == id) vertexArray = UnknownState;
+	}
+
+	void RenderStateCache::ForgetTexture(unsigned int id)
+	{
+		for (auto& unit : textureUnits)
+		{
+			for (auto& binding : unit)
+			{
+				if (binding.Id == id) binding.Id = UnknownState;
+			}
+		}
+	}
+
+	const RenderStateStatistics& RenderStateCache::GetFrameStatistics()
+	{
+		return frameStatistics;
+	}
+
+	const RenderStateStatistics& RenderStateCache::GetLastFrameStatistics()
+	{
+		return lastFrameStatistics;
+	}
+
+	const RenderStateStatistics& RenderStateCache::GetTotalStatistics()
+	{
+		return totalStatistics;
+	}
+
+	void RenderStateCache::EndFrame()
+	{
+		totalStatistics += frameStatistics;
+		lastFrameStatistics = frameStatistics;
+		frameStatistics = RenderStateStatistics{ };
+	}
+
+	void RenderStateCache::ResetStatistics()
+	{
+		frameStatistics = RenderStateStatistics{ };
+		lastFrameStatistics = RenderStateStatistics{ };
+		totalStatistics = RenderStateStatistics{ };
+	}
+}
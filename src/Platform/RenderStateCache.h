@@ -0,0 +1,135 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <array>
+
+namespace MxEngine
+{
+	struct RenderStateStatistics
+	{
+		size_t IssuedCalls = 0;
+		size_t SkippedCalls = 0;
+
+		float GetSkippedPercentage() const;
+		RenderStateStatistics& operator+=(const RenderStateStatistics& other);
+	};
+
+	enum class RenderCapability : uint8_t
+	{
+		DEPTH_TEST,
+		CULL_FACE,
+		BLEND,
+		MULTISAMPLE,
+
+		COUNT,
+	};
+
+	/*
+	shadow copy of graphic API state, shared by all graphic objects of current context. Before issuing state-changing call
+	graphic backend asks cache if state differs from requested one. Each method records new state and returns true if call
+	must be issued, or false if it can be skipped. Values are passed as native enums of backend, cache only compares them.
+	Cache must be invalidated if state is changed bypassing it (for example, by ImGui renderer), and objects must be forgotten
+	when they are deleted, as graphic API may reuse their ids
+	*/
+	class RenderStateCache
+	{
+		constexpr static size_t MaxTextureUnits = 32;
+		constexpr static size_t MaxTextureTargets = 4;
+		constexpr static unsigned int UnknownState = ~0u;
+
+		struct TextureBinding
+		{
+			unsigned int Target;
+			unsigned int Id;
+		};
+		using TextureUnit = std::array<TextureBinding, MaxTextureTargets>;
+
+		inline static unsigned int program = UnknownState;
+		inline static unsigned int vertexArray = UnknownState;
+		inline static unsigned int activeTexture = UnknownState;
+		inline static unsigned int depthMask = UnknownState;
+		inline static unsigned int depthFunction = UnknownState;
+		inline static unsigned int blendSource = UnknownState;
+		inline static unsigned int blendDestination = UnknownState;
+		inline static unsigned int cullFace = UnknownState;
+		inline static unsigned int frontFace = UnknownState;
+		inline static std::array<unsigned int, (size_t)RenderCapability::COUNT> capabilities;
+		inline static std::array<TextureUnit, MaxTextureUnits> textureUnits;
+		inline static RenderStateStatistics frameStatistics;
+		inline static RenderStateStatistics lastFrameStatistics;
+		inline static RenderStateStatistics totalStatistics;
+		inline static bool isValid = false;
+
+		static bool Update(unsigned int& current, unsigned int value);
+	public:
+		/*!
+		marks all state as unknown, so next call of each kind will be issued
+		*/
+		static void Invalidate();
+		static bool UseProgram(unsigned int id);
+		static bool BindVertexArray(unsigned int id);
+		static bool ActiveTexture(unsigned int unit);
+		/*!
+		records texture binding of texture unit. Note that unit must be activated by caller using ActiveTexture() before binding
+		\param unit index of texture unit (not offset by native enum)
+		\param target native texture target (2d, cubemap, ...)
+		\param id native handle of texture
+		\returns true if texture must be bound
+		*/
+		static bool BindTexture(unsigned int unit, unsigned int target, unsigned int id);
+		static bool Enable(RenderCapability capability, bool value);
+		static bool DepthMask(bool value);
+		static bool DepthFunction(unsigned int function);
+		static bool BlendFunction(unsigned int source, unsigned int destination);
+		static bool CullFace(unsigned int face);
+		static bool FrontFace(unsigned int order);
+		static unsigned int GetActiveTexture();
+
+		static void ForgetProgram(unsigned int id);
+		static void ForgetVertexArray(unsigned int id);
+		static void ForgetTexture(unsigned int id);
+
+		/*!
+		gets counters of calls requested since last EndFrame() call
+		\returns statistics of current frame
+		*/
+		static const RenderStateStatistics& GetFrameStatistics();
+		/*!
+		gets counters of last finished frame. Unlike current frame ones, they are complete at any point of frame
+		\returns statistics of previous frame
+		*/
+		static const RenderStateStatistics& GetLastFrameStatistics();
+		static const RenderStateStatistics& GetTotalStatistics();
+		static void EndFrame();
+		static void ResetStatistics();
+	};
+}
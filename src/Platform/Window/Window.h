@@ -57,6 +57,9 @@ namespace MxEngine
 		bool anyMouseEvent = false;
 		bool doubleBuffer = false;
 		Vector2 windowPosition{ 0.0f, 0.0f };
+		// state of window without native handle, used by headless builds
+		bool isVirtualCreated = false;
+		bool isVirtualClosed = false;
 
 		void Destroy();
 		void Move(Window&& window);
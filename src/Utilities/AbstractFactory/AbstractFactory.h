@@ -30,6 +30,7 @@
 
 #include "Utilities/UUID/UUID.h"
 #include "Utilities/VectorPool/VectorPool.h"
+#include "Utilities/VectorPool/PagedVectorPool.h"
 
 namespace MxEngine
 {
@@ -51,23 +52,128 @@ namespace MxEngine
         ManagedResource& operator=(const ManagedResource&) = delete;
         ManagedResource& operator=(ManagedResource&&) noexcept(std::is_nothrow_move_assignable_v<T>) = default;
 
-        ~ManagedResource()
+        // uuid is not reset on destruction: object destructor may still need it (for example, to remove event listeners by it),
+        // and handles detect destroyed objects by block generation
+        ~ManagedResource() = default;
+    };
+
+    template<typename T, typename = void>
+    struct uses_paged_pool : std::false_type { };
+
+    template<typename T>
+    struct uses_paged_pool<T, std::enable_if_t<T::UsePagedPool>> : std::true_type { };
+
+    /*!
+    pool type used by factories to store objects of type T. Type can opt in paged storage by declaring public member
+    `constexpr static bool UsePagedPool = true;`. Paged pool never moves objects, so references to them stay valid when pool grows
+    */
+    template<typename T>
+    using ResourcePool = std::conditional_t<uses_paged_pool<T>::value, PagedVectorPool<ManagedResource<T>>, VectorPool<ManagedResource<T>>>;
+
+    template<typename T, typename Factory>
+    class Resource;
+
+    /*!
+    borrowed resource is a non-owning handle to object stored in factory pool. It consists only of pool index and block generation,
+    so copying it does not touch object refcount and validity check does not compare UUIDs. Borrowed resource does not keep object alive,
+    so it should be used in hot loops where owning Resource is guaranteed to exist. Use Lock() to get owning handle back
+    */
+    template<typename T, typename Factory>
+    class BorrowedResource
+    {
+        uint32_t handle;
+        uint32_t generation;
+
+        static constexpr uint32_t InvalidHandle = std::numeric_limits<uint32_t>::max();
+    public:
+        BorrowedResource()
+            : handle(InvalidHandle), generation(0)
+        {
+
+        }
+
+        BorrowedResource(uint32_t handle, uint32_t generation)
+            : handle(handle), generation(generation)
+        {
+
+        }
+
+        [[nodiscard]] bool IsValid() const
+        {
+            return this->handle != InvalidHandle && Factory::template Get<T>().GetGeneration(this->handle) == this->generation;
+        }
+
+        [[nodiscard]] T* GetUnchecked() const
+        {
+            return &Factory::template Get<T>()[this->handle].value;
+        }
+
+        [[nodiscard]] T* operator->() const
+        {
+            MX_ASSERT(this->IsValid()); // access of null handle
+            return this->GetUnchecked();
+        }
+
+        [[nodiscard]] T& operator*() const
+        {
+            MX_ASSERT(this->IsValid()); // access of null handle
+            return *this->GetUnchecked();
+        }
+
+        [[nodiscard]] size_t GetHandle() const
+        {
+            return this->handle == InvalidHandle ? std::numeric_limits<size_t>::max() : (size_t)this->handle;
+        }
+
+        [[nodiscard]] uint32_t GetGeneration() const
+        {
+            return this->generation;
+        }
+
+        /*!
+        gets UUID of object, which is stored in its pool block. UUID is available until object is deallocated, including its destructor.
+        Handles of destroyed objects return null UUID, so code which uses UUID as a key (for example, of event listeners) must get it while object is alive
+        \returns object UUID or null UUID if handle is invalid
+        */
+        [[nodiscard]] UUID GetUUID() const
+        {
+            return this->IsValid() ? Factory::template Get<T>()[this->handle].uuid : UUIDGenerator::GetNull();
+        }
+
+        [[nodiscard]] Resource<T, Factory> Lock() const
+        {
+            if (!this->IsValid()) return Resource<T, Factory>{ };
+            return Resource<T, Factory>(Factory::template Get<T>()[this->handle].uuid, this->handle);
+        }
+
+        [[nodiscard]] bool operator==(const BorrowedResource& other) const
+        {
+            return this->handle == other.handle && this->generation == other.generation;
+        }
+
+        [[nodiscard]] bool operator!=(const BorrowedResource& other) const
         {
-            uuid = UUIDGenerator::GetNull();
+            return !(*this == other);
         }
     };
 
+    static_assert(sizeof(BorrowedResource<char, void>) == 8, "borrowed resource must fit into 8 bytes");
+
+    /*!
+    resource is an owning handle to object stored in factory pool. It consists only of pool index and block generation,
+    object UUID is kept in the pool block and is compared once on handle construction
+    */
     template<typename T, typename Factory>
     class Resource
     {
-        UUID uuid;
-        size_t handle;
+        uint32_t handle;
+        uint32_t generation;
 
         #if defined(MXENGINE_DEBUG)
         mutable ManagedResource<T>* _resourcePtr = nullptr;
         #endif
 
-        static constexpr size_t InvalidHandle = std::numeric_limits<size_t>::max();
+        static constexpr uint32_t InvalidHandle = std::numeric_limits<uint32_t>::max();
 
         void IncRef()
         {
@@ -107,19 +213,26 @@ namespace MxEngine
         }
     public:
         Resource()
-            : uuid(UUIDGenerator::GetNull()), handle(InvalidHandle)
+            : handle(InvalidHandle), generation(0)
         {
 
         }
 
         Resource(UUID uuid, size_t handle)
-            : uuid(uuid), handle(handle)
+            : handle(InvalidHandle), generation(0)
         {
+            // uuid is compared only once on construction, later validity checks compare block generations
+            auto& pool = Factory::template Get<T>();
+            if (pool.IsAllocated(handle) && pool[handle].uuid == uuid)
+            {
+                this->handle = (uint32_t)handle;
+                this->generation = pool.GetGeneration(handle);
+            }
             this->IncRef();
         }
 
         Resource(const Resource& wrapper)
-            : uuid(wrapper.uuid), handle(wrapper.handle)
+            : handle(wrapper.handle), generation(wrapper.generation)
         {
             this->IncRef();
             #if defined(MXENGINE_DEBUG)
@@ -135,15 +248,15 @@ namespace MxEngine
             this->_resourcePtr = wrapper._resourcePtr;
             #endif
 
-            this->uuid = wrapper.uuid;
             this->handle = wrapper.handle;
+            this->generation = wrapper.generation;
             this->IncRef();
 
             return *this;
         }
 
         Resource(Resource&& wrapper) noexcept
-            : uuid(wrapper.uuid), handle(wrapper.handle)
+            : handle(wrapper.handle), generation(wrapper.generation)
         {
             #if defined(MXENGINE_DEBUG)
             this->_resourcePtr = wrapper._resourcePtr;
@@ -154,8 +267,8 @@ namespace MxEngine
         Resource& operator=(Resource&& wrapper) noexcept
         {
             this->DecRef();
-            this->uuid = wrapper.uuid;
             this->handle = wrapper.handle;
+            this->generation = wrapper.generation;
             wrapper.handle = InvalidHandle;
 
             #if defined(MXENGINE_DEBUG)
@@ -166,7 +279,7 @@ namespace MxEngine
 
         [[nodiscard]] bool IsValid() const
         {
-            return handle != InvalidHandle && Dereference().uuid == uuid;
+            return handle != InvalidHandle && Factory::template Get<T>().GetGeneration(handle) == generation;
         }
 
         void MakeStatic()
@@ -214,19 +327,38 @@ namespace MxEngine
             return &this->Dereference().value;
         }
 
-        [[nodiscard]] auto GetHandle() const
+        [[nodiscard]] size_t GetHandle() const
+        {
+            return this->handle == InvalidHandle ? std::numeric_limits<size_t>::max() : (size_t)this->handle;
+        }
+
+        [[nodiscard]] uint32_t GetGeneration() const
         {
-            return this->handle;
+            return this->generation;
         }
 
-        [[nodiscard]] const auto& GetUUID() const
+        /*!
+        creates non-owning handle to the same object. Borrowed handle does not change refcount on copy
+        \returns borrowed handle, which is invalidated when object is destroyed
+        */
+        [[nodiscard]] BorrowedResource<T, Factory> Borrow() const
         {
-            return this->uuid;
+            return BorrowedResource<T, Factory>(this->handle, this->generation);
+        }
+
+        /*!
+        gets UUID of object, which is stored in its pool block. UUID is available until object is deallocated, including its destructor.
+        Handles of destroyed objects return null UUID, so code which uses UUID as a key (for example, of event listeners) must get it while object is alive
+        \returns object UUID or null UUID if handle is invalid
+        */
+        [[nodiscard]] UUID GetUUID() const
+        {
+            return this->IsValid() ? this->Dereference().uuid : UUIDGenerator::GetNull();
         }
 
         [[nodiscard]] bool operator==(const Resource& wrapper) const
         {
-            return this->handle == wrapper.handle && this->uuid == wrapper.uuid;
+            return this->handle == wrapper.handle && this->generation == wrapper.generation;
         }
 
         [[nodiscard]] bool operator!=(const Resource& wrapper) const
@@ -240,11 +372,15 @@ namespace MxEngine
         }
     };
 
+    #if !defined(MXENGINE_DEBUG)
+    static_assert(sizeof(Resource<char, void>) == 8, "resource must fit into 8 bytes");
+    #endif
+
     template<typename T, typename... Args>
     struct FactoryImpl : FactoryImpl<Args...>
     {
         using Base = FactoryImpl<Args...>;
-        using Pool = VectorPool<ManagedResource<T>>;
+        using Pool = ResourcePool<T>;
         Pool pool;
 
         template<typename U>
@@ -267,7 +403,7 @@ namespace MxEngine
     template<typename T>
     struct FactoryImpl<T>
     {
-        using FactoryPool = VectorPool<ManagedResource<T>>;
+        using FactoryPool = ResourcePool<T>;
         FactoryPool Pool;
 
         template<typename U>
@@ -28,18 +28,39 @@
 
 #pragma once
 
+#include <array>
+#include <utility>
+
 #include "Utilities/ECS/ComponentFactory.h"
 
 namespace MxEngine
 {
     class ComponentManager;
 
+    /*!
+    type list used by components to declare which component types their OnUpdate method reads and writes
+    copying a component handle changes its refcount, so components accessed through handles must be declared as written
+    */
+    template<typename... Ts>
+    struct ComponentTypes { };
+
+    /*!
+    determines on which thread component OnUpdate can be invoked. Components without update declaration are always updated on main thread
+    */
+    enum class UpdatePolicy
+    {
+        MAIN_THREAD, // OnUpdate accesses graphic, audio or input api, casts physics rays or invokes user code
+        ANY_THREAD, // all components of type are updated by single job on any worker thread
+        PARALLEL_FOR_EACH, // OnUpdate has no cross-object side effects, components are updated in chunks on all worker threads
+    };
+
     struct Component
     {
         using Deleter = void (*)(void*);
 
         std::aligned_storage_t<sizeof(CResource<char>)> resource;
         size_t type;
+        size_t handle;
         Deleter deleter;
 
         template<typename T>
@@ -48,6 +69,7 @@ namespace MxEngine
             static_assert(sizeof(CResource<T>) == sizeof(Component::resource), "storage must fit resource size");
 
             this->type = type;
+            this->handle = component.GetHandle();
             this->deleter = [](void* ptr) { ComponentFactory::Destroy(*std::launder(reinterpret_cast<CResource<T>*>(ptr))); };
             auto* replace = new (&resource) CResource<T>();
             *replace = std::move(component);
@@ -59,62 +81,152 @@ namespace MxEngine
         template<typename T>
         using ComponentList = MxVector<T>;
 
+        using SlotIndex = uint8_t;
+        // slot table maps component type index to position in component list + 1. Zero means no component
+        constexpr static size_t SlotTableSize = 32;
+        constexpr static SlotIndex EmptySlot = 0;
+        constexpr static size_t MaxComponentCount = std::numeric_limits<SlotIndex>::max();
+
         ComponentList<std::aligned_storage_t<sizeof(Component)>> components;
+        std::array<SlotIndex, SlotTableSize> slots{ };
+
+        Component& GetComponentRecord(size_t position)
+        {
+            return *std::launder(reinterpret_cast<Component*>(&this->components[position]));
+        }
+
+        const Component& GetComponentRecord(size_t position) const
+        {
+            return *std::launder(reinterpret_cast<const Component*>(&this->components[position]));
+        }
+
+        const Component* FindComponent(size_t type) const
+        {
+            if (type < SlotTableSize)
+            {
+                SlotIndex slot = this->slots[type];
+                return slot != EmptySlot ? &this->GetComponentRecord(slot - 1) : nullptr;
+            }
+            // types registered after slot table is filled are searched linearly
+            for (size_t i = 0; i < this->components.size(); i++)
+            {
+                const auto& componentRef = this->GetComponentRecord(i);
+                if (componentRef.type == type) return &componentRef;
+            }
+            return nullptr;
+        }
+
+        void SetSlot(size_t type, size_t position)
+        {
+            if (type < SlotTableSize) this->slots[type] = SlotIndex(position + 1);
+        }
+
+        void ClearSlot(size_t type)
+        {
+            if (type < SlotTableSize) this->slots[type] = EmptySlot;
+        }
     public:
         ComponentManager() = default;
         ComponentManager(const ComponentManager&) = delete;
-        ComponentManager(ComponentManager&&) noexcept = default;
         ComponentManager& operator=(const ComponentManager&) = delete;
-        ComponentManager& operator=(ComponentManager&&) noexcept = default;
+
+        ComponentManager(ComponentManager&& other) noexcept
+            : components(std::move(other.components)), slots(other.slots)
+        {
+            other.components.clear();
+            other.slots.fill(EmptySlot);
+        }
+
+        ComponentManager& operator=(ComponentManager&& other) noexcept
+        {
+            // components are exchanged, as before slot table was introduced: previous components of this manager
+            // are destroyed together with moved-from one
+            this->components.swap(other.components);
+            std::swap(this->slots, other.slots);
+            return *this;
+        }
 
         template<typename T, typename... Args>
         CResource<T> AddComponent(Args&&... args)
         {
             this->RemoveComponent<T>();
+            MX_ASSERT(this->components.size() < MaxComponentCount);
             
+            size_t type = ComponentFactory::GetTypeIndex<T>();
             auto component = ComponentFactory::CreateComponent<T>(std::forward<Args>(args)...);
             auto& data = components.emplace_back();
-            Component* result = new (&data) Component(T::ComponentId, std::move(component));
+            Component* result = new (&data) Component(type, std::move(component));
+            this->SetSlot(type, this->components.size() - 1);
             return *std::launder(reinterpret_cast<CResource<T>*>(&result->resource));
         }
 
         template<typename T>
         CResource<T> GetComponent() const
         {
-            for (const auto& component : components)
+            const Component* component = this->FindComponent(ComponentFactory::GetTypeIndex<T>());
+            if (component != nullptr)
             {
-                const auto& componentRef = *reinterpret_cast<const Component*>(&component);
-                if (componentRef.type == T::ComponentId)
-                {
-                    return *std::launder(reinterpret_cast<const CResource<T>*>(&componentRef.resource));
-                }
+                return *std::launder(reinterpret_cast<const CResource<T>*>(&component->resource));
             }
             return CResource<T>{ };
         }
 
+        /*!
+        gets component without copying its handle, so component refcount is not changed. Can be used from worker threads
+        while components of object are not added or removed
+        \returns pointer to component or nullptr if there is no such component
+        */
+        template<typename T>
+        T* BorrowComponent() const
+        {
+            const Component* component = this->FindComponent(ComponentFactory::GetTypeIndex<T>());
+            return component != nullptr ? &ComponentFactory::Get<T>()[component->handle].value : nullptr;
+        }
+
         template<typename T>
         void RemoveComponent()
         {
-            for (auto it = components.begin(); it != components.end(); it++)
+            size_t type = ComponentFactory::GetTypeIndex<T>();
+            const Component* component = this->FindComponent(type);
+            if (component == nullptr) return;
+
+            auto& resource = *std::launder(reinterpret_cast<CResource<T>*>(&const_cast<Component*>(component)->resource));
+            if (resource.IsValid())
+            {
+                ComponentFactory::Destroy(resource);
+            }
+
+            // component destructor may modify component list or even remove component itself, so position is computed after destruction
+            component = this->FindComponent(type);
+            if (component == nullptr) return;
+            size_t position = size_t(reinterpret_cast<const uint8_t*>(component) - reinterpret_cast<const uint8_t*>(this->components.data())) / sizeof(this->components[0]);
+            this->ClearSlot(type);
+
+            // move last component in place of removed one to keep list dense
+            size_t last = this->components.size() - 1;
+            if (position != last)
             {
-                auto& componentRef = *reinterpret_cast<Component*>(&*it);
-                if (componentRef.type == T::ComponentId)
-                {
-                    auto& resource = *std::launder(reinterpret_cast<CResource<T>*>(&componentRef.resource));
-                    if (resource.IsValid())
-                    {
-                        ComponentFactory::Destroy(resource);
-                    }
-                    components.erase(it);
-                    return;
-                }
+                this->components[position] = this->components[last];
+                this->SetSlot(this->GetComponentRecord(position).type, position);
             }
+            this->components.pop_back();
         }
 
         template<typename T>
         bool HasComponent() const
         {
-            return this->GetComponent<T>().IsValid();
+            return this->FindComponent(ComponentFactory::GetTypeIndex<T>()) != nullptr;
+        }
+
+        /*!
+        gets index of component in its factory pool
+        \param type component type index (see ComponentFactory::GetTypeIndex)
+        \returns component pool index or max value of size_t if there is no such component
+        */
+        size_t GetComponentHandle(size_t type) const
+        {
+            const Component* component = this->FindComponent(type);
+            return component != nullptr ? component->handle : std::numeric_limits<size_t>::max();
         }
 
         void RemoveAllComponents()
@@ -125,6 +237,7 @@ namespace MxEngine
                 componentRef.deleter(static_cast<void*>(&componentRef.resource));
             }
             components.clear();
+            slots.fill(EmptySlot);
         }
 
         ~ComponentManager()
@@ -0,0 +1,70 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "ComponentFactory.h"
+#include "Utilities/ECS/Component.h"
+
+namespace MxEngine
+{
+    void ComponentFactory::OnComponentAdded(size_t type, size_t object, const ComponentManager& components)
+    {
+        std::lock_guard lock(data->QueryMutex);
+        for (size_t queryId : data->QueriesByType[type])
+        {
+            auto& query = *data->Queries[queryId];
+            if (query.Contains(object)) continue;
+
+            MxVector<size_t> handles(query.Types.size());
+            bool isMatched = true;
+            for (size_t i = 0; i < query.Types.size() && isMatched; i++)
+            {
+                handles[i] = components.GetComponentHandle(query.Types[i]);
+                isMatched = handles[i] != std::numeric_limits<size_t>::max();
+            }
+            if (isMatched) query.AddEntry(object, handles.data());
+        }
+    }
+
+    void ComponentFactory::OnComponentRemoved(size_t type, size_t object)
+    {
+        std::lock_guard lock(data->QueryMutex);
+        for (size_t queryId : data->QueriesByType[type])
+        {
+            data->Queries[queryId]->RemoveEntry(object);
+        }
+    }
+
+    void ComponentFactory::OnObjectDestroyed(size_t object)
+    {
+        std::lock_guard lock(data->QueryMutex);
+        for (auto& query : data->Queries)
+        {
+            query->RemoveEntry(object);
+        }
+    }
+}
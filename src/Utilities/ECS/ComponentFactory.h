@@ -28,32 +28,145 @@
 
 #pragma once
 
+#include <mutex>
+#include <atomic>
+#include <array>
+#include <algorithm>
+
 #include "Utilities/STL/MxHashMap.h"
 #include "Utilities/String/String.h"
 #include "Utilities/AbstractFactory/AbstractFactory.h"
 #include "Utilities/ECS/ComponentView.h"
+#include "Utilities/ECS/ComponentQuery.h"
 
 namespace MxEngine
 {
+    class ComponentManager;
+
     class ComponentFactory
     {
-        static constexpr size_t FactorySize = sizeof(FactoryImpl<char>);
+        static constexpr size_t FactorySize = std::max(sizeof(FactoryImpl<char>), sizeof(PagedVectorPool<ManagedResource<char>>));
     public:
         using FactoryMap = MxHashMap<StringId, std::aligned_storage_t<FactorySize>>;
+        using TypeIndexMap = MxHashMap<StringId, size_t>;
+
+        /*!
+        max number of distinct component types which can be registered in application
+        */
+        constexpr static size_t MaxComponentTypes = 256;
+
+        struct FactoryData
+        {
+            FactoryMap Factories;
+            TypeIndexMap TypeIndices;
+            std::mutex TypeIndexMutex;
+            // factories indexed by component type index. Entries point into Factories map and never change once set
+            std::array<std::atomic<void*>, MaxComponentTypes> FactoryTable{ };
+            // query match lists and ids of queries which depend on each component type. Guarded by QueryMutex, as queries
+            // can be registered and components can be added from any thread. Match lists are not moved once created
+            std::mutex QueryMutex;
+            MxVector<UniqueRef<ComponentQueryData>> Queries;
+            std::array<MxVector<size_t>, MaxComponentTypes> QueriesByType;
+        };
     private:
-        inline static FactoryMap* factories = nullptr;
-    public:
+        inline static FactoryData* data = nullptr;
+
         template<typename T>
-        static FactoryImpl<T>& GetFactory()
+        static FactoryImpl<T>& CreateFactory(size_t typeIndex)
         {
-            if (factories->find(T::ComponentId) == factories->end())
+            static_assert(sizeof(FactoryImpl<T>) <= FactorySize, "factory storage must fit pool size");
+            std::lock_guard lock(data->TypeIndexMutex);
+            auto& factories = data->Factories;
+            if (factories.find(T::ComponentId) == factories.end())
             {
-                new (&(*factories)[T::ComponentId]) FactoryImpl<T>();
+                new (&factories[T::ComponentId]) FactoryImpl<T>();
             }
-            auto factory = std::launder(reinterpret_cast<FactoryImpl<T>*>(&(*factories)[T::ComponentId]));
+            auto factory = std::launder(reinterpret_cast<FactoryImpl<T>*>(&factories[T::ComponentId]));
+            data->FactoryTable[typeIndex].store(static_cast<void*>(factory), std::memory_order_release);
             return *factory;
         }
 
+        template<typename T>
+        static void CollectComponentOwners(MxHashMap<size_t, size_t>& owners)
+        {
+            auto& pool = Get<T>();
+            for (auto it = pool.begin(); it != pool.end(); it++)
+            {
+                auto object = reinterpret_cast<size_t>(it->value.UserData);
+                if (object != std::numeric_limits<size_t>::max())
+                    owners[object] = it.GetBase();
+            }
+        }
+
+        template<typename... Ts>
+        static const ComponentQueryData* RegisterQuery()
+        {
+            MxVector<size_t> types{ GetTypeIndex<Ts>()... };
+            std::lock_guard lock(data->QueryMutex);
+            for (const auto& query : data->Queries)
+            {
+                if (query->Types == types) return query.get();
+            }
+
+            // fill match list with objects which already exist
+            MxHashMap<size_t, size_t> owners[sizeof...(Ts)];
+            size_t ownerIndex = 0;
+            (CollectComponentOwners<Ts>(owners[ownerIndex++]), ...);
+
+            auto query = MakeUnique<ComponentQueryData>();
+            query->Types = types;
+            size_t handles[sizeof...(Ts)];
+            for (const auto& [object, handle] : owners[0])
+            {
+                bool isMatched = true;
+                handles[0] = handle;
+                for (size_t i = 1; i < sizeof...(Ts) && isMatched; i++)
+                {
+                    auto it = owners[i].find(object);
+                    isMatched = it != owners[i].end();
+                    if (isMatched) handles[i] = it->second;
+                }
+                if (isMatched) query->AddEntry(object, handles);
+            }
+
+            size_t queryId = data->Queries.size();
+            for (size_t type : types)
+                data->QueriesByType[type].push_back(queryId);
+            data->Queries.push_back(std::move(query));
+            return data->Queries.back().get();
+        }
+
+        static size_t RegisterTypeIndex(StringId componentId)
+        {
+            std::lock_guard lock(data->TypeIndexMutex);
+            auto it = data->TypeIndices.find(componentId);
+            if (it == data->TypeIndices.end())
+                it = data->TypeIndices.insert({ componentId, data->TypeIndices.size() }).first;
+            MX_ASSERT(it->second < MaxComponentTypes);
+            return it->second;
+        }
+    public:
+        /*!
+        gets dense index of component type. Indices are assigned in order of first request and shared between all modules
+        \returns index of component type in range [0, registered component type count)
+        */
+        template<typename T>
+        static size_t GetTypeIndex()
+        {
+            static const size_t index = RegisterTypeIndex(T::ComponentId);
+            return index;
+        }
+
+        template<typename T>
+        static FactoryImpl<T>& GetFactory()
+        {
+            size_t typeIndex = GetTypeIndex<T>();
+            void* factory = data->FactoryTable[typeIndex].load(std::memory_order_acquire);
+            if (factory == nullptr)
+                return CreateFactory<T>(typeIndex);
+            return *static_cast<FactoryImpl<T>*>(factory);
+        }
+
         template<typename T>
         static auto& Get()
         {
@@ -63,9 +176,27 @@ namespace MxEngine
         template<typename T>
         static ComponentView<T> GetView()
         {
-            return ComponentView{ Get<T>() };
+            return ComponentView<T>{ Get<T>() };
+        }
+
+        /*!
+        creates view over all objects which have each of Ts components. Match list is created on first call and then
+        updated by MxObject when components are added or removed, so iteration does not perform any per-object lookups.
+        Query can be created from any thread, but view must not be iterated while components of Ts types are added or removed
+        \returns view of query matches
+        */
+        template<typename... Ts>
+        static ComponentQueryView<ComponentFactory, Ts...> Query()
+        {
+            static_assert(sizeof...(Ts) > 0, "query must contain at least one component type");
+            static const ComponentQueryData* query = RegisterQuery<Ts...>();
+            return ComponentQueryView<ComponentFactory, Ts...>{ *query };
         }
 
+        static void OnComponentAdded(size_t type, size_t object, const ComponentManager& components);
+        static void OnComponentRemoved(size_t type, size_t object);
+        static void OnObjectDestroyed(size_t object);
+
         template<typename T, typename... Args>
         static auto CreateComponent(Args&&... args)
         {
@@ -83,20 +214,23 @@ namespace MxEngine
 
         static void Init()
         {
-            factories = new FactoryMap(); // static data, so dont care about freeing
+            data = new FactoryData(); // static data, so dont care about freeing
         }
 
-        static FactoryMap* GetImpl()
+        static FactoryData* GetImpl()
         {
-            return factories;
+            return data;
         }
 
-        static void Clone(FactoryMap* other)
+        static void Clone(FactoryData* other)
         {
-            factories = other;
+            data = other;
         }
     };
 
     template<typename T>
     using CResource = Resource<T, ComponentFactory>;
+
+    template<typename T>
+    using CBorrowedResource = BorrowedResource<T, ComponentFactory>;
 }
\ No newline at end of file
@@ -0,0 +1,206 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <algorithm>
+#include <type_traits>
+
+#include "Utilities/STL/MxVector.h"
+#include "Utilities/STL/MxHashMap.h"
+
+namespace MxEngine
+{
+    /*!
+    match list of component query. For each object which has all queried components, stores object handle followed by
+    handles of its components in query order. List is updated incrementally when components are added to or removed from objects
+    */
+    struct ComponentQueryData
+    {
+        MxVector<size_t> Types;
+        MxVector<size_t> Entries;
+        MxHashMap<size_t, size_t> Positions;
+
+        size_t GetStride() const
+        {
+            return this->Types.size() + 1;
+        }
+
+        size_t GetCount() const
+        {
+            return this->Entries.size() / this->GetStride();
+        }
+
+        bool Contains(size_t object) const
+        {
+            return this->Positions.find(object) != this->Positions.end();
+        }
+
+        void AddEntry(size_t object, const size_t* componentHandles)
+        {
+            this->Positions[object] = this->Entries.size();
+            this->Entries.push_back(object);
+            this->Entries.insert(this->Entries.end(), componentHandles, componentHandles + this->Types.size());
+        }
+
+        void RemoveEntry(size_t object)
+        {
+            auto it = this->Positions.find(object);
+            if (it == this->Positions.end()) return;
+
+            size_t position = it->second;
+            size_t stride = this->GetStride();
+            size_t last = this->Entries.size() - stride;
+            if (position != last)
+            {
+                // move last entry in place of removed one to keep list dense
+                std::copy(this->Entries.begin() + last, this->Entries.end(), this->Entries.begin() + position);
+                this->Positions[this->Entries[position]] = position;
+            }
+            this->Entries.resize(last);
+            this->Positions.erase(object);
+        }
+    };
+
+    template<typename T, typename... Ts>
+    struct type_list_index;
+
+    template<typename T, typename... Ts>
+    struct type_list_index<T, T, Ts...> : std::integral_constant<size_t, 0> { };
+
+    template<typename T, typename U, typename... Ts>
+    struct type_list_index<T, U, Ts...> : std::integral_constant<size_t, 1 + type_list_index<T, Ts...>::value> { };
+
+    /*!
+    component query view is a wrapper around query match list, which allows to iterate over objects which have all Ts components
+    it does not perform any component lookups, as component handles are stored in match list. View must not be used while
+    components are added to or removed from objects, as match list can be changed
+    */
+    template<typename Factory, typename... Ts>
+    class ComponentQueryView
+    {
+        const ComponentQueryData& query;
+    public:
+        /*!
+        single query match. Provides access to object handle and its queried components
+        */
+        class Entry
+        {
+            const size_t* data;
+        public:
+            explicit Entry(const size_t* data) : data(data) { }
+
+            /*!
+            getter for engine handle of object which owns matched components
+            \returns object handle, which can be passed to MxObject::GetByHandle()
+            */
+            size_t GetObjectHandle() const
+            {
+                return this->data[0];
+            }
+
+            /*!
+            gets component of matched object
+            \returns reference to component of type T
+            */
+            template<typename T>
+            T& Get() const
+            {
+                constexpr size_t index = type_list_index<T, Ts...>::value;
+                return Factory::template Get<T>()[this->data[index + 1]].value;
+            }
+        };
+
+        class Iterator
+        {
+            const size_t* ptr;
+            size_t stride;
+        public:
+            Iterator(const size_t* ptr, size_t stride) : ptr(ptr), stride(stride) { }
+
+            Iterator& operator++()
+            {
+                this->ptr += this->stride;
+                return *this;
+            }
+
+            Iterator operator++(int)
+            {
+                Iterator copy = *this;
+                ++(*this);
+                return copy;
+            }
+
+            Entry operator*() const
+            {
+                return Entry{ this->ptr };
+            }
+
+            bool operator==(const Iterator& other) const
+            {
+                return this->ptr == other.ptr;
+            }
+
+            bool operator!=(const Iterator& other) const
+            {
+                return !(*this == other);
+            }
+        };
+
+        explicit ComponentQueryView(const ComponentQueryData& query) : query(query) { }
+
+        /*!
+        gets number of objects which match the query
+        \returns match count
+        */
+        size_t size() const
+        {
+            return this->query.GetCount();
+        }
+
+        /*!
+        gets query match by its index. Can be used to split view between job system workers
+        \param index index of match in range [0, size())
+        \returns query match
+        */
+        Entry operator[](size_t index) const
+        {
+            return Entry{ this->query.Entries.data() + index * this->query.GetStride() };
+        }
+
+        Iterator begin() const
+        {
+            return Iterator{ this->query.Entries.data(), this->query.GetStride() };
+        }
+
+        Iterator end() const
+        {
+            return Iterator{ this->query.Entries.data() + this->query.Entries.size(), this->query.GetStride() };
+        }
+    };
+}
@@ -29,6 +29,10 @@
 #include "ApplicationEditor.h"
 #include "Utilities/ImGui/ImGuiUtils.h"
 #include "Core/Config/GlobalConfig.h"
+#include "Core/Application/Rendering.h"
+#include "Core/Rendering/RenderAdaptor.h"
+#include "Core/Resources/GeometryArena.h"
+#include "Platform/RenderStateCache.h"
 
 namespace MxEngine::GUI
 {
@@ -46,6 +50,37 @@ namespace MxEngine::GUI
         ImGui::Text("current FPS: %d | total elapsed time: %f seconds", (int)Time::FPS(), Time::Current());
         ImGui::Text("time delta: %fms | frame interval: %fms", Time::Delta() * 1000.0f, Time::UnscaledDelta() * 1000.0f);
 
+        const auto& shadowStatistics = Rendering::GetController().GetShadowMapStatistics();
+        ImGui::Text("shadow casters drawn: %d | culled: %d", (int)shadowStatistics.DrawnCasters, (int)shadowStatistics.CulledCasters());
+        ImGui::Text("shadow cube faces rendered: %d | skipped: %d", (int)shadowStatistics.RenderedCubeFaces, (int)shadowStatistics.SkippedCubeFaces);
+        ImGui::Text("shadow maps refreshed: %d | cached: %d | throttled: %d", 
+            (int)shadowStatistics.RefreshedShadowMaps, (int)shadowStatistics.CachedShadowMaps, (int)shadowStatistics.ThrottledShadowMaps);
+
+        const auto& occlusionStatistics = Rendering::GetController().GetOcclusionStatistics();
+        ImGui::Text("occlusion culled: %.1f%% (%d of %d units) | occluder triangles: %d", occlusionStatistics.GetOccludedPercentage(),
+            (int)occlusionStatistics.OccludedBoxes, (int)occlusionStatistics.TestedBoxes, (int)occlusionStatistics.RasterizedTriangles);
+
+        const auto& instancingStatistics = Rendering::GetController().GetInstancingStatistics();
+        ImGui::Text("instanced units: %d of %d | instanced draws: %d | total draws: %d", (int)instancingStatistics.InstancedCommands, 
+            (int)instancingStatistics.SubmittedCommands, (int)instancingStatistics.InstancedBatches, (int)instancingStatistics.GetDrawCalls());
+
+        const auto& staticBatchStatistics = Rendering::GetAdaptor().StaticBatcher.GetStatistics();
+        ImGui::Text("static batches: %d from %d submeshes | rebuilds: %d", (int)staticBatchStatistics.Batches,
+            (int)staticBatchStatistics.MergedSources, (int)staticBatchStatistics.Rebuilds);
+
+        auto arenaStatistics = GeometryArena::GetStatistics();
+        ImGui::Text("geometry arena: %d meshes | vertecies: %d / %d | indicies: %d / %d", (int)arenaStatistics.Allocations,
+            (int)arenaStatistics.UsedVertecies, (int)arenaStatistics.VertexCapacity, (int)arenaStatistics.UsedIndicies, (int)arenaStatistics.IndexCapacity);
+        ImGui::Text("arena fragmentation: %.1f%% / %.1f%% | reallocations: %d", 100.0f * arenaStatistics.VertexFragmentation,
+            100.0f * arenaStatistics.IndexFragmentation, (int)arenaStatistics.Reallocations);
+        ImGui::SameLine();
+        if (ImGui::Button("defragment"))
+            GeometryArena::Defragment();
+
+        const auto& stateStatistics = RenderStateCache::GetLastFrameStatistics();
+        ImGui::Text("state calls issued: %d | skipped: %d (%.1f%%)", 
+            (int)stateStatistics.IssuedCalls, (int)stateStatistics.SkippedCalls, stateStatistics.GetSkippedPercentage());
+
         ImGui::End();
     }
 }
\ No newline at end of file
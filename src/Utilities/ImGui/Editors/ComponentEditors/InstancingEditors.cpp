@@ -42,6 +42,7 @@ namespace MxEngine::GUI
 		REMOVE_COMPONENT_BUTTON(instanceFactory);
 
 		ImGui::Text("instance count: %d", (int)instanceFactory.GetCount());
+		ImGui::Text("lightweight instance count: %d", (int)instanceFactory.GetInstanceStorage().GetCount());
 
 		ImGui::SameLine();
 		if (ImGui::Button("instanciate"))
@@ -51,6 +52,8 @@ namespace MxEngine::GUI
 			instanceFactory.DestroyInstances();
 		ImGui::SameLine();
 		ImGui::Checkbox("is static", &instanceFactory.IsStatic);
+		ImGui::SameLine();
+		ImGui::Checkbox("frustrum culling", &instanceFactory.UseFrustrumCulling);
 
 		int id = 0;
 		auto self = MxObject::GetComponentHandle(instanceFactory);
@@ -80,6 +80,9 @@ namespace MxEngine::GUI
 		TREE_NODE_PUSH("MeshRenderer");
 		REMOVE_COMPONENT_BUTTON(meshRenderer);
 
+		ImGui::Checkbox("is occluder", &meshRenderer.IsOccluder);
+		ImGui::Checkbox("is static", &meshRenderer.IsStatic);
+
 		if (ImGui::Button("load from file"))
 		{
 			MxString path = FileManager::OpenFileDialog();
@@ -353,6 +353,10 @@ namespace MxEngine::GUI
         base.AmbientColor  = VectorMax(MakeVector3(0.0f), base.AmbientColor );
         base.DiffuseColor  = VectorMax(MakeVector3(0.0f), base.DiffuseColor );
         base.SpecularColor = VectorMax(MakeVector3(0.0f), base.SpecularColor);
+
+        int shadowUpdateInterval = (int)base.ShadowUpdateInterval;
+        if (ImGui::DragInt("shadow update interval", &shadowUpdateInterval, 0.1f, 1, 60))
+            base.ShadowUpdateInterval = (size_t)Max(shadowUpdateInterval, 1);
     }
 
     void DrawVertexEditor(Vertex& vertex)
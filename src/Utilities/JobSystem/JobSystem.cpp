@@ -0,0 +1,314 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "JobSystem.h"
+#include "Core/Macro/Macro.h"
+#include "Utilities/Memory/Memory.h"
+#include "Utilities/Logging/Logger.h"
+#include "Utilities/STL/MxVector.h"
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <array>
+
+namespace MxEngine
+{
+    struct Job
+    {
+        JobSystem::JobFunction Function;
+        JobCounter* Counter = nullptr;
+    };
+
+    // fixed-size Chase-Lev deque. Only owner thread may Push/Pop, any thread may Steal
+    class WorkStealingQueue
+    {
+        constexpr static int64_t Capacity = 4096;
+        constexpr static int64_t Mask = Capacity - 1;
+        static_assert((Capacity & Mask) == 0, "capacity must be power of two");
+
+        alignas(64) std::atomic<int64_t> top{ 0 };
+        alignas(64) std::atomic<int64_t> bottom{ 0 };
+        std::array<std::atomic<Job*>, Capacity> jobs;
+    public:
+        bool Push(Job* job)
+        {
+            int64_t b = this->bottom.load(std::memory_order_relaxed);
+            int64_t t = this->top.load(std::memory_order_acquire);
+            if (b - t >= Capacity) return false;
+
+            this->jobs[b & Mask].store(job, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            this->bottom.store(b + 1, std::memory_order_relaxed);
+            return true;
+        }
+
+        Job* Pop()
+        {
+            int64_t b = this->bottom.load(std::memory_order_relaxed) - 1;
+            this->bottom.store(b, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            int64_t t = this->top.load(std::memory_order_relaxed);
+
+            if (t > b)
+            {
+                this->bottom.store(b + 1, std::memory_order_relaxed);
+                return nullptr;
+            }
+
+            Job* job = this->jobs[b & Mask].load(std::memory_order_relaxed);
+            if (t == b) // last element, race against stealers
+            {
+                if (!this->top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                    job = nullptr;
+                this->bottom.store(b + 1, std::memory_order_relaxed);
+            }
+            return job;
+        }
+
+        Job* Steal()
+        {
+            int64_t t = this->top.load(std::memory_order_acquire);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            int64_t b = this->bottom.load(std::memory_order_acquire);
+
+            if (t >= b) return nullptr;
+
+            Job* job = this->jobs[t & Mask].load(std::memory_order_relaxed);
+            if (!this->top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                return nullptr;
+            return job;
+        }
+    };
+
+    struct JobSystemData
+    {
+        MxVector<UniqueRef<WorkStealingQueue>> Queues;
+        MxVector<std::thread> Workers;
+
+        // jobs scheduled from threads which are not owned by job system
+        std::mutex ExternalMutex;
+        MxVector<Job*> ExternalJobs;
+        std::atomic<size_t> ExternalJobCount{ 0 };
+
+        std::mutex SleepMutex;
+        std::condition_variable SleepCondition;
+        std::atomic<size_t> PendingJobs{ 0 };
+        std::atomic<bool> IsRunning{ false };
+
+        static void ReleaseCounter(JobCounter& counter)
+        {
+            counter.value.fetch_sub(1, std::memory_order_acq_rel);
+        }
+    };
+
+    // index of current thread in job system. Threads not owned by job system have invalid index
+    static thread_local size_t ThreadIndex = std::numeric_limits<size_t>::max();
+
+    static Job* FetchJob(JobSystemData& data)
+    {
+        size_t threadCount = data.Queues.size();
+        size_t index = ThreadIndex;
+        if (index < threadCount)
+        {
+            if (Job* job = data.Queues[index]->Pop(); job != nullptr) return job;
+        }
+        else index = 0;
+
+        for (size_t i = 1; i <= threadCount; i++)
+        {
+            size_t victim = (index + i) % threadCount;
+            if (victim == ThreadIndex) continue;
+            if (Job* job = data.Queues[victim]->Steal(); job != nullptr) return job;
+        }
+
+        if (data.ExternalJobCount.load(std::memory_order_acquire) > 0)
+        {
+            std::lock_guard lock(data.ExternalMutex);
+            if (!data.ExternalJobs.empty())
+            {
+                Job* job = data.ExternalJobs.back();
+                data.ExternalJobs.pop_back();
+                data.ExternalJobCount.fetch_sub(1, std::memory_order_release);
+                return job;
+            }
+        }
+        return nullptr;
+    }
+
+    static void ExecuteJob(JobSystemData& data, Job* job)
+    {
+        data.PendingJobs.fetch_sub(1, std::memory_order_relaxed);
+        job->Function();
+        if (job->Counter != nullptr)
+            JobSystemData::ReleaseCounter(*job->Counter);
+        Free(job);
+    }
+
+    static void WorkerLoop(JobSystemData* data, size_t index)
+    {
+        ThreadIndex = index;
+        while (data->IsRunning.load(std::memory_order_acquire))
+        {
+            if (Job* job = FetchJob(*data); job != nullptr)
+            {
+                ExecuteJob(*data, job);
+                continue;
+            }
+
+            std::unique_lock lock(data->SleepMutex);
+            data->SleepCondition.wait(lock, [data]()
+            {
+                return data->PendingJobs.load(std::memory_order_relaxed) > 0 || !data->IsRunning.load(std::memory_order_relaxed);
+            });
+        }
+    }
+
+    void JobSystem::Init(size_t workerCount)
+    {
+        if (workerCount == 0)
+        {
+            size_t hardwareThreads = (size_t)std::thread::hardware_concurrency();
+            workerCount = hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+        }
+
+        data = Alloc<JobSystemData>();
+        data->IsRunning = true;
+        for (size_t i = 0; i < workerCount + 1; i++)
+            data->Queues.push_back(MakeUnique<WorkStealingQueue>());
+
+        ThreadIndex = 0;
+        for (size_t i = 1; i < workerCount + 1; i++)
+            data->Workers.emplace_back(WorkerLoop, data, i);
+
+        MXLOG_INFO("MxEngine::JobSystem", "started job system with worker count: " + ToMxString(workerCount));
+    }
+
+    void JobSystem::Destroy()
+    {
+        if (data == nullptr) return;
+
+        {
+            std::lock_guard lock(data->SleepMutex);
+            data->IsRunning = false;
+        }
+        data->SleepCondition.notify_all();
+        for (auto& worker : data->Workers)
+            worker.join();
+
+        while (Job* job = FetchJob(*data)) Free(job);
+
+        Free(data);
+        data = nullptr;
+    }
+
+    JobSystemData* JobSystem::GetImpl()
+    {
+        return data;
+    }
+
+    void JobSystem::Clone(JobSystemData* other)
+    {
+        data = other;
+    }
+
+    size_t JobSystem::GetThreadCount()
+    {
+        return data != nullptr ? data->Queues.size() : 1;
+    }
+
+    size_t JobSystem::GetThreadIndex()
+    {
+        return Min(ThreadIndex, JobSystem::GetThreadCount());
+    }
+
+    void JobSystem::Push(JobFunction&& function, JobCounter* counter)
+    {
+        if (data == nullptr)
+        {
+            // no workers to execute job, so it is done before Push() returns and counter never changes
+            function();
+            return;
+        }
+
+        if (counter != nullptr)
+            counter->value.fetch_add(1, std::memory_order_relaxed);
+
+        Job* job = Alloc<Job>();
+        job->Function = std::move(function);
+        job->Counter = counter;
+
+        data->PendingJobs.fetch_add(1, std::memory_order_relaxed);
+        size_t index = ThreadIndex;
+        if (index >= data->Queues.size() || !data->Queues[index]->Push(job))
+        {
+            std::lock_guard lock(data->ExternalMutex);
+            data->ExternalJobs.push_back(job);
+            data->ExternalJobCount.fetch_add(1, std::memory_order_release);
+        }
+
+        // empty critical section guarantees that sleeping worker will not miss notification
+        { std::lock_guard lock(data->SleepMutex); }
+        data->SleepCondition.notify_one();
+    }
+
+    void JobSystem::Schedule(JobFunction function, JobCounter* counter)
+    {
+        JobSystem::Push(std::move(function), counter);
+    }
+
+    void JobSystem::Schedule(JobFunction function, JobCounterHandle dependency, JobCounter* counter)
+    {
+        MX_ASSERT(dependency != nullptr);
+        if (dependency->IsDone())
+        {
+            JobSystem::Push(std::move(function), counter);
+            return;
+        }
+        // waiting job helps to execute other jobs, so dependencies are never starved even with single thread
+        JobSystem::Push([f = std::move(function), dependency = std::move(dependency)]() { JobSystem::Wait(*dependency); f(); }, counter);
+    }
+
+    void JobSystem::Wait(const JobCounter& counter)
+    {
+        // without workers all jobs are executed inline, so nothing can be pending
+        if (data == nullptr)
+        {
+            MX_ASSERT(counter.IsDone());
+            return;
+        }
+
+        while (!counter.IsDone())
+        {
+            if (Job* job = FetchJob(*data); job != nullptr)
+                ExecuteJob(*data, job);
+            else
+                std::this_thread::yield();
+        }
+    }
+}
@@ -0,0 +1,160 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <atomic>
+#include <functional>
+
+#include "Utilities/Math/Math.h"
+#include "Utilities/Memory/Memory.h"
+
+namespace MxEngine
+{
+    class JobCounter;
+    struct JobSystemData;
+
+    /*!
+    shared job counter, which can be passed as dependency to jobs which may outlive the scope where it was created
+    */
+    using JobCounterHandle = Ref<JobCounter>;
+
+    /*!
+    job counter is a synchronization primitive for JobSystem. Each scheduled job increments counter and decrements it when finished
+    counter is considered done when its value reaches zero. Counters must outlive all jobs which reference them
+    */
+    class JobCounter
+    {
+        std::atomic<size_t> value{ 0 };
+
+        friend class JobSystem;
+        friend struct JobSystemData;
+    public:
+        JobCounter() = default;
+        JobCounter(const JobCounter&) = delete;
+        JobCounter& operator=(const JobCounter&) = delete;
+
+        /*!
+        checks if all jobs attached to counter are finished
+        \returns true if counter value is zero, false either
+        */
+        bool IsDone() const { return this->value.load(std::memory_order_acquire) == 0; }
+        /*!
+        getter for number of unfinished jobs
+        \returns current counter value
+        */
+        size_t Get() const { return this->value.load(std::memory_order_acquire); }
+    };
+
+    /*!
+    job system is a global thread pool with a fixed number of workers. Each worker (including main thread) owns a work-stealing deque:
+    jobs are pushed and popped from its bottom by the owner, while idle workers steal from the top of other deques
+    jobs are grouped by JobCounter objects, which can be waited on or used as dependencies for other jobs
+    if job system is not initialized, all jobs are executed inline on the calling thread
+    */
+    class JobSystem
+    {
+    public:
+        using JobFunction = std::function<void()>;
+    private:
+        inline static JobSystemData* data = nullptr;
+
+        static void Push(JobFunction&& function, JobCounter* counter);
+    public:
+        /*!
+        creates worker pool. Main thread is always registered as worker with index 0
+        \param workerCount number of additional worker threads. If zero, hardware concurrency - 1 is used
+        */
+        static void Init(size_t workerCount = 0);
+        /*!
+        stops and joins all worker threads. Unfinished jobs are discarded
+        */
+        static void Destroy();
+        static JobSystemData* GetImpl();
+        static void Clone(JobSystemData* other);
+
+        /*!
+        getter for total number of threads which execute jobs
+        \returns worker thread count + 1 (main thread), or 1 if job system is not initialized
+        */
+        static size_t GetThreadCount();
+        /*!
+        getter for index of current thread inside job system. Can be used to access per-thread buffers
+        \returns index in range [0, GetThreadCount()), or GetThreadCount() if thread is not owned by job system
+        */
+        static size_t GetThreadIndex();
+
+        /*!
+        schedules job for execution. Job may start immediately on another worker
+        \param function job to execute
+        \param counter optional counter which is incremented now and decremented when job is finished
+        */
+        static void Schedule(JobFunction function, JobCounter* counter = nullptr);
+        /*!
+        schedules job which will start only after all jobs of dependency counter are finished
+        \param function job to execute
+        \param dependency shared counter which must be done before job starts. Job keeps its own copy of handle, so counter stays alive until job is finished
+        \param counter optional counter which is incremented now and decremented when job is finished
+        */
+        static void Schedule(JobFunction function, JobCounterHandle dependency, JobCounter* counter = nullptr);
+        /*!
+        blocks until counter is done. Calling thread executes pending jobs while waiting
+        \param counter counter to wait for
+        */
+        static void Wait(const JobCounter& counter);
+
+        /*!
+        splits range [0, count) into batches and executes them on all workers. Blocks until whole range is processed
+        \param count number of elements in range
+        \param batchSize number of elements processed by one job. If zero, range is split evenly between threads
+        \param func functor with signature void(size_t begin, size_t end), called once per batch
+        */
+        template<typename F>
+        static void ParallelFor(size_t count, size_t batchSize, F&& func)
+        {
+            if (count == 0) return;
+            if (batchSize == 0)
+                batchSize = Max((count + JobSystem::GetThreadCount() - 1) / JobSystem::GetThreadCount(), (size_t)1);
+
+            if (batchSize >= count || JobSystem::GetThreadCount() == 1)
+            {
+                func(size_t(0), count);
+                return;
+            }
+
+            JobCounter counter;
+            for (size_t begin = batchSize; begin < count; begin += batchSize)
+            {
+                size_t end = Min(begin + batchSize, count);
+                JobSystem::Schedule([&func, begin, end]() { func(begin, end); }, &counter);
+            }
+            func(size_t(0), batchSize); // first batch is always processed by the calling thread
+            JobSystem::Wait(counter);
+        }
+    };
+}
@@ -35,6 +35,8 @@
 #include <cmath>
 #include <array>
 #include <algorithm>
+#include <cstdint>
+#include <cstring>
 
 namespace MxEngine
 {
@@ -171,6 +173,12 @@ namespace MxEngine
 		return glm::length2(value);
 	}
 
+	template<typename T>
+	inline T Abs(const T& value)
+	{
+		return glm::abs(value);
+	}
+
 	inline Matrix4x4 Translate(const Matrix4x4& mat, const Vector3& vec)
 	{
 		return glm::translate(mat, vec);
@@ -196,6 +204,11 @@ namespace MxEngine
 		return glm::toMat4(q);
 	}
 
+	inline Quaternion ToQuaternion(const Matrix3x3& rotation)
+	{
+		return glm::quat_cast(rotation);
+	}
+
 	inline Quaternion MakeQuaternion(float angle, const Vector3& axis)
 	{
 		return glm::angleAxis(angle, axis);
@@ -700,4 +713,33 @@ namespace MxEngine
 		}
 		return ret;
 	}
+
+	/*!
+	mixes value into running hash
+	\param seed hash of previously mixed values
+	\param value value to mix
+	\returns combined hash
+	*/
+	inline constexpr uint64_t HashCombine(uint64_t seed, uint64_t value)
+	{
+		return seed ^ (value + 0x9E3779B97F4A7C15ull + (seed << 6) + (seed >> 2));
+	}
+
+	/*!
+	mixes bit patterns of floats into running hash, so any change of values changes result
+	\param seed hash of previously mixed values
+	\param data pointer to an array of floats
+	\param count number of floats to mix
+	\returns combined hash
+	*/
+	inline uint64_t HashFloats(uint64_t seed, const float* data, size_t count)
+	{
+		for (size_t i = 0; i < count; i++)
+		{
+			uint32_t bits = 0;
+			std::memcpy(&bits, data + i, sizeof(bits));
+			seed = HashCombine(seed, bits);
+		}
+		return seed;
+	}
 }
\ No newline at end of file
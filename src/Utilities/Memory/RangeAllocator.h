@@ -0,0 +1,286 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+
+#include "Core/Macro/Macro.h"
+#include "Utilities/STL/MxVector.h"
+
+namespace MxEngine
+{
+    /*
+    RangeAllocator class
+    manages offsets inside of linear storage of fixed capacity, do NOT touch storage by itself, so it can be used for GPU buffers
+    allocates ranges of any size, each can be freed in any order. Free ranges are kept sorted and merged with neighbours on free,
+    allocation picks smallest free range which fits requested size. Storage can be compacted by Defragment(), which
+    returns list of moves the owner must perform on its storage
+    */
+    class RangeAllocator
+    {
+    public:
+        /*!
+        continuous range of storage elements
+        */
+        struct Range
+        {
+            size_t Offset;
+            size_t Size;
+        };
+
+        /*!
+        move of allocated range performed by defragmentation. Destination never lies after source
+        */
+        struct Relocation
+        {
+            size_t From;
+            size_t To;
+            size_t Size;
+        };
+
+        static constexpr size_t InvalidOffset = std::numeric_limits<size_t>::max();
+    private:
+        /*!
+        free ranges sorted by offset. Two free ranges are never adjacent, as they are merged on insertion
+        */
+        MxVector<Range> freeRanges;
+        /*!
+        allocated ranges sorted by offset
+        */
+        MxVector<Range> allocations;
+        /*!
+        total number of elements managed by allocator
+        */
+        size_t capacity = 0;
+        /*!
+        number of elements in allocated ranges
+        */
+        size_t usedSize = 0;
+
+        /*!
+        binary search of first range which offset is not less than offset provided
+        \param ranges ranges sorted by offset
+        \param offset offset to search for
+        \returns index of range or ranges size if there is no such range
+        */
+        static size_t LowerBound(const MxVector<Range>& ranges, size_t offset)
+        {
+            size_t begin = 0, end = ranges.size();
+            while (begin < end)
+            {
+                size_t middle = begin + (end - begin) / 2;
+                if (ranges[middle].Offset < offset)
+                    begin = middle + 1;
+                else
+                    end = middle;
+            }
+            return begin;
+        }
+
+        /*!
+        returns range to the free list, merging it with adjacent free ranges
+        \param offset begin of range
+        \param size number of elements in range
+        */
+        void InsertFreeRange(size_t offset, size_t size)
+        {
+            size_t index = LowerBound(this->freeRanges, offset);
+            bool mergesPrevious = index > 0 && this->freeRanges[index - 1].Offset + this->freeRanges[index - 1].Size == offset;
+            bool mergesNext = index < this->freeRanges.size() && offset + size == this->freeRanges[index].Offset;
+
+            if (mergesPrevious && mergesNext)
+            {
+                this->freeRanges[index - 1].Size += size + this->freeRanges[index].Size;
+                this->freeRanges.erase(this->freeRanges.begin() + index);
+            }
+            else if (mergesPrevious)
+            {
+                this->freeRanges[index - 1].Size += size;
+            }
+            else if (mergesNext)
+            {
+                this->freeRanges[index].Offset = offset;
+                this->freeRanges[index].Size += size;
+            }
+            else
+            {
+                this->freeRanges.insert(this->freeRanges.begin() + index, Range{ offset, size });
+            }
+        }
+    public:
+        /*!
+        creates empty range allocator with zero capacity
+        */
+        RangeAllocator() = default;
+
+        /*!
+        creates range allocator which manages storage of capacity provided
+        \param capacity number of elements in storage
+        */
+        explicit RangeAllocator(size_t capacity)
+        {
+            this->Init(capacity);
+        }
+
+        /*!
+        resets allocator to manage storage of capacity provided. All previous allocations are discarded
+        \param capacity number of elements in storage
+        */
+        void Init(size_t capacity)
+        {
+            this->freeRanges.clear();
+            this->allocations.clear();
+            this->capacity = capacity;
+            this->usedSize = 0;
+            if (capacity > 0) this->freeRanges.push_back(Range{ 0, capacity });
+        }
+
+        /*!
+        extends storage capacity. Existing allocations keep their offsets
+        \param capacity new number of elements in storage, must be not less than current one
+        */
+        void Grow(size_t capacity)
+        {
+            MX_ASSERT(capacity >= this->capacity);
+            size_t oldCapacity = this->capacity;
+            this->capacity = capacity;
+            if (capacity > oldCapacity) this->InsertFreeRange(oldCapacity, capacity - oldCapacity);
+        }
+
+        /*!
+        allocates continuous range of storage, using the smallest free range which is large enough
+        \param size number of elements to allocate, must be non-zero
+        \returns offset of allocated range or InvalidOffset if there is no free range of such size
+        */
+        [[nodiscard]] size_t Allocate(size_t size)
+        {
+            MX_ASSERT(size > 0);
+            size_t bestIndex = this->freeRanges.size();
+            for (size_t i = 0; i < this->freeRanges.size(); i++)
+            {
+                const auto& range = this->freeRanges[i];
+                if (range.Size < size) continue;
+                if (bestIndex == this->freeRanges.size() || range.Size < this->freeRanges[bestIndex].Size)
+                    bestIndex = i;
+                if (range.Size == size) break; // exact fit cannot be improved
+            }
+            if (bestIndex == this->freeRanges.size()) return InvalidOffset;
+
+            auto& range = this->freeRanges[bestIndex];
+            size_t offset = range.Offset;
+            range.Offset += size;
+            range.Size -= size;
+            if (range.Size == 0) this->freeRanges.erase(this->freeRanges.begin() + bestIndex);
+
+            size_t index = LowerBound(this->allocations, offset);
+            this->allocations.insert(this->allocations.begin() + index, Range{ offset, size });
+            this->usedSize += size;
+            return offset;
+        }
+
+        /*!
+        frees range allocated by Allocate()
+        \param offset offset returned by Allocate()
+        */
+        void Free(size_t offset)
+        {
+            size_t index = LowerBound(this->allocations, offset);
+            MX_ASSERT(index < this->allocations.size() && this->allocations[index].Offset == offset);
+
+            size_t size = this->allocations[index].Size;
+            this->allocations.erase(this->allocations.begin() + index);
+            this->usedSize -= size;
+            this->InsertFreeRange(offset, size);
+        }
+
+        /*!
+        moves all allocations to the begin of storage, leaving one free range at its end. Allocation order is preserved
+        \param relocations list which is filled with performed moves in order of increasing offset. Moves may overlap,
+        so storage must be copied in the order provided, or into separate storage
+        */
+        void Defragment(MxVector<Relocation>& relocations)
+        {
+            relocations.clear();
+            size_t cursor = 0;
+            for (auto& allocation : this->allocations)
+            {
+                if (allocation.Offset != cursor)
+                {
+                    relocations.push_back(Relocation{ allocation.Offset, cursor, allocation.Size });
+                    allocation.Offset = cursor;
+                }
+                cursor += allocation.Size;
+            }
+
+            this->freeRanges.clear();
+            if (cursor < this->capacity) this->freeRanges.push_back(Range{ cursor, this->capacity - cursor });
+        }
+
+        /*!
+        getter for storage capacity
+        \returns number of elements managed by allocator
+        */
+        size_t GetCapacity() const
+        {
+            return this->capacity;
+        }
+
+        /*!
+        getter for used storage size
+        \returns number of elements in all allocated ranges
+        */
+        size_t GetUsedSize() const
+        {
+            return this->usedSize;
+        }
+
+        /*!
+        getter for free storage size
+        \returns number of elements in all free ranges
+        */
+        size_t GetFreeSize() const
+        {
+            return this->capacity - this->usedSize;
+        }
+
+        /*!
+        getter for largest free range
+        \returns size of largest range which can be allocated at once
+        */
+        size_t GetLargestFreeRange() const
+        {
+            size_t result = 0;
+            for (const auto& range : this->freeRanges)
+                result = result < range.Size ? range.Size : result;
+            return result;
+        }
+
+        /*!
+        computes fragmentation of free storage
+        \returns zero if all free elements form one range, values close to one if free storage is split into many small ranges
+        */
+        float GetFragmentation() const
+        {
+            size_t freeSize = this->GetFreeSize();
+            if (freeSize == 0) return 0.0f;
+            return 1.0f - float(this->GetLargestFreeRange()) / float(freeSize);
+        }
+
+        /*!
+        getter for allocated ranges
+        \returns allocated ranges sorted by offset
+        */
+        const MxVector<Range>& GetAllocations() const
+        {
+            return this->allocations;
+        }
+
+        /*!
+        getter for free ranges
+        \returns free ranges sorted by offset
+        */
+        const MxVector<Range>& GetFreeRanges() const
+        {
+            return this->freeRanges;
+        }
+    };
+}
@@ -29,6 +29,8 @@
 #include "Profiler.h"
 #include "Utilities/STL/MxString.h"
 
+#include <thread>
+
 namespace MxEngine
 {
 	void ProfileSession::WriteJsonHeader()
@@ -66,6 +68,7 @@ namespace MxEngine
 	{
 		if (!this->IsValid()) return;
 
+		std::lock_guard lock(this->outputMutex);
 		if (this->GetEntryCount() > 0)
 		{
 			output << ",\n";
@@ -74,7 +77,7 @@ namespace MxEngine
 
 		output << "	{";
 		output << "\"pid\": 0, ";
-		output << "\"tid\": 0, ";
+		output << "\"tid\": " << std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id()) % 100000) << ", ";
 		output << "\"ts\": " << std::to_string(uint64_t((double)begin * 1000000)) << ", ";
 		output << "\"dur\": " << std::to_string(uint64_t((double)delta * 1000000)) << ", ";
 		output << "\"ph\": \"X\", ";
@@ -85,6 +88,7 @@ namespace MxEngine
 	void ProfileSession::EndSession()
 	{
 		if (!this->IsValid()) return;
+		std::lock_guard lock(this->outputMutex);
 		this->WriteJsonFooter();
 		output.Close();
 	}
@@ -28,6 +28,8 @@
 
 #pragma once
 
+#include <mutex>
+
 #include "Core/Macro/Macro.h"
 #include "Utilities/Time/Time.h"
 #include "Utilities/Logging/Logger.h"
@@ -49,6 +51,10 @@ namespace MxEngine
 		count of json log entries (is used internally to create json file)
 		*/
 		size_t entriesCount = 0;
+		/*!
+		guards json output, as entries can be written from job system worker threads
+		*/
+		std::mutex outputMutex;
 
 		/*!
 		writes header of json file, i.e "{ traceEvents: [ ..."
@@ -39,6 +39,16 @@ MxEngine::TimeStep MxEngine::Time::Current()
 {
 	return (MxEngine::TimeStep)glfwGetTime();
 }
+#else
+#include "Core/Application/Application.h"
+
+MxEngine::TimeStep MxEngine::Time::Current()
+{
+	// same as glfwGetTime(): seconds passed since first call
+	using namespace std::chrono;
+	static const auto start = steady_clock::now();
+	return duration_cast<duration<MxEngine::TimeStep>>(steady_clock::now() - start).count();
+}
 #endif
 
 namespace MxEngine
@@ -34,8 +34,85 @@
 #include <boost/uuid/random_generator.hpp>
 #include <boost/uuid/nil_generator.hpp>
 
+#include <array>
+#include <algorithm>
+#include <cstring>
+
 namespace MxEngine
 {
+    // xoshiro256** generator. It is not cryptographic, but is fast and has enough state to produce unique v4 uuids
+    class Xoshiro256
+    {
+        uint64_t state[4] = { 0 };
+
+        static uint64_t Rotl(uint64_t x, int k)
+        {
+            return (x << k) | (x >> (64 - k));
+        }
+    public:
+        void Seed(const uint8_t* seed, size_t bytes)
+        {
+            std::memcpy(this->state, seed, std::min(bytes, sizeof(this->state)));
+            if ((this->state[0] | this->state[1] | this->state[2] | this->state[3]) == 0)
+                this->state[0] = 0x9E3779B97F4A7C15; // all-zero state is invalid for xoshiro
+        }
+
+        uint64_t Next()
+        {
+            const uint64_t result = Rotl(this->state[1] * 5, 7) * 9;
+            const uint64_t t = this->state[1] << 17;
+
+            this->state[2] ^= this->state[0];
+            this->state[3] ^= this->state[1];
+            this->state[1] ^= this->state[2];
+            this->state[0] ^= this->state[3];
+            this->state[2] ^= t;
+            this->state[3] = Rotl(this->state[3], 45);
+
+            return result;
+        }
+    };
+
+    // uuids are generated by batches into thread-local buffer, so UUIDGenerator::Get() is mostly a copy from it
+    struct UUIDBatch
+    {
+        constexpr static size_t Size = 64;
+
+        std::array<boost::uuids::uuid, Size> Uuids;
+        size_t Current = Size;
+        Xoshiro256 Generator;
+        bool IsSeeded = false;
+    };
+
+    static thread_local UUIDBatch ThreadBatch;
+
+    static void RefillBatch(UUIDBatch& batch, UUIDGeneratorImpl& storage)
+    {
+        if (!batch.IsSeeded)
+        {
+            // seed is taken from system random generator, so each thread (and module) gets independent sequence
+            boost::uuids::uuid seed[2];
+            {
+                std::lock_guard lock(storage.SeedMutex);
+                seed[0] = storage.GetGeneratorImpl()();
+                seed[1] = storage.GetGeneratorImpl()();
+            }
+            batch.Generator.Seed(reinterpret_cast<const uint8_t*>(seed), sizeof(seed));
+            batch.IsSeeded = true;
+        }
+
+        for (auto& uuid : batch.Uuids)
+        {
+            uint64_t random[2] = { batch.Generator.Next(), batch.Generator.Next() };
+            std::memcpy(uuid.data, random, sizeof(random));
+
+            // set version (4, random) and variant (RFC 4122) bits
+            uuid.data[6] = (uuid.data[6] & 0x0F) | 0x40;
+            uuid.data[8] = (uuid.data[8] & 0x3F) | 0x80;
+        }
+        batch.Current = 0;
+    }
+
     void UUIDGenerator::Init()
     {
         static_assert(AssertEquality<sizeof(storage->generator), sizeof(boost::uuids::random_generator)>::value,
@@ -49,8 +126,11 @@ namespace MxEngine
 
     UUID UUIDGenerator::Get()
     {
+        if (ThreadBatch.Current == UUIDBatch::Size)
+            RefillBatch(ThreadBatch, *storage);
+
         UUID uuid;
-        uuid.GetImpl() = storage->GetGeneratorImpl()();
+        uuid.GetImpl() = ThreadBatch.Uuids[ThreadBatch.Current++];
         return uuid;
     }
 
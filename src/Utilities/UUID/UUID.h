@@ -31,6 +31,7 @@
 #include <utility>
 #include <ostream>
 #include <istream>
+#include <mutex>
 
 #include "Utilities/STL/MxString.h"
 #include "Core/Macro/Macro.h"
@@ -74,6 +75,8 @@ namespace MxEngine
         #else
         std::aligned_storage_t<1, 1> generator;
         #endif
+        // guards generator, which is used to seed per-thread uuid sources
+        std::mutex SeedMutex;
         boost::uuids::random_generator_pure& GetGeneratorImpl();
     };
 
@@ -0,0 +1,416 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include "Utilities/STL/MxVector.h"
+#include "Utilities/Memory/Memory.h"
+
+#if defined(MXENGINE_WINDOWS)
+#include <intrin.h>
+#endif
+
+namespace MxEngine
+{
+    /*!
+    counts trailing zero bits in 64-bit word
+    \param value word to count zeros in. Must not be zero
+    \returns index of lowest set bit
+    */
+    inline size_t CountTrailingZeros(uint64_t value)
+    {
+        MX_ASSERT(value != 0);
+        #if defined(MXENGINE_WINDOWS)
+        unsigned long index = 0;
+        _BitScanForward64(&index, value);
+        return (size_t)index;
+        #else
+        return (size_t)__builtin_ctzll(value);
+        #endif
+    }
+
+    /*!
+    PagedVectorPool is an object pool with the same interface as VectorPool, but objects are stored in fixed-size pages which are never moved
+    this means that growing the pool does not relocate existing objects, so references to them stay valid until object is deallocated
+    each page keeps occupancy bitmap, so iteration over sparse pool skips 64 empty slots at once
+    */
+    template<typename T, size_t PageSize = 256>
+    class PagedVectorPool
+    {
+        static_assert(PageSize > 0 && PageSize % 64 == 0, "page size must be multiple of 64");
+        constexpr static size_t WordBits = 64;
+        constexpr static size_t WordsPerPage = PageSize / WordBits;
+    public:
+        using Generation = uint32_t;
+
+        /*!
+        iterator for PagedVectorPool class. supports increment, compare and decrement.
+        Ignores not allocated objects, using occupancy bitmap to find next allocated one
+        */
+        class PoolIterator
+        {
+            /*!
+            current index of object in paged pool
+            */
+            size_t index = 0;
+            /*!
+            reference to paged pool. Pool must not be moved/deleted until iterator exists
+            */
+            PagedVectorPool<T, PageSize>& poolRef;
+        public:
+            size_t GetBase() const
+            {
+                return index;
+            }
+
+            PagedVectorPool<T, PageSize>& GetPoolRef()
+            {
+                return poolRef;
+            }
+
+            /*!
+            constructs new iterator of paged pool
+            \param index to the element of pool (0 for begin(), Capacity() for end() methods)
+            \param poolRef reference to paged pool
+            */
+            PoolIterator(size_t index, PagedVectorPool<T, PageSize>& ref)
+                : index(ref.FindNextAllocated(index)), poolRef(ref) { }
+
+            PoolIterator operator++(int)
+            {
+                PoolIterator copy = *this;
+                ++(*this);
+                return copy;
+            }
+
+            PoolIterator operator++()
+            {
+                index = poolRef.FindNextAllocated(index + 1);
+                return *this;
+            }
+
+            PoolIterator operator--(int)
+            {
+                PoolIterator copy = *this;
+                --(*this);
+                return copy;
+            }
+
+            PoolIterator operator--()
+            {
+                do { index--; } while (index < poolRef.Capacity() && !poolRef.IsAllocated(index));
+                return *this;
+            }
+
+            T* operator->()
+            {
+                return &poolRef[index];
+            }
+
+            const T* operator->() const
+            {
+                return &poolRef[index];
+            }
+
+            T& operator*()
+            {
+                return poolRef[index];
+            }
+
+            const T& operator*() const
+            {
+                return poolRef[index];
+            }
+
+            bool operator==(const PoolIterator& it) const
+            {
+                return (index == it.index) && (&poolRef == &it.poolRef);
+            }
+
+            bool operator!=(const PoolIterator& it) const
+            {
+                return !(*this == it);
+            }
+        };
+    private:
+        using Storage = std::aligned_storage_t<sizeof(T), alignof(T)>;
+
+        struct Page
+        {
+            Storage Data[PageSize];
+            uint64_t Occupancy[WordsPerPage] = { };
+            Generation Generations[PageSize] = { };
+        };
+
+        /*!
+        begin of page data and index of page in pages list
+        */
+        struct PageAddress
+        {
+            const uint8_t* Begin;
+            size_t Page;
+        };
+
+        /*!
+        pages of objects. Pages are allocated separately, so growing the list does not move objects
+        */
+        MxVector<UniqueRef<Page>> pages;
+        /*!
+        page data addresses sorted in increasing order, each paired with page index. Used by IndexOf() to binary search page of element
+        */
+        MxVector<PageAddress> pageAddresses;
+        /*!
+        stack of free slot indices. Lowest indices are on top, so objects are packed at the beginning of pool
+        */
+        MxVector<size_t> freeList;
+        /*!
+        number of constructed objects
+        */
+        size_t allocated = 0;
+
+        void AddPage()
+        {
+            size_t base = this->Capacity();
+            this->pages.push_back(MakeUnique<Page>());
+
+            const uint8_t* address = reinterpret_cast<const uint8_t*>(this->pages.back()->Data);
+            size_t position = this->FindPageAfter(address);
+            this->pageAddresses.insert(this->pageAddresses.begin() + position, PageAddress{ address, this->pages.size() - 1 });
+            for (size_t i = PageSize; i > 0; i--)
+                this->freeList.push_back(base + i - 1);
+        }
+
+        /*!
+        binary search of first page which data begins after address provided
+        \param address address to search for
+        \returns index in page address table or its size if there is no such page
+        */
+        size_t FindPageAfter(const uint8_t* address) const
+        {
+            size_t begin = 0, end = this->pageAddresses.size();
+            while (begin < end)
+            {
+                size_t middle = begin + (end - begin) / 2;
+                if (this->pageAddresses[middle].Begin <= address)
+                    begin = middle + 1;
+                else
+                    end = middle;
+            }
+            return begin;
+        }
+
+        Page& GetPage(size_t index) { return *this->pages[index / PageSize]; }
+        const Page& GetPage(size_t index) const { return *this->pages[index / PageSize]; }
+    public:
+        PagedVectorPool() = default;
+        PagedVectorPool(const PagedVectorPool&) = delete;
+        PagedVectorPool& operator=(const PagedVectorPool&) = delete;
+        PagedVectorPool(PagedVectorPool&&) noexcept = default;
+
+        PagedVectorPool& operator=(PagedVectorPool&& other) noexcept
+        {
+            this->Clear();
+            this->pages = std::move(other.pages);
+            this->pageAddresses = std::move(other.pageAddresses);
+            this->freeList = std::move(other.freeList);
+            this->allocated = other.allocated;
+            other.allocated = 0;
+            return *this;
+        }
+
+        /*!
+        constructs paged pool with at least count elements as capacity
+        \param count number of preallocated elements (not constructed)
+        */
+        PagedVectorPool(size_t count)
+        {
+            this->Resize(count);
+        }
+
+        /*!
+        adds pages until capacity is not less than count. Existing objects are not moved
+        \param count number of preallocated elements in container (not constructed)
+        */
+        void Resize(size_t count)
+        {
+            while (this->Capacity() < count) this->AddPage();
+        }
+
+        size_t Allocated() const
+        {
+            return this->allocated;
+        }
+
+        size_t Capacity() const
+        {
+            return this->pages.size() * PageSize;
+        }
+
+        size_t CapacityInBytes() const
+        {
+            return this->pages.size() * sizeof(Page);
+        }
+
+        T& operator[] (size_t index)
+        {
+            MX_ASSERT(index < this->Capacity());
+            return *std::launder(reinterpret_cast<T*>(&this->GetPage(index).Data[index % PageSize]));
+        }
+
+        const T& operator[] (size_t index) const
+        {
+            MX_ASSERT(index < this->Capacity());
+            return *std::launder(reinterpret_cast<const T*>(&this->GetPage(index).Data[index % PageSize]));
+        }
+
+        /*!
+        destroys all constructed elements. Pages are kept allocated
+        */
+        void Clear()
+        {
+            for (size_t i = this->FindNextAllocated(0); i < this->Capacity(); i = this->FindNextAllocated(i + 1))
+                this->Deallocate(i);
+
+            this->freeList.clear();
+            size_t pageCount = this->pages.size();
+            for (size_t page = pageCount; page > 0; page--)
+            {
+                for (size_t i = PageSize; i > 0; i--)
+                    this->freeList.push_back((page - 1) * PageSize + i - 1);
+            }
+        }
+
+        bool IsAllocated(size_t index) const
+        {
+            if (index >= this->Capacity()) return false;
+            size_t local = index % PageSize;
+            return (this->GetPage(index).Occupancy[local / WordBits] >> (local % WordBits)) & 1;
+        }
+
+        /*!
+        finds first allocated element starting from index. Empty 64-element runs are skipped using occupancy bitmap
+        \param index index to start search from
+        \returns index of allocated element or Capacity() if there is none
+        */
+        size_t FindNextAllocated(size_t index) const
+        {
+            size_t capacity = this->Capacity();
+            while (index < capacity)
+            {
+                size_t local = index % PageSize;
+                uint64_t word = this->GetPage(index).Occupancy[local / WordBits] & (~uint64_t(0) << (local % WordBits));
+                if (word != 0)
+                    return index - local % WordBits + CountTrailingZeros(word);
+                index = (index / WordBits + 1) * WordBits;
+            }
+            return capacity;
+        }
+
+        Generation GetGeneration(size_t index) const
+        {
+            MX_ASSERT(index < this->Capacity());
+            return this->GetPage(index).Generations[index % PageSize];
+        }
+
+        void Deallocate(size_t index)
+        {
+            if (IsAllocated(index))
+            {
+                Page& page = this->GetPage(index);
+                size_t local = index % PageSize;
+                (*this)[index].~T();
+                page.Occupancy[local / WordBits] &= ~(uint64_t(1) << (local % WordBits));
+                page.Generations[local]++;
+                this->freeList.push_back(index);
+                this->allocated--;
+            }
+        }
+
+        void Deallocate(const PoolIterator& it)
+        {
+            this->Deallocate(it.GetBase());
+        }
+
+        /*!
+        constructs element in paged pool. If it has not enough space - new page is added
+        \param args arguments for element constructor
+        \returns index of element in paged pool
+        */
+        template<typename... Args>
+        size_t Allocate(Args&&... args)
+        {
+            if (this->freeList.empty()) this->AddPage();
+
+            size_t index = this->freeList.back();
+            this->freeList.pop_back();
+
+            Page& page = this->GetPage(index);
+            size_t local = index % PageSize;
+            new (&page.Data[local]) T(std::forward<Args>(args)...);
+            page.Occupancy[local / WordBits] |= uint64_t(1) << (local % WordBits);
+            this->allocated++;
+            return index;
+        }
+
+        /*!
+        retrieves index of element in paged pool by reference. Page of element is found by binary search over page addresses
+        \param obj element of paged pool
+        \returns index of element in paged pool
+        */
+        size_t IndexOf(const T& obj) const
+        {
+            const uint8_t* ptr = reinterpret_cast<const uint8_t*>(&obj);
+            // element belongs to the last page which begins not after it
+            size_t position = this->FindPageAfter(ptr);
+            if (position > 0)
+            {
+                const auto& page = this->pageAddresses[position - 1];
+                if (ptr < page.Begin + sizeof(Page::Data))
+                    return page.Page * PageSize + size_t(ptr - page.Begin) / sizeof(Storage);
+            }
+            MX_ASSERT(false); // object does not belong to this pool
+            return this->Capacity();
+        }
+
+        PoolIterator begin()
+        {
+            return PoolIterator{ 0, *this };
+        }
+
+        PoolIterator end()
+        {
+            return PoolIterator{ this->Capacity(), *this };
+        }
+
+        ~PagedVectorPool()
+        {
+            for (size_t i = this->FindNextAllocated(0); i < this->Capacity(); i = this->FindNextAllocated(i + 1))
+                (*this)[i].~T();
+        }
+    };
+}
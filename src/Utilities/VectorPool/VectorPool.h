@@ -180,6 +180,7 @@ namespace MxEngine
 
         using Allocator = PoolAllocator<T>;
         using Block = typename Allocator::Block;
+        using Generation = uint32_t;
     private:
         /*!
         storage for allocator memory. Unluckly, not debuggable
@@ -190,6 +191,10 @@ namespace MxEngine
         */
         Allocator allocator;
         /*!
+        generation of each block. Incremented every time object in block is destroyed, so stale handles can be detected
+        */
+        Container<Generation> generations;
+        /*!
         number of constructed objects
         */
         size_t allocated = 0;
@@ -233,6 +238,10 @@ namespace MxEngine
             Container<uint8_t> newMemory(count * sizeof(Block));
             allocator.Transfer(newMemory.data(), newMemory.size());
             memoryStorage = std::move(newMemory);
+
+            // generations are kept even after Clear(), so container may already be big enough
+            if (this->generations.size() < count)
+                this->generations.resize(count, Generation(0));
         }
 
         /*!
@@ -288,6 +297,8 @@ namespace MxEngine
             this->allocator.~PoolAllocator();
             this->memoryStorage.clear();
             this->allocated = 0;
+            for (auto& generation : this->generations)
+                generation++;
         }
 
         /*!
@@ -300,6 +311,17 @@ namespace MxEngine
             return index < this->Capacity() && !GetBlockByIndex(index)->IsFree();
         }
 
+        /*!
+        gets generation of block. Generation changes each time element in block is destroyed
+        \param index index of element in vector Pool
+        \returns current generation of block
+        */
+        Generation GetGeneration(size_t index) const
+        {
+            MX_ASSERT(index < this->generations.size());
+            return this->generations[index];
+        }
+
         /*!
         destroys element in vector Pool
         \param index index of element to destroy
@@ -311,6 +333,7 @@ namespace MxEngine
                 T& ptr = GetBlockByIndex(index)->data;
                 allocator.Free(&ptr);
                 this->allocated--;
+                this->generations[index]++;
             }
         }
 